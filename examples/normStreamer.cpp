@@ -108,6 +108,11 @@ class NormStreamer
             assert(NORM_SESSION_INVALID != norm_session);
             NormSetTxRate(norm_session, bitsPerSecond);
         }
+        void SetNormTxPacingMode(NormTxPacingMode pacingMode)
+        {
+            assert(NORM_SESSION_INVALID != norm_session);
+            NormSetTxPacingMode(norm_session, pacingMode);
+        }
         void SetNormMulticastInterface(const char* ifaceName)
         {
             assert(NORM_SESSION_INVALID != norm_session);
@@ -1343,6 +1348,7 @@ void Usage()
     fprintf(stderr, "Usage: normStreamer id <nodeIdInteger> {send|recv} [addr <addr>[/<port>]]\n"
                     "                    [interface <name>] [loopback] [info] [ptos <value>] [ex]\n"
                     "                    [cc|cce|ccl|rate <bitsPerSecond>]\n"
+                    "                    [pacing {timer|bucket|hybrid}]\n"
                     "                    [ack auto|<node1>[,<node2>,...]]\n"
                     "                    [flush {none|passive|active}]\n"
                     "                    [listen [<mcastAddr>/]<port>] [linterface <name>]\n"
@@ -1396,6 +1402,8 @@ void PrintHelp()
             "   insockbuffer <bytes>    -- Specifies the size of the 'listen' UDP socket buffer (optional).\n"
             "   outsockbuffer <bytes>   -- Specifies the size of the 'relay' UDP socket buffer (optional).\n"
             "   txsockbuffer <bytes>    -- Specifies the size of the NORM/UDP transmit socket buffer (optional).\n"
+            "   pacing {timer|bucket|hybrid} -- Specifies NORM transmit rate pacing mode (optional, 'bucket' or\n"
+            "                              'hybrid' pace high rates more precisely than the default 'timer').\n"
             "   rxsockbuffer <bytes>    -- Specifies the size of the NORM/UDP receive socket buffer (optional).\n"
             "   streambuffer <bytes>    -- Specifies the size of the NORM stream buffer (optional).\n\n");
     Usage();
@@ -1444,6 +1452,7 @@ int main(int argc, char* argv[])
     unsigned long inputSocketBufferSize = 0;    // 6*1024*1024;
     unsigned long outputSocketBufferSize = 0;   // 6*1024*1024;
     unsigned long txSocketBufferSize = 0;       // 6*1024*1024;
+    NormTxPacingMode txPacingMode = NORM_PACING_TIMER;
     unsigned long rxSocketBufferSize = 0;       // 6*1024*1024;
     unsigned long streamBufferSize = 1*1024*1024;
 
@@ -1888,6 +1897,34 @@ int main(int argc, char* argv[])
             }
             normStreamer.SetNumParity(value);
         }
+        else if (0 == strncmp(cmd, "pacing", len))
+        {
+            if (i >= argc)
+            {
+                fprintf(stderr, "normStreamer error: missing 'pacing' mode!\n");
+                Usage();
+                return -1;
+            }
+            const char* mode = argv[i++];
+            if (0 == strcmp(mode, "timer"))
+            {
+                txPacingMode = NORM_PACING_TIMER;
+            }
+            else if (0 == strcmp(mode, "bucket"))
+            {
+                txPacingMode = NORM_PACING_BUCKET;
+            }
+            else if (0 == strcmp(mode, "hybrid"))
+            {
+                txPacingMode = NORM_PACING_HYBRID;
+            }
+            else
+            {
+                fprintf(stderr, "normStreamer error: invalid 'pacing' mode \"%s\"\n", mode);
+                Usage();
+                return -1;
+            }
+        }
         else if (0 == strncmp(cmd, "auto", len))
         {
             if (i >= argc)
@@ -2076,6 +2113,8 @@ int main(int argc, char* argv[])
     normStreamer.SetNormCongestionControl(ccMode);
     if (NormStreamer::NORM_FIXED == ccMode)
         normStreamer.SetNormTxRate(txRate);
+    if (NORM_PACING_TIMER != txPacingMode)
+        normStreamer.SetNormTxPacingMode(txPacingMode);
     if (NULL != mcastIface)
         normStreamer.SetNormMulticastInterface(mcastIface);
     
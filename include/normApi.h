@@ -163,6 +163,14 @@ typedef enum NormRepairBoundary
     NORM_BOUNDARY_OBJECT
 } NormRepairBoundary;
     
+NORM_API_LINKAGE
+typedef enum NormTxPacingMode
+{
+    NORM_PACING_TIMER,  // tx timer scheduled per message (default)
+    NORM_PACING_BUCKET, // token bucket credited by elapsed time, small bursts
+    NORM_PACING_HYBRID  // token bucket plus spin-wait for short intervals
+} NormTxPacingMode;
+    
 NORM_API_LINKAGE
 typedef enum NormEventType
 {
@@ -210,6 +218,73 @@ typedef struct
 typedef char* (*NormAllocFunctionHandle)(size_t);
 typedef void (*NormFreeFunctionHandle)(char*);
 
+// For "scatter/gather" data enqueue and stream writes (laid out 
+// like the POSIX "struct iovec" so those may be cast to this type)
+typedef struct
+{
+    void*   iov_base;
+    size_t  iov_len;
+} NormIoVec;
+
+// Statistics histograms have log2-spaced microsecond bins:  bins[0] counts
+// values under 1 usec, bins[i] counts [2^(i-1), 2^i) usec and the last bin
+// also counts anything longer
+#define NORM_HISTOGRAM_BINS 24
+typedef struct
+{
+    unsigned long long  count;
+    unsigned long long  sumUsec;
+    unsigned long long  maxUsec;
+    unsigned long long  bins[NORM_HISTOGRAM_BINS];
+} NormHistogram;
+
+// Cumulative session statistics (see NormGetSessionStats())
+typedef struct
+{
+    unsigned long long  txPackets;            // messages sent
+    unsigned long long  txBytes;
+    unsigned long long  txDropped;            // dropped by NormSetTxLoss() testing
+    unsigned long long  rxPackets;            // messages received from other nodes
+    unsigned long long  rxBytes;
+    // Sender state
+    unsigned long long  nacksReceived;        // NACK messages
+    unsigned long long  nackItems;            // SEGMENT repair items in NACKs
+    unsigned long long  nackItemsCoalesced;   // ... already covered this repair cycle
+    unsigned long long  parityCacheHits;
+    unsigned long long  parityCacheMisses;
+    unsigned long long  bufferPeakSegments;   // peak tx segment pool usage
+    unsigned long long  bufferOverruns;
+    double              txRate;               // bits/sec
+    double              grtt;                 // advertised GRTT (sec)
+    NormNodeId          ccClrId;              // NORM_NODE_NONE when no CLR
+    double              ccClrRate;            // bits/sec
+    double              ccClrRtt;             // sec
+    double              ccClrLoss;            // fraction
+    bool                ccSlowStart;
+    NormHistogram       repairDelay;          // NACK arrival to first repair sent
+    NormHistogram       rxInterArrival;       // between received messages
+} NormSessionStats;
+
+// Cumulative statistics kept for a remote sender (see NormNodeGetStats())
+typedef struct
+{
+    unsigned long long  rxPackets;
+    unsigned long long  rxBytes;
+    unsigned long long  rxGoodputBytes;       // object data received or decoded
+    unsigned long long  nacksSent;
+    unsigned long long  nacksSuppressed;
+    unsigned long long  resyncs;
+    unsigned long long  objectsCompleted;
+    unsigned long long  objectsFailed;
+    unsigned long long  bufferPeakSegments;   // peak rx segment pool usage
+    unsigned long long  bufferOverruns;
+    double              rxRate;               // recent bits/sec
+    double              grtt;                 // sender's advertised GRTT (sec)
+    double              lossEstimate;         // fraction
+    NormHistogram       rxInterArrival;       // between messages from this sender
+    NormHistogram       decodeTime;           // FEC block decoding
+} NormNodeStats;
+
 
 /** NORM API General Initialization and Operation Functions */
 
@@ -224,6 +299,14 @@ int NormGetVersion(int* major DEFAULT((int*)0),
 NORM_API_LINKAGE 
 NormInstanceHandle NormCreateInstance(bool priorityBoost DEFAULT(false));
 
+// Creates an instance whose sessions are spread across "threadCount" NORM
+// protocol threads (each with its own timers and sockets).  Each new session
+// is placed on the thread with the fewest sessions.  Events from all threads
+// are delivered through the instance (e.g., NormGetNextEvent()) as usual.
+NORM_API_LINKAGE 
+NormInstanceHandle NormCreateShardedInstance(unsigned int threadCount,
+                                             bool         priorityBoost DEFAULT(false));
+
 NORM_API_LINKAGE 
 void NormDestroyInstance(NormInstanceHandle instanceHandle);
 
@@ -246,11 +329,31 @@ NORM_API_LINKAGE
 bool NormSetCacheDirectory(NormInstanceHandle instanceHandle, 
                            const char*        cachePath);
 
+// Selects the file object I/O backend for a session.  With a non-zero 
+// "threadCount", file reads (prefetching "readAhead" blocks ahead of 
+// transmission) and received content writes are performed by worker
+// threads instead of blocking the protocol thread (not supported on WIN32).
+NORM_API_LINKAGE
+bool NormSetFileIoThreads(NormSessionHandle sessionHandle,
+                          unsigned int      threadCount,
+                          unsigned int      readAhead DEFAULT(4));
+
 // This call blocks until the next NormEvent is ready unless asynchronous
 // notification is used (see below)
 NORM_API_LINKAGE 
 bool NormGetNextEvent(NormInstanceHandle instanceHandle, NormEvent* theEvent, bool waitForEvent DEFAULT(true));
 
+// Retrieves up to "arraySize" pending events in a single call and returns the
+// number of events copied to "eventArray" (zero if none are pending when 
+// "waitForEvent" is false).  Handles in returned events remain valid until
+// the next call to NormGetNextEvents(), NormGetNextEvent() or 
+// NormReleasePreviousEvent().  This does not block the NORM protocol thread.
+NORM_API_LINKAGE 
+unsigned int NormGetNextEvents(NormInstanceHandle   instanceHandle, 
+                               NormEvent*           eventArray, 
+                               unsigned int         arraySize, 
+                               bool                 waitForEvent DEFAULT(true));
+
 // The "NormGetDescriptor()" function returns a HANDLE (WIN32) or
 // a file descriptor (UNIX) which can be used for async notification
 // of pending NORM events. On WIN32, the returned HANDLE can be used 
@@ -410,6 +513,12 @@ bool NormSetFragmentation(NormSessionHandle sessionHandle,
 NORM_API_LINKAGE 
 void NormSetMessageTrace(NormSessionHandle sessionHandle, bool state);
 
+// Records a compact binary trace of messages sent and received to "path"
+// instead of the text trace lines (a NULL "path" closes the trace file).
+// Use the "normTraceDecode" tool to convert the file for "n2m" and "trpr".
+NORM_API_LINKAGE
+bool NormSetMessageTraceFile(NormSessionHandle sessionHandle, const char* path);
+
 NORM_API_LINKAGE 
 void NormSetTxLoss(NormSessionHandle sessionHandle, double percent);
 
@@ -440,6 +549,13 @@ void NormSetReportInterval(NormSessionHandle sessionHandle, double interval);
 NORM_API_LINKAGE
 double NormGetReportInterval(NormSessionHandle sessionHandle);
 
+// Copies the session's cumulative statistics into "stats".  This doesn't
+// suspend the NORM thread, so it is cheap enough to poll, but the values
+// are read individually rather than as an atomic snapshot.
+NORM_API_LINKAGE
+bool NormGetSessionStats(NormSessionHandle sessionHandle,
+                         NormSessionStats* stats);
+
 /** NORM Sender Functions */
 
 NORM_API_LINKAGE
@@ -467,10 +583,23 @@ void NormSetTxRate(NormSessionHandle sessionHandle,
 NORM_API_LINKAGE 
 double NormGetTxRate(NormSessionHandle sessionHandle);
 
+// Selects how transmission is paced at the session "txRate". The token bucket
+// modes achieve the configured rate more precisely at high (>100 Mbps) rates.
+NORM_API_LINKAGE 
+void NormSetTxPacingMode(NormSessionHandle sessionHandle,
+                         NormTxPacingMode  pacingMode);
+
 NORM_API_LINKAGE 
 bool NormSetTxSocketBuffer(NormSessionHandle sessionHandle,
                            unsigned int      bufferSize);
 
+// Sets the maximum number of messages that are sent per system call when the
+// transmit rate allows a burst (Linux sendmmsg() or UDP GSO).  A "batchSize"
+// of 0 or 1 (default) disables batched transmission.
+NORM_API_LINKAGE 
+bool NormSetTxBatchSize(NormSessionHandle sessionHandle,
+                        unsigned int      batchSize);
+
 NORM_API_LINKAGE 
 void NormSetFlowControl(NormSessionHandle sessionHandle,
                         double            flowControlFactor);
@@ -495,6 +624,27 @@ NORM_API_LINKAGE
 void NormSetAutoParity(NormSessionHandle sessionHandle,
                        unsigned char     autoParity);
 
+// When enabled, FEC parity is computed for a whole block at once (when first
+// needed) instead of incrementally as each source segment is sent.  This is
+// more cache-efficient for large blocks (e.g., with "auto parity") 
+NORM_API_LINKAGE 
+bool NormSetBlockEncode(NormSessionHandle sessionHandle,
+                        bool              state);
+
+// Sets how many recently repaired blocks' FEC parity the sender keeps after
+// their buffers are reclaimed, so repeated repairs of those blocks do not
+// re-read source data and re-encode (0 disables, default is 8 blocks)
+NORM_API_LINKAGE 
+bool NormSetTxParityCache(NormSessionHandle sessionHandle,
+                          unsigned int      blockCount);
+
+// Sets the number of FEC worker threads used to calculate block parity (sender)
+// and decode blocks (receiver) off of the NORM protocol thread.  The default
+// of zero threads does all FEC work inline.
+NORM_API_LINKAGE 
+bool NormSetFecThreads(NormSessionHandle sessionHandle,
+                       unsigned int      threadCount);
+
 NORM_API_LINKAGE 
 void NormSetGrttEstimate(NormSessionHandle sessionHandle,
                          double            grttEstimate);
@@ -531,6 +681,16 @@ NORM_API_LINKAGE
 void NormSetTxRobustFactor(NormSessionHandle sessionHandle,
                            int               robustFactor);
 
+// When enabled, file objects subsequently enqueued or received are accessed
+// through a memory mapping rather than per-segment read()/write() calls.
+// Received files are only mapped (Linux only) when their storage can be
+// preallocated, otherwise write() is used.  Enqueued files must not be
+// truncated while being sent since the process would receive SIGBUS when
+// accessing the mapped pages past the new end of the file.
+NORM_API_LINKAGE 
+void NormSetFileMapping(NormSessionHandle sessionHandle,
+                        bool              state);
+
 NORM_API_LINKAGE 
 NormObjectHandle NormFileEnqueue(NormSessionHandle sessionHandle,
                                  const char*       fileName,
@@ -544,6 +704,16 @@ NormObjectHandle NormDataEnqueue(NormSessionHandle sessionHandle,
                                  const char*       infoPtr DEFAULT((const char*)0),
                                  unsigned int      infoLen DEFAULT(0));
 
+// Enqueues a data object whose content is the concatenation of the "iovCount"
+// buffers (the NormIoVec array itself need not be retained, but the buffers
+// it points to must be kept until the object is purged as for NormDataEnqueue())
+NORM_API_LINKAGE 
+NormObjectHandle NormDataEnqueueV(NormSessionHandle sessionHandle,
+                                  const NormIoVec*  iov,
+                                  unsigned int      iovCount,
+                                  const char*       infoPtr DEFAULT((const char*)0),
+                                  unsigned int      infoLen DEFAULT(0));
+
 NORM_API_LINKAGE 
 bool NormRequeueObject(NormSessionHandle sessionHandle, NormObjectHandle objectHandle);
                                      
@@ -571,6 +741,15 @@ unsigned int NormStreamWrite(NormObjectHandle streamHandle,
                              const char*      buffer,
                              unsigned int     numBytes);
 
+// Gathers the "iovCount" buffers into the stream as one write, returning
+// the number of bytes written (as for NormStreamWrite()).  Buffers of 4 GiB
+// or more are invalid (nothing is written) and at most 4 GiB - 1 bytes are
+// written per call.
+NORM_API_LINKAGE 
+unsigned int NormStreamWriteV(NormObjectHandle streamHandle,
+                              const NormIoVec* iov,
+                              unsigned int     iovCount);
+
 NORM_API_LINKAGE 
 void NormStreamFlush(NormObjectHandle streamHandle, 
                      bool             eom DEFAULT(false),
@@ -584,6 +763,15 @@ NORM_API_LINKAGE
 void NormStreamSetPushEnable(NormObjectHandle streamHandle, 
                              bool             pushEnable);
 
+// Adds a staging buffer of "bufferSize" bytes to a sender or receiver stream so
+// that NormStreamWrite() and NormStreamRead() normally do not need to suspend
+// the NORM protocol thread.  Staged receive data is only available while the
+// application is "in sync" with the stream (i.e., after a successful read or
+// message start seek).  A single application thread should access the stream.
+NORM_API_LINKAGE 
+bool NormStreamEnableStaging(NormObjectHandle streamHandle,
+                             unsigned int     bufferSize);
+
 NORM_API_LINKAGE 
 bool NormStreamHasVacancy(NormObjectHandle streamHandle);
 
@@ -593,6 +781,21 @@ unsigned int NormStreamGetVacancy(NormObjectHandle streamHandle, unsigned int by
 NORM_API_LINKAGE 
 void NormStreamMarkEom(NormObjectHandle streamHandle);
 
+// Zero-copy stream writing: NormStreamAcquireWriteBuffer() returns a pointer to
+// (and the size of) the unused space of the stream's current segment, or NULL
+// if the stream buffer is full (a NORM_TX_QUEUE_VACANCY will follow). After
+// placing data there, NormStreamCommitWrite() writes "numBytes" of it to the
+// stream (returning the number written).  No other writes may be made to the
+// stream while a buffer is acquired (NormStreamWrite(), NormStreamWriteV(),
+// NormStreamFlush() and NormStreamMarkEom() are refused until it is committed).
+NORM_API_LINKAGE 
+char* NormStreamAcquireWriteBuffer(NormObjectHandle streamHandle,
+                                   unsigned int*    bufferSize);
+
+NORM_API_LINKAGE 
+unsigned int NormStreamCommitWrite(NormObjectHandle streamHandle,
+                                   unsigned int     numBytes);
+
 NORM_API_LINKAGE 
 bool NormSetWatermark(NormSessionHandle  sessionHandle,
                       NormObjectHandle   objectHandle,
@@ -672,6 +875,21 @@ NORM_API_LINKAGE
 bool NormSetRxSocketBuffer(NormSessionHandle sessionHandle,
                            unsigned int      bufferSize);
 
+// Sets the number of datagrams read per system call (Linux recvmmsg()).
+// A "batchSize" of 0 or 1 (default) disables batched receive.
+NORM_API_LINKAGE 
+bool NormSetRxBatchSize(NormSessionHandle sessionHandle,
+                        unsigned int      batchSize);
+
+// For low latency reception, the NORM thread keeps polling a drained session
+// socket for up to "usec" microseconds before waiting for the next socket
+// notification (trading CPU for wake-up latency and jitter).  On Linux, the
+// SO_BUSY_POLL socket option is also set (which may require privilege).  A
+// "usec" of 0 (default) disables busy-polling.
+NORM_API_LINKAGE 
+bool NormSetRxBusyPoll(NormSessionHandle sessionHandle,
+                       unsigned int      usec);
+
 NORM_API_LINKAGE 
 void NormSetSilentReceiver(NormSessionHandle sessionHandle,
                            bool              silent,
@@ -733,6 +951,21 @@ bool NormStreamRead(NormObjectHandle   streamHandle,
 NORM_API_LINKAGE 
 bool NormStreamSeekMsgStart(NormObjectHandle streamHandle);
 
+// Zero-copy stream reading: NormStreamPeekRead() sets "bufferPtr" and "numBytes"
+// to the received data available in the stream's current segment (zero bytes
+// if none) and returns "false" upon a stream break like NormStreamRead(). The
+// application then calls NormStreamConsume() with the number of bytes it used
+// (which returns "false" if the stream was broken while the data was peeked).
+// Peeking is not supported for streams with staging enabled.
+NORM_API_LINKAGE 
+bool NormStreamPeekRead(NormObjectHandle   streamHandle,
+                        const char**       bufferPtr,
+                        unsigned int*      numBytes);
+
+NORM_API_LINKAGE 
+bool NormStreamConsume(NormObjectHandle   streamHandle,
+                       unsigned int       numBytes);
+
 NORM_API_LINKAGE 
 UINT32 NormStreamGetReadOffset(NormObjectHandle streamHandle);
 
@@ -814,6 +1047,12 @@ const void* NormNodeGetUserData(NormNodeHandle nodeHandle);
 NORM_API_LINKAGE
 double NormNodeGetGrtt(NormNodeHandle remoteSender);
 
+// Copies a remote sender's cumulative statistics into "stats" (see
+// NormGetSessionStats() about NORM thread concurrency)
+NORM_API_LINKAGE
+bool NormNodeGetStats(NormNodeHandle remoteSender,
+                      NormNodeStats* stats);
+
 
 NORM_API_LINKAGE
 bool NormNodeGetCommand(NormNodeHandle remoteSender,
@@ -0,0 +1,98 @@
+#ifndef _NORM_ATOMIC
+#define _NORM_ATOMIC
+
+// This module provides a minimal set of portable atomic operations on
+// 32-bit values for the lock-free single-producer / single-consumer
+// structures shared between the NORM protocol thread and application
+// threads.  Loads have "acquire" and stores have "release" semantics.
+
+#include "protoDefs.h"  // for UINT32, UINT64
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#include <intrin.h>
+#endif // _MSC_VER
+
+inline UINT32 NormAtomicLoad(const volatile UINT32* ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER)
+    UINT32 value = *ptr;  // (MSVC volatile reads have acquire semantics)
+    _ReadWriteBarrier();
+    return value;
+#else
+#error "NormAtomicLoad() not implemented for this compiler"
+#endif
+}  // end NormAtomicLoad()
+
+inline void NormAtomicStore(volatile UINT32* ptr, UINT32 value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER)
+    _ReadWriteBarrier();
+    *ptr = value;         // (MSVC volatile writes have release semantics)
+#endif
+}  // end NormAtomicStore()
+
+// Returns the previous value
+inline UINT32 NormAtomicExchange(volatile UINT32* ptr, UINT32 value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+    return (UINT32)InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+#endif
+}  // end NormAtomicExchange()
+
+// Returns the new value
+inline UINT32 NormAtomicAdd(volatile UINT32* ptr, UINT32 value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_add_fetch(ptr, value, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+    return (UINT32)InterlockedExchangeAdd((volatile LONG*)ptr, (LONG)value) + value;
+#endif
+}  // end NormAtomicAdd()
+
+// 64-bit loads and stores for the single-writer statistics counters (see
+// normStats.h).  No ordering is implied, but a value is never "torn" even
+// on 32-bit platforms.
+inline UINT64 NormAtomicLoad64(const volatile UINT64* ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+#ifdef _WIN64
+    return *ptr;
+#else
+    return (UINT64)InterlockedCompareExchange64((volatile LONGLONG*)ptr, 0, 0);
+#endif // if/else _WIN64
+#endif
+}  // end NormAtomicLoad64()
+
+inline void NormAtomicStore64(volatile UINT64* ptr, UINT64 value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(ptr, value, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+#ifdef _WIN64
+    *ptr = value;
+#else
+    InterlockedExchange64((volatile LONGLONG*)ptr, (LONGLONG)value);
+#endif // if/else _WIN64
+#endif
+}  // end NormAtomicStore64()
+
+// Full memory barrier (orders a preceding store with a subsequent load)
+inline void NormAtomicFence()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+    MemoryBarrier();
+#endif
+}  // end NormAtomicFence()
+
+#endif // _NORM_ATOMIC
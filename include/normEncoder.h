@@ -42,6 +42,14 @@ class NormEncoder
         virtual bool Init(unsigned int numData, unsigned int numParity, UINT16 vectorSize) = 0;
         virtual void Destroy() = 0;
         virtual void Encode(unsigned int segmentId, const char *dataVector, char **parityVectorList) = 0;    
+        // Computes parity for a complete block of "numData" (zero-padded) source vectors
+        // at once, _overwriting_ the "parityVectorList" content.  Implementations 
+        // work across the vectors in cache-sized "tiles" so the parity stays cache
+        // resident instead of being streamed through once per source vector.
+        virtual void EncodeBlock(const char** dataVectorList, char** parityVectorList, unsigned int numData) = 0;
+        
+        // Target size (bytes) of the set of parity vector tiles worked on at once by EncodeBlock()
+        enum {BLOCK_TILE_SPACE = 16384};
 };  // end class NormEncoder
 
 class NormDecoder
@@ -51,6 +59,74 @@ class NormDecoder
         virtual bool Init(unsigned int numData, unsigned int numParity, UINT16 vectorSize) = 0;
         virtual void Destroy() = 0;
         virtual int Decode(char** vectorList, unsigned int numData,  unsigned int erasureCount, unsigned int* erasureLocs) = 0;    
+        
+        // Decoding matrix cache statistics (returns false if decoder doesn't cache)
+        virtual bool GetMatrixCacheStats(unsigned long& hits, unsigned long& misses, unsigned long& fastCount) const
+            {return false;}
 };  // end class NormDecoder
 
+// This is a bounded, least-recently-used cache of inverted decoding matrix
+// rows used by the Reed-Solomon decoders.  Entries are keyed by the erasure 
+// pattern: the block's "numData" plus the erased source segment locations 
+// and the parity segment locations used in their place (this fully determines
+// the decoding matrix).  Only the rows for the erased source segments are kept.
+class NormDecoderMatrixCache
+{
+    public:
+        NormDecoderMatrixCache();
+        ~NormDecoderMatrixCache();
+        
+        // "rowSize" is bytes per matrix row
+        bool Init(unsigned int entryMax, unsigned int rowSize);
+        void Destroy();
+        
+        // Returns cached rows (one per source erasure) or NULL
+        const char* Find(unsigned int        numData, 
+                         unsigned int        erasureCount, 
+                         const unsigned int* erasureLocs, 
+                         const unsigned int* parityLocs);
+        // Returns space for the caller to copy "erasureCount" rows into (least
+        // recently used entry is recycled as needed), or NULL if not cacheable.
+        char* Insert(unsigned int        numData, 
+                     unsigned int        erasureCount, 
+                     const unsigned int* erasureLocs, 
+                     const unsigned int* parityLocs);
+        
+        unsigned long GetHitCount() const
+            {return hit_count;}
+        unsigned long GetMissCount() const
+            {return miss_count;}
+        
+        enum 
+        {
+            ENTRY_MAX_DEFAULT = 32,
+            ERASURE_MAX = 16,       // larger erasure patterns aren't cached
+            SPACE_MAX = 1048576     // bounds entry count for large rows
+        };
+            
+    private:
+        struct Entry
+        {
+            Entry*          prev;
+            Entry*          next;
+            UINT32          hash;
+            unsigned int    num_data;
+            unsigned int    erasure_count;  // 0 for unused entry
+            unsigned int    locs[2*ERASURE_MAX];
+            char*           rows;
+            unsigned int    rows_max;       // in rows
+        };
+        static UINT32 Hash(unsigned int numData, unsigned int erasureCount,
+                           const unsigned int* erasureLocs, const unsigned int* parityLocs);
+        void MoveToHead(Entry* entry);
+        
+        Entry*          entry_list;  // array of "entry_max" entries
+        unsigned int    entry_max;
+        unsigned int    row_size;
+        Entry*          head;        // most recently used
+        Entry*          tail;        // least recently used
+        unsigned long   hit_count;
+        unsigned long   miss_count;
+};  // end class NormDecoderMatrixCache
+
 #endif // _NORM_ENCODER
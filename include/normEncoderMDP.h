@@ -46,9 +46,13 @@ class NormEncoderMDP : public NormEncoder
         bool IsReady(){return (bool)(gen_poly != NULL);}
         // "Encode" MUST be called in order of source vector0, vector1, vector2, etc
 	    void Encode(unsigned int segmentId, const char *dataVector, char **parityVectorList);
+        // (Encoding is independent per vector byte, so the block is encoded in tiles)
+        void EncodeBlock(const char** dataVectorList, char** parityVectorList, unsigned int numData);
 	
     private:
 	    bool CreateGeneratorPolynomial();
+        // Runs the encoder shift register for vector bytes "offset" through "offset+len-1"
+        void EncodeRange(const char* data, char** pVec, unsigned int offset, unsigned int len);
     
     // Members
 	    unsigned int    npar;	      // No. of parity packets (n-k)
@@ -13,6 +13,7 @@ class NormEncoderRS16 : public NormEncoder
         virtual bool Init(unsigned int numData, unsigned int numParity, UINT16 vectorSize);
         virtual void Destroy();
         virtual void Encode(unsigned int segmentId, const char* dataVector, char** parityVectorList);    
+        virtual void EncodeBlock(const char** dataVectorList, char** parityVectorList, unsigned int numData);
         
         unsigned int GetNumData() 
             {return ndata;}
@@ -39,6 +40,13 @@ class NormDecoderRS16 : public NormDecoder
         virtual bool Init(unsigned int numData, unsigned int numParity, UINT16 vectorSize);
         virtual void Destroy();
         virtual int Decode(char** vectorList, unsigned int numData,  unsigned int erasureCount, unsigned int* erasureLocs);
+        virtual bool GetMatrixCacheStats(unsigned long& hits, unsigned long& misses, unsigned long& fastCount) const
+        {
+            hits = matrix_cache.GetHitCount();
+            misses = matrix_cache.GetMissCount();
+            fastCount = fast_count;
+            return true;
+        }
         
         unsigned int GetNumParity() 
             {return npar;}
@@ -61,6 +69,10 @@ class NormDecoderRS16 : public NormDecoder
         unsigned int*   inv_pivt;   
         UINT8*          inv_id_row;
         UINT8*          inv_temp_row;
+        
+        // Inverted matrix rows are cached for recurring erasure patterns
+        NormDecoderMatrixCache  matrix_cache;
+        unsigned long           fast_count;  // single erasure decodes
              
 };  // end class NormDecoderRS16
 
@@ -13,6 +13,24 @@ class NormEncoderRS8 : public NormEncoder
         virtual bool Init(unsigned int numData, unsigned int numParity, UINT16 vectorSize);
         virtual void Destroy();
         virtual void Encode(unsigned int segmentId, const char* dataVector, char** parityVectorList);    
+        virtual void EncodeBlock(const char** dataVectorList, char** parityVectorList, unsigned int numData);
+        
+        // GF(2^8) multiply-accumulate kernel selection.  The "best" kernel
+        // supported by the CPU is selected automatically; these let
+        // tests and benchmarks compare/force a specific implementation.
+        // (Note the selection is global, shared by all RS8 encoders/decoders)
+        enum SimdMode
+        {
+            SIMD_NONE = 0,  // portable scalar (table lookup) code
+            SIMD_SSSE3,     // 128-bit split-nibble PSHUFB
+            SIMD_AVX2,      // 256-bit split-nibble VPSHUFB
+            SIMD_AVX512,    // 512-bit split-nibble VPSHUFB
+            SIMD_GFNI       // 256-bit GF2P8AFFINEQB
+        };
+        static SimdMode GetSimdMode();
+        static bool SimdModeIsSupported(SimdMode mode);
+        static bool SetSimdMode(SimdMode mode);
+        static const char* GetSimdModeName(SimdMode mode);
         
         unsigned int GetNumData() 
             {return ndata;}
@@ -38,6 +56,13 @@ class NormDecoderRS8 : public NormDecoder
         virtual bool Init(unsigned int numData, unsigned int numParity, UINT16 vectorSize);
         virtual void Destroy();
         virtual int Decode(char** vectorList, unsigned int numData,  unsigned int erasureCount, unsigned int* erasureLocs);
+        virtual bool GetMatrixCacheStats(unsigned long& hits, unsigned long& misses, unsigned long& fastCount) const
+        {
+            hits = matrix_cache.GetHitCount();
+            misses = matrix_cache.GetMissCount();
+            fastCount = fast_count;
+            return true;
+        }
         
         unsigned int GetNumParity() 
             {return npar;}
@@ -60,6 +85,10 @@ class NormDecoderRS8 : public NormDecoder
         unsigned int*   inv_pivt;   
         UINT8*          inv_id_row;
         UINT8*          inv_temp_row;
+        
+        // Inverted matrix rows are cached for recurring erasure patterns
+        NormDecoderMatrixCache  matrix_cache;
+        unsigned long           fast_count;  // single erasure decodes
              
 };  // end class NormDecoder
 
@@ -0,0 +1,194 @@
+/*********************************************************************
+ *
+ * AUTHORIZATION TO USE AND DISTRIBUTE
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that:
+ *
+ * (1) source code distributions retain this paragraph in its entirety,
+ *
+ * (2) distributions including binary code include this paragraph in
+ *     its entirety in the documentation or other materials provided
+ *     with the distribution, and
+ *
+ * (3) all advertising materials mentioning features or use of this
+ *     software display the following acknowledgment:
+ *
+ *      "This product includes software written and developed
+ *       by Brian Adamson and Joe Macker of the Naval Research
+ *       Laboratory (NRL)."
+ *
+ *  The name of NRL, the name(s) of NRL  employee(s), or any entity
+ *  of the United States Government may not be used to endorse or
+ *  promote  products derived from this software, nor does the
+ *  inclusion of the NRL written and developed software  directly or
+ *  indirectly suggest NRL or United States  Government endorsement
+ *  of this product.
+ *
+ * THIS SOFTWARE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ ********************************************************************/
+
+#ifndef _NORM_FEC_POOL
+#define _NORM_FEC_POOL
+
+#include "normMessage.h"  // for NormNodeId, NormObjectId, NormBlockId
+#include "normEncoder.h"
+#include "normWorkerPool.h"
+
+// A NormFecJob is a self-contained FEC encode or decode work item.  The job
+// owns _copies_ of the block's segment vectors so worker threads never touch
+// NormSegmentPool memory.  Results are applied by the protocol (dispatcher)
+// thread, which re-finds the job's session/node/object/block by identifier
+// and discards the results if the block is no longer present.
+class NormFecJob : public NormWorkerJob
+{
+    friend class NormFecPool;
+
+    public:
+        enum Type {ENCODE, DECODE};
+
+        NormFecJob();
+        ~NormFecJob();
+
+        // Sizes job for "blockSize" vectors of "vectorSize" bytes (and resets its state)
+        bool Init(Type          jobType,
+                  UINT8         fecId,
+                  UINT8         fecM,
+                  UINT16        numDataMax,
+                  UINT16        numParity,
+                  UINT16        vectorSize);
+        void Destroy();
+
+        Type GetType() const
+            {return job_type;}
+
+        // Vectors are laid out as "numData" source vectors followed by the parity vectors
+        char* GetVector(unsigned int index)
+            {return vector_list[index];}
+        char** GetVectorList()
+            {return vector_list;}
+        UINT16 GetVectorSize() const
+            {return vector_size;}
+
+        // Identifiers used to re-find the job's block upon completion (the pointers
+        // are only compared, never dereferenced, to guard against stale results)
+        void SetBlock(const void*   nodePtr,
+                      NormNodeId    nodeId,
+                      const void*   objectPtr,
+                      NormObjectId  objectId,
+                      NormBlockId   blockId,
+                      UINT16        numData)
+        {
+            node_ptr = nodePtr;
+            node_id = nodeId;
+            object_ptr = objectPtr;
+            object_id = objectId;
+            block_id = blockId;
+            num_data = numData;
+        }
+        const void* GetNodePtr() const {return node_ptr;}
+        NormNodeId GetNodeId() const {return node_id;}
+        const void* GetObjectPtr() const {return object_ptr;}
+        NormObjectId GetObjectId() const {return object_id;}
+        const NormBlockId& GetBlockId() const {return block_id;}
+        UINT16 GetNumData() const {return num_data;}
+        UINT16 GetNumParity() const {return npar;}
+
+        // Encode jobs track the largest source segment length of the block
+        void SetSegSizeMax(UINT16 segSizeMax) {seg_size_max = segSizeMax;}
+        UINT16 GetSegSizeMax() const {return seg_size_max;}
+
+        // Decode jobs list the erasure locations (in ascending order)
+        void SetErasureLoc(UINT16 index, unsigned int loc)
+        {
+            ASSERT(index < npar);
+            erasure_loc[index] = loc;
+        }
+        unsigned int GetErasureLoc(UINT16 index) const
+            {return erasure_loc[index];}
+        void SetErasureCount(UINT16 count) {erasure_count = count;}
+        UINT16 GetErasureCount() const {return erasure_count;}
+
+        bool IsComplete() const {return complete;}
+        // Worker processing time (sec), for statistics
+        double GetProcessTime() const {return process_time;}
+
+    private:
+        Type            job_type;
+        UINT8           fec_id;
+        UINT8           fec_m;
+        UINT16          ndata;          // max source vectors per block
+        UINT16          npar;
+        UINT16          vector_size;
+        unsigned int    vector_max;     // allocated "vector_list" size
+        unsigned int    buffer_size;    // allocated "buffer" size (bytes)
+        char*           buffer;
+        char**          vector_list;
+        unsigned int*   erasure_loc;
+
+        const void*     node_ptr;
+        NormNodeId      node_id;
+        const void*     object_ptr;
+        NormObjectId    object_id;
+        NormBlockId     block_id;
+        UINT16          num_data;
+        UINT16          seg_size_max;
+        UINT16          erasure_count;
+        bool            complete;       // set by worker thread when FEC succeeded
+        double          process_time;   // set by worker thread
+};  // end class NormFecJob
+
+// The NormFecPool is a NormWorkerPool of FEC encode/decode jobs
+class NormFecPool : public NormWorkerPool
+{
+    public:
+        NormFecPool();
+        ~NormFecPool();
+
+        bool Open(unsigned int threadCount, ProtoChannel::Notifier* notifier);
+        void Close();
+
+        // GetFreeJob() returns NULL when the job limit has been reached 
+        // (caller should do the FEC work itself)
+        NormFecJob* GetFreeJob()
+            {return static_cast<NormFecJob*>(NormWorkerPool::GetFreeJob());}
+        NormFecJob* GetCompletedJob()
+            {return static_cast<NormFecJob*>(NormWorkerPool::GetCompletedJob());}
+
+        enum {JOBS_PER_THREAD = 4};
+
+    protected:
+        NormWorkerJob* CreateJob()
+            {return new NormFecJob;}
+        void ProcessJob(unsigned int workerIndex, NormWorkerJob& job);
+
+    private:
+        // Each worker thread keeps its own encoder/decoder instances (re-initialized as needed)
+        class Coder
+        {
+            public:
+                Coder();
+                ~Coder();
+                void Process(NormFecJob& job);
+
+            private:
+                NormEncoder*    encoder;
+                NormDecoder*    decoder;
+                UINT8           enc_fec_id;
+                UINT8           enc_fec_m;
+                UINT16          enc_ndata;
+                UINT16          enc_npar;
+                UINT16          enc_vec_size;
+                UINT8           dec_fec_id;
+                UINT8           dec_fec_m;
+                UINT16          dec_ndata;
+                UINT16          dec_npar;
+                UINT16          dec_vec_size;
+        };  // end class NormFecPool::Coder
+
+        Coder*      coder_list;     // one per worker thread
+};  // end class NormFecPool
+
+#endif // _NORM_FEC_POOL
@@ -65,6 +65,15 @@ class NormFile
 #else
             return (fd >= 0);
 #endif // _WIN32_WCE
+        }
+        // Returns the underlying file descriptor (-1 if not applicable)
+        int GetDescriptor() const
+        {
+#ifdef _WIN32_WCE
+            return -1;
+#else
+            return fd;
+#endif // if/else _WIN32_WCE
         }
         size_t Read(char* buffer, size_t len);
         size_t Write(const char* buffer, size_t len);
@@ -73,6 +82,24 @@ class NormFile
 		NormFile::Offset GetSize() const;
         bool Pad(Offset theOffset);  // if file size is less than theOffset, writes a byte to force filesize
         
+        // Memory-mapped file access (UNIX only).  Map() maps the first "theSize"
+        // bytes of the open file.  A "writable" mapping is only made (Linux only)
+        // when the file can first be preallocated to "theSize" bytes.  Note that
+        // accessing a read-only mapping of a file truncated by another process
+        // raises SIGBUS, so mapped files must not be truncated while in use.
+        bool Map(Offset theSize, bool writable);
+        void Unmap();
+        bool IsMapped() const
+            {return (NULL != map_ptr);}
+        char* GetMapping() const
+            {return map_ptr;}
+        Offset GetMapSize() const
+            {return map_size;}
+        // Hints that a (non-sequential) mapped range will be accessed soon
+        void Prefetch(Offset theOffset, Offset theLength);
+        // Initiates (or, if "wait", completes) writeback of a writable mapping
+        bool Sync(bool wait);
+        
         // static helper methods
         static NormFile::Type GetType(const char *path);
 		static NormFile::Offset GetSize(const char* path);
@@ -125,6 +152,8 @@ class NormFile
 #else
         off_t   offset;
 #endif // if/else WIN32/UNIX
+        char*   map_ptr;
+        Offset  map_size;
 };  // end class NormFile
 
 
@@ -0,0 +1,123 @@
+/*********************************************************************
+ *
+ * AUTHORIZATION TO USE AND DISTRIBUTE
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that:
+ *
+ * (1) source code distributions retain this paragraph in its entirety,
+ *
+ * (2) distributions including binary code include this paragraph in
+ *     its entirety in the documentation or other materials provided
+ *     with the distribution, and
+ *
+ * (3) all advertising materials mentioning features or use of this
+ *     software display the following acknowledgment:
+ *
+ *      "This product includes software written and developed
+ *       by Brian Adamson and Joe Macker of the Naval Research
+ *       Laboratory (NRL)."
+ *
+ *  The name of NRL, the name(s) of NRL  employee(s), or any entity
+ *  of the United States Government may not be used to endorse or
+ *  promote  products derived from this software, nor does the
+ *  inclusion of the NRL written and developed software  directly or
+ *  indirectly suggest NRL or United States  Government endorsement
+ *  of this product.
+ *
+ * THIS SOFTWARE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ ********************************************************************/
+
+
+#ifndef _NORM_FILE_IO
+#define _NORM_FILE_IO
+
+#include "normMessage.h"     // for NormBlockId
+#include "normFile.h"        // for NormFile::Offset
+#include "normWorkerPool.h"
+
+// A NormFileIoJob is a positioned read (file read-ahead) or write (received
+// content) of a NormFileObject's file performed by a NormFileIoPool worker
+// thread.  The job owns its data buffer.  The "owner" (NormFileObject) must
+// Flush() its jobs before closing its file descriptor.
+class NormFileIoJob : public NormWorkerJob
+{
+    friend class NormFileIoPool;
+
+    public:
+        enum Type {READ, WRITE};
+
+        NormFileIoJob();
+        ~NormFileIoJob();
+
+        // Sizes the job's buffer for "length" bytes (and resets its state)
+        bool Init(Type              jobType,
+                  void*             owner,
+                  int               fd,
+                  NormFile::Offset  offset,
+                  unsigned int      length);
+        void Destroy();
+
+        Type GetType() const
+            {return job_type;}
+        char* GetBuffer()
+            {return buffer;}
+        NormFile::Offset GetOffset() const
+            {return offset;}
+        unsigned int GetLength() const
+            {return length;}
+
+        // Read-ahead jobs are tagged with the block they contain
+        void SetBlockId(const NormBlockId& blockId)
+            {block_id = blockId;}
+        const NormBlockId& GetBlockId() const
+            {return block_id;}
+        // Set (by the protocol thread) once the job's completion has been handled
+        void SetDone(bool state)
+            {done = state;}
+        bool IsDone() const
+            {return done;}
+
+        bool IsComplete() const {return complete;}
+
+    private:
+        Type                job_type;
+        int                 file_fd;
+        NormFile::Offset    offset;
+        unsigned int        length;
+        unsigned int        buffer_size;    // allocated "buffer" size (bytes)
+        char*               buffer;
+        NormBlockId         block_id;
+        bool                done;
+        bool                complete;       // set by worker thread when I/O succeeded
+};  // end class NormFileIoJob
+
+// The NormFileIoPool is a NormWorkerPool that performs NormFileObject file 
+// reads and writes with pread()/pwrite() so that disk latency doesn't stall
+// the protocol thread.  (Not supported on WIN32).
+class NormFileIoPool : public NormWorkerPool
+{
+    public:
+        NormFileIoPool();
+        ~NormFileIoPool();
+
+        bool Open(unsigned int threadCount, ProtoChannel::Notifier* notifier);
+
+        // GetFreeJob() returns NULL when the job limit has been reached 
+        // (caller should do the I/O itself)
+        NormFileIoJob* GetFreeJob()
+            {return static_cast<NormFileIoJob*>(NormWorkerPool::GetFreeJob());}
+        NormFileIoJob* GetCompletedJob()
+            {return static_cast<NormFileIoJob*>(NormWorkerPool::GetCompletedJob());}
+
+        enum {JOBS_PER_THREAD = 64};
+
+    protected:
+        NormWorkerJob* CreateJob()
+            {return new NormFileIoJob;}
+        void ProcessJob(unsigned int workerIndex, NormWorkerJob& job);
+};  // end class NormFileIoPool
+
+#endif // _NORM_FILE_IO
@@ -584,8 +584,15 @@ class NormMsg
             REPORT   = 6
         };    
         enum {MAX_SIZE = 65536};
+        // Upper bound on header (including extensions and stream payload
+        // header) bytes in addition to the "segment_size" payload
+        enum {HEADER_MAX = 256};
                
-        NormMsg();
+        // The message buffer storage is provided by a NormMessagePool (or a
+        // NormLocalMsg for stack instances) and is _not_ owned by the NormMsg
+        NormMsg(UINT32* bufferPtr = NULL, unsigned int bufferSize = 0);
+        void AttachBuffer(UINT32* bufferPtr, unsigned int bufferSize);
+        unsigned int GetBufferSize() const {return buffer_size;}
         
         // Message building routines
         void SetVersion(UINT8 version) 
@@ -613,7 +620,7 @@ class NormMsg
         
         void AttachExtension(NormHeaderExtension& extension)
         {
-            extension.Init(buffer+(header_length/4), MAX_SIZE - header_length);
+            extension.Init(buffer+(header_length/4), buffer_size - header_length);
             ExtendHeaderLength(extension.GetLength());
         }
         // Only use this for extensions that have content appended after attachment
@@ -627,7 +634,7 @@ class NormMsg
         bool InitFromBuffer(UINT16 msgLength);
         bool CopyFromBuffer(const char* theBuffer, unsigned int theLength)
         {
-            if (theLength > MAX_SIZE) return false;
+            if (theLength > buffer_size) return false;
             memcpy(buffer, theBuffer, theLength);
             return InitFromBuffer(theLength);
         }
@@ -709,7 +716,8 @@ class NormMsg
             ((UINT8*)buffer)[HDR_LEN_OFFSET] = header_length >> 2;
         }
            
-        UINT32          buffer[MAX_SIZE / sizeof(UINT32)]; 
+        UINT32*         buffer; 
+        unsigned int    buffer_size;    // in bytes
         UINT16          length;         // in bytes
         UINT16          header_length;  
         UINT16          header_length_base;
@@ -717,6 +725,11 @@ class NormMsg
         
         NormMsg*        prev;
         NormMsg*        next;
+        
+    private:
+        // (copies would share the buffer)
+        NormMsg(const NormMsg&);
+        NormMsg& operator=(const NormMsg&);
 };  // end class NormMsg
 
 // "NormObjectMsg" is a base class for the similar "NormInfoMsg"
@@ -1940,7 +1953,7 @@ class NormNackMsg : public NormMsg
         }
         
         // TBD - add some safety checks to these methods 
-        void InitFrom(NormNackMsg nack)
+        void InitFrom(const NormNackMsg& nack)
         {
             // Copy header from "nack"
             memcpy(buffer, nack.buffer, nack.GetHeaderLength());
@@ -2125,6 +2138,19 @@ class NormReportMsg : public NormMsg
 // do some unions so we can easily use these
 // via casting or dereferencing the union members
 
+// A message type instance with its own MAX_SIZE storage (e.g., for
+// stack instances used to receive or immediately send a message)
+template <class msgType>
+class NormLocalMsg : public msgType
+{
+    public:
+        NormLocalMsg()
+            {msgType::AttachBuffer(storage, sizeof(storage));}
+        
+    private:
+        UINT32  storage[NormMsg::MAX_SIZE / sizeof(UINT32)];
+};  // end class NormLocalMsg
+
 class NormMessageQueue
 {
     public:
@@ -2144,6 +2170,46 @@ class NormMessageQueue
         NormMsg*    tail;
 };  // end class NormMessageQueue
 
+// The NormMessagePool provides messages whose buffers are carved from
+// contiguous "slab" allocations sized for the session's maximum message
+// (i.e., "segment_size" plus HEADER_MAX) instead of MAX_SIZE.  Requests for
+// larger messages (e.g., jumbo/loopback segment sizes or receiver NACKs built
+// for a remote sender's segment size) are served by a separate "large"
+// message list, limited to the same count as the regular pool.
+class NormMessagePool
+{
+    public:
+        NormMessagePool();
+        ~NormMessagePool();
+        
+        // If already initialized, the previous messages are kept for large
+        // message use until Destroy() (outstanding messages remain valid)
+        bool Init(unsigned int msgCount, unsigned int msgSize);
+        void Destroy();
+        bool IsInitialized() const {return (0 != msg_size);}
+        unsigned int GetMessageSize() const {return msg_size;}
+        
+        // A "msgSize" of zero requests a regular (GetMessageSize()) message
+        NormMsg* Get(unsigned int msgSize = 0);
+        void Put(NormMsg* msg);
+    
+    private:
+        class Slab
+        {
+            public:
+                Slab*   next;
+                UINT32* storage;
+        };
+        bool AddSlab(unsigned int msgCount, unsigned int msgSize, NormMessageQueue& msgList);
+        
+        unsigned int        msg_size;       // regular message buffer size (bytes)
+        unsigned int        msg_count;
+        NormMessageQueue    msg_list;       // free regular messages
+        NormMessageQueue    large_list;     // free messages of other sizes
+        unsigned int        large_count;    // allocated large messages
+        Slab*               slab_list;
+};  // end class NormMessagePool
+
 // Helper function to output report on repair content (e.g. NormNack content) to debug log
 void LogRepairContent(const UINT32* buffer, UINT16 bufferLen, UINT8 fecId, UINT8 fecM);
 
@@ -355,6 +355,8 @@ class NormSenderNode : public NormNode, public ProtoTree::Item
                            const NormCmdMsg&     cmd);
         
         void HandleObjectMessage(const NormObjectMsg& msg);
+        // Applies a completed FEC worker pool decode job (see NormSession::HandleFecJobs())
+        void HandleDecodeJob(NormFecJob& job);
         void HandleCCFeedback(UINT8 ccFlags, double ccRate);
         void HandleNackMessage(const NormNackMsg& nack);
         void HandleAckMessage(const NormAckMsg& ack);
@@ -461,8 +463,15 @@ class NormSenderNode : public NormNode, public ProtoTree::Item
         
         UINT16 Decode(char** segmentList, UINT16 numData, UINT16 erasureCount)
         {
-            return decoder->Decode(segmentList, numData, erasureCount, erasure_loc);
+            struct timeval startTime, endTime;
+            ProtoSystemTime(startTime);
+            UINT16 result = decoder->Decode(segmentList, numData, erasureCount, erasure_loc);
+            ProtoSystemTime(endTime);
+            decode_time_hist.RecordInterval(startTime, endTime);
+            return result;
         }
+        bool GetDecoderStats(unsigned long& hits, unsigned long& misses, unsigned long& fastCount) const
+            {return ((NULL != decoder) && decoder->GetMatrixCacheStats(hits, misses, fastCount));}
         
         void CalculateGrttResponse(const struct timeval& currentTime,
                                    struct timeval&       grttResponse) const;
@@ -492,20 +501,35 @@ class NormSenderNode : public NormNode, public ProtoTree::Item
         void IncrementRecvTotal(unsigned long count) 
             {recv_total.Increment(count);}
         void IncrementRecvGoodput(unsigned long count) 
-            {recv_goodput.Increment(count);}
+        {
+            recv_goodput.Increment(count);
+            recv_goodput_count.Increment(count);
+        }
         void ResetRecvStats() 
         {
             recv_total.Reset();
             recv_goodput.Reset();
         }
-        void IncrementResyncCount() {resync_count++;}
-        void DecrementResyncCount() {resync_count--;}
-        unsigned long ResyncCount() const {return resync_count;}
-        unsigned long NackCount() const {return nack_count;}
-        unsigned long SuppressCount() const {return suppress_count;}
-        unsigned long CompletionCount() const {return completion_count;}
+        void IncrementResyncCount() {resync_count.Increment();}
+        void DecrementResyncCount() {resync_count.Decrement();}
+        unsigned long ResyncCount() const {return (unsigned long)resync_count.GetValue();}
+        unsigned long NackCount() const {return (unsigned long)nack_count.GetValue();}
+        unsigned long SuppressCount() const {return (unsigned long)suppress_count.GetValue();}
+        unsigned long CompletionCount() const {return (unsigned long)completion_count.GetValue();}
         unsigned long PendingCount() const {return rx_table.GetCount();}
-        unsigned long FailureCount() const {return failure_count;}
+        unsigned long FailureCount() const {return (unsigned long)failure_count.GetValue();}
+        
+        // These (and the counts above, except PendingCount()) may be read by
+        // other threads at any time (see NormNodeGetStats() and normStats.h)
+        UINT64 RecvPacketCount() const {return recv_packet_count.GetValue();}
+        UINT64 RecvByteCount() const {return recv_byte_count.GetValue();}
+        UINT64 RecvGoodputCount() const {return recv_goodput_count.GetValue();}
+        double StatsRecvRate() const {return recv_rate_gauge.GetValue();}  // bytes/sec
+        double StatsGrtt() const {return grtt_gauge.GetValue();}
+        double StatsLoss() const {return loss_gauge.GetValue();}
+        const NormStatsHistogram& RecvIntervalHistogram() const {return recv_interval_hist;}
+        const NormStatsHistogram& DecodeTimeHistogram() const {return decode_time_hist;}
+        unsigned long PeakBufferSegments() const {return segment_pool.PeakUsage();}
         
         class CmdBuffer
         {
@@ -567,6 +591,8 @@ class NormSenderNode : public NormNode, public ProtoTree::Item
         
         
     private:
+        NormObject* CheckObjectCompletion(NormObject* obj);
+        
         const char* GetKey() const
             {return key_buffer;}    
         unsigned int GetKeysize() const
@@ -686,11 +712,20 @@ class NormSenderNode : public NormNode, public ProtoTree::Item
         // For statistics tracking
         Accumulator             recv_total;        // total recvd accumulator
         Accumulator             recv_goodput;      // goodput recvd accumulator
-        unsigned long           resync_count;
-        unsigned long           nack_count;
-        unsigned long           suppress_count;
-        unsigned long           completion_count;
-        unsigned long           failure_count;     // usually due to re-syncs
+        NormStatsCounter        resync_count;
+        NormStatsCounter        nack_count;
+        NormStatsCounter        suppress_count;
+        NormStatsCounter        completion_count;
+        NormStatsCounter        failure_count;     // usually due to re-syncs
+        NormStatsCounter        recv_packet_count;
+        NormStatsCounter        recv_byte_count;
+        NormStatsCounter        recv_goodput_count;
+        NormStatsGauge          recv_rate_gauge;   // (published along with recv_rate)
+        NormStatsGauge          grtt_gauge;
+        NormStatsGauge          loss_gauge;
+        NormStatsHistogram      recv_interval_hist;  // packet inter-arrival time
+        NormStatsHistogram      decode_time_hist;    // FEC block decode time
+        struct timeval          recv_last_time;      // for recv_interval_hist
         
 };  // end class NormSenderNode
     
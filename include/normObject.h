@@ -3,12 +3,26 @@
 
 #include "normSegment.h"  // NORM segmentation classes
 #include "normEncoder.h"
+#include "normFecPool.h"
 #include "normFile.h"
+#include "normFileIo.h"
+#include "normAtomic.h"
+
+#include "protoEvent.h"
 
 #include <stdio.h>
 
 #define USE_PROTO_TREE 1  // for more better performing NormObjectTable?
 
+// Describes one piece of a "scatter/gather" data object or stream write
+// (see NormDataObject::Open() and NormStreamObject::WriteV())
+class NormDataFragment
+{
+    public:
+        const char* data;
+        UINT32      length;
+};  // end class NormDataFragment
+
 #ifdef USE_PROTO_TREE
 #include "protoTree.h"
 
@@ -222,6 +236,10 @@ class NormObject
         bool NextSenderMsg(NormObjectMsg* msg);
         NormBlock* SenderRecoverBlock(NormBlockId blockId);
         bool CalculateBlockParity(NormBlock* block);
+        // Queues block parity calculation to the session FEC worker pool
+        // (returns false if pool is unavailable or block data can't be read)
+        bool SenderQueueParityJob(NormBlock* block);
+        void SenderHandleParityJob(NormFecJob& job);
         
         /*bool IsFirstPass() {return first_pass;}
         void ClearFirstPass() {first_pass = false};*/
@@ -253,6 +271,9 @@ class NormObject
                                  NormMsg::Type        msgType,
                                  NormBlockId          blockId,
                                  NormSegmentId        segmentId);
+        // Applies FEC worker pool decoding results (see NormSenderNode::HandleDecodeJob())
+        bool ReceiverHandleDecodeJob(NormFecJob& job);
+        bool ReceiverQueueDecodeJob(NormBlock* block, UINT16 numData, UINT16 erasureCount);
         
         
         // Used by receiver for resource management scheme
@@ -291,6 +312,9 @@ class NormObject
                    const NormObjectId&      objectId); 
     
         void Accept() {accepted = true;}
+        
+        // Posts RX_OBJECT_UPDATED (or pumps a staged receive stream)
+        void NotifyUpdated();
 
 #ifdef USE_PROTO_TREE    
         // Proto::Tree item required overrides
@@ -382,12 +406,32 @@ class NormFileObject : public NormObject
         
         virtual char* RetrieveSegment(NormBlockId   blockId,
                                       NormSegmentId segmentId);
+        
+        // Called by the session for completed NormFileIoPool jobs
+        void HandleIoJob(NormFileIoJob* job);
+        // True if received content couldn't be written (asynchronously)
+        bool WriteFailed() const
+            {return write_failed;}
+        
+        enum {READ_AHEAD_MAX = 32};
             
     //private:
-        char            path[PATH_MAX+10];
-        NormFile        file;
-        NormObjectSize  large_block_length;
-        NormObjectSize  small_block_length;
+        NormFile::Offset GetSegmentOffset(NormBlockId blockId, NormSegmentId segmentId) const;
+        void ReadAhead(NormBlockId blockId);
+        void FlushIoJobs();
+        
+        char              path[PATH_MAX+10];
+        NormFile          file;
+        NormObjectSize    large_block_length;
+        NormObjectSize    small_block_length;
+        NormFile::Offset  map_next;  // expected offset of next sequential mapped read
+        // Asynchronous (NormFileIoPool) file I/O state
+        NormFileIoJob*    read_ahead_list[READ_AHEAD_MAX];
+        unsigned int      read_ahead_count;
+        UINT32            read_ahead_block;  // block for which read-ahead was last requested
+        bool              read_ahead_valid;
+        unsigned int      write_pending;     // count of outstanding write jobs
+        bool              write_failed;
 };  // end class NormFileObject
 
 class NormDataObject : public NormObject
@@ -407,9 +451,16 @@ class NormDataObject : public NormObject
                   bool        dataRelease,
                   const char* infoPtr = NULL,
                   UINT16      infoLen = 0);
+        // Sender "scatter/gather" object whose content is the concatenation
+        // of the fragments (the fragment list is copied, but not the data)
+        bool Open(const NormDataFragment* fragList,
+                  unsigned int            fragCount,
+                  const char*             infoPtr = NULL,
+                  UINT16                  infoLen = 0);
         bool Accept(char* dataPtr, UINT32 dataMax, bool dataRelease);
         void Close();
         
+        // (NULL for fragmented objects)
         const char* GetData() {return data_ptr;}
         char* DetachData() 
         {
@@ -432,17 +483,80 @@ class NormDataObject : public NormObject
         
             
     private:
+        UINT16 GatherSegment(UINT32 offset, UINT16 len, char* buffer);
+        void ClearFragments();
+        
+        // Fragment list entries also record their offset into the object
+        class Fragment
+        {
+            public:
+                const char* data;
+                UINT32      length;
+                UINT32      offset;
+        };
+        
         NormObjectSize          large_block_length;
         NormObjectSize          small_block_length;
         char*                   data_ptr;
         UINT32                  data_max;
         bool                    data_released;   // when true, data_ptr is deleted 
         DataFreeFunctionHandle  data_free_func;
+        Fragment*               frag_list;
+        unsigned int            frag_count;
         
                                          // on NormDataObject destruction
 };  // end class NormDataObject
 
 
+// The NormStreamStage is a single-producer / single-consumer byte ring used to
+// "stage" stream data between an application thread and the NORM protocol
+// thread without suspending the protocol thread for each NormStreamWrite() or
+// NormStreamRead() call.  The ring indices are free-running byte counts.
+class NormStreamStage
+{
+    public:
+        NormStreamStage();
+        ~NormStreamStage();
+        
+        // The "bufferSize" is rounded up to a power of 2
+        bool Init(unsigned int bufferSize);
+        void Destroy();
+        bool IsOpen() const
+            {return (NULL != buffer);}
+        
+        // These may be called by either side
+        unsigned int GetCount() const
+            {return (NormAtomicLoad(&write_index) - NormAtomicLoad(&read_index));}
+        unsigned int GetSize() const
+            {return (mask + 1);}
+        bool IsEmpty() const
+            {return (0 == GetCount());}
+        
+        // Producer side: copies up to "len" bytes into the ring
+        unsigned int Write(const char* data, unsigned int len);
+        // Producer side: contiguous space at the ring tail ("len" is set)
+        char* GetWriteSpace(unsigned int& len);
+        void CommitWrite(unsigned int len)
+            {NormAtomicStore(&write_index, write_index + len);}
+        UINT32 GetWriteIndex() const
+            {return NormAtomicLoad(&write_index);}
+        
+        // Consumer side: copies up to "len" bytes from the ring
+        unsigned int Read(char* data, unsigned int len);
+        // Consumer side: contiguous data at the ring head ("len" is set)
+        const char* GetReadData(unsigned int& len);
+        void CommitRead(unsigned int len)
+            {NormAtomicStore(&read_index, read_index + len);}
+        UINT32 GetReadIndex() const
+            {return NormAtomicLoad(&read_index);}
+        
+    private:
+        char*               buffer;
+        UINT32              mask;
+        volatile UINT32     write_index;
+        volatile UINT32     read_index;
+};  // end class NormStreamStage
+
 class NormStreamObject : public NormObject
 {
     public:
@@ -467,12 +581,14 @@ class NormStreamObject : public NormObject
             
         void SetFlushMode(FlushMode flushMode) {flush_mode = flushMode;}
         FlushMode GetFlushMode() {return flush_mode;}
-        void Flush(bool eom = false)
+        bool Flush(bool eom = false)
         {
+            if (NULL != write_loan) return false;  // (see AcquireWriteBuffer())
             FlushMode oldFlushMode = flush_mode;
             SetFlushMode((FLUSH_ACTIVE == oldFlushMode) ? FLUSH_ACTIVE : FLUSH_PASSIVE);
             Write(NULL, 0, eom);
             SetFlushMode(oldFlushMode);   
+            return true;
         }
         void SetPushMode(bool state) {push_mode = state;}
         bool GetPushMode() const {return push_mode;}
@@ -498,9 +614,59 @@ class NormStreamObject : public NormObject
         
             
         bool Read(char* buffer, unsigned int* buflen, bool findMsgStart = false);
-        UINT32 Write(const char* buffer, UINT32 len, bool eom = false);
+        UINT32 Write(const char* buffer, UINT32 len, bool eom = false)
+        {
+            NormDataFragment frag;
+            frag.data = buffer;
+            frag.length = len;
+            return WriteV(&frag, 1, eom);
+        }
+        // Gathers the "fragCount" fragments into stream segments, returning
+        // the total number of bytes written (a NULL fragment "data" commits
+        // bytes already placed in the current segment)
+        UINT32 WriteV(const NormDataFragment* fragList, unsigned int fragCount, bool eom = false);
         
-        UINT32 GetCurrentReadOffset() {return read_offset;}
+        UINT32 GetCurrentReadOffset() const
+        {
+            // (for staged receive streams, the offset of the next staged byte)
+            return (stage.IsOpen() && (StageIsSynced() || !stage.IsEmpty())) ?
+                        (stage_offset + stage.GetReadIndex()) : read_offset;
+        }
+        
+        // Zero-copy "loans" of stream segment space.  AcquireWriteBuffer() returns
+        // the unused portion of the current write segment and CommitWrite() 
+        // writes "len" bytes placed there.  PeekRead() returns the unread data
+        // of the current read segment (returning false upon stream break) and 
+        // Consume() advances past "len" of those bytes.  Loans never span
+        // segment boundaries and only one of each may be outstanding.  While
+        // a write loan is outstanding, Write(), WriteV() and Flush() refuse.
+        char* AcquireWriteBuffer(unsigned int& size);
+        UINT32 CommitWrite(UINT32 len);
+        bool HasWriteLoan() const {return (NULL != write_loan);}
+        bool PeekRead(const char*& ptr, unsigned int& len);
+        bool Consume(unsigned int len);
+        
+        // Staging ring support. EnableStaging() and the "Stage" methods marked 
+        // "(NORM thread)" require the NORM thread be suspended (or be the caller).
+        // The others are for the single application thread using the stream.
+        bool EnableStaging(unsigned int bufferSize);
+        bool IsStaged() const
+            {return stage.IsOpen();}
+        // Returns number of bytes staged for transmission (app thread)
+        unsigned int StageWrite(const char* buffer, unsigned int len);
+        // Moves staged tx data into the stream, returns true if emptied (NORM thread)
+        bool StageDrain();
+        // Returns true if staged rx data (or a staged stream break/end) is 
+        // available to read without the NORM thread (app thread)
+        bool StageRead(char* buffer, unsigned int* buflen, bool& result);
+        // Records a message end after currently staged data (app thread)
+        bool StageMarkEom();
+        // Fills the rx staging ring from the stream (NORM thread)
+        void StagePump();
+        bool StageIsSynced() const
+            {return (0 != NormAtomicLoad(&stage_sync));}
+        // Reads with the NORM thread suspended, (re)starting staging (NORM thread)
+        bool StageSyncRead(char* buffer, unsigned int* buflen, bool seekMsgStart);
         
         unsigned int GetCurrentBufferUsage() const  // in segments
             {return segment_pool.CurrentUsage();}
@@ -584,6 +750,13 @@ class NormStreamObject : public NormObject
     private:
         bool ReadPrivate(char* buffer, unsigned int* buflen, bool findMsgStart = false);
         void Terminate();
+        char* GetWriteSegment(NormBlock*& block);
+        void OnStageEvent(ProtoEvent& theEvent);
+        void RequestStageService()
+        {
+            if (0 == NormAtomicExchange(&stage_pending, 1))
+                stage_event.Set();
+        }
         
         class Index
         {
@@ -619,6 +792,29 @@ class NormStreamObject : public NormObject
         
         // For threaded API purposes
         UINT32                      block_pool_threshold;
+        
+        // Staging ring state (the "volatile" flags are shared with the app thread)
+        enum {STAGE_EOM_MAX = 256};  // (must be a power of 2)
+        NormStreamStage             stage;
+        UINT32*                     stage_eom_list; // tx: "stage" indices of message ends
+        volatile UINT32             stage_eom_write;
+        volatile UINT32             stage_eom_read;
+        ProtoEvent                  stage_event;    // wakes NORM thread to service "stage"
+        volatile UINT32             stage_pending;  // stage_event has been set
+        volatile UINT32             stage_sync;     // rx: NORM thread is filling "stage"
+        volatile UINT32             stage_notify;   // rx: app wants RX_OBJECT_UPDATED
+        volatile UINT32             stage_stalled;  // rx: "stage" was full
+        volatile UINT32             stage_break;    // rx: stream break follows staged data
+        volatile UINT32             stage_end;      // rx: stream end follows staged data
+        UINT32                      stage_offset;   // rx: stream offset of "stage" index zero
+        bool                        stage_pumping;  // rx: StagePump() is reading
+        bool                        stage_close;    // tx: graceful close awaits StageDrain()
+        
+        // Zero-copy segment loan state
+        char*                       write_loan;     // segment with acquired write space
+        unsigned int                write_loan_size;
+        char*                       read_loan;      // (detached) segment being peeked
+        Index                       read_loan_index;
 };  // end class NormStreamObject
 
 #ifdef SIMULATE
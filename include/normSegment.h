@@ -2,6 +2,7 @@
 #define _NORM_SEGMENT
 
 #include "normMessage.h"
+#include "normStats.h"
 #include "protoBitmask.h"
 
 #define USE_PROTO_TREE 1  // for more better performing NormBlockBuffer?
@@ -30,8 +31,9 @@ class NormSegmentPool
         
         unsigned int CurrentUsage() const 
             {return (seg_total - seg_count);}
-        unsigned long PeakUsage() const {return peak_usage;}
-        unsigned long OverunCount() const {return overruns;}
+        // (these two may be read by other threads, see normStats.h)
+        unsigned long PeakUsage() const {return (unsigned long)peak_usage.GetValue();}
+        unsigned long OverunCount() const {return (unsigned long)overruns.GetValue();}
         unsigned int GetSegmentSize() {return seg_size;}
         
     private: 
@@ -41,11 +43,46 @@ class NormSegmentPool
         char*           seg_list;
 		char**          seg_pool;
         
-        unsigned long   peak_usage;
-        unsigned long   overruns;
-        bool            overrun_flag;
+        NormStatsCounter    peak_usage;
+        NormStatsCounter    overruns;
+        bool                overrun_flag;
 };  // end class NormSegmentPool
 
+// Iterates over runs of consecutive set bits of a ProtoBitmask within
+// the index range [firstIndex, endIndex), scanning the underlying mask
+// 64 bits at a time instead of testing one bit per call.  This is used
+// for NACK and repair advertisement building and for merging received
+// repair requests into a block's repair_mask.
+class NormBitmaskRunIterator
+{
+    public:
+        NormBitmaskRunIterator(const ProtoBitmask& mask,
+                               UINT32              firstIndex,
+                               UINT32              endIndex);
+
+        // Returns "false" when no more runs remain
+        bool GetNextRun(UINT32& runStart, UINT32& runCount);
+
+        // Advances past the next "count" set bits (returns "false"
+        // if fewer than "count" set bits remain)
+        bool SkipSet(UINT32 count);
+
+        // These return "endIndex" if no such bit is found in range
+        UINT32 FindNextSet(UINT32 index) const
+            {return FindNext(index, true);}
+        UINT32 FindNextUnset(UINT32 index) const
+            {return FindNext(index, false);}
+
+    private:
+        UINT32 FindNext(UINT32 index, bool set) const;
+        UINT64 GetWord(UINT32 index, bool set, UINT32& wordBase) const;
+
+        const unsigned char*    mask_ptr;
+        UINT32                  mask_len;   // in bytes
+        UINT32                  next_index;
+        UINT32                  end_index;
+};  // end class NormBitmaskRunIterator
+
 #ifdef USE_PROTO_TREE
 class NormBlock : public ProtoSortedTree::Item
 #else
@@ -58,7 +95,9 @@ class NormBlock
     public:
         enum Flag 
         {
-            IN_REPAIR    = 0x01
+            IN_REPAIR       = 0x01,
+            PARITY_PENDING  = 0x02,  // sender: parity job queued to FEC worker pool
+            DECODE_PENDING  = 0x04   // receiver: decode job queued to FEC worker pool
         };
             
         NormBlock();
@@ -71,6 +110,7 @@ class NormBlock
         void SetFlag(NormBlock::Flag flag) {flags |= flag;}
         void ClearFlag(NormBlock::Flag flag) {flags &= ~flag;}
         bool InRepair() {return (0 != (flags & IN_REPAIR));}
+        bool FlagIsSet(NormBlock::Flag flag) const {return (0 != (flags & flag));}
         bool ParityReady(UINT16 ndata) {return (erasure_count == ndata);}
         UINT16 ParityReadiness() {return erasure_count;}
         void IncreaseParityReadiness() {erasure_count++;}
@@ -138,6 +178,7 @@ class NormBlock
         bool HandleSegmentRequest(NormSegmentId nextId, NormSegmentId lastId,
                                   UINT16 ndata, UINT16 nparity, 
                                   UINT16 erasureCount);
+        bool MergeRepairRange(NormSegmentId firstId, NormSegmentId lastId);
         bool ActivateRepairs(UINT16 nparity);
         void ResetParityCount(UINT16 nparity) 
         {
@@ -306,7 +347,7 @@ class NormBlockPool
             else if (!overrun_flag)
             {
                 PLOG(PL_DEBUG, "NormBlockPool::Get() warning: operating with constrained buffering resources\n");
-                overruns++;
+                overruns.Increment();
                 overrun_flag = true;   
             }
             return b;
@@ -317,18 +358,70 @@ class NormBlockPool
             head = b;
             blk_count++;
         }
-        unsigned long OverrunCount() const {return overruns;}
+        unsigned long OverrunCount() const {return (unsigned long)overruns.GetValue();}
         UINT32 GetCount() {return blk_count;}
         UINT32 GetTotal() {return blk_total;}
         
     private:
         NormBlock*      head;
         UINT32          blk_total;
-        UINT32          blk_count;
-        unsigned long   overruns;
-        bool            overrun_flag;
+        UINT32              blk_count;
+        NormStatsCounter    overruns;
+        bool                overrun_flag;
 };  // end class NormBlockPool
 
+// Sender cache of computed parity for recently repaired blocks, keyed by
+// (objectId, blockId).  When a repaired block's resources are stolen for
+// other blocks, its parity is saved here so a later repair of the same
+// block can restore it instead of re-reading source data and re-encoding.
+// When full, the entry with the oldest NormBlock::last_nack_time is evicted.
+class NormParityCache
+{
+    public:
+        NormParityCache();
+        ~NormParityCache();
+        bool Init(unsigned int numEntries, UINT16 numParity, UINT16 payloadMax);
+        void Destroy();
+        bool IsOpen() const {return (NULL != entry_list);}
+        
+        // "block" must have its parity ready
+        void Save(NormObjectId objectId, NormBlock& block, UINT16 numData);
+        // Returns "true" and sets the block's parity ready upon a cache hit
+        bool Restore(NormObjectId objectId, NormBlock& block, UINT16 numData);
+        // Invalidates any entries for the given object (e.g., when it is released)
+        void Invalidate(NormObjectId objectId);
+        // Invalidates the given block's entry (e.g., when a stream reuses the block id)
+        void Invalidate(NormObjectId objectId, const NormBlockId& blockId)
+        {
+            Entry* entry = Find(objectId, blockId);
+            if (NULL != entry) entry->valid = false;
+        }
+        
+        unsigned long GetHitCount() const {return (unsigned long)hit_count.GetValue();}
+        unsigned long GetMissCount() const {return (unsigned long)miss_count.GetValue();}
+            
+    private:
+        class Entry
+        {
+            public:
+                NormObjectId    object_id;
+                NormBlockId     block_id;
+                UINT16          seg_size_max;
+                bool            valid;
+                ProtoTime       last_nack_time;
+                char*           parity;  // num_parity * payload_max bytes
+        };
+        Entry* Find(NormObjectId objectId, const NormBlockId& blockId);
+        
+        Entry*          entry_list;
+        unsigned int    entry_count;
+        char*           parity_buffer;
+        UINT16          num_parity;
+        UINT16          payload_max;
+        NormStatsCounter    hit_count;
+        NormStatsCounter    miss_count;
+};  // end class NormParityCache
+
 #ifdef USE_PROTO_TREE
 class NormBlockTree : public ProtoSortedTreeTemplate<NormBlock> {};
 #endif // USE_PROTO_TREE
@@ -341,7 +434,12 @@ class NormBlockBuffer
             
         NormBlockBuffer();
         ~NormBlockBuffer();
-        bool Init(unsigned long rangeMax, unsigned long tableSize, UINT32 fecBlockMask);
+        // With USE_PROTO_TREE, a "directIndex" table of up to "tableSize" block
+        // pointers (indexed by blockId modulo table size) serves lookups within
+        // a (nearly) contiguous block range in constant time.  The tree remains
+        // for ordered iteration and lookup of blocks evicted by table collisions.
+        bool Init(unsigned long rangeMax, unsigned long tableSize, UINT32 fecBlockMask,
+                  bool directIndex = true);
         void Destroy();
         
         bool Insert(NormBlock* theBlock);
@@ -394,6 +492,9 @@ class NormBlockBuffer
 
 #ifdef USE_PROTO_TREE
         NormBlockTree   tree;
+        NormBlock**     direct_table;   // (NULL when direct indexing is disabled)
+        UINT32          direct_mask;
+        unsigned long   direct_misses;  // count of buffered blocks not in direct_table
 #else    
         static NormBlock* Next(NormBlock* b) {return b->next;}    
         NormBlock**     table;
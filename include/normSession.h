@@ -5,6 +5,8 @@
 #include "normObject.h"
 #include "normNode.h"
 #include "normEncoder.h"
+#include "normFecPool.h"
+#include "normTrace.h"
 
 #include "protokit.h"
 
@@ -23,6 +25,16 @@
 
 #define LIMIT_CC_RATE 1
 
+// Linux recvmmsg() and sendmmsg() (with UDP GSO when possible) are used for
+// optional batched datagram reception and transmission
+#if defined(LINUX) && !defined(SIMULATE)
+#define NORM_RECVMMSG 1
+#define NORM_SENDMMSG 1
+struct mmsghdr;
+struct iovec;
+struct sockaddr_storage;
+#endif // LINUX && !SIMULATE
+
 class NormController
 {
     public:
@@ -123,6 +135,61 @@ class NormSessionMgr
               
 };  // end class NormSessionMgr
 
+// Sender-side index of the SEGMENT repair requests already merged into
+// block repair state during the current repair (NACK aggregation) cycle.
+// After a shared loss, many receivers NACK the same segments; requests
+// fully covered by this index are coalesced without re-processing.
+// Each (objectId, blockId) entry keeps a small sorted set of disjoint
+// segment intervals and the largest erasure count seen for the block.
+class NormNackAggregator
+{
+    public:
+        NormNackAggregator();
+        ~NormNackAggregator();
+        
+        bool Init(unsigned int entryMax);
+        void Destroy();
+        void Clear();  // called at the end of each repair cycle
+        
+        bool IsCovered(NormObjectId         objectId, 
+                       const NormBlockId&   blockId,
+                       NormSegmentId        firstId, 
+                       NormSegmentId        lastId,
+                       UINT16               erasureCount) const;
+        void Insert(NormObjectId        objectId, 
+                    const NormBlockId&  blockId,
+                    NormSegmentId       firstId, 
+                    NormSegmentId       lastId,
+                    UINT16              erasureCount);
+        // Drops recorded state for a block (e.g. when the block is recovered anew)
+        void Invalidate(NormObjectId objectId, const NormBlockId& blockId);
+        
+        unsigned int GetEntryCount() const {return used_count;}
+            
+    private:
+        enum {INTERVAL_MAX = 8};
+        class Entry
+        {
+            public:
+                UINT32          block_id;
+                UINT16          object_id;
+                UINT16          erasure_max;
+                UINT16          interval_count;
+                NormSegmentId   interval_first[INTERVAL_MAX];
+                NormSegmentId   interval_last[INTERVAL_MAX];
+        };
+        // Returns NULL if not found, with "index" set to the free slot
+        // where the entry belongs (or to "table_mask + 1" if the table is full)
+        Entry* Find(NormObjectId objectId, const NormBlockId& blockId, unsigned int& index) const;
+        
+        Entry*          entry_table;
+        bool*           entry_used;
+        unsigned int    table_mask;
+        unsigned int*   used_list;   // indices of used entries (for fast Clear())
+        unsigned int    used_count;
+        unsigned int    used_max;
+};  // end class NormNackAggregator
+
 
 class NormSession
 {
@@ -130,6 +197,8 @@ class NormSession
     
     public:
         enum {DEFAULT_MESSAGE_POOL_DEPTH = 16};
+        // Payload size for pooled messages until the sender "segment_size" is known
+        enum {DEFAULT_MESSAGE_PAYLOAD_MAX = 1024};
         static const UINT8 DEFAULT_TTL;  
         static const double DEFAULT_TRANSMIT_RATE;  // in bytes per second
         static const double DEFAULT_GRTT_INTERVAL_MIN;
@@ -144,8 +213,11 @@ class NormSession
         static const UINT16 DEFAULT_TX_CACHE_MIN;
         static const UINT16 DEFAULT_TX_CACHE_MAX;
         static const UINT32 DEFAULT_TX_CACHE_SIZE;
+        static const unsigned int DEFAULT_TX_PARITY_CACHE;
         static const double DEFAULT_FLOW_CONTROL_FACTOR;
         static const UINT16 DEFAULT_RX_CACHE_MAX;
+        static const double TX_BATCH_INTERVAL;
+        static const double TX_SPIN_MAX;
         static const int DEFAULT_ROBUST_FACTOR;
         
         enum {IFACE_NAME_MAX = 31};
@@ -260,6 +332,43 @@ class NormSession
             {return tx_socket->SetTxBufferSize(bufferSize);}
         bool SetRxSocketBuffer(unsigned int bufferSize)
             {return rx_socket.SetRxBufferSize(bufferSize);}
+        // Sets the number of datagrams read per recvmmsg() system call for
+        // batched receive (0 or 1 disables batching; Linux only)
+        bool SetRxBatchSize(unsigned int batchSize);
+        unsigned int GetRxBatchSize() const
+            {return rx_batch_size;}
+        enum {RX_BATCH_MAX = 64};
+        // Sets a receive "busy-poll" interval (in microseconds) for low latency
+        // reception.  When the rx_socket is drained, the receive handler keeps 
+        // polling it for up to this long before returning to the dispatcher,
+        // and the Linux SO_BUSY_POLL socket option is set (0 disables)
+        bool SetRxBusyPoll(unsigned int usec);
+        unsigned int GetRxBusyPoll() const
+            {return rx_busy_poll;}
+        // Sets the maximum number of messages sent per sendmmsg() (or UDP GSO
+        // sendmsg()) call, limited to those due within the current pacing
+        // interval (0 or 1 disables batching; Linux only)
+        bool SetTxBatchSize(unsigned int batchSize);
+        unsigned int GetTxBatchSize() const
+            {return tx_batch_size;}
+        enum {TX_BATCH_MAX = 64};
+        
+        // The default TX_PACE_TIMER mode schedules the tx_timer per message.  The
+        // token bucket modes release small bursts credited by elapsed time for
+        // more precise high rate pacing (TX_PACE_HYBRID also spin-waits short intervals)
+        enum TxPacingMode {TX_PACE_TIMER, TX_PACE_BUCKET, TX_PACE_HYBRID};
+        void SetTxPacingMode(TxPacingMode pacingMode);
+        TxPacingMode GetTxPacingMode() const
+            {return tx_pace_mode;}
+        enum {TX_BURST_MAX = 64};
+        
+        // When enabled, file objects subsequently opened (for transmission or
+        // reception) access their content through a memory mapping instead of 
+        // per-segment seek/read()/write() calls (UNIX only, else falls back)
+        void SetFileMapping(bool state)
+            {file_mapping = state;}
+        bool GetFileMapping() const
+            {return file_mapping;}
         
         // Session parameters
         double GetTxRate();  // returns bits/sec
@@ -350,8 +459,11 @@ class NormSession
             notify_pending = false;
         }
         
-        NormMsg* GetMessageFromPool() {return message_pool.RemoveHead();}
-        void ReturnMessageToPool(NormMsg* msg) {message_pool.Append(msg);}
+        // A non-zero "msgSize" is needed for messages that may exceed the
+        // local "segment_size" plus NormMsg::HEADER_MAX (e.g., receiver NACKs)
+        NormMsg* GetMessageFromPool(unsigned int msgSize = 0) 
+            {return message_pool.Get(msgSize);}
+        void ReturnMessageToPool(NormMsg* msg) {message_pool.Put(msg);}
         void QueueMessage(NormMsg* msg);
         enum MessageStatus
         {
@@ -361,6 +473,17 @@ class NormSession
                     
         };
         MessageStatus SendMessage(NormMsg& msg);
+        // Per-message state determined by PrepareTxMessage()
+        struct TxInfo
+        {
+            bool    is_receiver_msg;
+            bool    is_probe;
+            bool    send_raw;
+            UINT8   fec_m;
+            UINT16  inst_id;
+        };
+        void PrepareTxMessage(NormMsg& msg, TxInfo& info);
+        void CompleteTxMessage(NormMsg& msg, const TxInfo& info, bool wasSent);
         void ActivateTimer(ProtoTimer& timer) {session_mgr.ActivateTimer(timer);}
         
         void SetUserData(const void* userData) 
@@ -399,6 +522,10 @@ class NormSession
                                     UINT32      dataLen,
                                     const char* infoPtr = NULL,
                                     UINT16      infoLen = 0);
+        NormDataObject* QueueTxData(const NormDataFragment* fragList,
+                                    unsigned int            fragCount,
+                                    const char*             infoPtr = NULL,
+                                    UINT16                  infoLen = 0);
         
         bool RequeueTxObject(NormObject* obj);
         
@@ -524,8 +651,76 @@ class NormSession
         void SenderEncode(unsigned int segmentId, const char* segment, char** parityVectorList)
             {encoder->Encode(segmentId, segment, parityVectorList);}
         
+        // With "block encode" enabled, block parity is calculated all at once
+        // (see NormEncoder::EncodeBlock()) from a resident copy of the block's
+        // source segments instead of incrementally as each segment is sent.
+        bool SenderBlockEncode() const
+            {return tx_block_encode;}
+        bool SenderSetBlockEncode(bool state);
+        
+        // Parity computed for up to "blockCount" recently repaired blocks is
+        // kept when their buffers are reclaimed so that repeated repairs of
+        // the same blocks can skip re-encoding (0 disables)
+        bool SenderSetParityCache(unsigned int blockCount);
+        unsigned int SenderGetParityCache() const
+            {return tx_parity_cache_max;}
+        bool SenderRestoreParity(NormObjectId objectId, NormBlock& block, UINT16 numData)
+            {return tx_parity_cache.Restore(objectId, block, numData);}
+        void SenderInvalidateParity(NormObjectId objectId, const NormBlockId& blockId)
+            {tx_parity_cache.Invalidate(objectId, blockId);}
+        // "ndata" zero-padded source vectors for block encoding
+        char** SenderBlockVectorList()
+            {return tx_block_vectors;}
+        void SenderEncodeBlock(const char** dataVectorList, char** parityVectorList, unsigned int numData)
+            {encoder->EncodeBlock(dataVectorList, parityVectorList, numData);}
+        
+        // An optional FEC worker pool offloads block parity calculation (sender)
+        // and block decoding (receiver) from the protocol thread (0 threads disables)
+        bool SetFecThreads(unsigned int threadCount);
+        unsigned int GetFecThreads() const
+            {return fec_pool.GetThreadCount();}
+        bool FecPoolIsOpen() const
+            {return fec_pool.IsOpen();}
+        // Returns NULL if the pool isn't open or its job limit is reached
+        NormFecJob* GetFreeFecJob()
+            {return fec_pool.GetFreeJob();}
+        void PutFreeFecJob(NormFecJob* job)
+            {fec_pool.PutFreeJob(job);}
+        void SubmitFecJob(NormFecJob* job)
+            {fec_pool.Submit(job);}
+        // Called when transmission must wait for a FEC worker result
+        void SenderSetFecWait()
+            {tx_fec_wait = true;}
+        
+        // An optional file I/O worker pool performs NormFileObject reads and writes
+        // off the protocol thread.  Senders read "readAhead" blocks beyond the current
+        // transmit position and receiver writes complete asynchronously (0 threads 
+        // restores synchronous file I/O; not supported on WIN32)
+        bool SetFileIoThreads(unsigned int threadCount, unsigned int readAhead = DEFAULT_FILE_READ_AHEAD);
+        unsigned int GetFileIoThreads() const
+            {return file_io_pool.GetThreadCount();}
+        unsigned int GetFileReadAhead() const
+            {return file_read_ahead;}
+        bool FileIoPoolIsOpen() const
+            {return file_io_pool.IsOpen();}
+        // Returns NULL if the pool isn't open or its job limit is reached
+        NormFileIoJob* GetFreeFileIoJob()
+            {return file_io_pool.GetFreeJob();}
+        void PutFreeFileIoJob(NormFileIoJob* job)
+            {file_io_pool.PutFreeJob(job);}
+        void SubmitFileIoJob(NormFileIoJob* job)
+            {file_io_pool.Submit(job);}
+        // Waits for the "owner" jobs to complete and handles all completed jobs
+        void FlushFileIoJobs(const void* owner)
+        {
+            file_io_pool.Flush(owner);
+            HandleFileIoJobs();
+        }
+        enum {DEFAULT_FILE_READ_AHEAD = 4};
+        
         
         NormBlock* SenderGetFreeBlock(NormObjectId objectId, NormBlockId blockId);
+        void SenderSaveParity(NormObject& obj, NormBlock& block);
         void SenderPutFreeBlock(NormBlock* block)
         {
             block->EmptyToPool(segment_pool);
@@ -642,10 +837,42 @@ class NormSession
         
         // Debug settings
         void SetTrace(bool state) {trace = state;}
+        // Binary message tracing (replaces text tracing while open)
+        bool OpenTraceFile(const char* path)
+            {return trace_ring.Open(path, LocalNodeId());}
+        void CloseTraceFile() {trace_ring.Close();}
+        bool TraceFileIsOpen() const {return trace_ring.IsOpen();}
         void SetTxLoss(double percent) {tx_loss_rate = percent;}
         void SetRxLoss(double percent) {rx_loss_rate = percent;}
         void SetReportTimerInterval(double interval) {report_timer.SetInterval(interval);}
-        double GetReportTimerInterval() {return report_timer.GetInterval();} 
+        double GetReportTimerInterval() {return report_timer.GetInterval();}
+        
+        // Sender NACK aggregation statistics (cumulative)
+        unsigned long SenderNackItemCount() const {return (unsigned long)tx_nack_items.GetValue();}
+        unsigned long SenderNackItemsCoalesced() const {return (unsigned long)tx_nack_items_coalesced.GetValue();} 
+        
+        // These statistics may be read by other threads at any time
+        // (see NormGetSessionStats() and normStats.h)
+        UINT64 TxPacketCount() const {return tx_packet_count.GetValue();}
+        UINT64 TxByteCount() const {return tx_byte_count.GetValue();}
+        UINT64 TxDropCount() const {return tx_drop_count.GetValue();}
+        UINT64 RxPacketCount() const {return rx_packet_count.GetValue();}
+        UINT64 RxByteCount() const {return rx_byte_count.GetValue();}
+        UINT64 SenderNackCount() const {return tx_nack_count.GetValue();}
+        unsigned long SenderParityCacheHits() const {return tx_parity_cache.GetHitCount();}
+        unsigned long SenderParityCacheMisses() const {return tx_parity_cache.GetMissCount();}
+        unsigned long SenderPeakBufferSegments() const {return segment_pool.PeakUsage();}
+        unsigned long SenderBufferOverunCount() const 
+            {return segment_pool.OverunCount() + block_pool.OverrunCount();}
+        double StatsTxRate() const {return tx_rate_gauge.GetValue();}  // bytes/sec
+        double StatsGrtt() const {return grtt_gauge.GetValue();}
+        NormNodeId StatsClrId() const {return (NormNodeId)clr_id_stat.GetValue();}
+        double StatsClrRate() const {return clr_rate_gauge.GetValue();}  // bytes/sec
+        double StatsClrRtt() const {return clr_rtt_gauge.GetValue();}
+        double StatsClrLoss() const {return clr_loss_gauge.GetValue();}
+        bool StatsSlowStart() const {return (0 != slow_start_stat.GetValue());}
+        const NormStatsHistogram& RepairDelayHistogram() const {return tx_repair_delay_hist;}
+        const NormStatsHistogram& RecvIntervalHistogram() const {return rx_interval_hist;}
 
 #ifdef SIMULATE   
         // Simulation specific methods
@@ -669,10 +896,22 @@ class NormSession
         double GetProbeInterval();
         
         bool OnTxTimeout(ProtoTimer& theTimer);
+        bool ServiceTxQueue();
+        void CreditTxBucket();
+        double GetTxPaceInterval(unsigned int msgLength);
+        bool TxMessageDue(unsigned int byteCount);
+#ifdef NORM_SENDMMSG
+        bool OnTxBatchTimeout();
+        MessageStatus SendMessageBatch(NormMsg** msgList, unsigned int msgCount, unsigned int& numSent);
+#endif // NORM_SENDMMSG
         bool OnRepairTimeout(ProtoTimer& theTimer);
         bool OnFlushTimeout(ProtoTimer& theTimer);
         bool OnProbeTimeout(ProtoTimer& theTimer);
         bool OnReportTimeout(ProtoTimer& theTimer);
+        void OnFecEvent(ProtoEvent& theEvent);
+        void HandleFecJobs();
+        void OnFileIoEvent(ProtoEvent& theEvent);
+        void HandleFileIoJobs();
         bool OnCmdTimeout(ProtoTimer& theTimer);
         bool OnFlowControlTimeout(ProtoTimer& theTimer);
         bool OnUserTimeout(ProtoTimer& theTimer);
@@ -680,6 +919,12 @@ class NormSession
         void TxSocketRecvHandler(ProtoSocket& theSocket, ProtoSocket::Event theEvent);
         void RxSocketRecvHandler(ProtoSocket& theSocket, ProtoSocket::Event theEvent);        
         void HandleReceiveMessage(NormMsg& msg, bool wasUnicast, bool ecn = false);
+#ifdef NORM_RECVMMSG
+        void RecvBatch(ProtoSocket& theSocket, bool isTxSocket);
+        void FreeRxBatch();
+#endif // NORM_RECVMMSG
+        bool ApplyRxBusyPoll();
+        bool RxBusyPollContinue(ProtoTime& spinEnd, bool& spinning);
 
 #ifdef ECN_SUPPORT        
         // This is used when raw packet capture is enabled
@@ -708,6 +953,7 @@ class NormSession
                                     UINT16         ccSequence);         
         void AdjustRate(bool onResponse);
         void SetTxRateInternal(double txRate);  // here, txRate is bytes/sec
+        void UpdateStatsGauges();
         //bool SenderQueueSquelch(NormObjectId objectId);
         void SenderQueueFlush();
         bool SenderQueueWatermarkFlush();
@@ -738,6 +984,15 @@ class NormSession
         ProtoCap*                       proto_cap;        // raw packet capture alternative to "rx_socket"
         ProtoAddress                    src_addr;         // used for raw packet sendto()
 #endif // ECN_SUPPORT
+        unsigned int                    rx_batch_size;
+        unsigned int                    rx_busy_poll;     // usec (0 == disabled)
+#ifdef NORM_RECVMMSG
+        NormLocalMsg<NormMsg>*          rx_batch_msgs;    // preallocated recvmmsg() message ring
+        struct mmsghdr*                 rx_batch_hdrs;
+        struct iovec*                   rx_batch_iovs;
+        struct sockaddr_storage*        rx_batch_addrs;
+        char*                           rx_batch_ctrl;    // IP_PKTINFO control buffers
+#endif // NORM_RECVMMSG
         bool                            rx_port_reuse; // enable rx_socket port (sessionPort) reuse when true
         ProtoAddress                    rx_bind_addr;
         ProtoAddress                    rx_connect_addr;
@@ -745,7 +1000,7 @@ class NormSession
         
         ProtoAddressList                dst_addr_list;  // list of local addresses
         NormMessageQueue                message_queue;
-        NormMessageQueue                message_pool;
+        NormMessagePool                 message_pool;
         ProtoTimer                      report_timer;
         UINT16                          tx_sequence;
         
@@ -764,7 +1019,15 @@ class NormSession
         double                          tx_rate;  // bytes per second
         double                          tx_rate_min;
         double                          tx_rate_max;
+        unsigned int                    tx_batch_size;
+        bool                            tx_gso;         // use UDP GSO for batches when possible
+        TxPacingMode                    tx_pace_mode;
+        double                          tx_bucket_tokens;  // bytes (negative when in deficit)
+        struct timeval                  tx_bucket_time;    // time bucket was last credited
         unsigned int                    tx_residual;    // for NORM_CMD(CC)/NORM_DATA "packet pairing"
+        bool                            file_mapping;   // mmap() file objects when possible
+        NormFileIoPool                  file_io_pool;
+        unsigned int                    file_read_ahead;  // blocks
         
         
         // Sender parameters and state
@@ -789,6 +1052,11 @@ class NormSession
         NormBlockPool                   block_pool;
         NormSegmentPool                 segment_pool;
         NormEncoder*                    encoder;
+        bool                            tx_block_encode;
+        char*                           tx_block_buffer;
+        char**                          tx_block_vectors;
+        bool                            tx_fec_wait;
+        NormFecPool                     fec_pool;
         UINT8                           fec_id;
         UINT8                           fec_m;
         INT32                           fec_block_mask;
@@ -818,6 +1086,11 @@ class NormSession
         NormObjectId                    tx_repair_object_min;
         NormBlockId                     tx_repair_block_min;
         NormSegmentId                   tx_repair_segment_min;
+        NormNackAggregator              tx_nack_aggregator;
+        NormStatsCounter                tx_nack_items;            // SEGMENT repair items received
+        NormStatsCounter                tx_nack_items_coalesced;  // ... already covered this repair cycle
+        NormParityCache                 tx_parity_cache;
+        unsigned int                    tx_parity_cache_max;      // in blocks
         
         // for unicast nack/cc feedback suppression
         bool                            advertise_repairs;
@@ -858,6 +1131,27 @@ class NormSession
         bool                            cc_slow_start;
         bool                            cc_active;
         NormNode::Accumulator           sent_accumulator;  // for sentRate measurement
+        
+        // Lock-free statistics (see NormGetSessionStats())
+        NormStatsCounter                tx_packet_count;
+        NormStatsCounter                tx_byte_count;
+        NormStatsCounter                tx_drop_count;     // dropped for "tx loss" testing
+        NormStatsCounter                rx_packet_count;
+        NormStatsCounter                rx_byte_count;
+        NormStatsCounter                tx_nack_count;     // NACK messages received
+        NormStatsGauge                  tx_rate_gauge;     // (see UpdateStatsGauges())
+        NormStatsGauge                  grtt_gauge;
+        NormStatsCounter                clr_id_stat;
+        NormStatsGauge                  clr_rate_gauge;
+        NormStatsGauge                  clr_rtt_gauge;
+        NormStatsGauge                  clr_loss_gauge;
+        NormStatsCounter                slow_start_stat;
+        NormStatsHistogram              tx_repair_delay_hist;  // NACK arrival to first repair sent
+        struct timeval                  tx_repair_nack_time;   // NACK that started repair cycle
+        bool                            tx_repair_timing;      // NACK aggregation in progress
+        bool                            tx_repair_sending;     // awaiting first repair message
+        NormStatsHistogram              rx_interval_hist;      // packet inter-arrival time
+        struct timeval                  rx_last_time;          // for rx_interval_hist
         double                          nominal_packet_size;
         bool                            data_active;       // true when actively sending data
         double                          flow_control_factor;
@@ -906,6 +1200,7 @@ class NormSession
         
         // Protocol test/debug parameters
         bool                            trace;
+        NormTraceRing                   trace_ring;
         double                          tx_loss_rate;  // for correlated loss
         double                          rx_loss_rate;  // for uncorrelated loss
         double                          report_timer_interval;
@@ -59,7 +59,7 @@ class NormSimAgent : public NormController, public ProtoMessageSink
         virtual void Notify(NormController::Event event,
                             class NormSessionMgr* sessionMgr,
                             class NormSession*    session,
-                            class NormSenderNode* sender,
+                            class NormNode*       node,
                             class NormObject*     object);
         
         void ActivateTimer(ProtoTimer& theTimer)
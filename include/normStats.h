@@ -0,0 +1,101 @@
+#ifndef _NORM_STATS
+#define _NORM_STATS
+
+// This module provides the statistics counters, gauges and histograms that
+// NormSession and NormSenderNode maintain for NormGetSessionStats() and
+// NormNodeGetStats().  Only the NORM protocol thread updates them, so no
+// locking is needed, and application threads may read them at any time.
+// (Each value is read atomically, but a set of values is not a snapshot.)
+
+#include "normAtomic.h"
+#include "protokit.h"  // for struct timeval
+
+#include <string.h>  // for memcpy()
+
+class NormStatsCounter
+{
+    public:
+        NormStatsCounter() : value(0) {}
+        
+        void Increment(UINT64 count = 1)
+            {NormAtomicStore64(&value, value + count);}
+        void Decrement()
+            {NormAtomicStore64(&value, value - 1);}
+        // Keeps the maximum of the values given (e.g. peak usage)
+        void UpdateMax(UINT64 theValue)
+            {if (theValue > value) NormAtomicStore64(&value, theValue);}
+        void Reset()
+            {NormAtomicStore64(&value, 0);}
+        // (a counter may also publish an integer state, e.g. a NormNodeId)
+        void SetValue(UINT64 theValue)
+            {NormAtomicStore64(&value, theValue);}
+        UINT64 GetValue() const
+            {return NormAtomicLoad64(&value);}
+        
+    private:
+        volatile UINT64 value;
+};  // end class NormStatsCounter
+
+// A floating point value (e.g., a rate or GRTT estimate) published for readers
+class NormStatsGauge
+{
+    public:
+        NormStatsGauge() : bits(0) {}  // (all-zero bits are 0.0)
+        
+        void SetValue(double theValue)
+        {
+            UINT64 theBits;
+            memcpy(&theBits, &theValue, sizeof(UINT64));
+            NormAtomicStore64(&bits, theBits);
+        }
+        double GetValue() const
+        {
+            UINT64 theBits = NormAtomicLoad64(&bits);
+            double theValue;
+            memcpy(&theValue, &theBits, sizeof(double));
+            return theValue;
+        }
+        
+    private:
+        volatile UINT64 bits;
+};  // end class NormStatsGauge
+
+// Histogram of time intervals with log2-spaced microsecond bins:  bin 0
+// counts intervals under 1 usec, bin i counts [2^(i-1), 2^i) usec and
+// the last bin also counts anything longer (see NORM_HISTOGRAM_BINS)
+class NormStatsHistogram
+{
+    public:
+        enum {BIN_COUNT = 24};
+        
+        void Record(double seconds)
+        {
+            UINT64 usec = (seconds > 0.0) ? (UINT64)(1.0e+06 * seconds) : 0;
+            unsigned int index = 0;
+            for (UINT64 v = usec; (0 != v) && (index < (BIN_COUNT - 1)); v >>= 1)
+                index++;
+            bin_list[index].Increment();
+            count.Increment();
+            sum_usec.Increment(usec);
+            max_usec.UpdateMax(usec);
+        }
+        void RecordInterval(const struct timeval& startTime, const struct timeval& endTime)
+        {
+            Record((double)(endTime.tv_sec - startTime.tv_sec) +
+                   1.0e-06 * ((double)endTime.tv_usec - (double)startTime.tv_usec));
+        }
+        
+        UINT64 GetCount() const {return count.GetValue();}
+        UINT64 GetSum() const {return sum_usec.GetValue();}  // usec
+        UINT64 GetMax() const {return max_usec.GetValue();}  // usec
+        UINT64 GetBin(unsigned int index) const
+            {return bin_list[index].GetValue();}
+        
+    private:
+        NormStatsCounter    count;
+        NormStatsCounter    sum_usec;
+        NormStatsCounter    max_usec;
+        NormStatsCounter    bin_list[BIN_COUNT];
+};  // end class NormStatsHistogram
+
+#endif // _NORM_STATS
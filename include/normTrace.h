@@ -0,0 +1,182 @@
+/*********************************************************************
+ *
+ * AUTHORIZATION TO USE AND DISTRIBUTE
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that:
+ *
+ * (1) source code distributions retain this paragraph in its entirety,
+ *
+ * (2) distributions including binary code include this paragraph in
+ *     its entirety in the documentation or other materials provided
+ *     with the distribution, and
+ *
+ * (3) all advertising materials mentioning features or use of this
+ *     software display the following acknowledgment:
+ *
+ *      "This product includes software written and developed
+ *       by Brian Adamson and Joe Macker of the Naval Research
+ *       Laboratory (NRL)."
+ *
+ *  The name of NRL, the name(s) of NRL  employee(s), or any entity
+ *  of the United States Government may not be used to endorse or
+ *  promote  products derived from this software, nor does the
+ *  inclusion of the NRL written and developed software  directly or
+ *  indirectly suggest NRL or United States  Government endorsement
+ *  of this product.
+ *
+ * THIS SOFTWARE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ ********************************************************************/
+
+#ifndef _NORM_TRACE
+#define _NORM_TRACE
+
+// This module provides binary NORM message tracing as a low-overhead
+// alternative to the text NormTrace() output.  The protocol thread adds
+// a fixed-size NormTraceRecord per message sent or received to a
+// single-producer / single-consumer ring and a writer thread drains the
+// ring to a compact trace file.  No formatting or locking is done by the
+// protocol thread, and records are dropped (and counted) rather than
+// blocking if the writer falls behind.  The "normTraceDecode" tool converts
+// a trace file back to NormTrace() text lines for "n2m" and "trpr".
+//
+// Trace file format (all fields in network byte order):
+//
+//   header:  "NTRC" magic (4), version (2), record size (2),
+//            local NormNodeId (4), dropped record count (4)
+//   records: NormTraceRecord::RECORD_SIZE bytes each (see Pack())
+
+#include "normMessage.h"
+#include "normAtomic.h"
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif // if/else WIN32
+
+class NormTraceRecord
+{
+    public:
+        enum
+        {
+            HEADER_SIZE = 16,
+            RECORD_SIZE = 48
+        };
+        enum {VERSION = 1};
+
+        enum Flag
+        {
+            FLAG_SENT       = 0x01,  // else received ("addr" is the source)
+            FLAG_CLR        = 0x02,  // ACK/NACK from the current limiting receiver
+            FLAG_STREAM     = 0x04,  // DATA "aux" is the stream payload offset
+            FLAG_WATERMARK  = 0x08,  // CMD(FLUSH) requesting acknowledgement
+            FLAG_IPV6       = 0x10,  // "addr" is an IPv6 address (else IPv4)
+            FLAG_RATE       = 0x20   // CMD(CC) "aux" is the quantized send rate
+        };
+
+        // Fills in the record for the given message (see NormTrace())
+        void Init(const struct timeval& currentTime,
+                  const NormMsg&        msg,
+                  bool                  sent,
+                  UINT8                 fecM,
+                  UINT16                instId);
+
+        // Serializes to / parses from RECORD_SIZE bytes
+        void Pack(char* buffer) const;
+        void Unpack(const char* buffer);
+
+        bool FlagIsSet(Flag flag) const
+            {return (0 != (flags & flag));}
+        // CMD(CC) send rate in bytes/sec
+        double GetRate() const;
+
+        UINT32      sec;
+        UINT32      usec;
+        UINT8       flags;
+        UINT8       msg_type;     // NormMsg::Type
+        UINT8       flavor;       // NormCmdMsg::Flavor or NormAck::Type
+        UINT8       detail;       // CMD(ACK_REQ) NormAck::Type
+        UINT16      length;
+        UINT16      seq;
+        UINT16      inst_id;
+        UINT16      object_id;
+        UINT32      block_id;
+        UINT16      symbol_id;    // (or CMD(CC) sequence)
+        UINT16      port;
+        UINT32      aux;          // stream offset or CC rate (see flags)
+        UINT8       addr[16];
+};  // end class NormTraceRecord
+
+// The NormTraceRing is written only by the protocol thread
+class NormTraceRing
+{
+    public:
+        NormTraceRing();
+        ~NormTraceRing();
+
+        // "ringSize" is rounded up to a power of 2 (records)
+        bool Open(const char* path, NormNodeId localId, unsigned int ringSize = DEFAULT_RING_SIZE);
+        // Writes any remaining records and closes the file
+        void Close();
+        bool IsOpen() const
+            {return (NULL != trace_file);}
+
+        void Record(const struct timeval&   currentTime,
+                    const NormMsg&          msg,
+                    bool                    sent,
+                    UINT8                   fecM,
+                    UINT16                  instId)
+        {
+            UINT32 writeIndex = ring_write;
+            if ((writeIndex - NormAtomicLoad(&ring_read)) > ring_mask)
+            {
+                drop_count++;  // writer thread has fallen behind
+                return;
+            }
+            ring[writeIndex & ring_mask].Init(currentTime, msg, sent, fecM, instId);
+            NormAtomicStore(&ring_write, writeIndex + 1);
+        }
+
+        // Enough for ~65 msec of 1 Mpps traffic between writer thread wakeups
+        enum {DEFAULT_RING_SIZE = 65536};
+        enum {WRITE_INTERVAL_MSEC = 20};
+
+    private:
+#ifdef WIN32
+        static DWORD WINAPI DoWriterThread(LPVOID param);
+#else
+        static void* DoWriterThread(void* param);
+#endif // if/else WIN32
+        void RunWriter();
+        // Writes records from the ring to the file (writer thread or Close())
+        void Drain();
+        void Lock();
+        void Unlock();
+
+        FILE*               trace_file;
+        NormTraceRecord*    ring;
+        UINT32              ring_mask;
+        volatile UINT32     ring_write;    // next record to fill (protocol thread)
+        volatile UINT32     ring_read;     // next record to write (writer thread)
+        UINT32              drop_count;    // (protocol thread)
+        char*               write_buffer;  // packed records for fwrite()
+        bool                write_error;
+        bool                started;
+        bool                stopping;      // protected by mutex
+#ifdef WIN32
+        HANDLE              thread_handle;
+        CRITICAL_SECTION    mutex;
+        CONDITION_VARIABLE  cond;
+#else
+        pthread_t           thread_id;
+        pthread_mutex_t     mutex;
+        pthread_cond_t      cond;
+#endif // if/else WIN32
+};  // end class NormTraceRing
+
+#endif // _NORM_TRACE
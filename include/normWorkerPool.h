@@ -0,0 +1,153 @@
+/*********************************************************************
+ *
+ * AUTHORIZATION TO USE AND DISTRIBUTE
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that:
+ *
+ * (1) source code distributions retain this paragraph in its entirety,
+ *
+ * (2) distributions including binary code include this paragraph in
+ *     its entirety in the documentation or other materials provided
+ *     with the distribution, and
+ *
+ * (3) all advertising materials mentioning features or use of this
+ *     software display the following acknowledgment:
+ *
+ *      "This product includes software written and developed
+ *       by Brian Adamson and Joe Macker of the Naval Research
+ *       Laboratory (NRL)."
+ *
+ *  The name of NRL, the name(s) of NRL  employee(s), or any entity
+ *  of the United States Government may not be used to endorse or
+ *  promote  products derived from this software, nor does the
+ *  inclusion of the NRL written and developed software  directly or
+ *  indirectly suggest NRL or United States  Government endorsement
+ *  of this product.
+ *
+ * THIS SOFTWARE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ ********************************************************************/
+
+
+#ifndef _NORM_WORKER_POOL
+#define _NORM_WORKER_POOL
+
+#include "protoEvent.h"
+#include "protoList.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif // if/else WIN32
+
+// A NormWorkerJob is a work item processed by a NormWorkerPool thread.  The
+// optional "owner" identifies the jobs that NormWorkerPool::Flush() waits for.
+class NormWorkerJob : public ProtoList::Item
+{
+    public:
+        NormWorkerJob() : owner_ptr(NULL) {}
+        virtual ~NormWorkerJob() {}
+
+        void* GetOwner() const
+            {return owner_ptr;}
+
+    protected:
+        void*   owner_ptr;
+
+    public:
+        class List : public ProtoListTemplate<NormWorkerJob> {};
+};  // end class NormWorkerJob
+
+// The NormWorkerPool is a set of worker threads with a bounded set of jobs.  
+// Jobs are submitted and their results collected by the protocol thread; the
+// pool's ProtoEvent is set whenever completed jobs are available.  Subclasses
+// (NormFecPool, NormFileIoPool) allocate their job type and process the jobs.
+// Note a subclass destructor must Close() the pool since the worker threads 
+// call its ProcessJob() method.
+class NormWorkerPool
+{
+    public:
+        NormWorkerPool(unsigned int jobsPerThread);
+        virtual ~NormWorkerPool();
+
+        // The "notifier" is used to deliver job completion events to the protocol thread
+        bool Open(unsigned int threadCount, ProtoChannel::Notifier* notifier);
+        // Note jobs already submitted are completed before the workers exit
+        // and remain available via GetCompletedJob()
+        void Close();
+        bool IsOpen() const
+            {return (0 != thread_count);}
+        unsigned int GetThreadCount() const
+            {return thread_count;}
+
+        template <class listenerType>
+        bool SetListener(listenerType* theListener, void(listenerType::*eventHandler)(ProtoEvent&))
+            {return done_event.SetListener(theListener, eventHandler);}
+
+        // These are only called by the protocol thread. GetFreeJob() returns NULL
+        // when the job limit has been reached (caller should do the work itself)
+        NormWorkerJob* GetFreeJob();
+        void PutFreeJob(NormWorkerJob* job);
+        void Submit(NormWorkerJob* job);
+        NormWorkerJob* GetCompletedJob();
+        // Blocks until all of the "owner" jobs submitted have completed
+        // (they are then available via GetCompletedJob())
+        void Flush(const void* owner);
+
+    protected:
+        virtual NormWorkerJob* CreateJob() = 0;
+        // Called by worker thread "workerIndex" (without the pool lock held)
+        virtual void ProcessJob(unsigned int workerIndex, NormWorkerJob& job) = 0;
+
+    private:
+        class Worker
+        {
+            public:
+                Worker();
+
+                NormWorkerPool* pool;
+                unsigned int    index;
+                NormWorkerJob*  current;    // job in progress (protected by mutex)
+#ifdef WIN32
+                HANDLE          thread_handle;
+#else
+                pthread_t       thread_id;
+#endif // if/else WIN32
+                bool            started;
+        };  // end class NormWorkerPool::Worker
+
+#ifdef WIN32
+        static DWORD WINAPI DoWorkerThread(LPVOID param);
+#else
+        static void* DoWorkerThread(void* param);
+#endif // if/else WIN32
+        void RunWorker(Worker& worker);
+        bool IsBusy(const void* owner);  // (called with mutex locked)
+        void Lock();
+        void Unlock();
+
+        unsigned int            jobs_per_thread;
+        unsigned int            thread_count;
+        Worker*                 worker_list;
+        unsigned int            job_max;
+        unsigned int            job_count;      // allocated jobs
+        NormWorkerJob::List     free_list;      // (protocol thread only)
+        NormWorkerJob::List     pending_list;   // protected by mutex
+        NormWorkerJob::List     done_list;      // protected by mutex
+        bool                    stopping;
+        ProtoEvent              done_event;
+#ifdef WIN32
+        CRITICAL_SECTION        job_mutex;
+        CONDITION_VARIABLE      job_cond;
+        CONDITION_VARIABLE      done_cond;
+#else
+        pthread_mutex_t         job_mutex;
+        pthread_cond_t          job_cond;
+        pthread_cond_t          done_cond;
+#endif // if/else WIN32
+};  // end class NormWorkerPool
+
+#endif // _NORM_WORKER_POOL
@@ -20,12 +20,16 @@ LOCAL_SRC_FILES := \
 	../../../src/common/normEncoderMDP.cpp \
 	../../../src/common/normEncoderRS16.cpp \
 	../../../src/common/normEncoderRS8.cpp \
+	../../../src/common/normFecPool.cpp \
 	../../../src/common/normFile.cpp \
+	../../../src/common/normFileIo.cpp \
 	../../../src/common/normMessage.cpp \
 	../../../src/common/normNode.cpp \
 	../../../src/common/normObject.cpp \
 	../../../src/common/normSegment.cpp \
-	../../../src/common/normSession.cpp
+	../../../src/common/normSession.cpp \
+	../../../src/common/normTrace.cpp \
+	../../../src/common/normWorkerPool.cpp
 include $(BUILD_STATIC_LIBRARY)
 
 include $(CLEAR_VARS)
@@ -5,6 +5,9 @@
 
 #include "normEncoderRS8.h"
 #include "normEncoderRS16.h"
+#include "normEncoderMDP.h"
+#include "normSegment.h"  // for NormBlockBuffer
+#include "normSession.h"  // for NormNackAggregator
 
 #include <string.h> // for memcpy(), etc
 #include <stdlib.h> // for rand()
@@ -20,6 +23,621 @@ const unsigned int B_SIZE = (SHORT_DATA + NUM_PARITY);
 #define NORM_ENCODER NormEncoderRS16
 #define NORM_DECODER NormDecoderRS16
 
+// Verifies each NormEncoderRS8 SIMD kernel supported on this CPU produces
+// parity (and decoded data) bit-identical to the scalar implementation
+// (An odd RS8_VEC_SIZE exercises the kernels' tail handling)
+const unsigned int RS8_NUM_DATA   = 200;
+const unsigned int RS8_NUM_PARITY = 55;
+const unsigned int RS8_VEC_SIZE   = 1403;
+const unsigned int RS8_B_SIZE     = (RS8_NUM_DATA + RS8_NUM_PARITY);
+
+static bool CheckRS8Kernels()
+{
+    static char srcData[RS8_NUM_DATA][RS8_VEC_SIZE];
+    static char refParity[RS8_NUM_PARITY][RS8_VEC_SIZE];
+    static char txData[RS8_B_SIZE][RS8_VEC_SIZE];
+    char* refParityPtr[RS8_NUM_PARITY];
+    char* txDataPtr[RS8_B_SIZE];
+    for (unsigned int i = 0; i < RS8_NUM_DATA; i++)
+    {
+        for (unsigned int j = 0; j < RS8_VEC_SIZE; j++)
+            srcData[i][j] = (char)rand();
+    }
+    for (unsigned int i = 0; i < RS8_NUM_PARITY; i++)
+        refParityPtr[i] = refParity[i];
+    for (unsigned int i = 0; i < RS8_B_SIZE; i++)
+        txDataPtr[i] = txData[i];
+    
+    NormEncoderRS8::SimdMode defaultMode = NormEncoderRS8::GetSimdMode();
+    fprintf(stderr, "fect: RS8 default kernel: %s\n", NormEncoderRS8::GetSimdModeName(defaultMode));
+    
+    // 1) Compute reference parity with the scalar kernel
+    NormEncoderRS8::SetSimdMode(NormEncoderRS8::SIMD_NONE);
+    NormEncoderRS8 encoder;
+    encoder.Init(RS8_NUM_DATA, RS8_NUM_PARITY, RS8_VEC_SIZE);
+    NormDecoderRS8 decoder;
+    decoder.Init(RS8_NUM_DATA, RS8_NUM_PARITY, RS8_VEC_SIZE);
+    memset(refParity, 0, sizeof(refParity));
+    for (unsigned int i = 0; i < RS8_NUM_DATA; i++)
+        encoder.Encode(i, srcData[i], refParityPtr);
+    
+    // 2) Compare each supported kernel's parity and decoding against the reference
+    bool result = true;
+    for (int m = NormEncoderRS8::SIMD_NONE; m <= NormEncoderRS8::SIMD_GFNI; m++)
+    {
+        NormEncoderRS8::SimdMode mode = (NormEncoderRS8::SimdMode)m;
+        if (!NormEncoderRS8::SimdModeIsSupported(mode)) continue;
+        NormEncoderRS8::SetSimdMode(mode);
+        for (unsigned int i = 0; i < RS8_NUM_DATA; i++)
+            memcpy(txData[i], srcData[i], RS8_VEC_SIZE);
+        for (unsigned int i = RS8_NUM_DATA; i < RS8_B_SIZE; i++)
+            memset(txData[i], 0, RS8_VEC_SIZE);
+        ProtoTime startTime, stopTime;
+        startTime.GetCurrentTime();
+        for (unsigned int i = 0; i < RS8_NUM_DATA; i++)
+            encoder.Encode(i, txDataPtr[i], txDataPtr + RS8_NUM_DATA);
+        stopTime.GetCurrentTime();
+        double encodeTime = ProtoTime::Delta(stopTime, startTime);
+        if (0 != memcmp(refParity, txData[RS8_NUM_DATA], sizeof(refParity)))
+        {
+            fprintf(stderr, "fect: RS8 %s kernel parity mismatch!\n", NormEncoderRS8::GetSimdModeName(mode));
+            result = false;
+            continue;
+        }
+        // Erase as many (sorted, unique) source segments as we have parity
+        unsigned int erasureLocs[RS8_NUM_PARITY];
+        unsigned int erasureCount = 0;
+        for (unsigned int i = 0; (i < RS8_NUM_DATA) && (erasureCount < RS8_NUM_PARITY); i++)
+        {
+            if (0 == (rand() % 3))
+            {
+                erasureLocs[erasureCount++] = i;
+                memset(txData[i], 0, RS8_VEC_SIZE);
+            }
+        }
+        startTime.GetCurrentTime();
+        decoder.Decode(txDataPtr, RS8_NUM_DATA, erasureCount, erasureLocs);
+        stopTime.GetCurrentTime();
+        double decodeTime = ProtoTime::Delta(stopTime, startTime);
+        if (0 != memcmp(srcData, txData, sizeof(srcData)))
+        {
+            fprintf(stderr, "fect: RS8 %s kernel decode error!\n", NormEncoderRS8::GetSimdModeName(mode));
+            result = false;
+            continue;
+        }
+        fprintf(stderr, "fect: RS8 %s kernel OK (erasures:%u) encodeTime:%lf usec decodeTime:%lf usec\n", 
+                NormEncoderRS8::GetSimdModeName(mode), erasureCount, 1.0e+06*encodeTime, 1.0e+06*decodeTime);
+    }
+    NormEncoderRS8::SetSimdMode(defaultMode);
+    return result;
+}  // end CheckRS8Kernels()
+
+// Verifies NormEncoder::EncodeBlock() parity matches per-segment Encode() parity
+// (for a full and a "shortened" block) and reports both encode times
+static bool CheckEncodeBlock(NormEncoder& encoder, const char* name, 
+                             unsigned int numData, unsigned int numParity, unsigned int vecSize)
+{
+    if (!encoder.Init(numData, numParity, vecSize))
+    {
+        fprintf(stderr, "fect: %s encoder init error!\n", name);
+        return false;
+    }
+    unsigned int blockSize = numData + numParity;
+    char* buffer = new char[(blockSize + numParity) * vecSize];
+    char** vectorList = new char*[blockSize + numParity];
+    for (unsigned int i = 0; i < (blockSize + numParity); i++)
+        vectorList[i] = buffer + i*vecSize;
+    char** refParity = vectorList + blockSize;
+    for (unsigned int i = 0; i < (numData * vecSize); i++)
+        buffer[i] = (char)rand();
+    bool result = true;
+    unsigned int shortData = numData / 2 + 1;
+    unsigned int dataCount[2] = {numData, shortData};
+    for (unsigned int k = 0; k < 2; k++)
+    {
+        unsigned int nd = dataCount[k];
+        for (unsigned int i = 0; i < numParity; i++)
+            memset(refParity[i], 0, vecSize);
+        ProtoTime startTime, stopTime;
+        startTime.GetCurrentTime();
+        for (unsigned int i = 0; i < nd; i++)
+            encoder.Encode(i, vectorList[i], refParity);
+        stopTime.GetCurrentTime();
+        double encodeTime = ProtoTime::Delta(stopTime, startTime);
+        // (EncodeBlock() overwrites, so fill parity w/ junk first)
+        for (unsigned int i = 0; i < numParity; i++)
+            memset(vectorList[numData+i], 0xa5, vecSize);
+        startTime.GetCurrentTime();
+        encoder.EncodeBlock((const char**)vectorList, vectorList + numData, nd);
+        stopTime.GetCurrentTime();
+        double blockTime = ProtoTime::Delta(stopTime, startTime);
+        if (0 != memcmp(refParity[0], vectorList[numData], numParity*vecSize))
+        {
+            fprintf(stderr, "fect: %s EncodeBlock() parity mismatch (numData:%u)!\n", name, nd);
+            result = false;
+        }
+        else
+        {
+            fprintf(stderr, "fect: %s EncodeBlock() OK (numData:%u) encodeTime:%lf usec blockEncodeTime:%lf usec\n", 
+                    name, nd, 1.0e+06*encodeTime, 1.0e+06*blockTime);
+        }
+    }
+    delete[] vectorList;
+    delete[] buffer;
+    return result;
+}  // end CheckEncodeBlock()
+
+// Verifies Decode() recovers repeated (cached), single erasure (fast path), and
+// uncached erasure patterns for full and "shortened" blocks and reports the 
+// decoder's matrix cache counters
+static bool CheckDecodeCache(NormEncoder& encoder, NormDecoder& decoder, const char* name, 
+                             unsigned int numData, unsigned int numParity, unsigned int vecSize)
+{
+    if (!encoder.Init(numData, numParity, vecSize) || !decoder.Init(numData, numParity, vecSize))
+    {
+        fprintf(stderr, "fect: %s encoder/decoder init error!\n", name);
+        return false;
+    }
+    unsigned int blockSize = numData + numParity;
+    char* txBuffer = new char[blockSize * vecSize];
+    char* rxBuffer = new char[blockSize * vecSize];
+    char** txList = new char*[blockSize];
+    char** rxList = new char*[blockSize];
+    unsigned int* erasureLocs = new unsigned int[numParity];
+    bool result = true;
+    unsigned int shortData = numData / 2 + 1;
+    unsigned int patternCount = 0;
+    for (unsigned int trial = 0; trial < 40; trial++)
+    {
+        // Alternate full and shortened blocks with a few recurring erasure patterns
+        unsigned int nd = (0 == (trial & 1)) ? numData : shortData;
+        for (unsigned int i = 0; i < (nd + numParity); i++)
+        {
+            txList[i] = txBuffer + i*vecSize;
+            rxList[i] = rxBuffer + i*vecSize;
+        }
+        for (unsigned int i = 0; i < (nd * vecSize); i++)
+            txBuffer[i] = (char)rand();
+        encoder.EncodeBlock((const char**)txList, txList + nd, nd);
+        memcpy(rxBuffer, txBuffer, (nd + numParity) * vecSize);
+        unsigned int erasureCount;
+        switch ((trial >> 1) % 5)
+        {
+            case 0:  // single source erasure
+                erasureCount = 1;
+                erasureLocs[0] = (trial * 7) % nd;
+                break;
+            case 1:  // single source erasure (plus a parity erasure)
+                erasureCount = 2;
+                erasureLocs[0] = 3;
+                erasureLocs[1] = nd;
+                break;
+            case 2:  // recurring burst
+            case 3:
+                erasureCount = 3;
+                for (unsigned int i = 0; i < erasureCount; i++)
+                    erasureLocs[i] = 10 + i;
+                break;
+            default:  // random pattern
+                erasureCount = numParity;
+                for (unsigned int i = 0; i < erasureCount; i++)
+                    erasureLocs[i] = (i * nd) / erasureCount + (rand() % (nd / erasureCount));
+                break;
+        }
+        for (unsigned int i = 0; i < erasureCount; i++)
+            memset(rxList[erasureLocs[i]], 0, vecSize);
+        decoder.Decode(rxList, nd, erasureCount, erasureLocs);
+        if (0 != memcmp(rxBuffer, txBuffer, nd * vecSize))
+        {
+            fprintf(stderr, "fect: %s Decode() mismatch (numData:%u erasureCount:%u)!\n", name, nd, erasureCount);
+            result = false;
+        }
+        patternCount++;
+    }
+    unsigned long hits, misses, fastCount;
+    if (decoder.GetMatrixCacheStats(hits, misses, fastCount))
+    {
+        fprintf(stderr, "fect: %s Decode() %u patterns, matrix cache hits:%lu misses:%lu fast:%lu\n", 
+                name, patternCount, hits, misses, fastCount);
+        if ((0 == hits) || (0 == fastCount)) result = false;
+    }
+    delete[] erasureLocs;
+    delete[] rxList;
+    delete[] txList;
+    delete[] rxBuffer;
+    delete[] txBuffer;
+    return result;
+}  // end CheckDecodeCache()
+
+// Verifies and times NormBlockBuffer lookups with and without the direct-indexed 
+// table for a sliding window of "window" blocks spaced "stride" block ids apart
+// that wraps around the (24-bit) block id space
+static bool CheckBlockBuffer(bool directIndex, unsigned int window, unsigned int stride)
+{
+    const UINT32 BLOCK_MASK = 0x00ffffff;
+    const unsigned int NUM_STEPS = 200000;
+    const unsigned int FINDS_PER_STEP = 16;
+    NormBlockBuffer buffer;
+    if (!buffer.Init(window*stride + 1, 256, BLOCK_MASK, directIndex))
+    {
+        fprintf(stderr, "fect: NormBlockBuffer init error!\n");
+        return false;
+    }
+    NormBlock* blockList = new NormBlock[window + 1];
+    if (NULL == blockList)
+    {
+        fprintf(stderr, "fect: new NormBlock error!\n");
+        return false;
+    }
+    bool result = true;
+    // Start near the end of the block id space so the window wraps
+    UINT32 loId = BLOCK_MASK - (NUM_STEPS * stride) / 2;
+    for (unsigned int i = 0; i < window; i++)
+    {
+        NormBlockId blockId((loId + i*stride) & BLOCK_MASK);
+        blockList[i].SetId(blockId);
+        buffer.Insert(blockList + i);
+    }
+    unsigned int loIndex = 0;  // blockList index of block "loId"
+    unsigned long findCount = 0;
+    ProtoTime startTime, stopTime;
+    startTime.GetCurrentTime();
+    for (unsigned int step = 0; (step < NUM_STEPS) && result; step++)
+    {
+        // Lookups of buffered (and some unbuffered) block ids
+        for (unsigned int i = 0; i < FINDS_PER_STEP; i++)
+        {
+            unsigned int offset = (unsigned int)rand() % (window*stride);
+            NormBlockId blockId((loId + offset) & BLOCK_MASK);
+            NormBlock* block = buffer.Find(blockId);
+            NormBlock* expected = 
+                (0 == (offset % stride)) ? (blockList + (loIndex + offset/stride) % (window + 1)) : NULL;
+            if (block != expected)
+            {
+                fprintf(stderr, "fect: NormBlockBuffer::Find() error (step:%u offset:%u)\n", step, offset);
+                result = false;
+                break;
+            }
+            findCount++;
+        }
+        // Slide the window, recycling the oldest block
+        NormBlock* newBlock = blockList + (loIndex + window) % (window + 1);
+        NormBlockId newId((loId + window*stride) & BLOCK_MASK);
+        newBlock->SetId(newId);
+        if (!buffer.Insert(newBlock) || !buffer.Remove(blockList + loIndex))
+        {
+            fprintf(stderr, "fect: NormBlockBuffer insert/remove error (step:%u)\n", step);
+            result = false;
+        }
+        loIndex = (loIndex + 1) % (window + 1);
+        loId = (loId + stride) & BLOCK_MASK;
+        if (buffer.RangeLo().GetValue() != loId)
+        {
+            fprintf(stderr, "fect: NormBlockBuffer range error (step:%u)\n", step);
+            result = false;
+        }
+    }
+    stopTime.GetCurrentTime();
+    double elapsed = ProtoTime::Delta(stopTime, startTime);
+    fprintf(stderr, "fect: NormBlockBuffer %s window:%u stride:%u %lu finds (plus slides) in %lf usec\n",
+                    directIndex ? "direct" : "tree", window, stride, findCount, 1.0e+06*elapsed);
+    for (unsigned int i = 0; i < window; i++)
+        buffer.Remove(blockList + (loIndex + i) % (window + 1));
+    buffer.Destroy();
+    delete[] blockList;
+    return result;
+}  // end CheckBlockBuffer()
+
+// Compares NormBitmaskRunIterator runs and skips against a bit-by-bit walk
+// of random masks (with varying density so both short and long runs occur)
+static bool CheckBitmaskRuns(unsigned int numBits, unsigned int trials)
+{
+    ProtoBitmask mask;
+    if (!mask.Init(numBits))
+    {
+        fprintf(stderr, "fect: ProtoBitmask init error!\n");
+        return false;
+    }
+    for (unsigned int trial = 0; trial < trials; trial++)
+    {
+        mask.Clear();
+        unsigned int density = 1 + (unsigned int)rand() % 15;  // out of 16
+        for (unsigned int i = 0; i < numBits; i++)
+            if (((unsigned int)rand() % 16) < density) mask.Set(i);
+        UINT32 firstIndex = (UINT32)rand() % numBits;
+        UINT32 endIndex = firstIndex + (UINT32)rand() % (numBits - firstIndex + 1);
+        UINT32 skipCount = (UINT32)rand() % 8;
+        // Expected position after skipping "skipCount" set bits
+        UINT32 index = firstIndex;
+        UINT32 skipped = 0;
+        while ((skipped < skipCount) && (index < endIndex))
+            if (mask.Test(index++)) skipped++;
+        NormBitmaskRunIterator iterator(mask, firstIndex, endIndex);
+        if (iterator.SkipSet(skipCount) != (skipped == skipCount))
+        {
+            fprintf(stderr, "fect: NormBitmaskRunIterator::SkipSet() error (trial:%u)\n", trial);
+            return false;
+        }
+        UINT32 runStart, runCount;
+        while (iterator.GetNextRun(runStart, runCount))
+        {
+            while ((index < endIndex) && !mask.Test(index)) index++;
+            UINT32 expectedStart = index;
+            while ((index < endIndex) && mask.Test(index)) index++;
+            if ((runStart != expectedStart) || (runCount != (index - expectedStart)))
+            {
+                fprintf(stderr, "fect: NormBitmaskRunIterator::GetNextRun() error (trial:%u run:%u:%u expected:%u:%u)\n",
+                                trial, runStart, runCount, expectedStart, index - expectedStart);
+                return false;
+            }
+        }
+        while ((index < endIndex) && !mask.Test(index)) index++;
+        if (index < endIndex)
+        {
+            fprintf(stderr, "fect: NormBitmaskRunIterator missed run at %u (trial:%u)\n", index, trial);
+            return false;
+        }
+    }
+    return true;
+}  // end CheckBitmaskRuns()
+
+// Verifies NormBlock::MergeRepairRange() sets the in-range part of a NACKed 
+// segment range, including ranges that extend past the end of the block
+static bool CheckMergeRepairRange(UINT16 blockSize)
+{
+    NormBlock block;
+    if (!block.Init(blockSize))
+    {
+        fprintf(stderr, "fect: NormBlock init error!\n");
+        return false;
+    }
+    bool result = true;
+    if (!block.MergeRepairRange(blockSize / 2, blockSize + 10) ||   // runs past the end
+        block.MergeRepairRange(blockSize / 2, blockSize - 1) ||     // already set
+        block.MergeRepairRange(blockSize, blockSize + 10) ||        // entirely past the end
+        block.MergeRepairRange(3, 2))                               // empty range
+    {
+        fprintf(stderr, "fect: NormBlock::MergeRepairRange() result error\n");
+        result = false;
+    }
+    // Exactly segments [blockSize/2, blockSize-1] should be marked for repair
+    UINT16 expectedId = blockSize / 2;
+    NormSymbolId symbolId;
+    bool found = block.GetFirstRepair(symbolId);
+    while (found && (symbolId == expectedId))
+    {
+        expectedId++;
+        symbolId++;
+        found = (symbolId < blockSize) && block.GetNextRepair(symbolId);
+    }
+    if (found || (expectedId != blockSize))
+    {
+        fprintf(stderr, "fect: NormBlock::MergeRepairRange() repair mask error at %u\n", expectedId);
+        result = false;
+    }
+    block.Destroy();
+    return result;
+}  // end CheckMergeRepairRange()
+
+// Verifies NormNackAggregator merges overlapping and adjacent segment ranges,
+// only reports requests as covered when fully contained in a recorded interval 
+// (with no more erasures than seen before) and forgets state on Invalidate()
+// and at the end of a repair cycle (Clear())
+static bool CheckNackAggregator()
+{
+    NormNackAggregator aggregator;
+    if (!aggregator.Init(4))
+    {
+        fprintf(stderr, "fect: NormNackAggregator init error!\n");
+        return false;
+    }
+    const NormObjectId OBJECT_ID(3);
+    const NormBlockId BLOCK_A(5);
+    const NormBlockId BLOCK_B(6);
+    bool result = true;
+    aggregator.Insert(OBJECT_ID, BLOCK_A, 10, 20, 2);
+    if (!aggregator.IsCovered(OBJECT_ID, BLOCK_A, 12, 18, 2) ||
+        aggregator.IsCovered(OBJECT_ID, BLOCK_A, 12, 18, 3) ||      // more erasures
+        aggregator.IsCovered(OBJECT_ID, BLOCK_A, 9, 12, 1) ||       // partial overlap
+        aggregator.IsCovered(OBJECT_ID, BLOCK_A, 15, 25, 1) ||
+        aggregator.IsCovered(OBJECT_ID, BLOCK_B, 12, 18, 1) ||      // other block
+        aggregator.IsCovered(NormObjectId(4), BLOCK_A, 12, 18, 1))  // other object
+    {
+        fprintf(stderr, "fect: NormNackAggregator single interval error\n");
+        result = false;
+    }
+    // Adjacent ranges merge into one interval
+    aggregator.Insert(OBJECT_ID, BLOCK_A, 21, 30, 1);
+    if (!aggregator.IsCovered(OBJECT_ID, BLOCK_A, 10, 30, 2))
+    {
+        fprintf(stderr, "fect: NormNackAggregator adjacent merge error\n");
+        result = false;
+    }
+    // Disjoint intervals, then overlapping and gap-filling ranges that join them
+    aggregator.Insert(OBJECT_ID, BLOCK_A, 40, 50, 0);
+    aggregator.Insert(OBJECT_ID, BLOCK_A, 60, 70, 0);
+    if (aggregator.IsCovered(OBJECT_ID, BLOCK_A, 45, 65, 0) ||
+        !aggregator.IsCovered(OBJECT_ID, BLOCK_A, 60, 70, 0))
+    {
+        fprintf(stderr, "fect: NormNackAggregator disjoint interval error\n");
+        result = false;
+    }
+    aggregator.Insert(OBJECT_ID, BLOCK_A, 45, 65, 0);
+    if (!aggregator.IsCovered(OBJECT_ID, BLOCK_A, 40, 70, 0) ||
+        aggregator.IsCovered(OBJECT_ID, BLOCK_A, 25, 45, 0))
+    {
+        fprintf(stderr, "fect: NormNackAggregator overlap merge error\n");
+        result = false;
+    }
+    aggregator.Insert(OBJECT_ID, BLOCK_A, 31, 39, 0);
+    if (!aggregator.IsCovered(OBJECT_ID, BLOCK_A, 10, 70, 2))
+    {
+        fprintf(stderr, "fect: NormNackAggregator gap merge error\n");
+        result = false;
+    }
+    // More disjoint intervals than an entry records are just not coalesced
+    for (NormSegmentId id = 0; id < 40; id += 2)
+        aggregator.Insert(OBJECT_ID, BLOCK_B, id, id, 0);
+    if (!aggregator.IsCovered(OBJECT_ID, BLOCK_B, 0, 0, 0) ||
+        aggregator.IsCovered(OBJECT_ID, BLOCK_B, 38, 38, 0) ||
+        aggregator.IsCovered(OBJECT_ID, BLOCK_B, 1, 1, 0))
+    {
+        fprintf(stderr, "fect: NormNackAggregator interval limit error\n");
+        result = false;
+    }
+    // Invalidate() drops a block's state (but not other blocks')
+    aggregator.Invalidate(OBJECT_ID, BLOCK_A);
+    if (aggregator.IsCovered(OBJECT_ID, BLOCK_A, 10, 10, 0) ||
+        !aggregator.IsCovered(OBJECT_ID, BLOCK_B, 0, 0, 0))
+    {
+        fprintf(stderr, "fect: NormNackAggregator::Invalidate() error\n");
+        result = false;
+    }
+    // Entries beyond "entryMax" aren't recorded
+    for (UINT32 i = 0; i < 4; i++)
+        aggregator.Insert(OBJECT_ID, NormBlockId(100 + i), 0, 0, 0);
+    if ((4 != aggregator.GetEntryCount()) ||
+        !aggregator.IsCovered(OBJECT_ID, NormBlockId(101), 0, 0, 0) ||
+        aggregator.IsCovered(OBJECT_ID, NormBlockId(102), 0, 0, 0))
+    {
+        fprintf(stderr, "fect: NormNackAggregator entry limit error\n");
+        result = false;
+    }
+    // The end of the repair cycle forgets everything
+    aggregator.Clear();
+    if ((0 != aggregator.GetEntryCount()) ||
+        aggregator.IsCovered(OBJECT_ID, BLOCK_B, 0, 0, 0) ||
+        aggregator.IsCovered(OBJECT_ID, NormBlockId(101), 0, 0, 0))
+    {
+        fprintf(stderr, "fect: NormNackAggregator::Clear() error\n");
+        result = false;
+    }
+    aggregator.Insert(OBJECT_ID, BLOCK_A, 1, 2, 0);
+    if (!aggregator.IsCovered(OBJECT_ID, BLOCK_A, 1, 2, 0))
+    {
+        fprintf(stderr, "fect: NormNackAggregator reuse after Clear() error\n");
+        result = false;
+    }
+    aggregator.Destroy();
+    return result;
+}  // end CheckNackAggregator()
+
+// Verifies a repaired block's parity saved to the sender NormParityCache is
+// restored bit-identical after the block is "stolen" (emptied to the segment
+// pool) and recovered the way NormObject::SenderRecoverBlock() rebuilds it,
+// and that invalidated or evicted entries are cache misses
+static bool CheckParityCache(unsigned int numData, unsigned int numParity, unsigned int vecSize)
+{
+    const unsigned int NUM_ENTRIES = 4;
+    const NormObjectId OBJECT_ID(7);
+    unsigned int blockSize = numData + numParity;
+    NormEncoderRS8 encoder;
+    NormSegmentPool segmentPool;
+    NormParityCache cache;
+    NormBlock block;
+    if (!encoder.Init(numData, numParity, vecSize) ||
+        !segmentPool.Init((NUM_ENTRIES + 2) * blockSize, vecSize) ||
+        !cache.Init(NUM_ENTRIES, numParity, vecSize) ||
+        !block.Init(blockSize))
+    {
+        fprintf(stderr, "fect: parity cache test init error!\n");
+        return false;
+    }
+    char* refParity = new char[numParity * vecSize];
+    if (NULL == refParity)
+    {
+        fprintf(stderr, "fect: new refParity error!\n");
+        return false;
+    }
+    bool result = true;
+    // Save parity for more blocks than the cache holds (the first block
+    // saved is the least recently NACKed one and so is evicted)
+    for (UINT32 id = 0; id <= NUM_ENTRIES; id++)
+    {
+        NormBlockId blockId(id);
+        block.TxInit(blockId, numData, 0);
+        for (unsigned int i = 0; i < blockSize; i++)
+        {
+            char* segment = segmentPool.Get();
+            if (i < numData)
+            {
+                for (unsigned int j = 0; j < vecSize; j++)
+                    segment[j] = (char)rand();
+            }
+            else
+            {
+                memset(segment, 0, vecSize);
+            }
+            block.AttachSegment(i, segment);
+        }
+        encoder.EncodeBlock((const char**)block.SegmentList(), block.SegmentList(numData), numData);
+        block.UpdateSegSizeMax(vecSize);
+        block.SetParityReadiness(numData);
+        block.SetFlag(NormBlock::IN_REPAIR);
+        ProtoTime nackTime;
+        nackTime.GetCurrentTime();
+        block.SetLastNackTime(nackTime);
+        cache.Save(OBJECT_ID, block, numData);
+        if (NUM_ENTRIES == id)
+        {
+            for (unsigned int i = 0; i < numParity; i++)
+                memcpy(refParity + i*vecSize, block.GetSegment(numData + i), vecSize);
+        }
+        block.EmptyToPool(segmentPool);
+    }
+    // Recover the last ("stolen") block with zeroed parity segments
+    NormBlockId blockId(NUM_ENTRIES);
+    block.TxRecover(blockId, numData, numParity);
+    for (unsigned int i = numData; i < blockSize; i++)
+    {
+        char* segment = segmentPool.Get();
+        memset(segment, 0, vecSize);
+        block.AttachSegment(i, segment);
+    }
+    if (!cache.Restore(OBJECT_ID, block, numData) || !block.ParityReady(numData) ||
+        (vecSize != block.GetSegSizeMax()))
+    {
+        fprintf(stderr, "fect: NormParityCache::Restore() miss for recovered block!\n");
+        result = false;
+    }
+    for (unsigned int i = 0; (i < numParity) && result; i++)
+    {
+        if (0 != memcmp(refParity + i*vecSize, block.GetSegment(numData + i), vecSize))
+        {
+            fprintf(stderr, "fect: NormParityCache restored parity mismatch (segment:%u)!\n", numData + i);
+            result = false;
+        }
+    }
+    block.EmptyToPool(segmentPool);
+    // Block 0 (least recently NACKed) was evicted, block 1 is cached until invalidated
+    block.TxRecover(blockId = NormBlockId(0), numData, numParity);
+    for (unsigned int i = numData; i < blockSize; i++)
+        block.AttachSegment(i, segmentPool.Get());
+    if (cache.Restore(OBJECT_ID, block, numData))
+    {
+        fprintf(stderr, "fect: NormParityCache evicted entry was restored!\n");
+        result = false;
+    }
+    block.TxRecover(blockId = NormBlockId(1), numData, numParity);
+    cache.Invalidate(OBJECT_ID);
+    if (cache.Restore(OBJECT_ID, block, numData))
+    {
+        fprintf(stderr, "fect: NormParityCache invalidated entry was restored!\n");
+        result = false;
+    }
+    block.EmptyToPool(segmentPool);
+    if (result && ((1 != cache.GetHitCount()) || (2 != cache.GetMissCount())))
+    {
+        fprintf(stderr, "fect: NormParityCache hit/miss count error (hits:%lu misses:%lu)!\n",
+                        cache.GetHitCount(), cache.GetMissCount());
+        result = false;
+    }
+    if (result)
+        fprintf(stderr, "fect: NormParityCache OK (numData:%u numParity:%u)\n", numData, numParity);
+    delete[] refParity;
+    return result;
+}  // end CheckParityCache()
+
 int main(int argc, char* argv[])
 {
     // Uncomment to seed random generator
@@ -29,6 +647,46 @@ int main(int argc, char* argv[])
     fprintf(stderr, "fect: seed = %u\n", seed);
     srand(seed);
     
+    if (!CheckRS8Kernels())
+        fprintf(stderr, "fect: RS8 SIMD kernel check FAILED!\n");
+    
+    NormEncoderRS8 rs8;
+    NormEncoderRS16 rs16;
+    NormEncoderMDP mdp;
+    if (!CheckEncodeBlock(rs8, "RS8", 200, 55, 1403) ||
+        !CheckEncodeBlock(rs16, "RS16", 400, 100, 1402) ||
+        !CheckEncodeBlock(mdp, "MDP", 200, 55, 1403))
+    {
+        fprintf(stderr, "fect: EncodeBlock() check FAILED!\n");
+    }
+    
+    NormDecoderRS8 rs8Decoder;
+    NormDecoderRS16 rs16Decoder;
+    if (!CheckDecodeCache(rs8, rs8Decoder, "RS8", 200, 55, 1403) ||
+        !CheckDecodeCache(rs16, rs16Decoder, "RS16", 400, 100, 1402))
+    {
+        fprintf(stderr, "fect: Decode() matrix cache check FAILED!\n");
+    }
+    
+    // Contiguous (table-indexed) and sparse (tree fallback) block windows
+    if (!CheckBlockBuffer(false, 64, 1) || !CheckBlockBuffer(true, 64, 1) ||
+        !CheckBlockBuffer(false, 64, 7) || !CheckBlockBuffer(true, 64, 7))
+    {
+        fprintf(stderr, "fect: NormBlockBuffer check FAILED!\n");
+    }
+    
+    if (!CheckBitmaskRuns(7, 1000) || !CheckBitmaskRuns(255, 1000) || !CheckBitmaskRuns(1200, 200))
+        fprintf(stderr, "fect: NormBitmaskRunIterator check FAILED!\n");
+    
+    if (!CheckMergeRepairRange(20) || !CheckMergeRepairRange(255))
+        fprintf(stderr, "fect: NormBlock::MergeRepairRange() check FAILED!\n");
+    
+    if (!CheckNackAggregator())
+        fprintf(stderr, "fect: NormNackAggregator check FAILED!\n");
+    
+    if (!CheckParityCache(20, 8, 1403) || !CheckParityCache(200, 55, 1024))
+        fprintf(stderr, "fect: NormParityCache check FAILED!\n");
+    
     NORM_ENCODER encoder;
     encoder.Init(NUM_DATA, NUM_PARITY, SEG_SIZE);
     NORM_DECODER decoder;
@@ -1,12 +1,18 @@
 #define _NORM_API_BUILD	// force 'dllexport' in "normApi.h"
 #include "normApi.h"
 #include "normSession.h"
+#include "normAtomic.h"
 
 #ifdef WIN32
 #ifndef _WIN32_WCE
 #include <io.h>  // for _mktemp()
 #endif // !_WIN32_WCE
-#endif // WIN32
+#else
+#include <pthread.h>
+#ifdef LINUX
+#include <sys/eventfd.h>
+#endif // LINUX
+#endif // if/else WIN32
 
 // const defs
 extern NORM_API_LINKAGE
@@ -43,43 +49,56 @@ class NormInstance : public NormController
                     class NormNode*         node,
                     class NormObject*       object);
         
-        bool Startup(bool priorityBoost = false);
+        // A "primaryInstance" is given when starting up an additional shard
+        bool Startup(bool priorityBoost = false, NormInstance* primaryInstance = NULL);
         void Shutdown();
         
-        void Stop()  // pause NORM protocol engine
-        {
-            dispatcher.Stop();
-            Notify(NormController::EVENT_INVALID, &session_mgr, NULL, NULL, NULL);
-        }
-        bool Start()
-        {
-            if (dispatcher.StartThread(priority_boost))
-            {
-                return true;
-            }
-            else
-            {
-                PLOG(PL_FATAL, "NormInstance::Resume() error restarting NORM thread\n");
-                return false;
-            }
-        }
+        // A "sharded" instance runs its sessions on "threadCount" NORM threads,
+        // each with its own ProtoDispatcher (timers and sockets).  The primary 
+        // instance (the NormInstanceHandle) is the first shard.  Session, node 
+        // and object handles map to the NormInstance shard that runs them while 
+        // events from all shards are delivered via the primary instance.
+        bool CreateShards(unsigned int threadCount, bool priorityBoost);
+        unsigned int GetShardCount() const
+            {return shard_count;}
+        NormInstance* GetShard(unsigned int index)
+            {return ((0 == index) ? this : shard_array[index - 1]);}
+        NormInstance* GetPrimary()
+            {return ((NULL != primary) ? primary : this);}
+        // Picks the shard with the fewest sessions for a new session
+        NormInstance* SelectShard();
+        void IncrementSessionCount()
+            {NormAtomicAdd(&session_count, 1);}
+        void DecrementSessionCount()
+            {NormAtomicAdd(&session_count, (UINT32)-1);}
+        // These suspend/resume all shards of the primary instance
+        bool SuspendShards();
+        void ResumeShards();
+        
+        void Stop();  // pause NORM protocol engine
+        bool Start();
         
         bool WaitForEvent();
-        bool GetNextEvent(NormEvent* theEvent);
+        // These may be called without suspending the NORM thread(s)
+        unsigned int GetNextEvents(NormEvent* eventArray, unsigned int arraySize);
+        void ReleasePreviousEvents();
+        bool EventRingIsEmpty() const
+            {return (NormAtomicLoad(&ring_read) == NormAtomicLoad(&ring_write));}
+        bool EventRingsAreEmpty();  // (all shards)
+        
         bool SetCacheDirectory(const char* cachePath);
         
         void SetAllocationFunctions(NormAllocFunctionHandle allocFunc, 
                                     NormFreeFunctionHandle  freeFunc)
         {
-            data_alloc_func = allocFunc;
-            session_mgr.SetDataFreeFunction(freeFunc);
+            for (unsigned int i = 0; i < shard_count; i++)
+            {
+                NormInstance* shard = GetShard(i);
+                shard->data_alloc_func = allocFunc;
+                shard->session_mgr.SetDataFreeFunction(freeFunc);
+            }
         }
         
-        void ReleasePreviousEvent();
-        
-        bool NotifyQueueIsEmpty() const 
-            {return notify_queue.IsEmpty();}
-        
         void PurgeSessionNotifications(NormSessionHandle sessionHandle);
         void PurgeNodeNotifications(NormNodeHandle nodeHandle);
         void PurgeObjectNotifications(NormObjectHandle objectHandle);
@@ -140,17 +159,72 @@ class NormInstance : public NormController
            while (read(notify_fd[0], byte, 32) > 0);  // TBD - error check
 #endif // if/else WIN32/UNIX
         }  
+        void SetNotificationEvent();
+        static void ReleaseEventHandles(const NormEvent& theEvent)
+        {
+            // "Release" any previously-retained object or node handle
+            if (NORM_OBJECT_INVALID != theEvent.object)
+                ((NormObject*)theEvent.object)->Release();
+            else if (NORM_NODE_INVALID != theEvent.sender)
+                ((NormNode*)theEvent.sender)->Release();
+        }
+        
+        // Events are passed from the NORM thread to the application through a 
+        // lock-free single-producer / single-consumer ring.  Delivered events (and
+        // the handles they retain) remain valid until the application's next call
+        // for events, after which the NORM thread recycles their slots.  Events
+        // are held in the "notify_queue" only when the ring is full.
+        enum {EVENT_RING_SIZE = 1024};  // (must be a power of 2)
+        class EventSlot
+        {
+            public:
+                NormEvent       event;
+                volatile UINT32 purged;  // set when undelivered event is purged
+        };
+        bool PushEvent(const NormEvent& theEvent);  // (NORM thread only)
+        void CleanEventRing();                      // (NORM thread only)
+        void PurgeEventRing(NormSessionHandle sessionHandle, 
+                            NormNodeHandle    nodeHandle, 
+                            NormObjectHandle  objectHandle, 
+                            NormEventType     eventType);
+        void OnRingEvent(ProtoEvent& theEvent);
+        // Consumer side of a single shard's ring (with primary consumer lock held)
+        unsigned int ReadEventRing(NormEvent* eventArray, unsigned int arraySize, bool& advanced);
+        bool ReleaseEventRing();
+        void LockConsumer();
+        void UnlockConsumer();
+        bool SetShardCacheDirectory(const char* cachePath);
          
         Notification::Queue         notify_pool;
-        Notification::Queue         notify_queue; 
-        Notification*               previous_notification;
+        Notification::Queue         notify_queue;  // (overflow from full event_ring)
+        
+        EventSlot                   event_ring[EVENT_RING_SIZE];
+        volatile UINT32             ring_write;    // next slot to fill (NORM thread)
+        volatile UINT32             ring_read;     // next slot to deliver (application)
+        volatile UINT32             ring_done;     // slots before this may be recycled (application)
+        UINT32                      ring_armed;    // deferred delivery actions applied (NORM thread)
+        UINT32                      ring_clean;    // slots before this are recycled (NORM thread)
+        volatile UINT32             ring_clean_pending;
+        ProtoEvent                  ring_event;    // wakes NORM thread to recycle slots
+#ifdef WIN32
+        CRITICAL_SECTION            consumer_mutex;  // serializes application threads
+#else
+        pthread_mutex_t             consumer_mutex;
+#endif // if/else WIN32
         
         const char*                 rx_cache_path;
         
+        NormInstance*               primary;       // NULL unless this is an additional shard
+        NormInstance**              shard_array;   // additional shards (primary only)
+        unsigned int                shard_count;   // includes the primary instance
+        unsigned int                shard_next;    // for round-robin event delivery
+        volatile UINT32             session_count;
+        
+        // (shards share the primary instance notification descriptor)
 #ifdef WIN32
         HANDLE                      notify_event;
 #else
-        int                         notify_fd[2];  // TBD - use eventfd on Linux for this, may EVT_USER on MacOS
+        int                         notify_fd[2];  // (notify_fd[0] == notify_fd[1] for Linux eventfd)
 #endif // if/else WIN32/UNIX
 };  // end class NormInstance
 
@@ -162,12 +236,16 @@ NormInstance::NormInstance()
    session_mgr(static_cast<ProtoTimerMgr&>(dispatcher), 
                static_cast<ProtoSocket::Notifier&>(dispatcher),
                static_cast<ProtoChannel::Notifier*>(&dispatcher)),
-   data_alloc_func(NULL), previous_notification(NULL), rx_cache_path(NULL)
+   data_alloc_func(NULL), ring_write(0), ring_read(0), ring_done(0), ring_armed(0), 
+   ring_clean(0), ring_clean_pending(0), ring_event(false), rx_cache_path(NULL),
+   primary(NULL), shard_array(NULL), shard_count(1), shard_next(0), session_count(0)
 {
 #ifdef WIN32
     notify_event = NULL;
+    InitializeCriticalSection(&consumer_mutex);
 #else
     notify_fd[0] = notify_fd[1] = -1;
+    pthread_mutex_init(&consumer_mutex, NULL);
 #endif // if/else WIN32/UNIX
     dispatcher.SetUserData(&session_mgr);  // for debugging
     session_mgr.SetController(static_cast<NormController*>(this));
@@ -176,9 +254,42 @@ NormInstance::NormInstance()
 NormInstance::~NormInstance()
 {
     Shutdown();
+#ifdef WIN32
+    DeleteCriticalSection(&consumer_mutex);
+#else
+    pthread_mutex_destroy(&consumer_mutex);
+#endif // if/else WIN32
 }
 
+void NormInstance::LockConsumer()
+{
+#ifdef WIN32
+    EnterCriticalSection(&consumer_mutex);
+#else
+    pthread_mutex_lock(&consumer_mutex);
+#endif // if/else WIN32
+}  // end NormInstance::LockConsumer()
+
+void NormInstance::UnlockConsumer()
+{
+#ifdef WIN32
+    LeaveCriticalSection(&consumer_mutex);
+#else
+    pthread_mutex_unlock(&consumer_mutex);
+#endif // if/else WIN32
+}  // end NormInstance::UnlockConsumer()
+
 bool NormInstance::SetCacheDirectory(const char* cachePath)
+{
+    for (unsigned int i = 0; i < shard_count; i++)
+    {
+        if (!GetShard(i)->SetShardCacheDirectory(cachePath))
+            return false;
+    }
+    return true;
+}  // end NormInstance::SetCacheDirectory()
+
+bool NormInstance::SetShardCacheDirectory(const char* cachePath)
 {
     // (TBD) verify that we can _write_ to this directory!
     bool result = false;
@@ -208,7 +319,7 @@ bool NormInstance::SetCacheDirectory(const char* cachePath)
         dispatcher.ResumeThread();
     }
     return result;
-}  // end NormInstance::SetCacheDirectory()
+}  // end NormInstance::SetShardCacheDirectory()
 
 void NormInstance::Notify(NormController::Event   event,
                           class NormSessionMgr*   sessionMgr,
@@ -226,20 +337,6 @@ void NormInstance::Notify(NormController::Event   event,
             break;
     }
     
-    // (TBD) set a limit on how many pending notifications
-    // we allow to queue up (it could be large and probably
-    // we could base it on how much memory space the pending
-    // notifications are allowed to consume.
-    Notification* next = notify_pool.RemoveHead();
-    if (NULL == next)
-    {
-        if (NULL == (next = new Notification))
-        {
-            PLOG(PL_FATAL, "NormInstance::Notify() new Notification error: %s\n", GetErrorString());
-            return;   
-        }
-    }
-    
     switch (event)
     { 
         case RX_OBJECT_NEW:
@@ -257,7 +354,6 @@ void NormInstance::Notify(NormController::Event   event,
                     if (!stream->Accept(size.LSB(), true))
                     {
                         PLOG(PL_FATAL, "NormInstance::Notify() stream accept error\n");
-                        notify_pool.Append(*next);
                         return;   
                     }
                     // By setting a non-zero "block pool threshold", this
@@ -326,7 +422,6 @@ void NormInstance::Notify(NormController::Event   event,
                     {
                         // we're ignoring files
                         PLOG(PL_DETAIL, "NormInstance::Notify() warning: receive file but no cache directory set, so ignoring file\n");
-                        notify_pool.Append(*next);
                         return;    
                     }                
                     break;
@@ -340,7 +435,6 @@ void NormInstance::Notify(NormController::Event   event,
                     {
                         PLOG(PL_FATAL, "NormInstance::Notify(RX_OBJECT_NEW) new dataPtr error: %s\n",
                                        GetErrorString());
-                        notify_pool.Append(*next);
                         return;   
                     }
                     // Note that the "true" parameter means the
@@ -351,14 +445,12 @@ void NormInstance::Notify(NormController::Event   event,
                     if (!dataObj->Accept(dataPtr, dataLen, true))
                     {
                         PLOG(PL_FATAL, "NormInstance::Notify() data object accept error\n");
-                        notify_pool.Append(*next);
                         return;   
                     }
                     break;
                 }
                 default:
                     // This shouldn't occur
-                    notify_pool.Append(*next);
                     return;
             }  // end switch(object->GetType())
             break;
@@ -374,35 +466,164 @@ void NormInstance::Notify(NormController::Event   event,
     else if (NORM_NODE_INVALID != node)
         ((NormNode*)node)->Retain();
     
-    bool doNotify = notify_queue.IsEmpty();
-    next->event.type = (NormEventType)event;
-    next->event.session = session;
-    next->event.sender = node;
-    next->event.object = object;
-    notify_queue.Append(*next);
+    NormEvent theEvent;
+    theEvent.type = (NormEventType)event;
+    theEvent.session = session;
+    theEvent.sender = node;
+    theEvent.object = object;
     
-    if (doNotify)
-    {
+    // Recycle any slots released by the application, then post the event
+    // (the "notify_queue" preserves event order while the ring is full)
+    CleanEventRing();
+    if (!notify_queue.IsEmpty() || !PushEvent(theEvent))
+    {
+        // (TBD) set a limit on how many pending notifications
+        // we allow to queue up (it could be large and probably
+        // we could base it on how much memory space the pending
+        // notifications are allowed to consume.
+        Notification* next = notify_pool.RemoveHead();
+        if ((NULL == next) && (NULL == (next = new Notification)))
+        {
+            PLOG(PL_FATAL, "NormInstance::Notify() new Notification error: %s\n", GetErrorString());
+            ReleaseEventHandles(theEvent);
+            return;   
+        }
+        next->event = theEvent;
+        notify_queue.Append(*next);
+    }
+}  // end NormInstance::Notify()
+
+void NormInstance::SetNotificationEvent()
+{
 #ifdef WIN32
-        if (0 == SetEvent(notify_event))
+    if (0 == SetEvent(notify_event))
+    {
+        PLOG(PL_ERROR, "NormInstance::SetNotificationEvent() SetEvent() error: %s\n",
+                       GetErrorString());
+    }
+#else
+#ifdef LINUX
+    uint64_t count = 1;  // eventfd
+#else
+    char count = 0;      // pipe
+#endif // if/else LINUX
+    while (sizeof(count) != write(notify_fd[1], &count, sizeof(count)))
+    {
+        if ((EINTR != errno) && (EAGAIN != errno))
         {
-            PLOG(PL_ERROR, "NormInstance::Notify() SetEvent() error: %s\n",
+            PLOG(PL_FATAL, "NormInstance::SetNotificationEvent() write() error: %s\n",
                            GetErrorString());
+            break;
         }
-#else
-        char byte = 0;
-        while (1 != write(notify_fd[1], &byte, 1))
+    }    
+#endif // if/else WIN32/UNIX  
+}  // end NormInstance::SetNotificationEvent()
+
+// Called by NORM thread only. Returns false if event ring is full.
+bool NormInstance::PushEvent(const NormEvent& theEvent)
+{
+    UINT32 writeIndex = ring_write;
+    if ((writeIndex - ring_clean) >= EVENT_RING_SIZE) return false;
+    EventSlot& slot = event_ring[writeIndex & (EVENT_RING_SIZE - 1)];
+    slot.event = theEvent;
+    NormAtomicStore(&slot.purged, 0);
+    NormAtomicStore(&ring_write, writeIndex + 1);
+    // The application resets the notification when it empties the ring 
+    // and then re-checks "ring_write", so we only need to signal when
+    // the ring was empty (the fences order these checks on both sides)
+    NormAtomicFence();
+    if (NormAtomicLoad(&ring_read) == writeIndex) SetNotificationEvent();
+    return true;
+}  // end NormInstance::PushEvent()
+
+// Called by NORM thread (or with it suspended or stopped)
+void NormInstance::CleanEventRing()
+{
+    // Note "ring_done" must be loaded before "ring_read" so
+    // that we never recycle slots that haven't been "armed"
+    UINT32 doneIndex = NormAtomicLoad(&ring_done);
+    UINT32 readIndex = NormAtomicLoad(&ring_read);
+    // 1) Apply deferred actions for events delivered to the application
+    while (ring_armed != readIndex)
+    {
+        EventSlot& slot = event_ring[ring_armed & (EVENT_RING_SIZE - 1)];
+        ring_armed++;
+        if (0 != NormAtomicLoad(&slot.purged)) continue;
+        switch (slot.event.type)
         {
-            if ((EINTR != errno) && (EAGAIN != errno))
+            case NORM_RX_OBJECT_UPDATED:
             {
-                PLOG(PL_FATAL, "NormInstance::Notify() write() error: %s\n",
-                               GetErrorString());
+                // reset update event notification for non-streams
+                // (NormStreamRead() takes care of streams)
+                NormObject* obj = ((NormObject*)slot.event.object);
+                if (!obj->IsStream()) obj->SetNotifyOnUpdate(true);
                 break;
             }
-        }    
-#endif // if/else WIN32/UNIX  
-    }  
-}  // end NormInstance::Notify()
+            case NORM_SEND_ERROR:
+            {
+                NormSession* session = (NormSession*)slot.event.session;
+                session->ClearSendError();
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    // 2) Release handles of events the application is done with
+    while (ring_clean != doneIndex)
+    {
+        EventSlot& slot = event_ring[ring_clean & (EVENT_RING_SIZE - 1)];
+        ring_clean++;
+        if (0 == NormAtomicLoad(&slot.purged)) 
+            ReleaseEventHandles(slot.event);
+    }
+    // 3) Move any overflow notifications into the freed slots
+    Notification* next;
+    while (NULL != (next = notify_queue.GetHead()))
+    {
+        if (!PushEvent(next->event)) break;
+        notify_queue.RemoveHead();
+        notify_pool.Append(*next);
+    }
+}  // end NormInstance::CleanEventRing()
+
+void NormInstance::OnRingEvent(ProtoEvent& /*theEvent*/)
+{
+    ring_event.Reset();
+    NormAtomicExchange(&ring_clean_pending, 0);
+    CleanEventRing();
+}  // end NormInstance::OnRingEvent()
+
+// Marks matching events not yet delivered as "purged" and releases their 
+// handles. Invalid parameter values match any event.  Events already copied
+// to the application (before "ring_read") keep their handles retained until
+// the application releases them and CleanEventRing() recycles their slots.
+// This is called with the NORM thread suspended (or by the NORM thread itself).
+// The primary consumer lock is held so that an application thread in 
+// GetNextEvents() can't copy an event whose handles are being released here.
+void NormInstance::PurgeEventRing(NormSessionHandle sessionHandle, 
+                                  NormNodeHandle    nodeHandle, 
+                                  NormObjectHandle  objectHandle, 
+                                  NormEventType     eventType)
+{
+    NormInstance* consumer = GetPrimary();
+    consumer->LockConsumer();
+    for (UINT32 i = ring_read; i != ring_write; i++)
+    {
+        EventSlot& slot = event_ring[i & (EVENT_RING_SIZE - 1)];
+        if (0 != NormAtomicLoad(&slot.purged)) continue;
+        const NormEvent& event = slot.event;
+        if (((NORM_SESSION_INVALID == sessionHandle) || (sessionHandle == event.session)) &&
+            ((NORM_NODE_INVALID == nodeHandle) || (nodeHandle == event.sender)) &&
+            ((NORM_OBJECT_INVALID == objectHandle) || (objectHandle == event.object)) &&
+            ((NORM_EVENT_INVALID == eventType) || (eventType == event.type)))
+        {
+            ReleaseEventHandles(event);
+            NormAtomicStore(&slot.purged, 1);
+        }
+    }
+    consumer->UnlockConsumer();
+}  // end NormInstance::PurgeEventRing()
 
 // Purge any notifications associated with a specific object
 void NormInstance::PurgeObjectNotifications(NormObjectHandle objectHandle)
@@ -422,14 +643,7 @@ void NormInstance::PurgeObjectNotifications(NormObjectHandle objectHandle)
             notify_pool.Append(*next);
         }
     }
-    if ((NULL != previous_notification) && (objectHandle == previous_notification->event.object))
-    {
-        // "Release" any previously-retained object or node handle
-        ((NormObject*)(previous_notification->event.object))->Release();
-        notify_pool.Append(*previous_notification);   
-        previous_notification = NULL;   
-    }
-    // TBD - check if event queue is emptied and reset event/fd
+    PurgeEventRing(NORM_SESSION_INVALID, NORM_NODE_INVALID, objectHandle, NORM_EVENT_INVALID);
 }  // end NormInstance::PurgeObjectNotifications()
 
 // Purge any notifications associated with a specific remote sender node
@@ -449,17 +663,7 @@ void NormInstance::PurgeNodeNotifications(NormNodeHandle nodeHandle)
             notify_pool.Append(*next);
         }
     }
-    if ((NULL != previous_notification) && (nodeHandle == previous_notification->event.sender))
-    {
-        // "Release" any previously-retained object or node handle
-        if (NORM_OBJECT_INVALID != previous_notification->event.object)
-            ((NormObject*)(previous_notification->event.object))->Release();
-        else
-            ((NormNode*)(previous_notification->event.sender))->Release();
-        notify_pool.Append(*previous_notification);   
-        previous_notification = NULL;   
-    }
-    if (notify_queue.IsEmpty()) ResetNotificationEvent();
+    PurgeEventRing(NORM_SESSION_INVALID, nodeHandle, NORM_OBJECT_INVALID, NORM_EVENT_INVALID);
 }  // end NormInstance::PurgeNodeNotifications()
 
 void NormInstance::PurgeSessionNotifications(NormSessionHandle sessionHandle)
@@ -480,17 +684,7 @@ void NormInstance::PurgeSessionNotifications(NormSessionHandle sessionHandle)
             notify_pool.Append(*next);
         }   
     }
-    if ((NULL != previous_notification) && (sessionHandle == previous_notification->event.session))
-    {
-        // "Release" any previously-retained object or node handle
-        if (NORM_OBJECT_INVALID != previous_notification->event.object)
-            ((NormObject*)(previous_notification->event.object))->Release();
-        else if (NORM_NODE_INVALID != previous_notification->event.sender)
-            ((NormNode*)(previous_notification->event.sender))->Release();
-        notify_pool.Append(*previous_notification);   
-        previous_notification = NULL;   
-    }
-    if (notify_queue.IsEmpty()) ResetNotificationEvent();
+    PurgeEventRing(sessionHandle, NORM_NODE_INVALID, NORM_OBJECT_INVALID, NORM_EVENT_INVALID);
 }  // end NormInstance::PurgeSessionNotifications()
 
 // Purges notifications of a specific type for a specific session
@@ -513,70 +707,96 @@ void NormInstance::PurgeNotifications(NormSessionHandle sessionHandle, NormEvent
             notify_pool.Append(*next);
         }
     }
-    if (notify_queue.IsEmpty()) ResetNotificationEvent();
+    PurgeEventRing(sessionHandle, NORM_NODE_INVALID, NORM_OBJECT_INVALID, eventType);
 }  // end NormInstance::PurgeNotifications()
 
-// NormInstance::dispatcher MUST be suspended _before_ calling this
-bool NormInstance::GetNextEvent(NormEvent* theEvent)
+// Copies up to "arraySize" pending events from this shard's ring (purged events
+// are skipped) and releases events delivered by the previous call for recycling
+// by the NORM thread.  This is called with the primary consumer lock held.
+unsigned int NormInstance::ReadEventRing(NormEvent* eventArray, unsigned int arraySize, bool& advanced)
 {
-    // First, do any garbage collection for "previous_notification"
-    if (NULL != previous_notification)
+    UINT32 readIndex = ring_read;
+    UINT32 writeIndex = NormAtomicLoad(&ring_write);
+    unsigned int count = 0;
+    while ((readIndex != writeIndex) && (count < arraySize))
     {
-        // "Release" any previously-retained object or node handle
-        if (NORM_OBJECT_INVALID != previous_notification->event.object)
-            ((NormObject*)(previous_notification->event.object))->Release();
-        else if (NORM_NODE_INVALID != previous_notification->event.sender)
-            ((NormNode*)(previous_notification->event.sender))->Release();
-        notify_pool.Append(*previous_notification);   
-        previous_notification = NULL;   
+        EventSlot& slot = event_ring[readIndex & (EVENT_RING_SIZE - 1)];
+        readIndex++;
+        if (0 != NormAtomicLoad(&slot.purged)) continue;
+        // Discard invalid events unless there is nothing else to report
+        if ((NORM_EVENT_INVALID == slot.event.type) && 
+            ((0 != count) || (readIndex != writeIndex))) continue;
+        eventArray[count++] = slot.event;
     }
-    Notification* next;
-    while (NULL != (next = notify_queue.RemoveHead()))
+    bool released = (ring_done != ring_read);
+    if (released) NormAtomicStore(&ring_done, ring_read);
+    if (readIndex != ring_read)
     {
-        switch (next->event.type)
-        {
-            case NORM_EVENT_INVALID:
-                if (!notify_queue.IsEmpty())
-                {
-                    // Discard this invalid event and get next one
-                    notify_pool.Append(*next);
-                    continue;
-                }
-                break;
-            case NORM_RX_OBJECT_UPDATED:
-            {
-                // reset update event notification for non-streams
-                // (NormStreamRead() takes care of streams)
-                NormObject* obj = ((NormObject*)next->event.object);
-                if (!obj->IsStream()) obj->SetNotifyOnUpdate(true);
-                break;
-            }
-            case NORM_SEND_ERROR:
-            {
-                NormSession* session = (NormSession*)next->event.session;
-                session->ClearSendError();
-                break;
-            }
-            default:
-                break;   
-        }
-	    break;
+        NormAtomicStore(&ring_read, readIndex);
+        advanced = true;
+    }
+    else if (!released)
+    {
+        return count;  // nothing for NORM thread to do
+    }
+    // Wake the NORM thread to apply deferred actions and recycle slots
+    if (0 == NormAtomicExchange(&ring_clean_pending, 1)) ring_event.Set();
+    return count;
+}  // end NormInstance::ReadEventRing()
+
+// Copies up to "arraySize" pending events from all shards.  This may be called
+// without suspending the NORM thread(s).  Events (and their handles) delivered 
+// by the previous call are released for recycling by the NORM thread(s).
+unsigned int NormInstance::GetNextEvents(NormEvent* eventArray, unsigned int arraySize)
+{
+    LockConsumer();
+    unsigned int count = 0;
+    bool advanced = false;
+    // (the starting shard is rotated so a busy shard can't starve the others)
+    for (unsigned int i = 0; i < shard_count; i++)
+    {
+        NormInstance* shard = GetShard((shard_next + i) % shard_count);
+        count += shard->ReadEventRing(eventArray + count, arraySize - count, advanced);
+    }
+    if (++shard_next >= shard_count) shard_next = 0;
+    if (advanced && EventRingsAreEmpty())
+    {
+        // Rings emptied, so reset notification and re-check (see PushEvent())
+        ResetNotificationEvent();
+        NormAtomicFence();
+        if (!EventRingsAreEmpty()) SetNotificationEvent();
     }
-    if (NULL != next)
+    UnlockConsumer();
+    return count; 
+}  // end NormInstance::GetNextEvents()
+
+bool NormInstance::ReleaseEventRing()
+{
+    bool released = (ring_done != ring_read);
+    if (released) 
     {
-        previous_notification = next;  // keep dispatched event for garbage collection
-        if (NULL != theEvent) *theEvent = next->event;
+        NormAtomicStore(&ring_done, ring_read);
+        if (0 == NormAtomicExchange(&ring_clean_pending, 1)) ring_event.Set();
     }
-    else if (NULL != theEvent)
+    return released;
+}  // end NormInstance::ReleaseEventRing()
+
+void NormInstance::ReleasePreviousEvents()
+{
+    LockConsumer();
+    for (unsigned int i = 0; i < shard_count; i++)
+        GetShard(i)->ReleaseEventRing();
+    UnlockConsumer();
+}  // end NormInstance::ReleasePreviousEvents()
+
+bool NormInstance::EventRingsAreEmpty()
+{
+    for (unsigned int i = 0; i < shard_count; i++)
     {
-    	theEvent->type = NORM_EVENT_INVALID;
-	    theEvent->session = NORM_SESSION_INVALID;
-	    theEvent->sender = NORM_NODE_INVALID;
-	    theEvent->object = NORM_OBJECT_INVALID;
+        if (!GetShard(i)->EventRingIsEmpty()) return false;
     }
-    if (notify_queue.IsEmpty()) ResetNotificationEvent();
-    return (NULL != next); 
-}  // end NormInstance::GetNextEvent()
+    return true;
+}  // end NormInstance::EventRingsAreEmpty()
 
 bool NormInstance::WaitForEvent()
 {
@@ -613,101 +833,205 @@ bool NormInstance::WaitForEvent()
 }  // end NormInstance::WaitForEvent()
 
 
-bool NormInstance::Startup(bool priorityBoost)
+bool NormInstance::Startup(bool priorityBoost, NormInstance* primaryInstance)
 {
     // 1) Create descriptor to use for event notification
-#ifdef WIN32
-    // Create initially non-signalled, manual reset event
-    notify_event = CreateEvent(NULL, TRUE, FALSE, NULL);  
-    if (NULL == notify_event)
+    //    (additional shards use the primary instance descriptor)
+    if (NULL != primaryInstance)
     {
-        PLOG(PL_FATAL, "NormInstance::Startup() CreateEvent() error: %s\n", GetErrorString());
-        return false;
-    }
+        primary = primaryInstance;
+#ifdef WIN32
+        notify_event = primary->notify_event;
 #else
-    if (0 != pipe(notify_fd))
+        notify_fd[0] = primary->notify_fd[0];
+        notify_fd[1] = primary->notify_fd[1];
+#endif // if/else WIN32/UNIX
+    }
+    else
     {
-        PLOG(PL_FATAL, "NormInstance::Startup() pipe() error: %s\n", GetErrorString());
-        return false;
+#ifdef WIN32
+        // Create initially non-signalled, manual reset event
+        notify_event = CreateEvent(NULL, TRUE, FALSE, NULL);  
+        if (NULL == notify_event)
+        {
+            PLOG(PL_FATAL, "NormInstance::Startup() CreateEvent() error: %s\n", GetErrorString());
+            return false;
+        }
+#elif defined(LINUX)
+        // A single non-blocking eventfd serves as both "ends" of the notification
+        if (0 > (notify_fd[0] = eventfd(0, EFD_NONBLOCK)))
+        {
+            PLOG(PL_FATAL, "NormInstance::Startup() eventfd() error: %s\n", GetErrorString());
+            notify_fd[0] = -1;
+            return false;
+        }
+        notify_fd[1] = notify_fd[0];
+#else
+        if (0 != pipe(notify_fd))
+        {
+            PLOG(PL_FATAL, "NormInstance::Startup() pipe() error: %s\n", GetErrorString());
+            return false;
+        }
+        // make reading non-blocking
+        if(-1 == fcntl(notify_fd[0], F_SETFL, fcntl(notify_fd[0], F_GETFL, 0)  | O_NONBLOCK))
+        {
+            PLOG(PL_FATAL, "NormInstance::Startup() fcntl(F_SETFL(O_NONBLOCK)) error: %s\n", GetErrorString());
+            close(notify_fd[0]);
+            close(notify_fd[1]);
+            notify_fd[0] = notify_fd[1] = -1;
+            return false;
+        }
+#endif // if/else WIN32/LINUX/UNIX
     }
-    // make reading non-blocking
-    if(-1 == fcntl(notify_fd[0], F_SETFL, fcntl(notify_fd[0], F_GETFL, 0)  | O_NONBLOCK))
+    // 2) Open event used by application to signal release of delivered events
+    ring_event.SetNotifier(static_cast<ProtoChannel::Notifier*>(&dispatcher));
+    ring_event.SetListener(this, &NormInstance::OnRingEvent);
+    if (!ring_event.Open() || !ring_event.StartInputNotification())
     {
-        PLOG(PL_FATAL, "NormInstance::Startup() fcntl(F_SETFL(O_NONBLOCK)) error: %s\n", GetErrorString());
-        close(notify_fd[0]);
-        close(notify_fd[1]);
-        notify_fd[0] = notify_fd[1] = -1;
+        PLOG(PL_FATAL, "NormInstance::Startup() error: unable to open ring_event\n");
+        Shutdown();
         return false;
     }
-#endif // if/else WIN32/UNIX
-    // 2) Start thread
+    // 3) Start thread
     priority_boost = priorityBoost;
     return dispatcher.StartThread(priorityBoost);
 }  // end NormInstance::Startup()
 
 
 
-void NormInstance::ReleasePreviousEvent()
+bool NormInstance::CreateShards(unsigned int threadCount, bool priorityBoost)
 {
-    // Garbage collect our "previous_notification"
-    if (NULL != previous_notification)
+    if (threadCount < 2) return true;
+    if (NULL == (shard_array = new NormInstance*[threadCount - 1]))
     {
-        // Release any previously-retained object or node handles
-        if (NORM_OBJECT_INVALID != previous_notification->event.object)
-            ((NormObject*)(previous_notification->event.object))->Release();
-        else if (NORM_NODE_INVALID != previous_notification->event.sender)
-            ((NormNode*)(previous_notification->event.sender))->Release();
-        notify_pool.Append(*previous_notification);   
-        previous_notification = NULL;   
+        PLOG(PL_FATAL, "NormInstance::CreateShards() new shard_array error: %s\n", GetErrorString());
+        return false;
+    }
+    for (unsigned int i = 1; i < threadCount; i++)
+    {
+        NormInstance* shard = new NormInstance;
+        if (NULL == shard)
+        {
+            PLOG(PL_FATAL, "NormInstance::CreateShards() new shard error: %s\n", GetErrorString());
+            return false;
+        }
+        if (!shard->Startup(priorityBoost, this))
+        {
+            PLOG(PL_FATAL, "NormInstance::CreateShards() shard startup error\n");
+            delete shard;
+            return false;
+        }
+        shard_array[i - 1] = shard;
+        shard_count = i + 1;
+    }
+    return true;
+}  // end NormInstance::CreateShards()
+
+NormInstance* NormInstance::SelectShard()
+{
+    NormInstance* shard = this;
+    UINT32 minCount = NormAtomicLoad(&session_count);
+    for (unsigned int i = 1; i < shard_count; i++)
+    {
+        UINT32 count = NormAtomicLoad(&shard_array[i - 1]->session_count);
+        if (count < minCount)
+        {
+            shard = shard_array[i - 1];
+            minCount = count;
+        }
+    }
+    return shard;
+}  // end NormInstance::SelectShard()
+
+bool NormInstance::SuspendShards()
+{
+    for (unsigned int i = 0; i < shard_count; i++)
+    {
+        if (!GetShard(i)->dispatcher.SuspendThread())
+        {
+            while (i > 0) GetShard(--i)->dispatcher.ResumeThread();
+            return false;
+        }
+    }
+    return true;
+}  // end NormInstance::SuspendShards()
+
+void NormInstance::ResumeShards()
+{
+    for (unsigned int i = shard_count; i > 0; i--)
+        GetShard(i - 1)->dispatcher.ResumeThread();
+}  // end NormInstance::ResumeShards()
+
+void NormInstance::Stop()
+{
+    for (unsigned int i = 0; i < shard_count; i++)
+        GetShard(i)->dispatcher.Stop();
+    Notify(NormController::EVENT_INVALID, &session_mgr, NULL, NULL, NULL);
+}  // end NormInstance::Stop()
+
+bool NormInstance::Start()
+{
+    for (unsigned int i = 0; i < shard_count; i++)
+    {
+        if (!GetShard(i)->dispatcher.StartThread(priority_boost))
+        {
+            PLOG(PL_FATAL, "NormInstance::Start() error restarting NORM thread\n");
+            return false;
+        }
     }
-}  // end NormInstance::ReleasePreviousEvent()
+    return true;
+}  // end NormInstance::Start()
 
 NORM_API_LINKAGE
 void NormReleasePreviousEvent(NormInstanceHandle instanceHandle)
 {
     NormInstance* instance = (NormInstance*)instanceHandle;
-    if (instance && instance->dispatcher.SuspendThread())
-    {
-        instance->ReleasePreviousEvent();
-        instance->dispatcher.ResumeThread();
-    }
+    if (NULL != instance) instance->ReleasePreviousEvents();
 }  // end NormReleasePreviousEvent()
 
 
 void NormInstance::Shutdown()
 {
+    // Additional shards are shut down first since they use our descriptor
+    if (NULL != shard_array)
+    {
+        for (unsigned int i = 1; i < shard_count; i++)
+            delete shard_array[i - 1];
+        delete[] shard_array;
+        shard_array = NULL;
+    }
+    shard_count = 1;
+    shard_next = 0;
     dispatcher.Stop();
 #ifdef WIN32
-    if (NULL != notify_event)
-    {
+    if ((NULL != notify_event) && (NULL == primary))
         CloseHandle(notify_event);
-        notify_event = NULL;
-    }
+    notify_event = NULL;
 #else
-    if (notify_fd[0] >= 0)
+    if ((notify_fd[0] >= 0) && (NULL == primary))
     {
         close(notify_fd[0]);  // close read end of pipe
-        close(notify_fd[1]);  // close write end of pipe
-        notify_fd[0] = notify_fd[1] = -1;
+        if (notify_fd[1] != notify_fd[0])
+            close(notify_fd[1]);  // close write end of pipe
     }
+    notify_fd[0] = notify_fd[1] = -1;
 #endif // if/else WIN32/UNIX
+    if (ring_event.IsOpen()) ring_event.Close();
     if (rx_cache_path)
     {
         delete[] (char*)rx_cache_path;
         rx_cache_path = NULL;   
     }
     
-    // Garbage collect our "previous_notification"
-    if (NULL != previous_notification)
+    // Release handles of any events remaining in the ring
+    while (ring_clean != ring_write)
     {
-        // Release any previously-retained object or node handles
-        if (NORM_OBJECT_INVALID != previous_notification->event.object)
-            ((NormObject*)(previous_notification->event.object))->Release();
-        else if (NORM_NODE_INVALID != previous_notification->event.sender)
-            ((NormNode*)(previous_notification->event.sender))->Release();
-        notify_pool.Append(*previous_notification);   
-        previous_notification = NULL;   
+        EventSlot& slot = event_ring[ring_clean & (EVENT_RING_SIZE - 1)];
+        ring_clean++;
+        if (0 == slot.purged) ReleaseEventHandles(slot.event);
     }
+    ring_write = ring_read = ring_done = ring_armed = ring_clean = 0;
+    ring_clean_pending = 0;
     
     Notification* next;
     while (NULL != (next = notify_queue.RemoveHead()))
@@ -787,6 +1111,21 @@ NormInstanceHandle NormCreateInstance(bool priorityBoost)
     return NORM_INSTANCE_INVALID;  
 }  // end NormCreateInstance()
 
+NORM_API_LINKAGE
+NormInstanceHandle NormCreateShardedInstance(unsigned int threadCount, bool priorityBoost)
+{
+    NormInstance* normInstance = new NormInstance;
+    if (normInstance)
+    {
+        if (normInstance->Startup(priorityBoost) && 
+            normInstance->CreateShards(threadCount, priorityBoost))
+            return ((NormInstanceHandle)normInstance); 
+        else
+            delete normInstance;
+    }
+    return NORM_INSTANCE_INVALID;  
+}  // end NormCreateShardedInstance()
+
 NORM_API_LINKAGE
 void NormDestroyInstance(NormInstanceHandle instanceHandle)
 {
@@ -819,7 +1158,7 @@ bool NormSuspendInstance(NormInstanceHandle instanceHandle)
 {
     NormInstance* instance = (NormInstance*)instanceHandle;
     if (instance) 
-        return instance->dispatcher.SuspendThread();  // stops NORM protocol thread
+        return instance->SuspendShards();  // stops NORM protocol thread(s)
     else
         return false;
 }  // end NormSuspendInstance()
@@ -828,7 +1167,7 @@ NORM_API_LINKAGE
 void NormResumeInstance(NormInstanceHandle instanceHandle)
 {
     NormInstance* instance = (NormInstance*)instanceHandle;
-    if (instance) instance->dispatcher.ResumeThread();  
+    if (instance) instance->ResumeShards();  
 }  // end NormResumeInstance()
 
 
@@ -843,6 +1182,22 @@ bool NormSetCacheDirectory(NormInstanceHandle instanceHandle,
         return false;
 } // end NormSetCacheDirectory()
 
+NORM_API_LINKAGE
+bool NormSetFileIoThreads(NormSessionHandle sessionHandle,
+                          unsigned int      threadCount,
+                          unsigned int      readAhead)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (session) result = session->SetFileIoThreads(threadCount, readAhead);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormSetFileIoThreads()
+
 NORM_API_LINKAGE
 NormDescriptor NormGetDescriptor(NormInstanceHandle instanceHandle)
 {
@@ -869,36 +1224,45 @@ void NormSetAllocationFunctions(NormInstanceHandle      instanceHandle,
 
 NORM_API_LINKAGE
 bool NormGetNextEvent(NormInstanceHandle instanceHandle, NormEvent* theEvent, bool waitForEvent)
+{
+    NormEvent event;
+    if (NULL == theEvent) theEvent = &event;
+    if (0 != NormGetNextEvents(instanceHandle, theEvent, 1, waitForEvent)) return true;
+    theEvent->type = NORM_EVENT_INVALID;
+    theEvent->session = NORM_SESSION_INVALID;
+    theEvent->sender = NORM_NODE_INVALID;
+    theEvent->object = NORM_OBJECT_INVALID;
+    return false;
+}  // end NormGetNextEvent()
+
+// Events are retrieved from the NormInstance event ring without suspending the
+// NORM thread.  Handles in the returned events remain valid until the next call
+// to NormGetNextEvents() (or NormGetNextEvent() or NormReleasePreviousEvent())
+NORM_API_LINKAGE
+unsigned int NormGetNextEvents(NormInstanceHandle   instanceHandle, 
+                               NormEvent*           eventArray, 
+                               unsigned int         arraySize, 
+                               bool                 waitForEvent)
 {
     NormInstance* instance = (NormInstance*)instanceHandle;
-    bool result = false;
-    if (instance)
+    if ((NULL == instance) || (NULL == eventArray) || (0 == arraySize)) return 0;
+    while (true)
     {
-        if (instance->dispatcher.SuspendThread())
+        if (waitForEvent && instance->EventRingsAreEmpty())
         {
-            if (waitForEvent)
+            if (!instance->WaitForEvent())
             {
-                if (instance->NotifyQueueIsEmpty()) 
-                {
-                    // no pending events, so resume and wait
-                    instance->dispatcher.ResumeThread();
-                    if (!instance->WaitForEvent())
-                    {
-                        // Indication that NormInstance is dead
-			            // TBD - how do we inform app although this shouldn't
-			            // happen unless the app destroys the "instance"
-                        return false;
-                    }
-                    // re-suspend thread after wait
-                    if (!instance->dispatcher.SuspendThread()) return false;
-                }
+                // Indication that NormInstance is dead
+                // TBD - how do we inform app although this shouldn't
+                // happen unless the app destroys the "instance"
+                return 0;
             }
-            result = instance->GetNextEvent(theEvent);
-            instance->dispatcher.ResumeThread();
         }
+        unsigned int count = instance->GetNextEvents(eventArray, arraySize);
+        // (the ring may have held only purged events)
+        if ((0 != count) || !waitForEvent) return count;
     }
-    return result;  
-}  // end NormGetNextEvent()
+}  // end NormGetNextEvents()
 
 
 NORM_API_LINKAGE
@@ -921,10 +1285,13 @@ NormSessionHandle NormCreateSession(NormInstanceHandle instanceHandle,
 {
     // (TBD) wrap this with SuspendThread/ResumeThread ???
     NormInstance* instance = (NormInstance*)instanceHandle;
+    // (sharded instances place the session on their least-loaded shard)
+    if (NULL != instance) instance = instance->SelectShard();
     if (instance && instance->dispatcher.SuspendThread())
     {
         NormSession* session = 
             instance->session_mgr.NewSession(sessionAddr, sessionPort, localNodeId);
+        if (NULL != session) instance->IncrementSessionCount();
         instance->dispatcher.ResumeThread();
         if (NULL != session) 
             return ((NormSessionHandle)session);
@@ -944,6 +1311,7 @@ void NormDestroySession(NormSessionHandle sessionHandle)
             session->Close();
             session->GetSessionMgr().DeleteSession(session);
             instance->PurgeSessionNotifications(sessionHandle);
+            instance->DecrementSessionCount();
         }
         instance->dispatcher.ResumeThread();
     }
@@ -952,8 +1320,9 @@ void NormDestroySession(NormSessionHandle sessionHandle)
 NORM_API_LINKAGE 
 NormInstanceHandle NormGetInstance(NormSessionHandle sessionHandle)
 {
-    
-    return (NormInstanceHandle)NormInstance::GetInstanceFromSession(sessionHandle);
+    // (the primary instance of a sharded instance is the one the app knows)
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    return (NormInstanceHandle)((NULL != instance) ? instance->GetPrimary() : NULL);
 }  // end NormGetIntance()
 
 NORM_API_LINKAGE
@@ -1431,6 +1800,28 @@ void NormSetMessageTrace(NormSessionHandle sessionHandle, bool state)
     if (session) session->SetTrace(state);
 }  // end NormSetMessageTrace()
 
+NORM_API_LINKAGE
+bool NormSetMessageTraceFile(NormSessionHandle sessionHandle, const char* path)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (NULL == path)
+        {
+            session->CloseTraceFile();
+            result = true;
+        }
+        else
+        {
+            result = session->OpenTraceFile(path);
+        }
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormSetMessageTraceFile()
+
 NORM_API_LINKAGE
 void NormSetTxLoss(NormSessionHandle sessionHandle, double percent)
 {
@@ -1538,6 +1929,50 @@ double NormGetReportInterval(NormSessionHandle sessionHandle)
     return result;
 }  // end NormGetReportInterval()
 
+// Copies a NormStatsHistogram to the public NormHistogram (the NORM
+// thread may still be adding to it, so the fields are read individually)
+static void NormCopyHistogram(const NormStatsHistogram& hist, NormHistogram& result)
+{
+    ASSERT(NORM_HISTOGRAM_BINS == NormStatsHistogram::BIN_COUNT);
+    result.count = hist.GetCount();
+    result.sumUsec = hist.GetSum();
+    result.maxUsec = hist.GetMax();
+    for (unsigned int i = 0; i < NORM_HISTOGRAM_BINS; i++)
+        result.bins[i] = hist.GetBin(i);
+}  // end NormCopyHistogram()
+
+NORM_API_LINKAGE
+bool NormGetSessionStats(NormSessionHandle  sessionHandle,
+                         NormSessionStats*  stats)
+{
+    // Note the statistics are read lock-free so the
+    // NORM thread is _not_ suspended here
+    NormSession* session = (NormSession*)sessionHandle;
+    if ((NULL == session) || (NULL == stats)) return false;
+    stats->txPackets = session->TxPacketCount();
+    stats->txBytes = session->TxByteCount();
+    stats->txDropped = session->TxDropCount();
+    stats->rxPackets = session->RxPacketCount();
+    stats->rxBytes = session->RxByteCount();
+    stats->nacksReceived = session->SenderNackCount();
+    stats->nackItems = session->SenderNackItemCount();
+    stats->nackItemsCoalesced = session->SenderNackItemsCoalesced();
+    stats->parityCacheHits = session->SenderParityCacheHits();
+    stats->parityCacheMisses = session->SenderParityCacheMisses();
+    stats->bufferPeakSegments = session->SenderPeakBufferSegments();
+    stats->bufferOverruns = session->SenderBufferOverunCount();
+    stats->txRate = 8.0 * session->StatsTxRate();
+    stats->grtt = session->StatsGrtt();
+    stats->ccClrId = session->StatsClrId();
+    stats->ccClrRate = 8.0 * session->StatsClrRate();
+    stats->ccClrRtt = session->StatsClrRtt();
+    stats->ccClrLoss = session->StatsClrLoss();
+    stats->ccSlowStart = session->StatsSlowStart();
+    NormCopyHistogram(session->RepairDelayHistogram(), stats->repairDelay);
+    NormCopyHistogram(session->RecvIntervalHistogram(), stats->rxInterArrival);
+    return true;
+}  // end NormGetSessionStats()
+
 /** NORM Sender Functions */
 
 NORM_API_LINKAGE
@@ -1607,6 +2042,19 @@ void NormSetTxRate(NormSessionHandle sessionHandle,
     }
 }  // end NormSetTxRate()
 
+NORM_API_LINKAGE
+void NormSetTxPacingMode(NormSessionHandle sessionHandle,
+                         NormTxPacingMode  pacingMode)
+{
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (session) session->SetTxPacingMode((NormSession::TxPacingMode)pacingMode);
+        instance->dispatcher.ResumeThread();
+    }
+}  // end NormSetTxPacingMode()
+
 NORM_API_LINKAGE
 bool NormSetTxSocketBuffer(NormSessionHandle sessionHandle, 
                            unsigned int      bufferSize)
@@ -1623,6 +2071,22 @@ bool NormSetTxSocketBuffer(NormSessionHandle sessionHandle,
     return result;
 }  // end NormSetTxSocketBuffer()
 
+NORM_API_LINKAGE
+bool NormSetTxBatchSize(NormSessionHandle sessionHandle, 
+                        unsigned int      batchSize)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (session) 
+            result = session->SetTxBatchSize(batchSize);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormSetTxBatchSize()
+
 NORM_API_LINKAGE
 void NormSetFlowControl(NormSessionHandle sessionHandle, double flowControlFactor)
 {
@@ -1689,6 +2153,48 @@ void NormSetAutoParity(NormSessionHandle sessionHandle, unsigned char autoParity
     }
 }  // end NormSetAutoParity()
 
+NORM_API_LINKAGE
+bool NormSetBlockEncode(NormSessionHandle sessionHandle, bool state)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (session) result = session->SenderSetBlockEncode(state);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormSetBlockEncode()
+
+NORM_API_LINKAGE
+bool NormSetTxParityCache(NormSessionHandle sessionHandle, unsigned int blockCount)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (session) result = session->SenderSetParityCache(blockCount);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormSetTxParityCache()
+
+NORM_API_LINKAGE
+bool NormSetFecThreads(NormSessionHandle sessionHandle, unsigned int threadCount)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (session) result = session->SetFecThreads(threadCount);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormSetFecThreads()
+
 NORM_API_LINKAGE
 void NormSetGrttEstimate(NormSessionHandle sessionHandle,
                          double            grttEstimate)
@@ -1810,6 +2316,19 @@ void NormSetTxRobustFactor(NormSessionHandle sessionHandle,
     }
 }  // end NormSetTxRobustFactor()
 
+NORM_API_LINKAGE
+void NormSetFileMapping(NormSessionHandle sessionHandle,
+                        bool              state)
+{
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        session->SetFileMapping(state);
+        instance->dispatcher.ResumeThread();
+    }
+}  // end NormSetFileMapping()
+
 NORM_API_LINKAGE
 NormObjectHandle NormFileEnqueue(NormSessionHandle  sessionHandle,
                                  const char*        fileName,
@@ -1855,6 +2374,72 @@ NormObjectHandle NormDataEnqueue(NormSessionHandle  sessionHandle,
     return objectHandle;
 }  // end NormDataEnqueue()
 
+// Converts (part of) a NormIoVec array to a NormDataFragment list, skipping
+// the first "skip" bytes of iov[0].  The "fragBuffer" is used if it is large
+// enough and otherwise a list is allocated (that the caller must delete[])
+static NormDataFragment* NormMakeFragmentList(const NormIoVec*  iov,
+                                              unsigned int      iovCount,
+                                              unsigned int      skip,
+                                              NormDataFragment* fragBuffer,
+                                              unsigned int      bufferCount)
+{
+    NormDataFragment* fragList = fragBuffer;
+    if (iovCount > bufferCount)
+    {
+        if (NULL == (fragList = new NormDataFragment[iovCount]))
+        {
+            PLOG(PL_FATAL, "NormMakeFragmentList() new fragment list error: %s\n", GetErrorString());
+            return NULL;
+        }
+    }
+    for (unsigned int i = 0; i < iovCount; i++)
+    {
+        if (iov[i].iov_len > 0xffffffff)
+        {
+            PLOG(PL_FATAL, "NormMakeFragmentList() error: invalid buffer length\n");
+            if (fragList != fragBuffer) delete[] fragList;
+            return NULL;
+        }
+        fragList[i].data = (const char*)iov[i].iov_base;
+        fragList[i].length = (UINT32)iov[i].iov_len;
+    }
+    if (0 != iovCount)
+    {
+        fragList[0].data += skip;
+        fragList[0].length -= skip;
+    }
+    return fragList;
+}  // end NormMakeFragmentList()
+
+#define NORM_FRAG_BUFFER_COUNT 16
+
+NORM_API_LINKAGE
+NormObjectHandle NormDataEnqueueV(NormSessionHandle  sessionHandle,
+                                  const NormIoVec*   iov,
+                                  unsigned int       iovCount,
+                                  const char*        infoPtr, 
+                                  unsigned int       infoLen)
+{
+    NormDataFragment fragBuffer[NORM_FRAG_BUFFER_COUNT];
+    NormDataFragment* fragList = NormMakeFragmentList(iov, iovCount, 0, fragBuffer, NORM_FRAG_BUFFER_COUNT);
+    if (NULL == fragList) return NORM_OBJECT_INVALID;
+    NormObjectHandle objectHandle = NORM_OBJECT_INVALID;
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (session)
+        {
+            NormObject* obj = 
+                static_cast<NormObject*>(session->QueueTxData(fragList, iovCount, infoPtr, infoLen));
+            if (NULL != obj) objectHandle = (NormObjectHandle)obj;
+        }
+        instance->dispatcher.ResumeThread();
+    }
+    if (fragList != fragBuffer) delete[] fragList;
+    return objectHandle;
+}  // end NormDataEnqueueV()
+
 
 NORM_API_LINKAGE 
 bool NormRequeueObject(NormSessionHandle sessionHandle, NormObjectHandle objectHandle)
@@ -1941,17 +2526,83 @@ unsigned int NormStreamWrite(NormObjectHandle   streamHandle,
     //       protolib time scheduling, etc. code actually invokes SignalThread() on an
     //       as-needed basis.  Thus, using SuspendThread() (lighter weight) should suffice
     unsigned int result = 0;
+    NormStreamObject* stream = 
+        static_cast<NormStreamObject*>((NormObject*)streamHandle);
+    // (writes are refused while a NormStreamAcquireWriteBuffer() loan is outstanding)
+    if ((NULL == stream) || stream->HasWriteLoan()) return 0;
+    if (stream->IsStaged())
+    {
+        // Staged streams are written without suspending the NORM thread
+        // unless the staging buffer is full
+        result = stream->StageWrite(buffer, numBytes);
+        if (result == numBytes) return result;
+        buffer += result;
+        numBytes -= result;
+    }
     NormInstance* instance = NormInstance::GetInstanceFromObject(streamHandle);
     if ((NULL != instance) && instance->dispatcher.SuspendThread())
     {
-        NormStreamObject* stream = 
-            static_cast<NormStreamObject*>((NormObject*)streamHandle);
-        result = stream->Write(buffer, numBytes, false);
+        // (staged data must be written to the stream first)
+        if (!stream->IsStaged() || stream->StageDrain())
+            result += stream->Write(buffer, numBytes, false);
         instance->dispatcher.ResumeThread();
     }
     return result;
 }  // end NormStreamWrite()
 
+NORM_API_LINKAGE
+unsigned int NormStreamWriteV(NormObjectHandle streamHandle,
+                              const NormIoVec* iov,
+                              unsigned int     iovCount)
+{
+    unsigned int result = 0;
+    unsigned int skip = 0;  // bytes of iov[0] already staged
+    NormStreamObject* stream = 
+        static_cast<NormStreamObject*>((NormObject*)streamHandle);
+    if ((NULL == stream) || stream->HasWriteLoan()) return 0;
+    for (unsigned int i = 0; i < iovCount; i++)
+    {
+        // (as in NormMakeFragmentList(), checked before anything is staged)
+        if (iov[i].iov_len > 0xffffffff)
+        {
+            PLOG(PL_ERROR, "NormStreamWriteV() error: invalid buffer length\n");
+            return 0;
+        }
+    }
+    if (stream->IsStaged())
+    {
+        // Staged streams are written without suspending the NORM thread
+        // unless the staging buffer is full
+        while (0 != iovCount)
+        {
+            unsigned int len = (unsigned int)iov->iov_len;
+            unsigned int count = stream->StageWrite((const char*)iov->iov_base, len);
+            result += count;
+            if (count < len)
+            {
+                skip = count;
+                break;
+            }
+            iov++;
+            iovCount--;
+        }
+        if (0 == iovCount) return result;
+    }
+    NormDataFragment fragBuffer[NORM_FRAG_BUFFER_COUNT];
+    NormDataFragment* fragList = NormMakeFragmentList(iov, iovCount, skip, fragBuffer, NORM_FRAG_BUFFER_COUNT);
+    if (NULL == fragList) return result;
+    NormInstance* instance = NormInstance::GetInstanceFromObject(streamHandle);
+    if ((NULL != instance) && instance->dispatcher.SuspendThread())
+    {
+        // (staged data must be written to the stream first)
+        if (!stream->IsStaged() || stream->StageDrain())
+            result += stream->WriteV(fragList, iovCount, false);
+        instance->dispatcher.ResumeThread();
+    }
+    if (fragList != fragBuffer) delete[] fragList;
+    return result;
+}  // end NormStreamWriteV()
+
 NORM_API_LINKAGE
 void NormStreamFlush(NormObjectHandle streamHandle, 
                      bool             eom,
@@ -1962,6 +2613,17 @@ void NormStreamFlush(NormObjectHandle streamHandle,
     {
         NormStreamObject* stream = 
             static_cast<NormStreamObject*>((NormObject*)streamHandle);
+        if (stream->HasWriteLoan())
+        {
+            PLOG(PL_ERROR, "NormStreamFlush() error: write buffer is acquired\n");
+            instance->dispatcher.ResumeThread();
+            return;
+        }
+        if (stream->IsStaged() && !stream->StageDrain() && eom)
+        {
+            // Message end is marked after the data still staged
+            if (stream->StageMarkEom()) eom = false;
+        }
         NormStreamObject::FlushMode saveFlushMode = stream->GetFlushMode();
         stream->SetFlushMode((NormStreamObject::FlushMode)flushMode);
         stream->Flush(eom);
@@ -1980,6 +2642,21 @@ void NormStreamSetAutoFlush(NormObjectHandle    streamHandle,
         stream->SetFlushMode((NormStreamObject::FlushMode)flushMode);
 }  // end NormStreamSetAutoFlush()
 
+NORM_API_LINKAGE
+bool NormStreamEnableStaging(NormObjectHandle streamHandle, unsigned int bufferSize)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromObject(streamHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormObject* obj = (NormObject*)streamHandle;
+        if (obj->IsStream())
+            result = static_cast<NormStreamObject*>(obj)->EnableStaging(bufferSize);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormStreamEnableStaging()
+
 NORM_API_LINKAGE
 void NormStreamSetPushEnable(NormObjectHandle streamHandle, bool state)
 {
@@ -1997,7 +2674,7 @@ bool NormStreamHasVacancy(NormObjectHandle streamHandle)
     {
         NormStreamObject* stream = 
             static_cast<NormStreamObject*>((NormObject*)streamHandle);
-        if (NULL != stream)
+        if ((NULL != stream) && (!stream->IsStaged() || stream->StageDrain()))
             result = stream->HasVacancy();
         instance->dispatcher.ResumeThread();
     }
@@ -2013,7 +2690,7 @@ unsigned int NormStreamGetVacancy(NormObjectHandle streamHandle, unsigned int by
     {
         NormStreamObject* stream = 
             static_cast<NormStreamObject*>((NormObject*)streamHandle);
-        if (NULL != stream)
+        if ((NULL != stream) && (!stream->IsStaged() || stream->StageDrain()))
             result = stream->GetVacancy(bytesWanted);
         instance->dispatcher.ResumeThread();
     }
@@ -2023,15 +2700,61 @@ unsigned int NormStreamGetVacancy(NormObjectHandle streamHandle, unsigned int by
 NORM_API_LINKAGE
 void NormStreamMarkEom(NormObjectHandle streamHandle)
 {
+    NormStreamObject* stream = 
+        static_cast<NormStreamObject*>((NormObject*)streamHandle);
+    if ((NULL == stream) || stream->HasWriteLoan()) return;
+    if (stream->IsStaged() && stream->StageMarkEom()) 
+        return;
+    NormInstance* instance = NormInstance::GetInstanceFromObject(streamHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        if (stream->IsStaged() && !stream->StageDrain())
+        {
+            if (!stream->StageMarkEom())
+            {
+                PLOG(PL_WARN, "NormStreamMarkEom() warning: too many staged message ends\n");
+                stream->Write(NULL, 0, true);
+            }
+        }
+        else
+        {
+            stream->Write(NULL, 0, true);
+        }
+        instance->dispatcher.ResumeThread();
+    }
+}  // end NormStreamMarkEom()
+
+NORM_API_LINKAGE
+char* NormStreamAcquireWriteBuffer(NormObjectHandle streamHandle, unsigned int* bufferSize)
+{
+    char* buffer = NULL;
+    unsigned int size = 0;
     NormInstance* instance = NormInstance::GetInstanceFromObject(streamHandle);
     if (instance && instance->dispatcher.SuspendThread())
     {
         NormStreamObject* stream = 
             static_cast<NormStreamObject*>((NormObject*)streamHandle);
-        if (stream) stream->Write(NULL, 0, true);
+        buffer = stream->AcquireWriteBuffer(size);
         instance->dispatcher.ResumeThread();
     }
-}  // end NormStreamMarkEom()
+    if (NULL != bufferSize) *bufferSize = size;
+    return buffer;
+}  // end NormStreamAcquireWriteBuffer()
+
+NORM_API_LINKAGE
+unsigned int NormStreamCommitWrite(NormObjectHandle streamHandle, unsigned int numBytes)
+{
+    unsigned int result = 0;
+    NormInstance* instance = NormInstance::GetInstanceFromObject(streamHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormStreamObject* stream = 
+            static_cast<NormStreamObject*>((NormObject*)streamHandle);
+        result = stream->CommitWrite(numBytes);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormStreamCommitWrite()
 
 NORM_API_LINKAGE
 bool NormSetWatermark(NormSessionHandle  sessionHandle,
@@ -2409,6 +3132,38 @@ bool NormSetRxSocketBuffer(NormSessionHandle sessionHandle,
     return result;
 }  // end NormSetRxSocketBuffer()
 
+NORM_API_LINKAGE
+bool NormSetRxBatchSize(NormSessionHandle sessionHandle, 
+                        unsigned int      batchSize)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (session) 
+            result = session->SetRxBatchSize(batchSize);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormSetRxBatchSize()
+
+NORM_API_LINKAGE
+bool NormSetRxBusyPoll(NormSessionHandle sessionHandle, 
+                       unsigned int      usec)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromSession(sessionHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormSession* session = (NormSession*)sessionHandle;
+        if (session) 
+            result = session->SetRxBusyPoll(usec);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormSetRxBusyPoll()
+
 NORM_API_LINKAGE
 void NormSetSilentReceiver(NormSessionHandle sessionHandle,
                            bool              silent,
@@ -2559,12 +3314,22 @@ bool NormStreamRead(NormObjectHandle   streamHandle,
                     unsigned int*      numBytes)
 {
     bool result = false;
+    NormStreamObject* stream = 
+        static_cast<NormStreamObject*>((NormObject*)streamHandle);
+    // Staged streams are read without suspending the NORM thread while the
+    // application is in sync with the stream
+    if ((NULL != stream) && (NULL != numBytes) && stream->IsStaged() && 
+        stream->StageRead(buffer, numBytes, result))
+    {
+        return result;
+    }
     NormInstance* instance = NormInstance::GetInstanceFromObject(streamHandle);
     if (instance && instance->dispatcher.SuspendThread())
     {
-        NormStreamObject* stream = 
-            static_cast<NormStreamObject*>((NormObject*)streamHandle);
-        result = stream->Read(buffer, numBytes);
+        if (stream->IsStaged())
+            result = stream->StageSyncRead(buffer, numBytes, false);
+        else
+            result = stream->Read(buffer, numBytes);
         instance->dispatcher.ResumeThread();
     }
     return result;
@@ -2580,12 +3345,51 @@ bool NormStreamSeekMsgStart(NormObjectHandle streamHandle)
         NormStreamObject* stream = 
             static_cast<NormStreamObject*>((NormObject*)streamHandle);
         unsigned int numBytes = 0;
-        result = stream->Read(NULL, &numBytes, true);
+        if (stream->IsStaged())
+            result = stream->StageSyncRead(NULL, &numBytes, true);
+        else
+            result = stream->Read(NULL, &numBytes, true);
         instance->dispatcher.ResumeThread();
     }
     return result;
 }  // end NormStreamSeekMsgStart()
 
+NORM_API_LINKAGE
+bool NormStreamPeekRead(NormObjectHandle   streamHandle,
+                        const char**       bufferPtr,
+                        unsigned int*      numBytes)
+{
+    bool result = false;
+    const char* ptr = NULL;
+    unsigned int len = 0;
+    NormInstance* instance = NormInstance::GetInstanceFromObject(streamHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormStreamObject* stream = 
+            static_cast<NormStreamObject*>((NormObject*)streamHandle);
+        result = stream->PeekRead(ptr, len);
+        instance->dispatcher.ResumeThread();
+    }
+    if (NULL != bufferPtr) *bufferPtr = ptr;
+    if (NULL != numBytes) *numBytes = len;
+    return result;
+}  // end NormStreamPeekRead()
+
+NORM_API_LINKAGE
+bool NormStreamConsume(NormObjectHandle streamHandle, unsigned int numBytes)
+{
+    bool result = false;
+    NormInstance* instance = NormInstance::GetInstanceFromObject(streamHandle);
+    if (instance && instance->dispatcher.SuspendThread())
+    {
+        NormStreamObject* stream = 
+            static_cast<NormStreamObject*>((NormObject*)streamHandle);
+        result = stream->Consume(numBytes);
+        instance->dispatcher.ResumeThread();
+    }
+    return result;
+}  // end NormStreamConsume()
+
 
 NORM_API_LINKAGE
 UINT32 NormStreamGetReadOffset(NormObjectHandle streamHandle)
@@ -2908,6 +3712,32 @@ double NormNodeGetGrtt(NormNodeHandle nodeHandle)
     }
 }  // end NormNodeGetGrtt()
 
+NORM_API_LINKAGE
+bool NormNodeGetStats(NormNodeHandle nodeHandle, NormNodeStats* stats)
+{
+    // (lock-free, see NormGetSessionStats())
+    NormNode* node = (NormNode*)nodeHandle;
+    if ((NULL == node) || (NormNode::SENDER != node->GetType()) || (NULL == stats))
+        return false;
+    NormSenderNode* sender = static_cast<NormSenderNode*>(node);
+    stats->rxPackets = sender->RecvPacketCount();
+    stats->rxBytes = sender->RecvByteCount();
+    stats->rxGoodputBytes = sender->RecvGoodputCount();
+    stats->nacksSent = sender->NackCount();
+    stats->nacksSuppressed = sender->SuppressCount();
+    stats->resyncs = sender->ResyncCount();
+    stats->objectsCompleted = sender->CompletionCount();
+    stats->objectsFailed = sender->FailureCount();
+    stats->bufferPeakSegments = sender->PeakBufferSegments();
+    stats->bufferOverruns = sender->BufferOverunCount();
+    stats->rxRate = 8.0 * sender->StatsRecvRate();
+    stats->grtt = sender->StatsGrtt();
+    stats->lossEstimate = sender->StatsLoss();
+    NormCopyHistogram(sender->RecvIntervalHistogram(), stats->rxInterArrival);
+    NormCopyHistogram(sender->DecodeTimeHistogram(), stats->decodeTime);
+    return true;
+}  // end NormNodeGetStats()
+
 NORM_API_LINKAGE
 bool NormNodeGetCommand(NormNodeHandle nodeHandle,
                         char*          cmdBuffer,
@@ -208,6 +208,7 @@ class NormApp : public NormController, public ProtoApp
         
         // Debug parameters
         bool                tracing;
+        char*               trace_path;     // binary message trace file
         double              tx_loss;
         double              rx_loss;
     
@@ -247,7 +248,7 @@ NormApp::NormApp()
    acking_flushes(false), watermark_pending(false), rx_buffer_size(1024*1024), rx_sock_buffer_size(0),
    rx_cache_path(NULL), post_processor(NULL), unicast_nacks(false), silent_receiver(false), 
    low_delay(false), realtime(false), rx_robust_factor(NormSession::DEFAULT_ROBUST_FACTOR), rx_persistent(true), process_aborted_files(false),
-   preallocate_sender(false), repair_boundary(NormSenderNode::BLOCK_BOUNDARY), tracing(false), tx_loss(0.0), rx_loss(0.0)
+   preallocate_sender(false), repair_boundary(NormSenderNode::BLOCK_BOUNDARY), tracing(false), trace_path(NULL), tx_loss(0.0), rx_loss(0.0)
 {
     control_pipe.SetListener(this, &NormApp::OnControlEvent);
     control_pipe.SetNotifier(&GetSocketNotifier());
@@ -272,6 +273,7 @@ NormApp::~NormApp()
     notify_pool.Destroy();
     if (address) delete[] address;
     if (interface_name) delete[] interface_name;
+    if (trace_path) delete[] trace_path;
     
     tx_file_cache.Destroy();
     
@@ -322,6 +324,7 @@ const char* const NormApp::cmd_list[] =
     "+debug",        // debug level
     "+log",          // log file name
     "+trace",        // message tracing on
+    "+btrace",       // binary message trace file name
     "+txloss",       // tx packet loss percent (for testing)
     "+rxloss",       // rx packet loss percent (for testing)
     "+address",      // session destination address/port
@@ -396,6 +399,7 @@ void NormApp::ShowHelp()
         "   +debug,        // debug level\n"
         "   +log,          // log file name\n"
         "   +trace,        // message tracing on\n"
+        "   +btrace,       // binary message trace file name (see normTraceDecode)\n"
         "   +txloss,       // tx packet loss percent (for testing)\n"
         "   +rxloss,       // rx packet loss percent (for testing)\n"
         "   +address,      // session destination address\n"
@@ -570,6 +574,22 @@ bool NormApp::OnCommand(const char* cmd, const char* val)
         }
         if (session) session->SetTrace(tracing);
     }
+    else if (!strncmp("btrace", cmd, len))
+    {
+        if (trace_path) delete[] trace_path;
+        if (!(trace_path = new char[strlen(val)+1]))
+        {
+            PLOG(PL_FATAL, "NormApp::OnCommand(btrace) error allocating string: %s\n",
+                GetErrorString());
+            return false;
+        }
+        strcpy(trace_path, val);
+        if (session && !session->OpenTraceFile(trace_path))
+        {
+            PLOG(PL_FATAL, "NormApp::OnCommand(btrace) error opening trace file\n");
+            return false;
+        }
+    }
     else if (!strncmp("precise", cmd, len))
     {
         precise = true;  // NormApp::dispatcher will run in "precision" mode
@@ -2307,6 +2327,8 @@ bool NormApp::OnStartup(int argc, const char*const* argv)
         session->SetTxRate(tx_rate);
         session->SetTxRateBounds(tx_rate_min, tx_rate_max);
         session->SetTrace(tracing);
+        if ((NULL != trace_path) && !session->OpenTraceFile(trace_path))
+            PLOG(PL_ERROR, "NormApp::OnStartup() error: unable to open trace file \"%s\"\n", trace_path);
         session->SetTxLoss(tx_loss);
         session->SetRxLoss(rx_loss);
         session->SetTTL(ttl);
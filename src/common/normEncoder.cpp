@@ -52,3 +52,152 @@ NormEncoder::~NormEncoder()
 NormDecoder::~NormDecoder()
 {
 }
+
+NormDecoderMatrixCache::NormDecoderMatrixCache()
+ : entry_list(NULL), entry_max(0), row_size(0), 
+   head(NULL), tail(NULL), hit_count(0), miss_count(0)
+{
+}
+
+NormDecoderMatrixCache::~NormDecoderMatrixCache()
+{
+    Destroy();
+}
+
+bool NormDecoderMatrixCache::Init(unsigned int entryMax, unsigned int rowSize)
+{
+    Destroy();
+    // Limit worst case row storage to SPACE_MAX bytes
+    unsigned int spaceMax = ERASURE_MAX * rowSize;
+    if ((0 != spaceMax) && ((SPACE_MAX / spaceMax) < entryMax))
+        entryMax = SPACE_MAX / spaceMax;
+    if (0 == entryMax) return true;  // caching disabled
+    if (NULL == (entry_list = new Entry[entryMax]))
+    {
+        PLOG(PL_FATAL, "NormDecoderMatrixCache::Init() new entry_list error: %s\n", GetErrorString());
+        return false;
+    }
+    // Link the (initially unused) entries into the LRU list
+    for (unsigned int i = 0; i < entryMax; i++)
+    {
+        Entry* entry = entry_list + i;
+        entry->prev = (0 == i) ? NULL : (entry - 1);
+        entry->next = ((entryMax - 1) == i) ? NULL : (entry + 1);
+        entry->erasure_count = 0;
+        entry->rows = NULL;
+        entry->rows_max = 0;
+    }
+    head = entry_list;
+    tail = entry_list + entryMax - 1;
+    entry_max = entryMax;
+    row_size = rowSize;
+    hit_count = miss_count = 0;
+    return true;
+}  // end NormDecoderMatrixCache::Init()
+
+void NormDecoderMatrixCache::Destroy()
+{
+    if (NULL != entry_list)
+    {
+        for (unsigned int i = 0; i < entry_max; i++)
+        {
+            if (NULL != entry_list[i].rows)
+                delete[] entry_list[i].rows;
+        }
+        delete[] entry_list;
+        entry_list = NULL;
+    }
+    entry_max = 0;
+    head = tail = NULL;
+}  // end NormDecoderMatrixCache::Destroy()
+
+UINT32 NormDecoderMatrixCache::Hash(unsigned int numData, unsigned int erasureCount,
+                                    const unsigned int* erasureLocs, const unsigned int* parityLocs)
+{
+    // FNV-1a style hash over the erasure pattern
+    UINT32 hash = 2166136261U;
+    hash = (hash ^ numData) * 16777619U;
+    for (unsigned int i = 0; i < erasureCount; i++)
+    {
+        hash = (hash ^ erasureLocs[i]) * 16777619U;
+        hash = (hash ^ parityLocs[i]) * 16777619U;
+    }
+    return hash;
+}  // end NormDecoderMatrixCache::Hash()
+
+void NormDecoderMatrixCache::MoveToHead(Entry* entry)
+{
+    if (entry == head) return;
+    // Unlink ...
+    entry->prev->next = entry->next;
+    if (NULL != entry->next)
+        entry->next->prev = entry->prev;
+    else
+        tail = entry->prev;
+    // ... and prepend
+    entry->prev = NULL;
+    entry->next = head;
+    head->prev = entry;
+    head = entry;
+}  // end NormDecoderMatrixCache::MoveToHead()
+
+const char* NormDecoderMatrixCache::Find(unsigned int        numData, 
+                                         unsigned int        erasureCount, 
+                                         const unsigned int* erasureLocs, 
+                                         const unsigned int* parityLocs)
+{
+    if (NULL == entry_list) return NULL;
+    if (erasureCount > ERASURE_MAX)
+    {
+        miss_count++;  // not cacheable
+        return NULL;
+    }
+    UINT32 hash = Hash(numData, erasureCount, erasureLocs, parityLocs);
+    // Unused entries are always at the tail end of the list
+    for (Entry* entry = head; (NULL != entry) && (0 != entry->erasure_count); entry = entry->next)
+    {
+        if ((hash != entry->hash) || (numData != entry->num_data) || 
+            (erasureCount != entry->erasure_count))
+        {
+            continue;
+        }
+        if ((0 != memcmp(entry->locs, erasureLocs, erasureCount*sizeof(unsigned int))) ||
+            (0 != memcmp(entry->locs + erasureCount, parityLocs, erasureCount*sizeof(unsigned int))))
+        {
+            continue;
+        }
+        MoveToHead(entry);
+        hit_count++;
+        return entry->rows;
+    }
+    miss_count++;
+    return NULL;
+}  // end NormDecoderMatrixCache::Find()
+
+char* NormDecoderMatrixCache::Insert(unsigned int        numData, 
+                                     unsigned int        erasureCount, 
+                                     const unsigned int* erasureLocs, 
+                                     const unsigned int* parityLocs)
+{
+    if ((NULL == entry_list) || (0 == erasureCount) || (erasureCount > ERASURE_MAX)) return NULL;
+    Entry* entry = tail;  // recycle least recently used entry
+    if (entry->rows_max < erasureCount)
+    {
+        if (NULL != entry->rows) delete[] entry->rows;
+        entry->rows_max = 0;
+        entry->erasure_count = 0;
+        if (NULL == (entry->rows = new char[erasureCount * row_size]))
+        {
+            PLOG(PL_ERROR, "NormDecoderMatrixCache::Insert() new rows error: %s\n", GetErrorString());
+            return NULL;
+        }
+        entry->rows_max = erasureCount;
+    }
+    entry->hash = Hash(numData, erasureCount, erasureLocs, parityLocs);
+    entry->num_data = numData;
+    entry->erasure_count = erasureCount;
+    memcpy(entry->locs, erasureLocs, erasureCount*sizeof(unsigned int));
+    memcpy(entry->locs + erasureCount, parityLocs, erasureCount*sizeof(unsigned int));
+    MoveToHead(entry);
+    return entry->rows;
+}  // end NormDecoderMatrixCache::Insert()
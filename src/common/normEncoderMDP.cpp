@@ -177,26 +177,49 @@ bool NormEncoderMDP::CreateGeneratorPolynomial()
 // MUST be called w/ "data" vectors in-order by segmentId (caller's responsibility)
 void NormEncoderMDP::Encode(unsigned int /*segmentId*/, const char* data, char** pVec)
 {
-    int i, j;
+    ASSERT(NULL != scratch);  // Make sure it's been init'd first    
+    // Assumes parity vectors are zero-filled at block start !!! 
+    EncodeRange(data, pVec, 0, vector_size);
+}  // end NormEncoderMDP::Encode()
+
+// Since each vector byte position is encoded independently, the block is
+// processed in tiles of "tileSize" bytes, running all of the source vectors
+// (in order) through the shift register for one tile before the next
+void NormEncoderMDP::EncodeBlock(const char** dataVectorList, char** pVec, unsigned int numData)
+{
+    ASSERT(NULL != scratch);
+    unsigned int tileSize = BLOCK_TILE_SPACE / npar;
+    tileSize &= ~63;
+    if (0 == tileSize) tileSize = 64;
+    for (unsigned int offset = 0; offset < vector_size; offset += tileSize)
+    {
+        unsigned int len = vector_size - offset;
+        if (len > tileSize) len = tileSize;
+        for (unsigned int i = 0; i < npar; i++)
+            memset(pVec[i] + offset, 0, len);
+        for (unsigned int j = 0; j < numData; j++)
+            EncodeRange(dataVectorList[j], pVec, offset, len);
+    }
+}  // end NormEncoderMDP::EncodeBlock()
+
+void NormEncoderMDP::EncodeRange(const char* data, char** pVec, unsigned int offset, unsigned int len)
+{
+    int i;
+    unsigned int j;
     unsigned char *userData, *LSFR1, *LSFR2, *pVec0;
     int npar_minus_one = npar - 1;
     unsigned char* genPoly = &gen_poly[npar_minus_one];
-    ASSERT(NULL != scratch);  // Make sure it's been init'd first    
-    // Assumes parity vectors are zero-filled at block start !!! 
     // Copy pVec[0] for use in calculations 
-    
-    UINT16 vecSize = vector_size;
-    
-    memcpy(scratch, pVec[0], vecSize);
+    memcpy(scratch, pVec[0] + offset, len);
     if (npar > 1)
     {
 	    for(i = 0; i < npar_minus_one; i++)
 	    {
 	        pVec0 = scratch;
-	        userData = (unsigned char*) data;
-	        LSFR1 = (unsigned char*) pVec[i];
-	        LSFR2 = (unsigned char*) pVec[i+1];
-	        for(j = 0; j < vecSize; j++)
+	        userData = (unsigned char*)data + offset;
+	        LSFR1 = (unsigned char*)pVec[i] + offset;
+	        LSFR2 = (unsigned char*)pVec[i+1] + offset;
+	        for(j = 0; j < len; j++)
 		        *LSFR1++ = *LSFR2++ ^
 			        gmult(*genPoly, (*userData++ ^ *pVec0++));
             genPoly--;
@@ -204,11 +227,11 @@ void NormEncoderMDP::Encode(unsigned int /*segmentId*/, const char* data, char**
         
     }    
     pVec0 = scratch;
-    userData = (unsigned char*) data;
-    LSFR1 = (unsigned char*) pVec[npar_minus_one];
-    for(j = 0; j < vecSize; j++)
+    userData = (unsigned char*)data + offset;
+    LSFR1 = (unsigned char*)pVec[npar_minus_one] + offset;
+    for(j = 0; j < len; j++)
     	*LSFR1++ = gmult(*genPoly, (*userData++ ^ *pVec0++));
-}  // end NormEncoderMDP::Encode()
+}  // end NormEncoderMDP::EncodeRange()
 
 
 /********************************************************************************
@@ -481,11 +481,44 @@ void NormEncoderRS16::Encode(unsigned int segmentId, const char* dataVector, cha
     }
 }  // end NormEncoderRS16::Encode()
 
+void NormEncoderRS16::EncodeBlock(const char** dataVectorList, char** parityVectorList, unsigned int numData)
+{
+    // The parity vectors are computed in "tiles" of up to "rowsMax" parity rows
+    // by "colsMax" vector elements so each tile (BLOCK_TILE_SPACE bytes) stays
+    // cache resident while all of the source vectors are accumulated into it.
+    // (Keeping the rows long makes for efficient addmul() kernel use)
+    unsigned int nelements = (GF_BITS > 8) ? vector_size / 2 : vector_size;
+    unsigned int colsMax = BLOCK_TILE_SPACE / sizeof(gf);
+    if (colsMax > nelements) colsMax = nelements;
+    unsigned int rowsMax = (BLOCK_TILE_SPACE / sizeof(gf)) / colsMax;
+    for (unsigned int row = 0; row < npar; row += rowsMax)
+    {
+        unsigned int rowEnd = row + rowsMax;
+        if (rowEnd > npar) rowEnd = npar;
+        for (unsigned int offset = 0; offset < nelements; offset += colsMax)
+        {
+            unsigned int len = nelements - offset;
+            if (len > colsMax) len = colsMax;
+            for (unsigned int i = row; i < rowEnd; i++)
+                memset(((gf*)parityVectorList[i]) + offset, 0, len*sizeof(gf));
+            for (unsigned int j = 0; j < numData; j++)
+            {
+                gf* src = ((gf*)dataVectorList[j]) + offset;
+                for (unsigned int i = row; i < rowEnd; i++)
+                {
+                    gf* p = ((gf*)enc_matrix) + ((i+ndata)*ndata);
+                    addmul(((gf*)parityVectorList[i]) + offset, src, p[j], len);
+                }
+            }
+        }
+    }
+}  // end NormEncoderRS16::EncodeBlock()
+
 
 NormDecoderRS16::NormDecoderRS16()
  : enc_matrix(NULL), dec_matrix(NULL), 
    parity_loc(NULL), inv_ndxc(NULL), inv_ndxr(NULL), 
-   inv_pivt(NULL), inv_id_row(NULL), inv_temp_row(NULL)
+   inv_pivt(NULL), inv_id_row(NULL), inv_temp_row(NULL), fast_count(0)
 {
 }
 
@@ -536,6 +569,7 @@ void NormDecoderRS16::Destroy()
         delete[] inv_temp_row;
         inv_temp_row = NULL;
     }
+    matrix_cache.Destroy();
 }  // end NormDecoderRS16::Destroy()
 
 bool NormDecoderRS16::Init(unsigned int numData, unsigned int numParity, UINT16 vecSizeMax)
@@ -611,6 +645,14 @@ bool NormDecoderRS16::Init(unsigned int numData, unsigned int numParity, UINT16
         return false;
     }
     
+    if (!matrix_cache.Init(NormDecoderMatrixCache::ENTRY_MAX_DEFAULT, k*sizeof(gf)))
+    {
+        PLOG(PL_FATAL, "NormDecoderRS16::Init() error: matrix_cache init failure\n");
+        Destroy();
+        return false;
+    }
+    fast_count = 0;
+    
     gf* tmpMatrix = NEW_GF_MATRIX(n, k);
     if (NULL == tmpMatrix)
     {
@@ -650,104 +692,101 @@ bool NormDecoderRS16::Init(unsigned int numData, unsigned int numParity, UINT16
 int NormDecoderRS16::Decode(char** vectorList, unsigned int numData,  unsigned int erasureCount, unsigned int* erasureLocs)
 {
     unsigned int bsz = ndata + npar;
-    // 1) Build decoding matrix for the given set of segments & erasures
-    unsigned int nextErasure = 0;
-    unsigned int ne = 0;
+    // 1) Determine source erasures and which parity segments to use in their place
+    //    (erasureLocs[] is in ascending order, so source erasures come first)
     unsigned int sourceErasureCount = 0;
+    while ((sourceErasureCount < erasureCount) && (erasureLocs[sourceErasureCount] < numData))
+        sourceErasureCount++;
+    if (0 == sourceErasureCount) return erasureCount;  // only parity segments missing
+    unsigned int nextErasure = sourceErasureCount;
     unsigned int parityCount = 0;
-    for (unsigned int i = 0;  i < bsz; i++)
-    {   
-        if (i < numData)
+    for (unsigned int i = numData; (i < bsz) && (parityCount < sourceErasureCount); i++)
+    {
+        if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
         {
-            if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
-            {
-                nextErasure++;
-                sourceErasureCount++;
-            }     
-            else
-            {
-                // set identity row for segments we have
-                gf* p = ((gf*)dec_matrix) + ndata*i;
-                memset(p, 0, ndata*sizeof(gf));
-                p[i] = 1;
-            }
+            nextErasure++;
         }
-        else if (i < ndata)
+        else
         {
-            // set identity row for assumed zero segments (shortened code)
-            gf* p = ((gf*)dec_matrix) + ndata*i;
-            memset(p, 0, ndata*sizeof(gf));
-            p[i] = 1;      
-            // Also keep track of where the non-erased parity segment are
-            // for the shortened code
-            if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
-            {
-                nextErasure++;
-            }
-            else if (parityCount < sourceErasureCount)
-            {
-                parity_loc[parityCount++] = i;
-                // Copy appropriate enc_matric parity row to dec_matrix erasureRow
-                gf* p = ((gf*)dec_matrix) + ndata*erasureLocs[ne++];  
-                memcpy(p, ((gf*)enc_matrix) + (ndata-numData+i)*ndata, ndata*sizeof(gf)); 
-            }
-                
+            ASSERT(parityCount < npar);
+            parity_loc[parityCount++] = i;
         }
-        else if (parityCount < sourceErasureCount)
+    }
+    ASSERT(parityCount == sourceErasureCount);
+    
+    // 2) Get decoding matrix rows for the erased source segments. A single erasure
+    //    is solved directly from its parity row (no inversion needed).  Otherwise,
+    //    a previously inverted matrix for the same erasure pattern is used if cached.
+    const gf* cachedRows = NULL;
+    if (1 == sourceErasureCount)
+    {
+        const gf* a = ((gf*)enc_matrix) + (ndata-numData+parity_loc[0])*ndata;
+        unsigned int row = erasureLocs[0];
+        if (0 == a[row])
         {
-            if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
+            PLOG(PL_FATAL, "NormDecoderRS16::Decode() error: singular parity row ?!\n");
+            return 0;
+        }
+        gf c = inverse[a[row]];
+        gf* p = ((gf*)dec_matrix) + ndata*row;
+        for (unsigned int col = 0; col < numData; col++)
+            p[col] = gf_mul(a[col], c);
+        p[row] = c;
+        fast_count++;
+    }
+    else if (NULL == (cachedRows = (const gf*)matrix_cache.Find(numData, sourceErasureCount, erasureLocs, parity_loc)))
+    {
+        unsigned int ne = 0;
+        for (unsigned int i = 0;  i < ndata; i++)
+        {   
+            gf* p = ((gf*)dec_matrix) + ndata*i;
+            if ((ne < sourceErasureCount) && (i == erasureLocs[ne]))
             {
-                nextErasure++;
+                // Copy appropriate enc_matrix parity row to dec_matrix erasure row
+                memcpy(p, ((gf*)enc_matrix) + (ndata-numData+parity_loc[ne])*ndata, ndata*sizeof(gf)); 
+                ne++;
             }
             else
             {
-                ASSERT(parityCount < npar);
-                parity_loc[parityCount++] = i;
-                // Copy appropriate enc_matric parity row to dec_matrix erasureRow
-                gf* p = ((gf*)dec_matrix) + ndata*erasureLocs[ne++];  
-                memcpy(p, ((gf*)enc_matrix) + (ndata-numData+i)*ndata, ndata*sizeof(gf)); 
+                // set identity row for segments we have (or assumed zero segments of shortened code)
+                memset(p, 0, ndata*sizeof(gf));
+                p[i] = 1;
             }
         }
-        else
+        // Invert the decoding matrix
+        if (!InvertDecodingMatrix()) 
         {
-            break;
+	        PLOG(PL_FATAL, "NormDecoderRS16::Decode() error: couldn't invert dec_matrix (numData:%d erasureCount:%d) ?!\n", numData, erasureCount);
+            return 0;
+        }
+        // Cache the rows needed for this erasure pattern
+        gf* rows = (gf*)matrix_cache.Insert(numData, sourceErasureCount, erasureLocs, parity_loc);
+        if (NULL != rows)
+        {
+            for (unsigned int e = 0; e < sourceErasureCount; e++)
+                memcpy(rows + e*ndata, ((gf*)dec_matrix) + erasureLocs[e]*ndata, ndata*sizeof(gf));
         }
-        
-    }
-    ASSERT(ne == sourceErasureCount);
-    // 2) Invert the decoding matrix
-    if (!InvertDecodingMatrix()) 
-    {
-	    PLOG(PL_FATAL, "NormDecoderRS16::Decode() error: couldn't invert dec_matrix (numData:%d erasureCount:%d) ?!\n", numData, erasureCount);
-        return 0;
     }
     
     // 3) Decode
-    for (unsigned int e = 0; e < erasureCount; e++)
+    unsigned int nelements = (GF_BITS > 8) ? vector_size/2 : vector_size;
+    for (unsigned int e = 0; e < sourceErasureCount; e++)
     {
-        // Calculate missing segments (erasures) using dec_matrix and non-erasures
+        // Calculate missing segments (erasures) using decoding matrix rows and non-erasures
         unsigned int row = erasureLocs[e];
-        if (row >= numData) break; // don't bother filling in parity segments
-        unsigned int col = 0;
+        const gf* coeff = (NULL != cachedRows) ? (cachedRows + e*ndata) : (((gf*)dec_matrix) + row*ndata);
         unsigned int nextErasure = 0;
-        unsigned int nelements = (GF_BITS > 8) ? vector_size/2 : vector_size;
         for (unsigned int i  = 0; i < numData; i++)
         {
-            if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
+            if ((nextErasure < sourceErasureCount) && (i == erasureLocs[nextErasure]))
             {
                 // Use parity segments in place of erased vector in decoding
-                addmul((gf*)vectorList[row], (gf*)vectorList[parity_loc[nextErasure]], ((gf*)dec_matrix)[row*ndata + col], nelements);
-                col++;
+                addmul((gf*)vectorList[row], (gf*)vectorList[parity_loc[nextErasure]], coeff[i], nelements);
                 nextErasure++;  // point to next erasure
             }
-            else if (i < numData)
-            {
-                addmul((gf*)vectorList[row], (gf*)vectorList[i], ((gf*)dec_matrix)[row*ndata + col], nelements);
-                col++;
-            }
             else
             {
-                ASSERT(0);
+                addmul((gf*)vectorList[row], (gf*)vectorList[i], coeff[i], nelements);
             }
         }
     } 
@@ -256,7 +256,7 @@ static void generate_gf()
  * Note that gcc on
  */
 #define addmul(dst, src, c, sz) \
-    if (c != 0) addmul1(dst, src, c, sz)
+    if (c != 0) addmul_kernel(dst, src, c, sz)
 #define UNROLL 16 /* 1, 4, 8, 16 */
 
 static void addmul1(gf* dst1, gf* src1, gf c, int sz)
@@ -298,6 +298,258 @@ static void addmul1(gf* dst1, gf* src1, gf c, int sz)
 	    GF_ADDMULC( *dst , *src );
 }  // end addmul1()
 
+/*
+ * SIMD addmul() kernels (x86/x86_64 w/ gcc or clang)
+ *
+ * The SSSE3, AVX2 and AVX-512 kernels use the "split nibble" method:
+ * for a given constant c, c*x = c*(x & 0x0f) ^ c*(x & 0xf0), so two
+ * 16-entry lookup tables (loaded into vector registers) and a byte
+ * shuffle (PSHUFB) compute the product for 16/32/64 bytes at a time.
+ * The GFNI kernel instead applies the 8x8 bit matrix for multiplication
+ * by c (for _our_ field polynomial, not the 0x11b AES polynomial that
+ * GF2P8MULB assumes) with GF2P8AFFINEQB.  The per-constant tables are
+ * built once in init_fec().  Each kernel finishes its tail bytes using
+ * its own instruction set (mixing legacy SSE and VEX encoded code is
+ * costly) and the plain table lookup, so results are bit-exact with
+ * the scalar addmul1() above.  The kernel is selected at init_fec()
+ * time based on CPUID.
+ */
+typedef void (*AddmulKernel)(gf* dst, gf* src, gf c, int sz);
+static AddmulKernel addmul_kernel = addmul1;
+static NormEncoderRS8::SimdMode simd_mode = NormEncoderRS8::SIMD_NONE;
+static unsigned int simd_supported = (1 << NormEncoderRS8::SIMD_NONE);  // bit mask of supported modes
+
+#if (GF_BITS == 8) && !defined(NORM_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NORM_RS8_SIMD
+#include <immintrin.h>
+#include <cpuid.h>
+
+// gf_nibble_table[c] holds c*x for x = 0x00..0x0f followed by c*x for x = 0x00..0xf0 
+static UINT8 gf_nibble_table[GF_SIZE + 1][32] __attribute__((aligned(32)));
+// gf_affine_table[c] is the GF2P8AFFINEQB bit matrix for multiplication by c
+static long long gf_affine_table[GF_SIZE + 1];
+
+static void init_simd_tables()
+{
+    for (int c = 0; c <= GF_SIZE; c++)
+    {
+        for (int x = 0; x < 16; x++)
+        {
+            gf_nibble_table[c][x] = gf_mul(c, x);
+            gf_nibble_table[c][16 + x] = gf_mul(c, x << 4);
+        }
+        // Output bit "i" of each byte is the parity of (matrix byte (7-i) & input),
+        // so bit "j" of matrix byte (7-i) is bit "i" of c * (1 << j)
+        UINT64 matrix = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            UINT64 row = 0;
+            for (int j = 0; j < 8; j++)
+            {
+                if (0 != (gf_mul(c, 1 << j) & (1 << i)))
+                    row |= (UINT64)(1 << j);
+            }
+            matrix |= row << (8 * (7 - i));
+        }
+        gf_affine_table[c] = (long long)matrix;
+    }
+}  // end init_simd_tables()
+
+// Scalar finish for SIMD kernel tails (no function call, no SSE)
+#define ADDMUL_TAIL(dst, src, c, i, sz) \
+    {gf* __row_ = gf_mul_table[c]; for (; i < sz; i++) dst[i] ^= __row_[src[i]];}
+
+__attribute__((target("ssse3")))
+static void addmul_ssse3(gf* dst, gf* src, gf c, int sz)
+{
+    const __m128i tlo = _mm_load_si128((const __m128i*)gf_nibble_table[c]);
+    const __m128i thi = _mm_load_si128((const __m128i*)(gf_nibble_table[c] + 16));
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    int i = 0;
+    for (; i <= (sz - 16); i += 16)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i pl = _mm_shuffle_epi8(tlo, _mm_and_si128(x, mask));
+        __m128i ph = _mm_shuffle_epi8(thi, _mm_and_si128(_mm_srli_epi64(x, 4), mask));
+        d = _mm_xor_si128(d, _mm_xor_si128(pl, ph));
+        _mm_storeu_si128((__m128i*)(dst + i), d);
+    }
+    ADDMUL_TAIL(dst, src, c, i, sz);
+}  // end addmul_ssse3()
+
+__attribute__((target("avx2")))
+static void addmul_avx2(gf* dst, gf* src, gf c, int sz)
+{
+    const __m256i tlo = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)gf_nibble_table[c]));
+    const __m256i thi = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)(gf_nibble_table[c] + 16)));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    int i = 0;
+    for (; i <= (sz - 64); i += 64)
+    {
+        // Two vectors per iteration to hide the shuffle latency
+        __m256i x0 = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i x1 = _mm256_loadu_si256((const __m256i*)(src + i + 32));
+        __m256i d0 = _mm256_loadu_si256((const __m256i*)(dst + i));
+        __m256i d1 = _mm256_loadu_si256((const __m256i*)(dst + i + 32));
+        __m256i p0 = _mm256_xor_si256(_mm256_shuffle_epi8(tlo, _mm256_and_si256(x0, mask)),
+                                      _mm256_shuffle_epi8(thi, _mm256_and_si256(_mm256_srli_epi64(x0, 4), mask)));
+        __m256i p1 = _mm256_xor_si256(_mm256_shuffle_epi8(tlo, _mm256_and_si256(x1, mask)),
+                                      _mm256_shuffle_epi8(thi, _mm256_and_si256(_mm256_srli_epi64(x1, 4), mask)));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(d0, p0));
+        _mm256_storeu_si256((__m256i*)(dst + i + 32), _mm256_xor_si256(d1, p1));
+    }
+    for (; i <= (sz - 32); i += 32)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+        __m256i p = _mm256_xor_si256(_mm256_shuffle_epi8(tlo, _mm256_and_si256(x, mask)),
+                                     _mm256_shuffle_epi8(thi, _mm256_and_si256(_mm256_srli_epi64(x, 4), mask)));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(d, p));
+    }
+    if (i <= (sz - 16))
+    {
+        // (VEX encoded here given the "avx2" target)
+        __m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i m = _mm256_castsi256_si128(mask);
+        __m128i p = _mm_xor_si128(_mm_shuffle_epi8(_mm256_castsi256_si128(tlo), _mm_and_si128(x, m)),
+                                  _mm_shuffle_epi8(_mm256_castsi256_si128(thi), _mm_and_si128(_mm_srli_epi64(x, 4), m)));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(d, p));
+        i += 16;
+    }
+    ADDMUL_TAIL(dst, src, c, i, sz);
+}  // end addmul_avx2()
+
+// (some gcc versions falsely warn about _mm512_undefined_epi32() usage in avx512fintrin.h)
+#if !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif // !__clang__
+__attribute__((target("avx512f,avx512bw")))
+static void addmul_avx512(gf* dst, gf* src, gf c, int sz)
+{
+    const __m512i tlo = _mm512_broadcast_i32x4(_mm_load_si128((const __m128i*)gf_nibble_table[c]));
+    const __m512i thi = _mm512_broadcast_i32x4(_mm_load_si128((const __m128i*)(gf_nibble_table[c] + 16)));
+    const __m512i mask = _mm512_set1_epi8(0x0f);
+    int i = 0;
+    for (; i <= (sz - 64); i += 64)
+    {
+        __m512i x = _mm512_loadu_si512((const void*)(src + i));
+        __m512i d = _mm512_loadu_si512((const void*)(dst + i));
+        __m512i p = _mm512_xor_si512(_mm512_shuffle_epi8(tlo, _mm512_and_si512(x, mask)),
+                                     _mm512_shuffle_epi8(thi, _mm512_and_si512(_mm512_srli_epi64(x, 4), mask)));
+        _mm512_storeu_si512((void*)(dst + i), _mm512_xor_si512(d, p));
+    }
+    if (i < sz)
+    {
+        // Masked load/store for the final (< 64) bytes
+        __mmask64 tail = (__mmask64)(~0ULL) >> (64 - (sz - i));
+        __m512i x = _mm512_maskz_loadu_epi8(tail, (const void*)(src + i));
+        __m512i d = _mm512_maskz_loadu_epi8(tail, (const void*)(dst + i));
+        __m512i p = _mm512_xor_si512(_mm512_shuffle_epi8(tlo, _mm512_and_si512(x, mask)),
+                                     _mm512_shuffle_epi8(thi, _mm512_and_si512(_mm512_srli_epi64(x, 4), mask)));
+        _mm512_mask_storeu_epi8((void*)(dst + i), tail, _mm512_xor_si512(d, p));
+    }
+}  // end addmul_avx512()
+#if !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif // !__clang__
+
+__attribute__((target("gfni,avx2")))
+static void addmul_gfni(gf* dst, gf* src, gf c, int sz)
+{
+    const __m256i matrix = _mm256_set1_epi64x(gf_affine_table[c]);
+    int i = 0;
+    for (; i <= (sz - 64); i += 64)
+    {
+        __m256i x0 = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i x1 = _mm256_loadu_si256((const __m256i*)(src + i + 32));
+        __m256i d0 = _mm256_loadu_si256((const __m256i*)(dst + i));
+        __m256i d1 = _mm256_loadu_si256((const __m256i*)(dst + i + 32));
+        d0 = _mm256_xor_si256(d0, _mm256_gf2p8affine_epi64_epi8(x0, matrix, 0));
+        d1 = _mm256_xor_si256(d1, _mm256_gf2p8affine_epi64_epi8(x1, matrix, 0));
+        _mm256_storeu_si256((__m256i*)(dst + i), d0);
+        _mm256_storeu_si256((__m256i*)(dst + i + 32), d1);
+    }
+    for (; i <= (sz - 32); i += 32)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(d, _mm256_gf2p8affine_epi64_epi8(x, matrix, 0)));
+    }
+    if (i <= (sz - 16))
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i p = _mm_gf2p8affine_epi64_epi8(x, _mm256_castsi256_si128(matrix), 0);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(d, p));
+        i += 16;
+    }
+    ADDMUL_TAIL(dst, src, c, i, sz);
+}  // end addmul_gfni()
+
+// Returns bit mask of kernels this CPU (and OS) supports
+static unsigned int detect_simd()
+{
+    unsigned int mask = (1 << NormEncoderRS8::SIMD_NONE);
+    unsigned int eax, ebx, ecx, edx;
+    if (0 == __get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return mask;
+    bool ssse3 = (0 != (ecx & bit_SSSE3));
+    // AVX-class kernels need OS support for saving YMM (and ZMM) state
+    bool ymmState = false;
+    bool zmmState = false;
+    if ((0 != (ecx & bit_OSXSAVE)) && (0 != (ecx & bit_AVX)))
+    {
+        unsigned int xcr0lo, xcr0hi;
+        __asm__ __volatile__ ("xgetbv" : "=a"(xcr0lo), "=d"(xcr0hi) : "c"(0));
+        ymmState = (0x06 == (xcr0lo & 0x06));
+        zmmState = ymmState && (0xe0 == (xcr0lo & 0xe0));
+    }
+    bool avx2 = false, avx512 = false, gfni = false;
+    if (ymmState && (0 != __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)))
+    {
+        avx2 = (0 != (ebx & bit_AVX2));
+        avx512 = zmmState && (0 != (ebx & bit_AVX512F)) && (0 != (ebx & bit_AVX512BW));
+        gfni = avx2 && (0 != (ecx & (1 << 8)));  // CPUID.7.0:ECX.GFNI[bit 8]
+    }
+    // (the wider kernels hand their tails to the narrower ones)
+    if (ssse3)
+    {
+        mask |= (1 << NormEncoderRS8::SIMD_SSSE3);
+        if (avx2)
+        {
+            mask |= (1 << NormEncoderRS8::SIMD_AVX2);
+            if (avx512) mask |= (1 << NormEncoderRS8::SIMD_AVX512);
+            if (gfni) mask |= (1 << NormEncoderRS8::SIMD_GFNI);
+        }
+    }
+    return mask;
+}  // end detect_simd()
+
+#endif // NORM_RS8_SIMD
+
+static AddmulKernel get_addmul_kernel(NormEncoderRS8::SimdMode mode)
+{
+    switch (mode)
+    {
+#ifdef NORM_RS8_SIMD
+        case NormEncoderRS8::SIMD_SSSE3:
+            return addmul_ssse3;
+        case NormEncoderRS8::SIMD_AVX2:
+            return addmul_avx2;
+        case NormEncoderRS8::SIMD_AVX512:
+            return addmul_avx512;
+        case NormEncoderRS8::SIMD_GFNI:
+            return addmul_gfni;
+#endif // NORM_RS8_SIMD
+        default:
+            return addmul1;
+    }
+}  // end get_addmul_kernel()
+
 
 // computes C = AB where A is n*k, B is k*m, C is n*m
 static void matmul(gf* a, gf* b, gf* c, int n, int k, int m)
@@ -383,10 +635,74 @@ static void init_fec()
     {
         generate_gf();
         init_mul_table();
+#ifdef NORM_RS8_SIMD
+        simd_supported = detect_simd();
+        if (simd_supported != (1 << NormEncoderRS8::SIMD_NONE))
+            init_simd_tables();
+#endif // NORM_RS8_SIMD
+        // Pick the preferred supported kernel
+        const NormEncoderRS8::SimdMode preference[] = 
+            {NormEncoderRS8::SIMD_GFNI, NormEncoderRS8::SIMD_AVX512,
+             NormEncoderRS8::SIMD_AVX2, NormEncoderRS8::SIMD_SSSE3};
+        simd_mode = NormEncoderRS8::SIMD_NONE;
+        for (unsigned int i = 0; i < sizeof(preference)/sizeof(preference[0]); i++)
+        {
+            if (0 != (simd_supported & (1 << preference[i])))
+            {
+                simd_mode = preference[i];
+                break;
+            }
+        }
+        addmul_kernel = get_addmul_kernel(simd_mode);
         fec_initialized = true;
     }
 }
 
+NormEncoderRS8::SimdMode NormEncoderRS8::GetSimdMode()
+{
+    init_fec();
+    return simd_mode;
+}  // end NormEncoderRS8::GetSimdMode()
+
+bool NormEncoderRS8::SimdModeIsSupported(SimdMode mode)
+{
+    init_fec();
+    return ((mode >= SIMD_NONE) && (mode <= SIMD_GFNI) &&
+            (0 != (simd_supported & (1 << mode))));
+}  // end NormEncoderRS8::SimdModeIsSupported()
+
+bool NormEncoderRS8::SetSimdMode(SimdMode mode)
+{
+    if (!SimdModeIsSupported(mode))
+    {
+        PLOG(PL_ERROR, "NormEncoderRS8::SetSimdMode() error: %s kernel not supported by this CPU\n",
+                       GetSimdModeName(mode));
+        return false;
+    }
+    simd_mode = mode;
+    addmul_kernel = get_addmul_kernel(mode);
+    return true;
+}  // end NormEncoderRS8::SetSimdMode()
+
+const char* NormEncoderRS8::GetSimdModeName(SimdMode mode)
+{
+    switch (mode)
+    {
+        case SIMD_NONE:
+            return "scalar";
+        case SIMD_SSSE3:
+            return "ssse3";
+        case SIMD_AVX2:
+            return "avx2";
+        case SIMD_AVX512:
+            return "avx512";
+        case SIMD_GFNI:
+            return "gfni";
+        default:
+            return "unknown";
+    }
+}  // end NormEncoderRS8::GetSimdModeName()
+
 NormEncoderRS8::NormEncoderRS8()
  : enc_matrix(NULL)
 {
@@ -482,11 +798,44 @@ void NormEncoderRS8::Encode(unsigned int segmentId, const char* dataVector, char
     }
 }  // end NormEncoderRS8::Encode()
 
+void NormEncoderRS8::EncodeBlock(const char** dataVectorList, char** parityVectorList, unsigned int numData)
+{
+    // The parity vectors are computed in "tiles" of up to "rowsMax" parity rows
+    // by "colsMax" vector elements so each tile (BLOCK_TILE_SPACE bytes) stays
+    // cache resident while all of the source vectors are accumulated into it.
+    // (Keeping the rows long makes for efficient addmul() kernel use)
+    unsigned int nelements = (GF_BITS > 8) ? vector_size / 2 : vector_size;
+    unsigned int colsMax = BLOCK_TILE_SPACE / sizeof(gf);
+    if (colsMax > nelements) colsMax = nelements;
+    unsigned int rowsMax = (BLOCK_TILE_SPACE / sizeof(gf)) / colsMax;
+    for (unsigned int row = 0; row < npar; row += rowsMax)
+    {
+        unsigned int rowEnd = row + rowsMax;
+        if (rowEnd > npar) rowEnd = npar;
+        for (unsigned int offset = 0; offset < nelements; offset += colsMax)
+        {
+            unsigned int len = nelements - offset;
+            if (len > colsMax) len = colsMax;
+            for (unsigned int i = row; i < rowEnd; i++)
+                memset(((gf*)parityVectorList[i]) + offset, 0, len*sizeof(gf));
+            for (unsigned int j = 0; j < numData; j++)
+            {
+                gf* src = ((gf*)dataVectorList[j]) + offset;
+                for (unsigned int i = row; i < rowEnd; i++)
+                {
+                    gf* p = ((gf*)enc_matrix) + ((i+ndata)*ndata);
+                    addmul(((gf*)parityVectorList[i]) + offset, src, p[j], len);
+                }
+            }
+        }
+    }
+}  // end NormEncoderRS8::EncodeBlock()
+
 
 NormDecoderRS8::NormDecoderRS8()
  : enc_matrix(NULL), dec_matrix(NULL), 
    parity_loc(NULL), inv_ndxc(NULL), inv_ndxr(NULL), 
-   inv_pivt(NULL), inv_id_row(NULL), inv_temp_row(NULL)
+   inv_pivt(NULL), inv_id_row(NULL), inv_temp_row(NULL), fast_count(0)
 {
 }
 
@@ -537,6 +886,7 @@ void NormDecoderRS8::Destroy()
         delete[] inv_temp_row;
         inv_temp_row = NULL;
     }
+    matrix_cache.Destroy();
 }  // end NormDecoderRS8::Destroy()
 
 bool NormDecoderRS8::Init(unsigned int numData, unsigned int numParity, UINT16 vecSizeMax)
@@ -612,6 +962,14 @@ bool NormDecoderRS8::Init(unsigned int numData, unsigned int numParity, UINT16 v
         return false;
     }
     
+    if (!matrix_cache.Init(NormDecoderMatrixCache::ENTRY_MAX_DEFAULT, k*sizeof(gf)))
+    {
+        PLOG(PL_FATAL, "NormDecoderRS8::Init() error: matrix_cache init failure\n");
+        Destroy();
+        return false;
+    }
+    fast_count = 0;
+    
     
     gf* tmpMatrix = NEW_GF_MATRIX(n, k);
     if (NULL == tmpMatrix)
@@ -652,104 +1010,101 @@ bool NormDecoderRS8::Init(unsigned int numData, unsigned int numParity, UINT16 v
 int NormDecoderRS8::Decode(char** vectorList, unsigned int numData,  unsigned int erasureCount, unsigned int* erasureLocs)
 {
     unsigned int bsz = ndata + npar;
-    // 1) Build decoding matrix for the given set of segments & erasures
-    unsigned int nextErasure = 0;
-    unsigned int ne = 0;
+    // 1) Determine source erasures and which parity segments to use in their place
+    //    (erasureLocs[] is in ascending order, so source erasures come first)
     unsigned int sourceErasureCount = 0;
+    while ((sourceErasureCount < erasureCount) && (erasureLocs[sourceErasureCount] < numData))
+        sourceErasureCount++;
+    if (0 == sourceErasureCount) return erasureCount;  // only parity segments missing
+    unsigned int nextErasure = sourceErasureCount;
     unsigned int parityCount = 0;
-    for (unsigned int i = 0;  i < bsz; i++)
-    {   
-        if (i < numData)
+    for (unsigned int i = numData; (i < bsz) && (parityCount < sourceErasureCount); i++)
+    {
+        if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
         {
-            if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
-            {
-                nextErasure++;
-                sourceErasureCount++;
-            }     
-            else
-            {
-                // set identity row for segments we have
-                gf* p = ((gf*)dec_matrix) + ndata*i;
-                memset(p, 0, ndata*sizeof(gf));
-                p[i] = 1;
-            }
+            nextErasure++;
         }
-        else if (i < ndata)
+        else
         {
-            // set identity row for assumed zero segments (shortened code)
-            gf* p = ((gf*)dec_matrix) + ndata*i;
-            memset(p, 0, ndata*sizeof(gf));
-            p[i] = 1;      
-            // Also keep track of where the non-erased parity segment are
-            // for the shortened code
-            if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
-            {
-                nextErasure++;
-            }
-            else if (parityCount < sourceErasureCount)
-            {
-                parity_loc[parityCount++] = i;
-                // Copy appropriate enc_matric parity row to dec_matrix erasureRow
-                gf* p = ((gf*)dec_matrix) + ndata*erasureLocs[ne++];  
-                memcpy(p, ((gf*)enc_matrix) + (ndata-numData+i)*ndata, ndata*sizeof(gf)); 
-            }
-                
+            ASSERT(parityCount < npar);
+            parity_loc[parityCount++] = i;
         }
-        else if (parityCount < sourceErasureCount)
+    }
+    ASSERT(parityCount == sourceErasureCount);
+    
+    // 2) Get decoding matrix rows for the erased source segments. A single erasure
+    //    is solved directly from its parity row (no inversion needed).  Otherwise,
+    //    a previously inverted matrix for the same erasure pattern is used if cached.
+    const gf* cachedRows = NULL;
+    if (1 == sourceErasureCount)
+    {
+        const gf* a = ((gf*)enc_matrix) + (ndata-numData+parity_loc[0])*ndata;
+        unsigned int row = erasureLocs[0];
+        if (0 == a[row])
         {
-            if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
+            PLOG(PL_FATAL, "NormDecoderRS8::Decode() error: singular parity row ?!\n");
+            return 0;
+        }
+        gf c = inverse[a[row]];
+        gf* p = ((gf*)dec_matrix) + ndata*row;
+        for (unsigned int col = 0; col < numData; col++)
+            p[col] = gf_mul(a[col], c);
+        p[row] = c;
+        fast_count++;
+    }
+    else if (NULL == (cachedRows = (const gf*)matrix_cache.Find(numData, sourceErasureCount, erasureLocs, parity_loc)))
+    {
+        unsigned int ne = 0;
+        for (unsigned int i = 0;  i < ndata; i++)
+        {   
+            gf* p = ((gf*)dec_matrix) + ndata*i;
+            if ((ne < sourceErasureCount) && (i == erasureLocs[ne]))
             {
-                nextErasure++;
+                // Copy appropriate enc_matrix parity row to dec_matrix erasure row
+                memcpy(p, ((gf*)enc_matrix) + (ndata-numData+parity_loc[ne])*ndata, ndata*sizeof(gf)); 
+                ne++;
             }
             else
             {
-                ASSERT(parityCount < npar);
-                parity_loc[parityCount++] = i;
-                // Copy appropriate enc_matric parity row to dec_matrix erasureRow
-                gf* p = ((gf*)dec_matrix) + ndata*erasureLocs[ne++];  
-                memcpy(p, ((gf*)enc_matrix) + (ndata-numData+i)*ndata, ndata*sizeof(gf)); 
+                // set identity row for segments we have (or assumed zero segments of shortened code)
+                memset(p, 0, ndata*sizeof(gf));
+                p[i] = 1;
             }
         }
-        else
+        // Invert the decoding matrix
+        if (!InvertDecodingMatrix()) 
         {
-            break;
+	        PLOG(PL_FATAL, "NormDecoderRS8::Decode() error: couldn't invert dec_matrix ?!\n");
+            return 0;
+        }
+        // Cache the rows needed for this erasure pattern
+        gf* rows = (gf*)matrix_cache.Insert(numData, sourceErasureCount, erasureLocs, parity_loc);
+        if (NULL != rows)
+        {
+            for (unsigned int e = 0; e < sourceErasureCount; e++)
+                memcpy(rows + e*ndata, ((gf*)dec_matrix) + erasureLocs[e]*ndata, ndata*sizeof(gf));
         }
-        
-    }
-    ASSERT(ne == sourceErasureCount);
-    // 2) Invert the decoding matrix
-    if (!InvertDecodingMatrix()) 
-    {
-	    PLOG(PL_FATAL, "NormDecoderRS8::Decode() error: couldn't invert dec_matrix ?!\n");
-        return 0;
     }
     
     // 3) Decode
-    for (unsigned int e = 0; e < erasureCount; e++)
+    unsigned int nelements = (GF_BITS > 8) ? vector_size/2 : vector_size;
+    for (unsigned int e = 0; e < sourceErasureCount; e++)
     {
-        // Calculate missing segments (erasures) using dec_matrix and non-erasures
+        // Calculate missing segments (erasures) using decoding matrix rows and non-erasures
         unsigned int row = erasureLocs[e];
-        if (row >= numData) break; // don't bother filling in parity segments
-        unsigned int col = 0;
+        const gf* coeff = (NULL != cachedRows) ? (cachedRows + e*ndata) : (((gf*)dec_matrix) + row*ndata);
         unsigned int nextErasure = 0;
-        unsigned int nelements = (GF_BITS > 8) ? vector_size/2 : vector_size;
         for (unsigned int i  = 0; i < numData; i++)
         {
-            if ((nextErasure < erasureCount) && (i == erasureLocs[nextErasure]))
+            if ((nextErasure < sourceErasureCount) && (i == erasureLocs[nextErasure]))
             {
                 // Use parity segments in place of erased vector in decoding
-                addmul((gf*)vectorList[row], (gf*)vectorList[parity_loc[nextErasure]], ((gf*)dec_matrix)[row*ndata + col], nelements);
-                col++;
+                addmul((gf*)vectorList[row], (gf*)vectorList[parity_loc[nextErasure]], coeff[i], nelements);
                 nextErasure++;  // point to next erasure
             }
-            else if (i < numData)
-            {
-                addmul((gf*)vectorList[row], (gf*)vectorList[i], ((gf*)dec_matrix)[row*ndata + col], nelements);
-                col++;
-            }
             else
             {
-                ASSERT(0);
+                addmul((gf*)vectorList[row], (gf*)vectorList[i], coeff[i], nelements);
             }
         }
     } 
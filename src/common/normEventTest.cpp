@@ -0,0 +1,154 @@
+// This code tests purging of NormInstance event ring notifications
+// (via NormObjectCancel()) while another application thread is
+// concurrently draining events with NormGetNextEvents().  Handles
+// of delivered events must stay valid until the next NormGetNextEvents()
+// call, so the drain thread touches every object handle it is given.
+// (Best run under valgrind or built with -fsanitize=address)
+
+#include "normApi.h"
+
+#include <stdio.h>
+#include <string.h>  // for memset()
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>  // for usleep()
+#endif // if/else WIN32
+
+const unsigned int OBJECT_COUNT = 20000;
+const unsigned int OBJECT_SIZE  = 1024;
+
+static char tx_buffer[OBJECT_SIZE];
+static volatile bool drain_done = false;
+static volatile unsigned long event_count = 0;
+static volatile unsigned long bad_count = 0;
+
+static void DrainEvents(NormInstanceHandle instance)
+{
+    NormEvent eventArray[16];
+    while (!drain_done)
+    {
+        unsigned int count = NormGetNextEvents(instance, eventArray, 16, false);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            event_count++;
+            NormObjectHandle object = eventArray[i].object;
+            if (NORM_OBJECT_INVALID == object) continue;
+            // (a released handle would be caught here by valgrind/ASAN)
+            if ((NORM_OBJECT_DATA != NormObjectGetType(object)) ||
+                (OBJECT_SIZE != NormObjectGetSize(object)))
+            {
+                bad_count++;
+            }
+        }
+    }
+}  // end DrainEvents()
+
+#ifdef WIN32
+static DWORD WINAPI DoDrainEvents(LPVOID param)
+{
+    DrainEvents((NormInstanceHandle)param);
+    return 0;
+}
+#else
+static void* DoDrainEvents(void* param)
+{
+    DrainEvents((NormInstanceHandle)param);
+    return NULL;
+}
+#endif // if/else WIN32
+
+static void SleepBriefly()
+{
+#ifdef WIN32
+    Sleep(1);
+#else
+    usleep(1000);
+#endif // if/else WIN32
+}
+
+int main(int argc, char* argv[])
+{
+    memset(tx_buffer, 'a', OBJECT_SIZE);
+
+    NormInstanceHandle instance = NormCreateInstance();
+    if (NORM_INSTANCE_INVALID == instance)
+    {
+        fprintf(stderr, "normEventTest: NormCreateInstance() error\n");
+        return -1;
+    }
+    NormSessionHandle session = NormCreateSession(instance, "127.0.0.1", 6003, 1);
+    if (NORM_SESSION_INVALID == session)
+    {
+        fprintf(stderr, "normEventTest: NormCreateSession() error\n");
+        NormDestroyInstance(instance);
+        return -1;
+    }
+    NormSetTxRate(session, 1.0e+09);
+    if (!NormStartSender(session, 1, 4*1024*1024, 1024, 16, 0))
+    {
+        fprintf(stderr, "normEventTest: NormStartSender() error\n");
+        NormDestroyInstance(instance);
+        return -1;
+    }
+
+#ifdef WIN32
+    HANDLE drainThread = CreateThread(NULL, 0, DoDrainEvents, (LPVOID)instance, 0, NULL);
+    if (NULL == drainThread)
+#else
+    pthread_t drainThread;
+    if (0 != pthread_create(&drainThread, NULL, DoDrainEvents, (void*)instance))
+#endif // if/else WIN32
+    {
+        fprintf(stderr, "normEventTest: error creating drain thread\n");
+        NormDestroyInstance(instance);
+        return -1;
+    }
+
+    // Enqueue objects and cancel every other one (purging its notifications)
+    // while the drain thread is retrieving their events
+    unsigned int enqueueCount = 0;
+    unsigned int cancelCount = 0;
+    NormObjectHandle prevObject = NORM_OBJECT_INVALID;
+    while (enqueueCount < OBJECT_COUNT)
+    {
+        NormObjectHandle object = NormDataEnqueue(session, tx_buffer, OBJECT_SIZE);
+        if (NORM_OBJECT_INVALID == object)
+        {
+            SleepBriefly();  // tx cache is full
+            continue;
+        }
+        enqueueCount++;
+        if (NORM_OBJECT_INVALID != prevObject)
+        {
+            NormObjectCancel(prevObject);
+            cancelCount++;
+            prevObject = NORM_OBJECT_INVALID;
+        }
+        else
+        {
+            prevObject = object;
+        }
+    }
+
+    drain_done = true;
+#ifdef WIN32
+    WaitForSingleObject(drainThread, INFINITE);
+    CloseHandle(drainThread);
+#else
+    pthread_join(drainThread, NULL);
+#endif // if/else WIN32
+    NormDestroyInstance(instance);
+
+    fprintf(stderr, "normEventTest: enqueued %u objects, cancelled %u, drained %lu events\n",
+                    enqueueCount, cancelCount, event_count);
+    if (0 != bad_count)
+    {
+        fprintf(stderr, "normEventTest: FAILED (%lu bad object handles)\n", bad_count);
+        return -1;
+    }
+    fprintf(stderr, "normEventTest: PASSED\n");
+    return 0;
+}  // end main()
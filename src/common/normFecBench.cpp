@@ -0,0 +1,527 @@
+// This program benchmarks the NORM FEC encoder/decoder implementations
+// (RS8, RS16, and MDP) over a sweep of block parameters and erasure
+// patterns, reporting throughput (GB/s) and cycles per byte.  Results
+// are printed as CSV lines that can be saved ("output <file>") and
+// compared with a later run ("baseline <file>") to catch regressions.
+//
+// Usage: normFecBench [codec {rs8|rs16|mdp|all}][ndata <n>[,<n>...]]
+//                     [nparity <n>[,<n>...]][segsize <n>[,<n>...]]
+//                     [pattern {random|burst|worst|all}][time <sec>]
+//                     [ghz <cpuGHz>][seed <value>][output <file>]
+//                     [baseline <file>][tolerance <percent>]
+//
+// Erasure patterns (decode):
+//   random - 1 to "nparity" erasures at random block (data+parity) locations
+//   burst  - "nparity" consecutive erasures starting at a random location
+//   worst  - "nparity" erasures, all source segments, with a new pattern
+//            for every block (i.e., no decoder matrix cache reuse)
+
+#include "protoTime.h"  // for ProtoTime
+
+#include "normEncoderRS8.h"
+#include "normEncoderRS16.h"
+#include "normEncoderMDP.h"
+
+#include <string.h> // for memcpy(), etc
+#include <stdlib.h> // for rand(), atoi(), etc
+#include <stdio.h>
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>  // for __rdtsc()
+#define NORM_BENCH_TSC 1
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>     // for __rdtsc()
+#define NORM_BENCH_TSC 1
+#endif
+
+enum {LIST_MAX = 16};
+
+enum CodecType {CODEC_RS8, CODEC_RS16, CODEC_MDP, CODEC_COUNT};
+static const char* const CODEC_NAME[CODEC_COUNT] = {"rs8", "rs16", "mdp"};
+
+enum PatternType {PATTERN_RANDOM, PATTERN_BURST, PATTERN_WORST, PATTERN_COUNT};
+static const char* const PATTERN_NAME[PATTERN_COUNT] = {"random", "burst", "worst"};
+
+class BenchResult
+{
+    public:
+        double  encode_rate;  // GB/s, incremental NormEncoder::Encode()
+        double  block_rate;   // GB/s, NormEncoder::EncodeBlock()
+        double  decode_rate;  // GB/s, NormDecoder::Decode()
+        bool    verified;
+};
+
+static void Usage()
+{
+    fprintf(stderr, "Usage: normFecBench [codec {rs8|rs16|mdp|all}][ndata <n>[,<n>...]]\n"
+                    "                    [nparity <n>[,<n>...]][segsize <n>[,<n>...]]\n"
+                    "                    [pattern {random|burst|worst|all}][time <sec>]\n"
+                    "                    [ghz <cpuGHz>][seed <value>][output <file>]\n"
+                    "                    [baseline <file>][tolerance <percent>]\n");
+}  // end Usage()
+
+// Parses a comma-separated list of positive integers
+static unsigned int ParseList(const char* text, unsigned int* list)
+{
+    unsigned int count = 0;
+    while ((NULL != text) && (count < LIST_MAX))
+    {
+        int value = atoi(text);
+        if (value <= 0) return 0;
+        list[count++] = (unsigned int)value;
+        text = strchr(text, ',');
+        if (NULL != text) text++;
+    }
+    return count;
+}  // end ParseList()
+
+static double GetCyclesPerSecond(double ghz)
+{
+    if (ghz > 0.0) return (1.0e+09 * ghz);
+#ifdef NORM_BENCH_TSC
+    // Calibrate the time stamp counter against the system clock
+    ProtoTime startTime, currentTime;
+    startTime.GetCurrentTime();
+    unsigned long long startCycles = __rdtsc();
+    double elapsed;
+    do
+    {
+        currentTime.GetCurrentTime();
+        elapsed = ProtoTime::Delta(currentTime, startTime);
+    } while (elapsed < 0.1);
+    return ((double)(__rdtsc() - startCycles) / elapsed);
+#else
+    return 0.0;  // unknown (cycles per byte not reported)
+#endif // if/else NORM_BENCH_TSC
+}  // end GetCyclesPerSecond()
+
+static NormEncoder* CreateEncoder(CodecType codec)
+{
+    switch (codec)
+    {
+        case CODEC_RS8:
+            return new NormEncoderRS8();
+        case CODEC_RS16:
+            return new NormEncoderRS16();
+        default:
+            return new NormEncoderMDP();
+    }
+}  // end CreateEncoder()
+
+static NormDecoder* CreateDecoder(CodecType codec)
+{
+    switch (codec)
+    {
+        case CODEC_RS8:
+            return new NormDecoderRS8();
+        case CODEC_RS16:
+            return new NormDecoderRS16();
+        default:
+            return new NormDecoderMDP();
+    }
+}  // end CreateDecoder()
+
+// Fills "erasureLocs" (sorted) per the pattern type and returns the erasure count
+static unsigned int MakeErasures(PatternType    pattern,
+                                 unsigned int   numData,
+                                 unsigned int   numParity,
+                                 unsigned int*  erasureLocs)
+{
+    unsigned int blockSize = numData + numParity;
+    unsigned int erasureCount;
+    switch (pattern)
+    {
+        case PATTERN_BURST:
+        {
+            erasureCount = numParity;
+            unsigned int start = (unsigned int)rand() % (blockSize - erasureCount + 1);
+            for (unsigned int i = 0; i < erasureCount; i++)
+                erasureLocs[i] = start + i;
+            return erasureCount;
+        }
+        case PATTERN_WORST:
+            erasureCount = (numParity < numData) ? numParity : numData;
+            blockSize = numData;  // (source segments only)
+            break;
+        default:
+            erasureCount = 1 + (unsigned int)rand() % numParity;
+            break;
+    }
+    // Select "erasureCount" of "blockSize" locations in order (selection sampling)
+    unsigned int count = 0;
+    for (unsigned int i = 0; (i < blockSize) && (count < erasureCount); i++)
+    {
+        if (((unsigned int)rand() % (blockSize - i)) < (erasureCount - count))
+            erasureLocs[count++] = i;
+    }
+    return count;
+}  // end MakeErasures()
+
+static bool RunBench(CodecType      codec,
+                     unsigned int   numData,
+                     unsigned int   numParity,
+                     unsigned int   segSize,
+                     PatternType    pattern,
+                     double         minTime,
+                     BenchResult&   result)
+{
+    NormEncoder* encoder = CreateEncoder(codec);
+    NormDecoder* decoder = CreateDecoder(codec);
+    if ((NULL == encoder) || (NULL == decoder))
+    {
+        fprintf(stderr, "normFecBench: new encoder/decoder error\n");
+        if (NULL != encoder) delete encoder;
+        if (NULL != decoder) delete decoder;
+        return false;
+    }
+    if (!encoder->Init(numData, numParity, segSize) || !decoder->Init(numData, numParity, segSize))
+    {
+        delete encoder;
+        delete decoder;
+        return false;  // (unsupported parameters for this codec)
+    }
+    unsigned int blockSize = numData + numParity;
+    char* txBuffer = new char[blockSize * segSize];
+    char* rxBuffer = new char[blockSize * segSize];
+    char** txList = new char*[blockSize];
+    char** rxList = new char*[blockSize];
+    unsigned int* erasureLocs = new unsigned int[blockSize];
+    if ((NULL == txBuffer) || (NULL == rxBuffer) || (NULL == txList) ||
+        (NULL == rxList) || (NULL == erasureLocs))
+    {
+        fprintf(stderr, "normFecBench: new buffer error\n");
+        if (NULL != txBuffer) delete[] txBuffer;
+        if (NULL != rxBuffer) delete[] rxBuffer;
+        if (NULL != txList) delete[] txList;
+        if (NULL != rxList) delete[] rxList;
+        if (NULL != erasureLocs) delete[] erasureLocs;
+        delete encoder;
+        delete decoder;
+        return false;
+    }
+    for (unsigned int i = 0; i < blockSize; i++)
+    {
+        txList[i] = txBuffer + i*segSize;
+        rxList[i] = rxBuffer + i*segSize;
+    }
+    for (unsigned int i = 0; i < (numData * segSize); i++)
+        txBuffer[i] = (char)rand();
+    double blockBytes = (double)numData * (double)segSize;
+
+    // 1) Incremental encoding (as the sender does by default)
+    ProtoTime startTime, stopTime;
+    unsigned long blockCount = 0;
+    double elapsed = 0.0;
+    startTime.GetCurrentTime();
+    do
+    {
+        memset(txList[numData], 0, numParity * segSize);
+        for (unsigned int i = 0; i < numData; i++)
+            encoder->Encode(i, txList[i], txList + numData);
+        blockCount++;
+        stopTime.GetCurrentTime();
+        elapsed = ProtoTime::Delta(stopTime, startTime);
+    } while (elapsed < minTime);
+    result.encode_rate = 1.0e-09 * blockBytes * blockCount / elapsed;
+    // Keep the reference parity for verification of EncodeBlock()
+    memcpy(rxBuffer, txBuffer, blockSize * segSize);
+
+    // 2) Whole block encoding
+    blockCount = 0;
+    startTime.GetCurrentTime();
+    do
+    {
+        encoder->EncodeBlock((const char**)txList, txList + numData, numData);
+        blockCount++;
+        stopTime.GetCurrentTime();
+        elapsed = ProtoTime::Delta(stopTime, startTime);
+    } while (elapsed < minTime);
+    result.block_rate = 1.0e-09 * blockBytes * blockCount / elapsed;
+    result.verified = (0 == memcmp(rxBuffer, txBuffer, blockSize * segSize));
+
+    // 3) Decoding (erasure patterns are generated ahead of time, but the timing
+    //    includes restoring the previous block's erased segments and zeroing
+    //    the new ones as a receiver would)
+    const unsigned int PATTERN_MAX = 64;
+    unsigned int* patternLocs = new unsigned int[PATTERN_MAX * blockSize];
+    unsigned int patternCount[PATTERN_MAX];
+    if (NULL == patternLocs)
+    {
+        fprintf(stderr, "normFecBench: new patternLocs error\n");
+        result.verified = false;
+        result.decode_rate = 0.0;
+    }
+    else
+    {
+        for (unsigned int i = 0; i < PATTERN_MAX; i++)
+            patternCount[i] = MakeErasures(pattern, numData, numParity, patternLocs + i*blockSize);
+        memcpy(rxBuffer, txBuffer, blockSize * segSize);
+        unsigned int* prevLocs = NULL;
+        unsigned int prevCount = 0;
+        blockCount = 0;
+        startTime.GetCurrentTime();
+        do
+        {
+            for (unsigned int i = 0; i < prevCount; i++)
+                memcpy(rxList[prevLocs[i]], txList[prevLocs[i]], segSize);
+            unsigned int index = (unsigned int)(blockCount % PATTERN_MAX);
+            unsigned int* locs = patternLocs + index*blockSize;
+            unsigned int erasureCount = patternCount[index];
+            // (the decoder's erasure list is scratch space, so pass a copy)
+            for (unsigned int i = 0; i < erasureCount; i++)
+            {
+                erasureLocs[i] = locs[i];
+                memset(rxList[locs[i]], 0, segSize);
+            }
+            decoder->Decode(rxList, numData, erasureCount, erasureLocs);
+            if ((0 == (blockCount % PATTERN_MAX)) && (0 != memcmp(rxBuffer, txBuffer, numData * segSize)))
+                result.verified = false;
+            prevLocs = locs;
+            prevCount = erasureCount;
+            blockCount++;
+            stopTime.GetCurrentTime();
+            elapsed = ProtoTime::Delta(stopTime, startTime);
+        } while (elapsed < minTime);
+        result.decode_rate = 1.0e-09 * blockBytes * blockCount / elapsed;
+        delete[] patternLocs;
+    }
+
+    delete[] erasureLocs;
+    delete[] rxList;
+    delete[] txList;
+    delete[] rxBuffer;
+    delete[] txBuffer;
+    delete decoder;
+    delete encoder;
+    return true;
+}  // end RunBench()
+
+// Looks up the rates recorded for a configuration in a baseline results file
+static bool FindBaseline(FILE* file, const char* key, double rates[3])
+{
+    if (NULL == file) return false;
+    rewind(file);
+    char line[256];
+    size_t keyLen = strlen(key);
+    while (NULL != fgets(line, 256, file))
+    {
+        if ((0 == strncmp(line, key, keyLen)) && (',' == line[keyLen]))
+        {
+            if (3 == sscanf(line + keyLen + 1, "%lf,%lf,%lf", rates, rates + 1, rates + 2))
+                return true;
+        }
+    }
+    return false;
+}  // end FindBaseline()
+
+int main(int argc, char* argv[])
+{
+    bool codecList[CODEC_COUNT] = {true, true, true};
+    bool patternList[PATTERN_COUNT] = {true, true, true};
+    unsigned int dataList[LIST_MAX] = {16, 64, 200};
+    unsigned int dataCount = 3;
+    unsigned int parityList[LIST_MAX] = {4, 16, 32};
+    unsigned int parityCount = 3;
+    unsigned int sizeList[LIST_MAX] = {512, 1400, 8192};
+    unsigned int sizeCount = 3;
+    double minTime = 0.1;
+    double ghz = 0.0;
+    double tolerance = 10.0;  // percent
+    const char* outputPath = NULL;
+    const char* baselinePath = NULL;
+    ProtoTime currentTime;
+    currentTime.GetCurrentTime();
+    unsigned int seed = (unsigned int)currentTime.usec();
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* cmd = argv[i];
+        const char* val = (i < (argc - 1)) ? argv[i+1] : NULL;
+        if (NULL == val)
+        {
+            fprintf(stderr, "normFecBench: missing \"%s\" argument\n", cmd);
+            Usage();
+            return -1;
+        }
+        i++;
+        if (0 == strcmp(cmd, "codec"))
+        {
+            bool all = (0 == strcmp(val, "all"));
+            bool match = all;
+            for (int c = 0; c < CODEC_COUNT; c++)
+            {
+                codecList[c] = all || (0 == strcmp(val, CODEC_NAME[c]));
+                match |= codecList[c];
+            }
+            if (!match)
+            {
+                fprintf(stderr, "normFecBench: invalid codec \"%s\"\n", val);
+                return -1;
+            }
+        }
+        else if (0 == strcmp(cmd, "pattern"))
+        {
+            bool all = (0 == strcmp(val, "all"));
+            bool match = all;
+            for (int p = 0; p < PATTERN_COUNT; p++)
+            {
+                patternList[p] = all || (0 == strcmp(val, PATTERN_NAME[p]));
+                match |= patternList[p];
+            }
+            if (!match)
+            {
+                fprintf(stderr, "normFecBench: invalid pattern \"%s\"\n", val);
+                return -1;
+            }
+        }
+        else if (0 == strcmp(cmd, "ndata"))
+        {
+            if (0 == (dataCount = ParseList(val, dataList)))
+            {
+                fprintf(stderr, "normFecBench: invalid ndata list \"%s\"\n", val);
+                return -1;
+            }
+        }
+        else if (0 == strcmp(cmd, "nparity"))
+        {
+            if (0 == (parityCount = ParseList(val, parityList)))
+            {
+                fprintf(stderr, "normFecBench: invalid nparity list \"%s\"\n", val);
+                return -1;
+            }
+        }
+        else if (0 == strcmp(cmd, "segsize"))
+        {
+            if (0 == (sizeCount = ParseList(val, sizeList)))
+            {
+                fprintf(stderr, "normFecBench: invalid segsize list \"%s\"\n", val);
+                return -1;
+            }
+        }
+        else if (0 == strcmp(cmd, "time"))
+        {
+            minTime = atof(val);
+        }
+        else if (0 == strcmp(cmd, "ghz"))
+        {
+            ghz = atof(val);
+        }
+        else if (0 == strcmp(cmd, "seed"))
+        {
+            seed = (unsigned int)atoi(val);
+        }
+        else if (0 == strcmp(cmd, "output"))
+        {
+            outputPath = val;
+        }
+        else if (0 == strcmp(cmd, "baseline"))
+        {
+            baselinePath = val;
+        }
+        else if (0 == strcmp(cmd, "tolerance"))
+        {
+            tolerance = atof(val);
+        }
+        else
+        {
+            fprintf(stderr, "normFecBench: invalid command \"%s\"\n", cmd);
+            Usage();
+            return -1;
+        }
+    }
+    srand(seed);
+
+    FILE* outputFile = NULL;
+    if ((NULL != outputPath) && (NULL == (outputFile = fopen(outputPath, "w"))))
+    {
+        perror("normFecBench: fopen(output) error");
+        return -1;
+    }
+    FILE* baselineFile = NULL;
+    if ((NULL != baselinePath) && (NULL == (baselineFile = fopen(baselinePath, "r"))))
+    {
+        perror("normFecBench: fopen(baseline) error");
+        if (NULL != outputFile) fclose(outputFile);
+        return -1;
+    }
+
+    double cyclesPerSecond = GetCyclesPerSecond(ghz);
+    fprintf(stderr, "normFecBench: seed:%u time:%lf sec/measurement cpu:%.3lf GHz%s\n", seed, minTime,
+                    1.0e-09 * cyclesPerSecond, (0.0 == cyclesPerSecond) ? " (unknown, use \"ghz\")" : "");
+    fprintf(stderr, "normFecBench: RS8 kernel: %s\n",
+                    NormEncoderRS8::GetSimdModeName(NormEncoderRS8::GetSimdMode()));
+
+    const char* header = "codec,ndata,nparity,segsize,pattern,encodeGBps,blockGBps,decodeGBps,"
+                         "encodeCpb,blockCpb,decodeCpb,verified";
+    printf("%s\n", header);
+    if (NULL != outputFile) fprintf(outputFile, "%s\n", header);
+
+    unsigned int runCount = 0;
+    unsigned int failCount = 0;
+    unsigned int regressionCount = 0;
+    for (int c = 0; c < CODEC_COUNT; c++)
+    {
+        if (!codecList[c]) continue;
+        for (unsigned int d = 0; d < dataCount; d++)
+        {
+            for (unsigned int p = 0; p < parityCount; p++)
+            {
+                for (unsigned int s = 0; s < sizeCount; s++)
+                {
+                    for (int e = 0; e < PATTERN_COUNT; e++)
+                    {
+                        if (!patternList[e]) continue;
+                        char key[128];
+                        sprintf(key, "%s,%u,%u,%u,%s", CODEC_NAME[c], dataList[d],
+                                parityList[p], sizeList[s], PATTERN_NAME[e]);
+                        BenchResult result;
+                        if (!RunBench((CodecType)c, dataList[d], parityList[p], sizeList[s],
+                                      (PatternType)e, minTime, result))
+                        {
+                            fprintf(stderr, "normFecBench: %s skipped (unsupported parameters)\n", key);
+                            continue;
+                        }
+                        runCount++;
+                        if (!result.verified) failCount++;
+                        // Cycles per byte = (cycles/sec) / (bytes/sec)
+                        double cpb[3] = {0.0, 0.0, 0.0};
+                        double rates[3] = {result.encode_rate, result.block_rate, result.decode_rate};
+                        for (int k = 0; k < 3; k++)
+                            if (rates[k] > 0.0) cpb[k] = cyclesPerSecond / (1.0e+09 * rates[k]);
+                        char line[256];
+                        sprintf(line, "%s,%.4lf,%.4lf,%.4lf,%.3lf,%.3lf,%.3lf,%s", key,
+                                rates[0], rates[1], rates[2], cpb[0], cpb[1], cpb[2],
+                                result.verified ? "ok" : "FAILED");
+                        printf("%s\n", line);
+                        fflush(stdout);
+                        if (NULL != outputFile) fprintf(outputFile, "%s\n", line);
+                        double baseRates[3];
+                        if (FindBaseline(baselineFile, key, baseRates))
+                        {
+                            static const char* const RATE_NAME[3] = {"encode", "block", "decode"};
+                            for (int k = 0; k < 3; k++)
+                            {
+                                if (baseRates[k] <= 0.0) continue;
+                                double change = 100.0 * (rates[k] - baseRates[k]) / baseRates[k];
+                                if (change < -tolerance)
+                                {
+                                    fprintf(stderr, "normFecBench: REGRESSION %s %s %.4lf -> %.4lf GB/s (%+.1lf%%)\n",
+                                                    key, RATE_NAME[k], baseRates[k], rates[k], change);
+                                    regressionCount++;
+                                }
+                            }
+                        }
+                    }  // end for (e)
+                }  // end for (s)
+            }  // end for (p)
+        }  // end for (d)
+    }  // end for (c)
+
+    if (NULL != outputFile) fclose(outputFile);
+    if (NULL != baselineFile) fclose(baselineFile);
+    fprintf(stderr, "normFecBench: %u configurations, %u verification failures", runCount, failCount);
+    if (NULL != baselinePath)
+        fprintf(stderr, ", %u regressions (tolerance %.1lf%%)", regressionCount, tolerance);
+    fprintf(stderr, "\n");
+    return ((0 != failCount) || (0 != regressionCount)) ? 1 : 0;
+}  // end main()
@@ -0,0 +1,279 @@
+/*********************************************************************
+ *
+ * AUTHORIZATION TO USE AND DISTRIBUTE
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that:
+ *
+ * (1) source code distributions retain this paragraph in its entirety,
+ *
+ * (2) distributions including binary code include this paragraph in
+ *     its entirety in the documentation or other materials provided
+ *     with the distribution, and
+ *
+ * (3) all advertising materials mentioning features or use of this
+ *     software display the following acknowledgment:
+ *
+ *      "This product includes software written and developed
+ *       by Brian Adamson and Joe Macker of the Naval Research
+ *       Laboratory (NRL)."
+ *
+ *  The name of NRL, the name(s) of NRL  employee(s), or any entity
+ *  of the United States Government may not be used to endorse or
+ *  promote  products derived from this software, nor does the
+ *  inclusion of the NRL written and developed software  directly or
+ *  indirectly suggest NRL or United States  Government endorsement
+ *  of this product.
+ *
+ * THIS SOFTWARE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ ********************************************************************/
+
+#include "normFecPool.h"
+#include "normEncoderRS8.h"
+#include "normEncoderRS16.h"
+#include "normEncoderMDP.h"
+
+#include <string.h>  // for memset()
+
+// These mirror the FEC type selection of NormSession::StartSender() and
+// NormSenderNode::AllocateBuffers() for the given FEC Encoding Id and 'm'
+static NormEncoder* CreateEncoder(UINT8 fecId, UINT8 fecM)
+{
+    switch (fecId)
+    {
+        case 2:
+            if (16 == fecM)
+                return new NormEncoderRS16;
+            else
+                return new NormEncoderRS8;
+        case 5:
+            return new NormEncoderRS8;
+        case 129:
+#ifdef ASSUME_MDP_FEC
+            return new NormEncoderMDP;
+#else
+            return new NormEncoderRS8;
+#endif // if/else ASSUME_MDP_FEC
+        default:
+            PLOG(PL_ERROR, "NormFecPool CreateEncoder() error: unsupported fecId>%d\n", fecId);
+            return NULL;
+    }
+}  // end CreateEncoder()
+
+static NormDecoder* CreateDecoder(UINT8 fecId, UINT8 fecM)
+{
+    switch (fecId)
+    {
+        case 2:
+            if (16 == fecM)
+                return new NormDecoderRS16;
+            else
+                return new NormDecoderRS8;
+        case 5:
+            return new NormDecoderRS8;
+        case 129:
+#ifdef ASSUME_MDP_FEC
+            return new NormDecoderMDP;
+#else
+            return new NormDecoderRS8;
+#endif // if/else ASSUME_MDP_FEC
+        default:
+            PLOG(PL_ERROR, "NormFecPool CreateDecoder() error: unsupported fecId>%d\n", fecId);
+            return NULL;
+    }
+}  // end CreateDecoder()
+
+NormFecJob::NormFecJob()
+ : job_type(ENCODE), fec_id(0), fec_m(0), ndata(0), npar(0), vector_size(0),
+   vector_max(0), buffer_size(0), buffer(NULL), vector_list(NULL), erasure_loc(NULL),
+   node_ptr(NULL), node_id(NORM_NODE_NONE), object_ptr(NULL), num_data(0),
+   seg_size_max(0), erasure_count(0), complete(false), process_time(0.0)
+{
+}
+
+NormFecJob::~NormFecJob()
+{
+    Destroy();
+}
+
+bool NormFecJob::Init(Type          jobType,
+                      UINT8         fecId,
+                      UINT8         fecM,
+                      UINT16        numDataMax,
+                      UINT16        numParity,
+                      UINT16        vectorSize)
+{
+    unsigned int vectorCount = numDataMax + numParity;
+    unsigned int bufferSize = vectorCount * vectorSize;
+    if ((vectorCount > vector_max) || (bufferSize > buffer_size))
+    {
+        Destroy();
+        if (NULL == (buffer = new char[bufferSize]))
+        {
+            PLOG(PL_ERROR, "NormFecJob::Init() new buffer error: %s\n", GetErrorString());
+            return false;
+        }
+        buffer_size = bufferSize;
+        if (NULL == (vector_list = new char*[vectorCount]))
+        {
+            PLOG(PL_ERROR, "NormFecJob::Init() new vector_list error: %s\n", GetErrorString());
+            Destroy();
+            return false;
+        }
+        if (NULL == (erasure_loc = new unsigned int[vectorCount]))
+        {
+            PLOG(PL_ERROR, "NormFecJob::Init() new erasure_loc error: %s\n", GetErrorString());
+            Destroy();
+            return false;
+        }
+        vector_max = vectorCount;
+    }
+    for (unsigned int i = 0; i < vectorCount; i++)
+        vector_list[i] = buffer + i*vectorSize;
+    job_type = jobType;
+    fec_id = fecId;
+    fec_m = fecM;
+    ndata = numDataMax;
+    npar = numParity;
+    vector_size = vectorSize;
+    node_ptr = object_ptr = NULL;
+    num_data = numDataMax;
+    seg_size_max = 0;
+    erasure_count = 0;
+    complete = false;
+    return true;
+}  // end NormFecJob::Init()
+
+void NormFecJob::Destroy()
+{
+    if (NULL != erasure_loc)
+    {
+        delete[] erasure_loc;
+        erasure_loc = NULL;
+    }
+    if (NULL != vector_list)
+    {
+        delete[] vector_list;
+        vector_list = NULL;
+    }
+    if (NULL != buffer)
+    {
+        delete[] buffer;
+        buffer = NULL;
+    }
+    vector_max = buffer_size = 0;
+}  // end NormFecJob::Destroy()
+
+NormFecPool::Coder::Coder()
+ : encoder(NULL), decoder(NULL),
+   enc_fec_id(0), enc_fec_m(0), enc_ndata(0), enc_npar(0), enc_vec_size(0),
+   dec_fec_id(0), dec_fec_m(0), dec_ndata(0), dec_npar(0), dec_vec_size(0)
+{
+}
+
+NormFecPool::Coder::~Coder()
+{
+    if (NULL != encoder) delete encoder;
+    if (NULL != decoder) delete decoder;
+}
+
+void NormFecPool::Coder::Process(NormFecJob& job)
+{
+    if (NormFecJob::ENCODE == job.job_type)
+    {
+        if ((NULL == encoder) || (job.fec_id != enc_fec_id) || (job.fec_m != enc_fec_m) ||
+            (job.ndata != enc_ndata) || (job.npar != enc_npar) || (job.vector_size != enc_vec_size))
+        {
+            if (NULL != encoder) delete encoder;
+            if ((NULL == (encoder = CreateEncoder(job.fec_id, job.fec_m))) ||
+                !encoder->Init(job.ndata, job.npar, job.vector_size))
+            {
+                PLOG(PL_ERROR, "NormFecPool::Coder::Process() error: unable to create encoder\n");
+                if (NULL != encoder) delete encoder;
+                encoder = NULL;
+                return;
+            }
+            enc_fec_id = job.fec_id;
+            enc_fec_m = job.fec_m;
+            enc_ndata = job.ndata;
+            enc_npar = job.npar;
+            enc_vec_size = job.vector_size;
+        }
+        encoder->EncodeBlock((const char**)job.vector_list, job.vector_list + job.num_data, job.num_data);
+        job.complete = true;
+    }
+    else
+    {
+        if ((NULL == decoder) || (job.fec_id != dec_fec_id) || (job.fec_m != dec_fec_m) ||
+            (job.ndata != dec_ndata) || (job.npar != dec_npar) || (job.vector_size != dec_vec_size))
+        {
+            if (NULL != decoder) delete decoder;
+            if ((NULL == (decoder = CreateDecoder(job.fec_id, job.fec_m))) ||
+                !decoder->Init(job.ndata, job.npar, job.vector_size))
+            {
+                PLOG(PL_ERROR, "NormFecPool::Coder::Process() error: unable to create decoder\n");
+                if (NULL != decoder) delete decoder;
+                decoder = NULL;
+                return;
+            }
+            dec_fec_id = job.fec_id;
+            dec_fec_m = job.fec_m;
+            dec_ndata = job.ndata;
+            dec_npar = job.npar;
+            dec_vec_size = job.vector_size;
+        }
+        job.complete = (0 != decoder->Decode(job.vector_list, job.num_data, job.erasure_count, job.erasure_loc));
+    }
+}  // end NormFecPool::Coder::Process()
+
+NormFecPool::NormFecPool()
+ : NormWorkerPool(JOBS_PER_THREAD), coder_list(NULL)
+{
+}
+
+NormFecPool::~NormFecPool()
+{
+    Close();  // (before NormWorkerPool destruction, see normWorkerPool.h)
+}
+
+bool NormFecPool::Open(unsigned int threadCount, ProtoChannel::Notifier* notifier)
+{
+    Close();
+    if (0 != threadCount)
+    {
+        if (NULL == (coder_list = new Coder[threadCount]))
+        {
+            PLOG(PL_ERROR, "NormFecPool::Open() new coder_list error: %s\n", GetErrorString());
+            return false;
+        }
+    }
+    if (!NormWorkerPool::Open(threadCount, notifier))
+    {
+        Close();
+        return false;
+    }
+    return true;
+}  // end NormFecPool::Open()
+
+void NormFecPool::Close()
+{
+    NormWorkerPool::Close();
+    if (NULL != coder_list)
+    {
+        delete[] coder_list;
+        coder_list = NULL;
+    }
+}  // end NormFecPool::Close()
+
+void NormFecPool::ProcessJob(unsigned int workerIndex, NormWorkerJob& workerJob)
+{
+    NormFecJob& job = static_cast<NormFecJob&>(workerJob);
+    struct timeval startTime, endTime;
+    ProtoSystemTime(startTime);
+    coder_list[workerIndex].Process(job);
+    ProtoSystemTime(endTime);
+    job.process_time = (double)(endTime.tv_sec - startTime.tv_sec) +
+                       1.0e-06 * ((double)endTime.tv_usec - (double)startTime.tv_usec);
+}  // end NormFecPool::ProcessJob()
@@ -29,12 +29,17 @@ static inline int dirfd(DIR *dir) {return (dir->dd_fd);}
 #include <sys/stat.h>
 #endif // !_WIN32_WCE
 
+#ifndef WIN32
+#include <sys/mman.h>  // for mmap(), etc
+#endif // !WIN32
+
 NormFile::NormFile()
 #ifdef _WIN32_WCE
     : file_ptr(NULL)
 #else
     : fd(-1)
 #endif // if/else _WIN32_WCE
+      , map_ptr(NULL), map_size(0)
 {    
 }
 
@@ -149,6 +154,7 @@ bool NormFile::Open(const char* thePath, int theFlags)
 
 void NormFile::Close()
 {
+    if (IsMapped()) Unmap();
     if (IsOpen())
     {
 #ifdef WIN32
@@ -462,6 +468,96 @@ bool NormFile::Pad(Offset theOffset)
     return true; 
 }  // end NormFile::Pad()
 
+bool NormFile::Map(Offset theSize, bool writable)
+{
+    ASSERT(IsOpen());
+    if (IsMapped()) Unmap();
+#ifdef WIN32
+    PLOG(PL_WARN, "NormFile::Map() warning: file mapping not supported on this platform\n");
+    return false;
+#else
+    if ((theSize <= 0) || ((UINT64)theSize > (UINT64)((size_t)-1)))
+    {
+        // (empty files can't be mapped and large files may exceed 32-bit address space)
+        PLOG(PL_DEBUG, "NormFile::Map() unable to map file of size %lld\n", (long long)theSize);
+        return false;
+    }
+    int prot = PROT_READ;
+    if (writable)
+    {
+        // Writable mappings are only used when file storage can be preallocated
+        // so that writing via the mapping can't fault (SIGBUS) on a full file
+        // system later.  Otherwise, the caller falls back to write() which 
+        // reports such errors.  (Preallocation also keeps the file extent from
+        // being fragmented by random order block arrival.)
+#ifdef LINUX
+        if (0 != fallocate(fd, 0, 0, theSize))
+        {
+            PLOG(PL_WARN, "NormFile::Map() fallocate() error: %s\n", GetErrorString());
+            return false;
+        }
+#else
+        PLOG(PL_DEBUG, "NormFile::Map() writable mapping requires fallocate() support\n");
+        return false;
+#endif // if/else LINUX
+        prot |= PROT_WRITE;
+    }
+    void* ptr = mmap(NULL, (size_t)theSize, prot, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == ptr)
+    {
+        PLOG(PL_WARN, "NormFile::Map() mmap() error: %s\n", GetErrorString());
+        return false;
+    }
+    // NORM mostly transmits and receives objects in order with
+    // repairs handled via Prefetch() hints
+    if (0 != madvise(ptr, (size_t)theSize, MADV_SEQUENTIAL))
+        PLOG(PL_DEBUG, "NormFile::Map() madvise() error: %s\n", GetErrorString());
+    map_ptr = (char*)ptr;
+    map_size = theSize;
+    return true;
+#endif // if/else WIN32
+}  // end NormFile::Map()
+
+void NormFile::Unmap()
+{
+#ifndef WIN32
+    if (NULL != map_ptr)
+    {
+        if (0 != munmap(map_ptr, (size_t)map_size))
+            PLOG(PL_ERROR, "NormFile::Unmap() munmap() error: %s\n", GetErrorString());
+    }
+#endif // !WIN32
+    map_ptr = NULL;
+    map_size = 0;
+}  // end NormFile::Unmap()
+
+void NormFile::Prefetch(Offset theOffset, Offset theLength)
+{
+#ifndef WIN32
+    if ((NULL == map_ptr) || (theOffset >= map_size)) return;
+    if ((theOffset + theLength) > map_size) 
+        theLength = map_size - theOffset;
+    // madvise() requires a page-aligned address
+    static long pageSize = sysconf(_SC_PAGESIZE);
+    Offset pageOffset = theOffset - (theOffset % pageSize);
+    theLength += (theOffset - pageOffset);
+    if (0 != madvise(map_ptr + pageOffset, (size_t)theLength, MADV_WILLNEED))
+        PLOG(PL_DEBUG, "NormFile::Prefetch() madvise() error: %s\n", GetErrorString());
+#endif // !WIN32
+}  // end NormFile::Prefetch()
+
+bool NormFile::Sync(bool wait)
+{
+#ifndef WIN32
+    if ((NULL != map_ptr) && (0 != msync(map_ptr, (size_t)map_size, wait ? MS_SYNC : MS_ASYNC)))
+    {
+        PLOG(PL_ERROR, "NormFile::Sync() msync() error: %s\n", GetErrorString());
+        return false;
+    }
+#endif // !WIN32
+    return true;
+}  // end NormFile::Sync()
+
 NormFile::Offset NormFile::GetSize() const
 {
     ASSERT(IsOpen());
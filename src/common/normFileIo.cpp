@@ -0,0 +1,136 @@
+/*********************************************************************
+ *
+ * AUTHORIZATION TO USE AND DISTRIBUTE
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that:
+ *
+ * (1) source code distributions retain this paragraph in its entirety,
+ *
+ * (2) distributions including binary code include this paragraph in
+ *     its entirety in the documentation or other materials provided
+ *     with the distribution, and
+ *
+ * (3) all advertising materials mentioning features or use of this
+ *     software display the following acknowledgment:
+ *
+ *      "This product includes software written and developed
+ *       by Brian Adamson and Joe Macker of the Naval Research
+ *       Laboratory (NRL)."
+ *
+ *  The name of NRL, the name(s) of NRL  employee(s), or any entity
+ *  of the United States Government may not be used to endorse or
+ *  promote  products derived from this software, nor does the
+ *  inclusion of the NRL written and developed software  directly or
+ *  indirectly suggest NRL or United States  Government endorsement
+ *  of this product.
+ *
+ * THIS SOFTWARE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ ********************************************************************/
+
+
+#include "normFileIo.h"
+
+#ifndef WIN32
+#include <unistd.h>  // for pread(), pwrite()
+#include <errno.h>
+#endif // !WIN32
+
+NormFileIoJob::NormFileIoJob()
+ : job_type(READ), file_fd(-1), offset(0), length(0),
+   buffer_size(0), buffer(NULL), done(false), complete(false)
+{
+}
+
+NormFileIoJob::~NormFileIoJob()
+{
+    Destroy();
+}
+
+bool NormFileIoJob::Init(Type              jobType,
+                         void*             owner,
+                         int               fd,
+                         NormFile::Offset  theOffset,
+                         unsigned int      theLength)
+{
+    if (theLength > buffer_size)
+    {
+        Destroy();
+        if (NULL == (buffer = new char[theLength]))
+        {
+            PLOG(PL_ERROR, "NormFileIoJob::Init() new buffer error: %s\n", GetErrorString());
+            return false;
+        }
+        buffer_size = theLength;
+    }
+    job_type = jobType;
+    owner_ptr = owner;
+    file_fd = fd;
+    offset = theOffset;
+    length = theLength;
+    done = false;
+    complete = false;
+    return true;
+}  // end NormFileIoJob::Init()
+
+void NormFileIoJob::Destroy()
+{
+    if (NULL != buffer)
+    {
+        delete[] buffer;
+        buffer = NULL;
+    }
+    buffer_size = 0;
+}  // end NormFileIoJob::Destroy()
+
+NormFileIoPool::NormFileIoPool()
+ : NormWorkerPool(JOBS_PER_THREAD)
+{
+}
+
+NormFileIoPool::~NormFileIoPool()
+{
+    Close();  // (before NormWorkerPool destruction, see normWorkerPool.h)
+}
+
+bool NormFileIoPool::Open(unsigned int threadCount, ProtoChannel::Notifier* notifier)
+{
+#ifdef WIN32
+    if (0 != threadCount)
+    {
+        PLOG(PL_ERROR, "NormFileIoPool::Open() error: asynchronous file I/O not supported on WIN32\n");
+        return false;
+    }
+#endif // WIN32
+    return NormWorkerPool::Open(threadCount, notifier);
+}  // end NormFileIoPool::Open()
+
+void NormFileIoPool::ProcessJob(unsigned int /*workerIndex*/, NormWorkerJob& workerJob)
+{
+#ifndef WIN32
+    NormFileIoJob& job = static_cast<NormFileIoJob&>(workerJob);
+    unsigned int count = 0;
+    while (count < job.length)
+    {
+        ssize_t result;
+        if (NormFileIoJob::READ == job.job_type)
+            result = pread(job.file_fd, job.buffer + count, job.length - count, job.offset + count);
+        else
+            result = pwrite(job.file_fd, job.buffer + count, job.length - count, job.offset + count);
+        if (result > 0)
+        {
+            count += (unsigned int)result;
+        }
+        else if ((0 == result) || (EINTR != errno))
+        {
+            PLOG(PL_ERROR, "NormFileIoPool::ProcessJob() %s error: %s\n",
+                 (NormFileIoJob::READ == job.job_type) ? "pread()" : "pwrite()",
+                 (0 == result) ? "unexpected end-of-file" : GetErrorString());
+            return;
+        }
+    }
+    job.complete = true;
+#endif // !WIN32
+}  // end NormFileIoPool::ProcessJob()
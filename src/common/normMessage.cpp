@@ -7,12 +7,25 @@ NormHeaderExtension::NormHeaderExtension()
     
 }
 
-NormMsg::NormMsg() 
- : length(8), header_length(8), header_length_base(8)
+NormMsg::NormMsg(UINT32* bufferPtr, unsigned int bufferSize) 
+ : buffer(bufferPtr), buffer_size(bufferSize), 
+   length(8), header_length(8), header_length_base(8)
 {
+    if (NULL != buffer)
+    {
+        SetType(INVALID);
+        SetVersion(NORM_PROTOCOL_VERSION);
+    }
+}
+
+void NormMsg::AttachBuffer(UINT32* bufferPtr, unsigned int bufferSize)
+{
+    buffer = bufferPtr;
+    buffer_size = bufferSize;
+    length = header_length = header_length_base = 8;
     SetType(INVALID);
     SetVersion(NORM_PROTOCOL_VERSION);
-}
+}  // end NormMsg::AttachBuffer()
 
 bool NormMsg::InitFromBuffer(UINT16 msgLength)
 {
@@ -420,6 +433,7 @@ void NormMessageQueue::Destroy()
         head = next->next;
         delete next;
     }   
+    tail = NULL;
 }  // end NormMessageQueue::Destroy()
 
 
@@ -489,6 +503,126 @@ NormMsg* NormMessageQueue::RemoveTail()
     }
 }  // end NormMessageQueue::RemoveTail()
 
+NormMessagePool::NormMessagePool()
+ : msg_size(0), msg_count(0), large_count(0), slab_list(NULL)
+{
+}
+
+NormMessagePool::~NormMessagePool()
+{
+    Destroy();
+}
+
+bool NormMessagePool::Init(unsigned int msgCount, unsigned int msgSize)
+{
+    // Keep buffers 32-bit aligned
+    msgSize = (msgSize + 3) & ~((unsigned int)3);
+    if (msgSize > NormMsg::MAX_SIZE) msgSize = NormMsg::MAX_SIZE;
+    // Previous (free) regular messages at least the new size become
+    // "large" messages; smaller ones are freed since they can no longer
+    // satisfy a default (msgSize = 0) request (storage remains in its slab)
+    NormMsg* msg;
+    while (NULL != (msg = msg_list.RemoveHead()))
+    {
+        if (msg->GetBufferSize() >= msgSize)
+            large_list.Append(msg);
+        else
+            delete msg;
+    }
+    if (!AddSlab(msgCount, msgSize, msg_list))
+    {
+        PLOG(PL_FATAL, "NormMessagePool::Init() error: unable to allocate messages: %s\n", GetErrorString());
+        return false;
+    }
+    msg_size = msgSize;
+    msg_count = msgCount;
+    return true;
+}  // end NormMessagePool::Init()
+
+// Note any messages not returned to the pool are invalid after this
+void NormMessagePool::Destroy()
+{
+    msg_list.Destroy();
+    large_list.Destroy();
+    while (NULL != slab_list)
+    {
+        Slab* slab = slab_list;
+        slab_list = slab->next;
+        delete[] slab->storage;
+        delete slab;
+    }
+    msg_size = msg_count = large_count = 0;
+}  // end NormMessagePool::Destroy()
+
+bool NormMessagePool::AddSlab(unsigned int msgCount, unsigned int msgSize, NormMessageQueue& msgList)
+{
+    Slab* slab = new Slab;
+    if (NULL == slab) return false;
+    unsigned int msgWords = msgSize / sizeof(UINT32);
+    if (NULL == (slab->storage = new UINT32[msgCount * msgWords]))
+    {
+        delete slab;
+        return false;
+    }
+    slab->next = slab_list;
+    slab_list = slab;
+    for (unsigned int i = 0; i < msgCount; i++)
+    {
+        NormMsg* msg = new NormMsg(slab->storage + i*msgWords, msgSize);
+        if (NULL == msg) return false;  // (slab is freed upon Destroy())
+        msgList.Append(msg);
+    }
+    return true;
+}  // end NormMessagePool::AddSlab()
+
+NormMsg* NormMessagePool::Get(unsigned int msgSize)
+{
+    if (0 == msgSize)
+        msgSize = msg_size;
+    else if (msgSize > NormMsg::MAX_SIZE)
+        msgSize = NormMsg::MAX_SIZE;
+    if (msgSize <= msg_size)
+    {
+        NormMsg* msg = msg_list.RemoveHead();
+        if (NULL != msg) return msg;
+    }
+    // First fit from the large message list
+    NormMsg* msg = large_list.GetHead();
+    while (NULL != msg)
+    {
+        if (msg->GetBufferSize() >= msgSize)
+        {
+            large_list.Remove(msg);
+            return msg;
+        }
+        msg = msg->GetNext();
+    }
+    if ((msgSize <= msg_size) || (large_count >= msg_count))
+        return NULL;  // pool is exhausted
+    // Allocate a new large message (rounded up to 1 kB)
+    msgSize = (msgSize + 1023) & ~((unsigned int)1023);
+    if (msgSize > NormMsg::MAX_SIZE) msgSize = NormMsg::MAX_SIZE;
+    NormMessageQueue newList;
+    if (!AddSlab(1, msgSize, newList))
+    {
+        PLOG(PL_ERROR, "NormMessagePool::Get() error: unable to allocate large message: %s\n", GetErrorString());
+        return NULL;
+    }
+    large_count++;
+    return newList.RemoveHead();
+}  // end NormMessagePool::Get()
+
+void NormMessagePool::Put(NormMsg* msg)
+{
+    unsigned int bufferSize = msg->GetBufferSize();
+    if (bufferSize == msg_size)
+        msg_list.Append(msg);
+    else if (bufferSize > msg_size)
+        large_list.Append(msg);
+    else
+        delete msg;  // outstanding message from before a larger Init()
+}  // end NormMessagePool::Put()
+
 
 /****************************************************************
  *  RTT quantization routines:
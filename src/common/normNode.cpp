@@ -75,8 +75,7 @@ NormSenderNode::NormSenderNode(class NormSession& theSession, NormNodeId nodeId)
    rtt_confirmed(false), is_clr(false), is_plr(false),
    slow_start(true), send_rate(0.0), recv_rate(0.0), recv_rate_prev(0.0),
    nominal_packet_size(0), cmd_buffer_head(NULL), cmd_buffer_tail(NULL),
-   cmd_buffer_pool(NULL), resync_count(0),
-   nack_count(0), suppress_count(0), completion_count(0), failure_count(0)
+   cmd_buffer_pool(NULL)
 {
     repair_boundary = session.ReceiverGetDefaultRepairBoundary();
     sync_policy = session.ReceiverGetDefaultSyncPolicy();
@@ -121,6 +120,9 @@ NormSenderNode::NormSenderNode(class NormSession& theSession, NormNodeId nodeId)
     
     prev_update_time.tv_sec = 0;
     prev_update_time.tv_usec = 0;   
+    recv_last_time.tv_sec = 0;
+    recv_last_time.tv_usec = 0;
+    grtt_gauge.SetValue(grtt_estimate);
 }
 
 
@@ -593,6 +595,7 @@ void NormSenderNode::UpdateGrttEstimate(UINT8 grttQuantized)
 {
     grtt_quantized = grttQuantized;
     grtt_estimate = NormUnquantizeRtt(grttQuantized);
+    grtt_gauge.SetValue(grtt_estimate);
     PLOG(PL_DEBUG, "NormSenderNode::UpdateGrttEstimate() node>%lu sender>%lu new grtt: %lf sec\n",
                     (unsigned long)LocalNodeId(), (unsigned long)GetId(), grtt_estimate);
     // activity timer depends upon sender's grtt estimate
@@ -1849,31 +1852,7 @@ void NormSenderNode::HandleObjectMessage(const NormObjectMsg& msg)
     if (NULL != obj)
     {
         obj->HandleObjectMessage(msg, msgType, blockId, segmentId);
-        bool objIsPending = obj->IsPending();
-        
-        // Silent receivers may be configured to allow obj completion w/out INFO
-        if (objIsPending && session.RcvrIgnoreInfo())
-            objIsPending = obj->PendingMaskIsSet();
-        
-        if (!objIsPending)
-        {
-            // Reliable reception of this object has completed
-            if (NormObject::FILE == obj->GetType()) 
-#ifdef SIMULATE
-                static_cast<NormSimObject*>(obj)->Close();           
-#else
-                static_cast<NormFileObject*>(obj)->Close();
-#endif // !SIMULATE
-            if (NormObject::STREAM != obj->GetType())
-            {
-                // Streams never complete unless they are "closed" by sender
-                // and this is handled within stream control code in "normObject.cpp"
-                session.Notify(NormController::RX_OBJECT_COMPLETED, this, obj);
-                DeleteObject(obj);
-                obj = NULL;
-                completion_count++;
-            }
-        } 
+        obj = CheckObjectCompletion(obj);
     }  
     switch (repair_boundary)
     {
@@ -1894,6 +1873,64 @@ void NormSenderNode::HandleObjectMessage(const NormObjectMsg& msg)
     }
 }  // end NormSenderNode::HandleObjectMessage()
 
+// Completes and deletes a non-stream "obj" for which reception is no
+// longer pending (returns NULL in that case)
+NormObject* NormSenderNode::CheckObjectCompletion(NormObject* obj)
+{
+#ifndef SIMULATE
+    if ((NormObject::FILE == obj->GetType()) && static_cast<NormFileObject*>(obj)->WriteFailed())
+    {
+        AbortObject(obj);
+        return NULL;
+    }
+#endif // !SIMULATE
+    bool objIsPending = obj->IsPending();
+    
+    // Silent receivers may be configured to allow obj completion w/out INFO
+    if (objIsPending && session.RcvrIgnoreInfo())
+        objIsPending = obj->PendingMaskIsSet();
+    
+    if (!objIsPending)
+    {
+        // Reliable reception of this object has completed
+        if (NormObject::FILE == obj->GetType()) 
+#ifdef SIMULATE
+            static_cast<NormSimObject*>(obj)->Close();           
+#else
+        {
+            // (Close() completes any asynchronous writes, which may have failed)
+            NormFileObject* fileObj = static_cast<NormFileObject*>(obj);
+            fileObj->Close();
+            if (fileObj->WriteFailed())
+            {
+                AbortObject(obj);
+                return NULL;
+            }
+        }
+#endif // !SIMULATE
+        if (NormObject::STREAM != obj->GetType())
+        {
+            // Streams never complete unless they are "closed" by sender
+            // and this is handled within stream control code in "normObject.cpp"
+            session.Notify(NormController::RX_OBJECT_COMPLETED, this, obj);
+            DeleteObject(obj);
+            obj = NULL;
+            completion_count.Increment();
+        }
+    } 
+    return obj;
+}  // end NormSenderNode::CheckObjectCompletion()
+
+void NormSenderNode::HandleDecodeJob(NormFecJob& job)
+{
+    decode_time_hist.Record(job.GetProcessTime());
+    NormObject* obj = rx_table.Find(job.GetObjectId());
+    // (the object may have been deleted while the job was in progress)
+    if ((NULL == obj) || ((const void*)obj != job.GetObjectPtr())) return;
+    if (obj->ReceiverHandleDecodeJob(job))
+        CheckObjectCompletion(obj);
+}  // end NormSenderNode::HandleDecodeJob()
+
 bool NormSenderNode::SyncTest(const NormObjectMsg& msg) const
 {
     switch (sync_policy)
@@ -1932,7 +1969,7 @@ void NormSenderNode::AbortObject(NormObject* obj)
 #endif // !SIMULATE
     session.Notify(NormController::RX_OBJECT_ABORTED, this, obj);
     DeleteObject(obj);
-    failure_count++;
+    failure_count.Increment();
 }  // end NormSenderNode::AbortObject()
 
 
@@ -2327,7 +2364,11 @@ bool NormSenderNode::OnRepairTimeout(ProtoTimer& /*theTimer*/)
                 if (repairPending)
                 {
                     // We weren't completely suppressed, so build NACK
-                    NormNackMsg* nack = static_cast<NormNackMsg*>(session.GetMessageFromPool());
+                    UINT16 payloadMax = 4*SegmentSize();
+                    // If we sync'd to non-DATA, we don't yet know the sender segment_size
+                    if (0 == payloadMax) 
+                        payloadMax = 4*NormNackMsg::DEFAULT_LENGTH_MAX;
+                    NormNackMsg* nack = static_cast<NormNackMsg*>(session.GetMessageFromPool(payloadMax + NormMsg::HEADER_MAX));
                     if (NULL == nack)
                     {
                         PLOG(PL_WARN, "NormSenderNode::OnRepairTimeout() node>%lu Warning! "
@@ -2336,10 +2377,6 @@ bool NormSenderNode::OnRepairTimeout(ProtoTimer& /*theTimer*/)
                         return false;   
                     }
                     nack->Init();
-                    UINT16 payloadMax = 4*SegmentSize();
-                    // If we sync'd to non-DATA, we don't yet know the sender segment_size
-                    if (0 == payloadMax) 
-                        payloadMax = 4*NormNackMsg::DEFAULT_LENGTH_MAX;
                     bool nackAppended = false;
                     
                     if (cc_enable)
@@ -2541,7 +2578,7 @@ bool NormSenderNode::OnRepairTimeout(ProtoTimer& /*theTimer*/)
                             if (nack->GetRepairContentLength() <= singleNackSize)
                             {
                                 session.SendMessage(*nack);
-                                nack_count++;
+                                nack_count.Increment();
                             }
                             else
                             {
@@ -2565,7 +2602,7 @@ bool NormSenderNode::OnRepairTimeout(ProtoTimer& /*theTimer*/)
                 {
                     if (!session.ReceiverIsSilent())
                     {
-                        suppress_count++;
+                        suppress_count.Increment();
                         PLOG(PL_DEBUG, "NormSenderNode::OnRepairTimeout() node>%lu sender>%lu NACK SUPPRESSED ...\n",
                                         (unsigned long)LocalNodeId(), (unsigned long)GetId());
                     }
@@ -2617,7 +2654,7 @@ void NormSenderNode::FragmentNack(NormNackMsg& superNack)
     // Parse a "super" NACK and refactor it into a series of smaller
     // NACK messages as needed (per "segment_size" constraint)
     // and send them.
-    NormNackMsg* nack = (NormNackMsg*)session.GetMessageFromPool();
+    NormNackMsg* nack = (NormNackMsg*)session.GetMessageFromPool((SegmentSize() ? SegmentSize() : NormNackMsg::DEFAULT_LENGTH_MAX) + NormMsg::HEADER_MAX);
     if (!nack)
     {
         PLOG(PL_WARN, "NormSenderNode::FragmentNack() node>%lu Warning! "
@@ -2673,7 +2710,7 @@ void NormSenderNode::FragmentNack(NormNackMsg& superNack)
                     // We have filled the NACK, so pack, send, and reset request
                     nack->PackRepairRequest(req);
                     session.SendMessage(*nack);
-                    nack_count++;
+                    nack_count.Increment();
                     nack->ResetPayload();
                     nack->AttachRepairRequest(req, SegmentSize());
                     payloadLength = REQ_HDR_LEN;
@@ -2695,7 +2732,7 @@ void NormSenderNode::FragmentNack(NormNackMsg& superNack)
         else
         {
             session.SendMessage(*nack);
-            nack_count++;
+            nack_count.Increment();
             nack->ResetPayload();
             payloadLength = 0;
         }
@@ -2704,7 +2741,7 @@ void NormSenderNode::FragmentNack(NormNackMsg& superNack)
     {
         ASSERT(nack->GetRepairContentLength() == payloadLength);
         session.SendMessage(*nack);
-        nack_count++;
+        nack_count.Increment();
     }
     session.ReturnMessageToPool(nack);
     
@@ -2712,6 +2749,12 @@ void NormSenderNode::FragmentNack(NormNackMsg& superNack)
 
 void NormSenderNode::UpdateRecvRate(const struct timeval& currentTime, unsigned short msgSize)
 {
+    // (for NormNodeGetStats())
+    recv_packet_count.Increment();
+    recv_byte_count.Increment(msgSize);
+    if (recv_last_time.tv_sec || recv_last_time.tv_usec)
+        recv_interval_hist.RecordInterval(recv_last_time, currentTime);
+    recv_last_time = currentTime;
     if (prev_update_time.tv_sec || prev_update_time.tv_usec)
     {
         double interval = (double)(currentTime.tv_sec - prev_update_time.tv_sec);
@@ -2740,6 +2783,8 @@ void NormSenderNode::UpdateRecvRate(const struct timeval& currentTime, unsigned
                 recv_rate = recv_rate_prev = currentRecvRate; 
                 prev_update_time = currentTime;
                 recv_accumulator.Reset();
+                recv_rate_gauge.SetValue(recv_rate);
+                loss_gauge.SetValue(LossEstimate());
             }
             else if (0.0 == recv_rate)
             {
@@ -3071,7 +3116,7 @@ bool NormSenderNode::OnAckTimeout(ProtoTimer& /*theTimer*/)
     // Build and send NORM_ACK(FLUSH)
     if (ack_ex_pending)
         return true;  // Will acknowledge when application services RX_ACK_REQUEST notification
-    NormAckFlushMsg* ack = (NormAckFlushMsg*)session.GetMessageFromPool();
+    NormAckFlushMsg* ack = (NormAckFlushMsg*)session.GetMessageFromPool(ack_ex_length + NormMsg::HEADER_MAX);
     if (NULL != ack)
     {
         ack->Init();
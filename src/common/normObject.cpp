@@ -1148,8 +1148,10 @@ bool NormObject::IsRepairPending(bool flush)
             {
                 bool isPending;
                 UINT16 numData = GetBlockSize(nextId);
-                //if (flush || (nextId < current_block_id))
-                if (flush || (Compare(nextId, current_block_id) < 0))
+                if (block->FlagIsSet(NormBlock::DECODE_PENDING))
+                    isPending = false;  // block has all it needs, decoding in progress
+                //else if (flush || (nextId < current_block_id))
+                else if (flush || (Compare(nextId, current_block_id) < 0))
                 {
                     isPending = block->IsRepairPending(numData, nparity);
                 }
@@ -1288,6 +1290,9 @@ bool NormObject::AppendRepairRequest(NormNackMsg&   nack,
                 {
                     blockIsPending = true;   
                 }
+                // (blocks being decoded by the FEC worker pool aren't NACKed)
+                if (block->FlagIsSet(NormBlock::DECODE_PENDING))
+                    blockIsPending = false;
                 if (blockIsPending && (NACK_NONE != nacking_mode))
                 {
                     UINT16 numData = GetBlockSize(nextId);
@@ -1476,7 +1481,8 @@ void NormObject::HandleObjectMessage(const NormObjectMsg& msg,
                 block->RxInit(blockId, numData, nparity);
                 block_buffer.Insert(block);
             }
-            if (block->IsPending(segmentId))
+            // (blocks being decoded by the FEC worker pool need no more segments)
+            if (block->IsPending(segmentId) && !block->FlagIsSet(NormBlock::DECODE_PENDING))
             {
                 UINT16 segmentLength = data.GetPayloadDataLength();
                 if (segmentLength > segment_size)
@@ -1601,42 +1607,52 @@ void NormObject::HandleObjectMessage(const NormObjectMsg& msg,
                         }  // end if (nextErasure < numData)
                     }  // end if (block->GetFirstPending(nextErasure))                 
                     
-                    if (erasureCount)
+                    if ((0 != erasureCount) && ReceiverQueueDecodeJob(block, numData, erasureCount))
                     {
-                        sender->Decode(block->SegmentList(), numData, erasureCount); 
-                        for (UINT16 i = 0; i < erasureCount; i++) 
+                        // The FEC worker pool decodes (from its own copy of the segments)
+                        // and the block is completed later by ReceiverHandleDecodeJob()
+                        for (UINT16 i = 0; i < retrievalCount; i++) 
+                            block->DetachSegment(sender->GetRetrievalLoc(i));
+                    }
+                    else
+                    {
+                        if (erasureCount)
                         {
-                            NormSegmentId sid = sender->GetErasureLoc(i);
-                            if (sid < numData)
+                            sender->Decode(block->SegmentList(), numData, erasureCount); 
+                            for (UINT16 i = 0; i < erasureCount; i++) 
                             {
-                                if (WriteSegment(blockId, sid, block->GetSegment(sid)))
+                                NormSegmentId sid = sender->GetErasureLoc(i);
+                                if (sid < numData)
                                 {
-                                    objectUpdated = true;
-                                    // For statistics only (TBD) #ifdef NORM_DEBUG
-                                    // "segmentLength" is not necessarily correct here (TBD - fix this)
-                                    sender->IncrementRecvGoodput(segmentLength);
-                                }  
+                                    if (WriteSegment(blockId, sid, block->GetSegment(sid)))
+                                    {
+                                        objectUpdated = true;
+                                        // For statistics only (TBD) #ifdef NORM_DEBUG
+                                        // "segmentLength" is not necessarily correct here (TBD - fix this)
+                                        sender->IncrementRecvGoodput(segmentLength);
+                                    }  
+                                    else
+                                    {
+                                        if (IsStream())
+                                            PLOG(PL_DEBUG, "NormObject::HandleObjectMessage() WriteSegment() error\n");
+                                        else
+                                            PLOG(PL_ERROR, "NormObject::HandleObjectMessage() WriteSegment() error\n");
+                                    } 
+                                }
                                 else
                                 {
-                                    if (IsStream())
-                                        PLOG(PL_DEBUG, "NormObject::HandleObjectMessage() WriteSegment() error\n");
-                                    else
-                                        PLOG(PL_ERROR, "NormObject::HandleObjectMessage() WriteSegment() error\n");
-                                } 
-                            }
-                            else
-                            {
-                                break;
+                                    break;
+                                }
                             }
                         }
+                        // Clear any temporarily retrieved segments for the block
+                        for (UINT16 i = 0; i < retrievalCount; i++) 
+                            block->DetachSegment(sender->GetRetrievalLoc(i));
+                        // OK, we're done with this block
+                        pending_mask.Unset(blockId.GetValue());
+                        block_buffer.Remove(block);
+                        sender->PutFreeBlock(block); 
                     }
-                    // Clear any temporarily retrieved segments for the block
-                    for (UINT16 i = 0; i < retrievalCount; i++) 
-                        block->DetachSegment(sender->GetRetrievalLoc(i));
-                    // OK, we're done with this block
-                    pending_mask.Unset(blockId.GetValue());
-                    block_buffer.Remove(block);
-                    sender->PutFreeBlock(block); 
                 }  // if erasureCount <= parityCount (i.e., block complete)
                 // Notify application of new data available
                 // (TBD) this could be improved for stream objects
@@ -1644,10 +1660,7 @@ void NormObject::HandleObjectMessage(const NormObjectMsg& msg,
                 if (objectUpdated && notify_on_update)
                 {
                     if ((NULL == stream) || stream->DetermineReadReadiness() || session.RcvrIsLowDelay())
-                    {
-                        notify_on_update = false;
-                        session.Notify(NormController::RX_OBJECT_UPDATED, sender, this);
-                    }
+                        NotifyUpdated();
                 }   
             }
             else
@@ -1668,6 +1681,104 @@ void NormObject::HandleObjectMessage(const NormObjectMsg& msg,
                     
 }  // end NormObject::HandleObjectMessage()
 
+// Queues decoding of a block (with its segment list and the sender's erasure locations
+// set up for decoding) to the session FEC worker pool
+bool NormObject::ReceiverQueueDecodeJob(NormBlock* block, UINT16 numData, UINT16 erasureCount)
+{
+    NormFecJob* job = session.GetFreeFecJob();
+    if (NULL == job) return false;  // pool not open or job limit reached
+    UINT16 payloadMax = segment_size + NormDataMsg::GetStreamPayloadHeaderLength();
+#ifdef SIMULATE
+    payloadMax = MIN(payloadMax, SIM_PAYLOAD_MAX);
+#endif // SIMULATE
+    if (!job->Init(NormFecJob::DECODE, fec_id, fec_m, ndata, nparity, payloadMax))
+    {
+        session.PutFreeFecJob(job);
+        return false;
+    }
+    // The job gets its own copy of the segments (erased source segments are zeroed)
+    UINT16 blockLen = numData + nparity;
+    for (UINT16 i = 0; i < blockLen; i++)
+    {
+        char* segment = block->GetSegment(i);
+        if (NULL != segment)
+            memcpy(job->GetVector(i), segment, payloadMax);
+    }
+    for (UINT16 i = 0; i < erasureCount; i++)
+        job->SetErasureLoc(i, sender->GetErasureLoc(i));
+    job->SetErasureCount(erasureCount);
+    job->SetBlock(sender, sender->GetId(), this, transport_id, block->GetId(), numData);
+    block->SetFlag(NormBlock::DECODE_PENDING);
+    session.SubmitFecJob(job);
+    return true;
+}  // end NormObject::ReceiverQueueDecodeJob()
+
+// Returns true if the block was completed
+bool NormObject::ReceiverHandleDecodeJob(NormFecJob& job)
+{
+    NormBlockId blockId = job.GetBlockId();
+    NormBlock* block = block_buffer.Find(blockId);
+    // Ignore result if the block has since been dropped
+    if ((NULL == block) || !block->FlagIsSet(NormBlock::DECODE_PENDING)) return false;
+    block->ClearFlag(NormBlock::DECODE_PENDING);
+    if (!job.IsComplete())
+    {
+        // (block remains pending and will be requested for repair)
+        PLOG(PL_ERROR, "NormObject::ReceiverHandleDecodeJob() node>%lu sender>%lu obj>%hu blk>%lu decode failure\n",
+                (unsigned long)LocalNodeId(), (unsigned long)sender->GetId(), 
+                (UINT16)transport_id, (unsigned long)blockId.GetValue());
+        return false;
+    }
+    bool objectUpdated = false;
+    UINT16 numData = job.GetNumData();
+    for (UINT16 i = 0; i < job.GetErasureCount(); i++)
+    {
+        NormSegmentId sid = job.GetErasureLoc(i);
+        if (sid >= numData) break;
+        if (WriteSegment(blockId, sid, job.GetVector(sid)))
+        {
+            objectUpdated = true;
+            // For statistics only (TBD) #ifdef NORM_DEBUG
+            sender->IncrementRecvGoodput(segment_size);
+        }
+        else
+        {
+            if (IsStream())
+                PLOG(PL_DEBUG, "NormObject::ReceiverHandleDecodeJob() WriteSegment() error\n");
+            else
+                PLOG(PL_ERROR, "NormObject::ReceiverHandleDecodeJob() WriteSegment() error\n");
+        }
+    }
+    // OK, we're done with this block
+    pending_mask.Unset(blockId.GetValue());
+    block_buffer.Remove(block);
+    sender->PutFreeBlock(block); 
+    if (objectUpdated && notify_on_update)
+    {
+        NormStreamObject* stream = IsStream() ? static_cast<NormStreamObject*>(this) : NULL;
+        if ((NULL == stream) || stream->DetermineReadReadiness() || session.RcvrIsLowDelay())
+            NotifyUpdated();
+    }
+    return true;
+}  // end NormObject::ReceiverHandleDecodeJob()
+
+void NormObject::NotifyUpdated()
+{
+    notify_on_update = false;
+    if (IsStream())
+    {
+        // A staged receive stream is read by the NORM thread into its
+        // staging ring, which then notifies the app as needed
+        NormStreamObject* stream = static_cast<NormStreamObject*>(this);
+        if (stream->IsStaged() && stream->StageIsSynced())
+        {
+            stream->StagePump();
+            return;
+        }
+    }
+    session.Notify(NormController::RX_OBJECT_UPDATED, sender, this);
+}  // end NormObject::NotifyUpdated()
+
 // Returns source symbol segments to pool for ordinally _first_ block with such resources
 bool NormObject::ReclaimSourceSegments(NormSegmentPool& segmentPool)
 {
@@ -1981,6 +2092,10 @@ bool NormObject::NextSenderMsg(NormObjectMsg* msg)
                }
            }  // end while (!block_buffer.Insert())
            if (NULL == block) continue;
+           // With a FEC worker pool, the parity calculation for non-stream objects
+           // can start right away, overlapping transmission of the source segments
+           if ((0 != nparity) && !IsStream() && session.FecPoolIsOpen())
+               SenderQueueParityJob(block);
         }  // end if (!block)
         if (!block->GetFirstPending(segmentId)) 
         {
@@ -2031,7 +2146,10 @@ bool NormObject::NextSenderMsg(NormObjectMsg* msg)
             data->SetPayloadLength(payloadLength);
 
             // Perform incremental FEC encoding as needed
-            if ((block->ParityReadiness() == segmentId) && (0 != nparity)) 
+            // (with block encoding, parity is instead calculated when first needed
+            //  and the FEC worker pool calculates it once the block data is available)
+            if ((block->ParityReadiness() == segmentId) && (0 != nparity) && 
+                !session.SenderBlockEncode() && !session.FecPoolIsOpen()) 
                // (TBD) && ((incrementalParity == true) || (auto_parity != 0))
             {
                 // (TBD) for non-stream objects, catch alternate "last block/segment len"
@@ -2047,12 +2165,27 @@ bool NormObject::NextSenderMsg(NormObjectMsg* msg)
                 session.SenderEncode(segmentId, data->AccessPayload(), block->SegmentList(numData)); 
                 block->IncreaseParityReadiness();     
             }
+            else if ((segmentId == (numData - 1)) && (0 != nparity) && session.FecPoolIsOpen() &&
+                     !block->ParityReady(numData) && !block->FlagIsSet(NormBlock::PARITY_PENDING))
+            {
+                // All of the block's data is now available (e.g., for streams)
+                SenderQueueParityJob(block);
+            }
         }
         else
         {   
-            if (!block->ParityReady(numData)) 
+            // (parity for recently repaired blocks may still be cached, but
+            //  first-time transmissions are not worth the cache lookup)
+            if (!block->ParityReady(numData) && 
+                !(block->InRepair() && session.SenderRestoreParity(transport_id, *block, numData))) 
             {
-                ASSERT(0 == block->ParityReadiness());
+                if (block->FlagIsSet(NormBlock::PARITY_PENDING) ||
+                    (session.FecPoolIsOpen() && SenderQueueParityJob(block)))
+                {
+                    // Transmission resumes when the FEC worker pool result is ready
+                    session.SenderSetFecWait();
+                    return false;
+                }
                 CalculateBlockParity(block);
             }
             char* segment = block->GetSegment(segmentId);
@@ -2199,8 +2332,40 @@ NormBlockId NormStreamObject::RepairWindowLo() const
 bool NormObject::CalculateBlockParity(NormBlock* block)
 {
     if (0 == nparity) return true;
-    char buffer[NormMsg::MAX_SIZE];
     UINT16 numData = GetBlockSize(block->GetId());
+    if (session.SenderBlockEncode())
+    {
+        // Gather the block's source segments and encode the whole block at once
+        // (this overwrites any partial incremental parity the block might have)
+        char** vectorList = session.SenderBlockVectorList();
+        UINT16 payloadMax = segment_size+NormDataMsg::GetStreamPayloadHeaderLength();
+#ifdef SIMULATE
+        payloadMax = MIN(payloadMax, SIM_PAYLOAD_MAX);
+#endif // SIMULATE
+        for (UINT16 i = 0; i < numData; i++)
+        {
+            UINT16 payloadLength = ReadSegment(block->GetId(), i, vectorList[i]);
+            if (0 == payloadLength) return false;
+            if (payloadLength < payloadMax)
+                memset(vectorList[i]+payloadLength, 0, payloadMax-payloadLength);
+            block->UpdateSegSizeMax(payloadLength);
+        }
+        session.SenderEncodeBlock((const char**)vectorList, block->SegmentList(numData), numData);
+        block->SetParityReadiness(numData);
+        return true;
+    }
+    if (0 != block->ParityReadiness())
+    {
+        // Discard partial incremental parity (e.g., FEC worker pool was enabled mid-block)
+        UINT16 payloadMax = segment_size+NormDataMsg::GetStreamPayloadHeaderLength();
+#ifdef SIMULATE
+        payloadMax = MIN(payloadMax, SIM_PAYLOAD_MAX);
+#endif // SIMULATE
+        for (UINT16 i = 0; i < nparity; i++)
+            memset(block->GetSegment(numData+i), 0, payloadMax);
+        block->SetParityReadiness(0);
+    }
+    char buffer[NormMsg::MAX_SIZE];
     for (UINT16 i = 0; i < numData; i++)
     {
         UINT16 payloadLength = ReadSegment(block->GetId(), i, buffer);
@@ -2224,6 +2389,63 @@ bool NormObject::CalculateBlockParity(NormBlock* block)
     return true;
 }  // end NormObject::CalculateBlockParity()
 
+bool NormObject::SenderQueueParityJob(NormBlock* block)
+{
+    NormFecJob* job = session.GetFreeFecJob();
+    if (NULL == job) return false;  // pool not open or job limit reached
+    UINT16 payloadMax = segment_size+NormDataMsg::GetStreamPayloadHeaderLength();
+#ifdef SIMULATE
+    payloadMax = MIN(payloadMax, SIM_PAYLOAD_MAX);
+#endif // SIMULATE
+    NormBlockId blockId = block->GetId();
+    UINT16 numData = GetBlockSize(blockId);
+    if (!job->Init(NormFecJob::ENCODE, fec_id, fec_m, ndata, nparity, payloadMax))
+    {
+        session.PutFreeFecJob(job);
+        return false;
+    }
+    // The job gets its own zero-padded copy of the block's source segments
+    UINT16 segSizeMax = 0;
+    for (UINT16 i = 0; i < numData; i++)
+    {
+        char* vector = job->GetVector(i);
+        UINT16 payloadLength = ReadSegment(blockId, i, vector);
+        if (0 == payloadLength)
+        {
+            session.PutFreeFecJob(job);
+            return false;
+        }
+        if (payloadLength < payloadMax)
+            memset(vector+payloadLength, 0, payloadMax-payloadLength);
+        if (payloadLength > segSizeMax) segSizeMax = payloadLength;
+    }
+    job->SetSegSizeMax(segSizeMax);
+    job->SetBlock(NULL, LocalNodeId(), this, transport_id, blockId, numData);
+    block->SetFlag(NormBlock::PARITY_PENDING);
+    session.SubmitFecJob(job);
+    return true;
+}  // end NormObject::SenderQueueParityJob()
+
+void NormObject::SenderHandleParityJob(NormFecJob& job)
+{
+    NormBlock* block = block_buffer.Find(job.GetBlockId());
+    // Ignore result if the block has since been released or reset
+    if ((NULL == block) || !block->FlagIsSet(NormBlock::PARITY_PENDING)) return;
+    block->ClearFlag(NormBlock::PARITY_PENDING);
+    UINT16 numData = job.GetNumData();
+    if (block->ParityReady(numData)) return;
+    if (!job.IsComplete())
+    {
+        CalculateBlockParity(block);
+        return;
+    }
+    UINT16 vecSize = job.GetVectorSize();
+    for (UINT16 i = 0; i < nparity; i++)
+        memcpy(block->GetSegment(numData+i), job.GetVector(numData+i), vecSize);
+    block->UpdateSegSizeMax(job.GetSegSizeMax());
+    block->SetParityReadiness(numData);
+}  // end NormObject::SenderHandleParityJob()
+
 NormBlock* NormObject::SenderRecoverBlock(NormBlockId blockId)
 {
     NormBlock* block = session.SenderGetFreeBlock(transport_id, blockId);
@@ -2254,8 +2476,9 @@ NormBlock* NormObject::SenderRecoverBlock(NormBlockId blockId)
                 return (NormBlock*)NULL;
             }
         }      
-        // Attempt to re-generate parity for the block
-        if (CalculateBlockParity(block))
+        // Attempt to restore cached parity or else re-generate parity for the block
+        if (session.SenderRestoreParity(transport_id, *block, numData) || 
+            CalculateBlockParity(block))
         {
             if (!block_buffer.Insert(block))
             {
@@ -2288,7 +2511,9 @@ NormFileObject::NormFileObject(class NormSession&       theSession,
                                class NormSenderNode*    theSender,
                                const NormObjectId&      objectId)
  : NormObject(FILE, theSession, theSender, objectId), 
-   large_block_length(0), small_block_length(0)
+   large_block_length(0), small_block_length(0), map_next(0),
+   read_ahead_count(0), read_ahead_block(0), read_ahead_valid(false), write_pending(0),
+   write_failed(false)
 {
     path[0] = '\0';
 }
@@ -2323,6 +2548,10 @@ bool NormFileObject::Open(const char* thePath,
                 PLOG(PL_FATAL, "NormFileObject::Open() recv file.Open() error!\n");
                 return false;
             }
+            // Received content is written directly into a preallocated mapping
+            NormFile::Offset size = GetSize().GetOffset();
+            if (session.GetFileMapping() && (0 != size) && !file.Map(size, true))
+                PLOG(PL_WARN, "NormFileObject::Open() warning: unable to map recv file (using write() instead)\n");
         }  
     }
     else
@@ -2354,6 +2583,9 @@ bool NormFileObject::Open(const char* thePath,
                     Close();
                     return false;
                 }
+                // Transmitted segments are copied directly from a read-only mapping
+                if (session.GetFileMapping() && (0 != size) && !file.Map(size, false))
+                    PLOG(PL_WARN, "NormFileObject::Open() warning: unable to map send file (using read() instead)\n");
             }
             /*
             else
@@ -2393,12 +2625,24 @@ bool NormFileObject::Accept(const char* thePath)
 
 void NormFileObject::Close()
 {
+    // Any asynchronous writes must complete before the file is closed
+    // (and, for receivers, before the RX_OBJECT_COMPLETED notification)
+    FlushIoJobs();
+    for (unsigned int i = 0; i < read_ahead_count; i++)
+        session.PutFreeFileIoJob(read_ahead_list[i]);
+    read_ahead_count = 0;
+    read_ahead_valid = false;
     if (file.IsOpen())
     {
         if (NULL != sender)  // we've been receiving this file
+        {
+            // Start writeback of received content (without blocking)
+            file.Sync(false);
             file.Unlock();
+        }
         file.Close();
     }
+    map_next = 0;
     NormObject::Close();
 }  // end NormFileObject::Close()
 
@@ -2418,21 +2662,29 @@ bool NormFileObject::WriteSegment(NormBlockId   blockId,
     {
         len = segment_size;
     }
-    // Determine segment offset from blockId::segmentId
-    NormObjectSize segmentOffset;
-    NormObjectSize segmentSize = NormObjectSize(segment_size);
-    if (blockId.GetValue() < large_block_count)
+    NormFile::Offset offset = GetSegmentOffset(blockId, segmentId);
+    if (file.IsMapped())
     {
-        segmentOffset = (large_block_length*blockId.GetValue()) + (segmentSize*segmentId);
+        if ((offset + (NormFile::Offset)len) > file.GetMapSize()) return false;
+        memcpy(file.GetMapping() + offset, buffer, len);
+        return true;
     }
-    else
+    if (session.FileIoPoolIsOpen())
     {
-        segmentOffset = large_block_length*large_block_count;  // (TBD) pre-calc this 
-        UINT32 smallBlockIndex = blockId.GetValue() - large_block_count;
-        segmentOffset = segmentOffset + small_block_length*smallBlockIndex +
-                                        segmentSize*segmentId;
+        // Hand the write off to the file I/O pool (or do it here if no job is free)
+        NormFileIoJob* job = session.GetFreeFileIoJob();
+        if (NULL != job)
+        {
+            if (job->Init(NormFileIoJob::WRITE, this, file.GetDescriptor(), offset, (unsigned int)len))
+            {
+                memcpy(job->GetBuffer(), buffer, len);
+                session.SubmitFileIoJob(job);
+                write_pending++;
+                return true;
+            }
+            session.PutFreeFileIoJob(job);
+        }
     }
-	NormFile::Offset offset = segmentOffset.GetOffset();
     if (offset != file.GetOffset())
     {
         if (!file.Seek(offset)) return false; 
@@ -2460,21 +2712,46 @@ UINT16 NormFileObject::ReadSegment(NormBlockId      blockId,
         len = segment_size;
     }
     
-    // Determine segment offset from blockId::segmentId
-    NormObjectSize segmentOffset;
-    NormObjectSize segmentSize = NormObjectSize(segment_size);
-    if (blockId.GetValue() < large_block_count)
+    NormFile::Offset offset = GetSegmentOffset(blockId, segmentId);
+    if (file.IsMapped())
     {
-        segmentOffset = large_block_length*blockId.GetValue() + segmentSize*segmentId;
+        if ((offset + (NormFile::Offset)len) > file.GetMapSize())
+        {
+            PLOG(PL_FATAL, "NormFileObject::ReadSegment() error: segment beyond mapped file size\n");
+            return 0;
+        }
+        if (offset != map_next)
+        {
+            // Out-of-order (e.g. repair) access, so hint the rest of the block in
+            NormFile::Offset blockRemainder = 
+                (NormFile::Offset)(GetBlockSize(blockId) - segmentId) * segment_size;
+            file.Prefetch(offset, blockRemainder);
+        }
+        memcpy(buffer, file.GetMapping() + offset, len);
+        map_next = offset + len;
+        return (UINT16)len;
+    }
+    if (NULL != sender)
+    {
+        // Receiver retrieval of content that may not yet be written
+        if (0 != write_pending) FlushIoJobs();
     }
     else
     {
-        segmentOffset = large_block_length*large_block_count;  // (TBD) pre-calc this  
-        UINT32 smallBlockIndex = blockId.GetValue() - large_block_count;
-        segmentOffset = segmentOffset + small_block_length*smallBlockIndex +
-                                        segmentSize*segmentId;
+        // Serve from a completed read-ahead job when available
+        for (unsigned int i = 0; i < read_ahead_count; i++)
+        {
+            NormFileIoJob* job = read_ahead_list[i];
+            if ((job->GetBlockId() == blockId) && job->IsDone())
+            {
+                if (!job->IsComplete()) break;  // (read error, so try again below)
+                memcpy(buffer, job->GetBuffer() + (offset - job->GetOffset()), len);
+                ReadAhead(blockId);
+                return (UINT16)len;
+            }
+        }
+        if (session.FileIoPoolIsOpen()) ReadAhead(blockId);
     }
-	NormFile::Offset offset = segmentOffset.GetOffset();
     if (offset != file.GetOffset())
     {
         if (!file.Seek(offset))
@@ -2492,6 +2769,113 @@ UINT16 NormFileObject::ReadSegment(NormBlockId      blockId,
         return 0;
 }  // end NormFileObject::ReadSegment()
 
+// Determine segment offset from blockId::segmentId
+NormFile::Offset NormFileObject::GetSegmentOffset(NormBlockId blockId, NormSegmentId segmentId) const
+{
+    NormObjectSize segmentOffset;
+    NormObjectSize segmentSize = NormObjectSize(segment_size);
+    if (blockId.GetValue() < large_block_count)
+    {
+        segmentOffset = large_block_length*blockId.GetValue() + segmentSize*segmentId;
+    }
+    else
+    {
+        segmentOffset = large_block_length*large_block_count;  // (TBD) pre-calc this  
+        UINT32 smallBlockIndex = blockId.GetValue() - large_block_count;
+        segmentOffset = segmentOffset + small_block_length*smallBlockIndex +
+                                        segmentSize*segmentId;
+    }
+    return segmentOffset.GetOffset();
+}  // end NormFileObject::GetSegmentOffset()
+
+// Requests asynchronous reads of the blocks following "blockId" as the sender
+// transmit position advances (repairs of earlier blocks are read synchronously)
+void NormFileObject::ReadAhead(NormBlockId blockId)
+{
+    UINT32 blockValue = blockId.GetValue();
+    if (read_ahead_valid && (blockValue <= read_ahead_block)) return;
+    read_ahead_block = blockValue;
+    read_ahead_valid = true;
+    // Release completed read-ahead for blocks now passed
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < read_ahead_count; i++)
+    {
+        NormFileIoJob* job = read_ahead_list[i];
+        if (job->IsDone() && (job->GetBlockId().GetValue() < blockValue))
+            session.PutFreeFileIoJob(job);
+        else
+            read_ahead_list[count++] = job;
+    }
+    read_ahead_count = count;
+    if (!session.FileIoPoolIsOpen()) return;
+    UINT32 lastBlock = blockValue + session.GetFileReadAhead();
+    if (lastBlock > final_block_id.GetValue()) 
+        lastBlock = final_block_id.GetValue();
+    for (UINT32 nextBlock = blockValue + 1; nextBlock <= lastBlock; nextBlock++)
+    {
+        NormBlockId nextId(nextBlock);
+        bool pending = false;
+        for (unsigned int i = 0; i < read_ahead_count; i++)
+        {
+            if (read_ahead_list[i]->GetBlockId() == nextId)
+            {
+                pending = true;
+                break;
+            }
+        }
+        if (pending) continue;
+        if (READ_AHEAD_MAX == read_ahead_count) break;
+        NormFileIoJob* job = session.GetFreeFileIoJob();
+        if (NULL == job) break;
+        UINT32 numSegments = GetBlockSize(nextId);
+        unsigned int length = (numSegments - 1) * segment_size;
+        length += (nextId == final_block_id) ? final_segment_size : segment_size;
+        if (!job->Init(NormFileIoJob::READ, this, file.GetDescriptor(), GetSegmentOffset(nextId, 0), length))
+        {
+            session.PutFreeFileIoJob(job);
+            break;
+        }
+        job->SetBlockId(nextId);
+        session.SubmitFileIoJob(job);
+        read_ahead_list[read_ahead_count++] = job;
+    }
+}  // end NormFileObject::ReadAhead()
+
+void NormFileObject::FlushIoJobs()
+{
+    bool pending = (0 != write_pending);
+    for (unsigned int i = 0; !pending && (i < read_ahead_count); i++)
+        pending = !read_ahead_list[i]->IsDone();
+    if (pending) session.FlushFileIoJobs(this);
+    ASSERT(0 == write_pending);
+}  // end NormFileObject::FlushIoJobs()
+
+void NormFileObject::HandleIoJob(NormFileIoJob* job)
+{
+    if (NormFileIoJob::WRITE == job->GetType())
+    {
+        ASSERT(0 != write_pending);
+        write_pending--;
+        if (!job->IsComplete())
+        {
+            // Retry failed write synchronously (for error reporting)
+            PLOG(PL_WARN, "NormFileObject::HandleIoJob() warning: asynchronous write failed, retrying ...\n");
+            if (!file.Seek(job->GetOffset()) || (job->GetLength() != file.Write(job->GetBuffer(), job->GetLength())))
+            {
+                // (WriteSegment() already succeeded, so the sender node aborts
+                //  the object when it next checks its completion status)
+                PLOG(PL_ERROR, "NormFileObject::HandleIoJob() error: unable to write received content\n");
+                write_failed = true;
+            }
+        }
+        session.PutFreeFileIoJob(job);
+    }
+    else
+    {
+        job->SetDone(true);  // (remains in the read_ahead_list)
+    }
+}  // end NormFileObject::HandleIoJob()
+
 char* NormFileObject::RetrieveSegment(NormBlockId      blockId, 
                                       NormSegmentId    segmentId)
 {
@@ -2530,7 +2914,7 @@ NormDataObject::NormDataObject(class NormSession&       theSession,
  : NormObject(DATA, theSession, theSender, objectId), 
    large_block_length(0), small_block_length(0),
    data_ptr(NULL), data_max(0), data_released(false),
-   data_free_func(dataFreeFunc)
+   data_free_func(dataFreeFunc), frag_list(NULL), frag_count(0)
 {
     
 }
@@ -2550,6 +2934,7 @@ NormDataObject::~NormDataObject()
         }
         data_released = false;
     }
+    ClearFragments();
 }
 
 // Assign data object to data ptr
@@ -2568,6 +2953,7 @@ bool NormDataObject::Open(char*       dataPtr,
         data_ptr = NULL;
         data_released = false;   
     }
+    ClearFragments();
     if (NULL == sender)
     {
         // We're sending this data object
@@ -2597,6 +2983,93 @@ bool NormDataObject::Open(char*       dataPtr,
     small_block_length = NormObjectSize(small_block_size) * segment_size;
     return true;
 }  // end NormDataObject::Open()
+
+bool NormDataObject::Open(const NormDataFragment* fragList,
+                          unsigned int            fragCount,
+                          const char*             infoPtr,
+                          UINT16                  infoLen)
+{
+    if (NULL != sender)
+    {
+        PLOG(PL_FATAL, "NormDataObject::Open() error: fragmented receive object\n");
+        return false;
+    }
+    UINT32 dataLen = 0;
+    for (unsigned int i = 0; i < fragCount; i++)
+    {
+        if ((NULL == fragList[i].data) && (0 != fragList[i].length))
+        {
+            PLOG(PL_FATAL, "NormDataObject::Open() error: NULL fragment data\n");
+            return false;
+        }
+        if ((dataLen + fragList[i].length) < dataLen)
+        {
+            PLOG(PL_FATAL, "NormDataObject::Open() error: fragmented object too large\n");
+            return false;
+        }
+        dataLen += fragList[i].length;
+    }
+    Fragment* fragments = new Fragment[(0 != fragCount) ? fragCount : 1];
+    if (NULL == fragments)
+    {
+        PLOG(PL_FATAL, "NormDataObject::Open() new fragment list error: %s\n", GetErrorString());
+        return false;
+    }
+    UINT32 offset = 0;
+    for (unsigned int i = 0; i < fragCount; i++)
+    {
+        fragments[i].data = fragList[i].data;
+        fragments[i].length = fragList[i].length;
+        fragments[i].offset = offset;
+        offset += fragList[i].length;
+    }
+    if (!Open((char*)NULL, dataLen, false, infoPtr, infoLen))
+    {
+        delete[] fragments;
+        return false;
+    }
+    frag_list = fragments;
+    frag_count = fragCount;
+    return true;
+}  // end NormDataObject::Open(fragments)
+
+void NormDataObject::ClearFragments()
+{
+    if (NULL != frag_list)
+    {
+        delete[] frag_list;
+        frag_list = NULL;
+    }
+    frag_count = 0;
+}  // end NormDataObject::ClearFragments()
+
+// Copies "len" bytes of the fragmented object content at "offset" into "buffer"
+UINT16 NormDataObject::GatherSegment(UINT32 offset, UINT16 len, char* buffer)
+{
+    // Binary search for the last fragment starting at or before "offset"
+    // (this skips any zero-length fragments at that same offset)
+    unsigned int lo = 0;
+    unsigned int hi = frag_count;
+    while ((hi - lo) > 1)
+    {
+        unsigned int mid = (lo + hi) >> 1;
+        if (frag_list[mid].offset <= offset)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    UINT16 count = 0;
+    UINT32 fragOffset = offset - frag_list[lo].offset;
+    for (unsigned int i = lo; (i < frag_count) && (count < len); i++)
+    {
+        UINT32 avail = frag_list[i].length - fragOffset;
+        UINT16 n = (avail < (UINT32)(len - count)) ? (UINT16)avail : (len - count);
+        memcpy(buffer + count, frag_list[i].data + fragOffset, n);
+        count += n;
+        fragOffset = 0;
+    }
+    return count;
+}  // end NormDataObject::GatherSegment()
                 
 bool NormDataObject::Accept(char* dataPtr, UINT32 dataMax, bool dataRelease)
 {
@@ -2665,7 +3138,7 @@ UINT16 NormDataObject::ReadSegment(NormBlockId      blockId,
                                    NormSegmentId    segmentId,
                                    char*            buffer)            
 {
-    if (NULL == data_ptr)
+    if ((NULL == data_ptr) && (NULL == frag_list))
     {
         PLOG(PL_FATAL, "NormDataObject::ReadSegment() error: NULL data_ptr\n");
         return 0;    
@@ -2704,6 +3177,8 @@ UINT16 NormDataObject::ReadSegment(NormBlockId      blockId,
     else if (data_max <= (segmentOffset.LSB() + len))
         len -= (segmentOffset.LSB() + len - data_max);
     
+    if (NULL != frag_list)
+        return GatherSegment(segmentOffset.LSB(), len, buffer);
     memcpy(buffer, data_ptr + segmentOffset.LSB(), len);
     return len;
 }  // end NormDataObject::ReadSegment()
@@ -2770,6 +3245,92 @@ char* NormDataObject::RetrieveSegment(NormBlockId   blockId,
 // NormStreamObject Implementation
 //
 
+NormStreamStage::NormStreamStage()
+ : buffer(NULL), mask(0), write_index(0), read_index(0)
+{
+}
+
+NormStreamStage::~NormStreamStage()
+{
+    Destroy();
+}
+
+bool NormStreamStage::Init(unsigned int bufferSize)
+{
+    Destroy();
+    UINT32 size = 256;
+    while ((size < bufferSize) && (size < 0x40000000)) size <<= 1;
+    if (NULL == (buffer = new char[size]))
+    {
+        PLOG(PL_FATAL, "NormStreamStage::Init() new buffer error: %s\n", GetErrorString());
+        return false;
+    }
+    mask = size - 1;
+    write_index = read_index = 0;
+    return true;
+}  // end NormStreamStage::Init()
+
+void NormStreamStage::Destroy()
+{
+    if (NULL != buffer)
+    {
+        delete[] buffer;
+        buffer = NULL;
+    }
+    mask = 0;
+    write_index = read_index = 0;
+}  // end NormStreamStage::Destroy()
+
+unsigned int NormStreamStage::Write(const char* data, unsigned int len)
+{
+    UINT32 index = write_index;
+    unsigned int space = GetSize() - (index - NormAtomicLoad(&read_index));
+    if (len > space) len = space;
+    if (0 == len) return 0;
+    unsigned int offset = index & mask;
+    unsigned int count = GetSize() - offset;
+    if (count > len) count = len;
+    memcpy(buffer + offset, data, count);
+    if (count < len) memcpy(buffer, data + count, len - count);
+    NormAtomicStore(&write_index, index + len);
+    return len;
+}  // end NormStreamStage::Write()
+
+char* NormStreamStage::GetWriteSpace(unsigned int& len)
+{
+    UINT32 index = write_index;
+    len = GetSize() - (index - NormAtomicLoad(&read_index));
+    if (0 == len) return NULL;
+    unsigned int offset = index & mask;
+    if (len > (GetSize() - offset)) len = GetSize() - offset;
+    return (buffer + offset);
+}  // end NormStreamStage::GetWriteSpace()
+
+unsigned int NormStreamStage::Read(char* data, unsigned int len)
+{
+    UINT32 index = read_index;
+    unsigned int avail = NormAtomicLoad(&write_index) - index;
+    if (len > avail) len = avail;
+    if (0 == len) return 0;
+    unsigned int offset = index & mask;
+    unsigned int count = GetSize() - offset;
+    if (count > len) count = len;
+    memcpy(data, buffer + offset, count);
+    if (count < len) memcpy(data + count, buffer, len - count);
+    NormAtomicStore(&read_index, index + len);
+    return len;
+}  // end NormStreamStage::Read()
+
+const char* NormStreamStage::GetReadData(unsigned int& len)
+{
+    UINT32 index = read_index;
+    len = NormAtomicLoad(&write_index) - index;
+    if (0 == len) return NULL;
+    unsigned int offset = index & mask;
+    if (len > (GetSize() - offset)) len = GetSize() - offset;
+    return (buffer + offset);
+}  // end NormStreamStage::GetReadData()
+
 NormStreamObject::NormStreamObject(class NormSession&       theSession, 
                                    class NormSenderNode*    theSender,
                                    const NormObjectId&      objectId)
@@ -2779,13 +3340,28 @@ NormStreamObject::NormStreamObject(class NormSession&       theSession,
    flush_pending(false), msg_start(true),
    flush_mode(FLUSH_NONE), push_mode(false),
    stream_broken(false), stream_closing(false),
-   block_pool_threshold(0)
+   block_pool_threshold(0), stage_eom_list(NULL), stage_eom_write(0), stage_eom_read(0),
+   stage_event(false), stage_pending(0), stage_sync(0), stage_notify(0), stage_stalled(0), 
+   stage_break(0), stage_end(0), stage_offset(0), stage_pumping(false), stage_close(false),
+   write_loan(NULL), write_loan_size(0), read_loan(NULL)
 {
 }
 
 NormStreamObject::~NormStreamObject()
 {
     Close();    
+    if (stage_event.IsOpen()) stage_event.Close();
+    stage.Destroy();
+    if (NULL != read_loan)
+    {
+        segment_pool.Put(read_loan);
+        read_loan = NULL;
+    }
+    if (NULL != stage_eom_list)
+    {
+        delete[] stage_eom_list;
+        stage_eom_list = NULL;
+    }
     tx_offset = write_offset = read_offset = 0;
     NormBlock* b;
     while ((b = stream_buffer.Find(stream_buffer.RangeLo())))
@@ -2919,6 +3495,12 @@ void NormStreamObject::Close(bool graceful)
 {
     if (graceful && (NULL == sender))
     {
+        if (IsStaged() && !StageDrain())
+        {
+            // Stream is terminated once staged data has been written
+            stage_close = true;
+            return;
+        }
         Terminate();
         //SetFlushMode(FLUSH_ACTIVE);
         //Flush();
@@ -3199,7 +3781,11 @@ UINT16 NormStreamObject::ReadSegment(NormBlockId      blockId,
                 write_vacancy = true; 
             }
             if (write_vacancy) 
+            {
+                // Staged data is written first (outside of this call)
+                if (IsStaged() && !stage.IsEmpty()) RequestStageService();
                 session.Notify(NormController::TX_QUEUE_VACANCY, NULL, this); 
+            }
         }       
     }
     
@@ -3292,11 +3878,7 @@ bool NormStreamObject::WriteSegment(NormBlockId   blockId,
                 NormStreamObject::Index tempIndex = read_index;
                 // (TBD) uncomment the code so that only a single
                 // UPDATED notification is posted???
-                if (notify_on_update)
-                {
-                    notify_on_update = false;
-                    session.Notify(NormController::RX_OBJECT_UPDATED, sender, this);
-                } 
+                if (notify_on_update) NotifyUpdated();
                 block = stream_buffer.Find(stream_buffer.RangeLo());
                 if (tempBlock == block)
                 {
@@ -3359,6 +3941,8 @@ bool NormStreamObject::WriteSegment(NormBlockId   blockId,
         block = block_pool.Get();
         block->SetId(blockId);
         block->ClearPending();
+        // New stream data for this block id makes any cached parity stale
+        if (NULL == sender) session.SenderInvalidateParity(transport_id, blockId);
         //ASSERT(blockId >= read_index.block);
         ASSERT(Compare(blockId, read_index.block) >= 0);
         bool success = stream_buffer.Insert(block);
@@ -3466,8 +4050,7 @@ void NormStreamObject::Prune(NormBlockId blockId, bool updateStatus)
                 // If "updateStatus" is true, then Prune() was invoked due to SQUELCH
                 // This will prompt the app to read from the stream which, in turn
                 // will force the stream read_index forward
-                notify_on_update = false;
-                session.Notify(NormController::RX_OBJECT_UPDATED, sender, this);
+                NotifyUpdated();
             }
             sender->IncrementResyncCount();
         }
@@ -3846,13 +4429,17 @@ bool NormStreamObject::ReadPrivate(char* buffer, unsigned int* buflen, bool seek
         }
         UINT16 count = length - read_index.offset;
         count = MIN(count, bytesToRead);
+        // (a NULL "buffer" consumes data read in place via PeekRead())
+        if (NULL != buffer)
+        {
 #ifdef SIMULATE
-        UINT16 simCount = read_index.offset + count + NormDataMsg::GetStreamPayloadHeaderLength();
-        simCount = (simCount < SIM_PAYLOAD_MAX) ? (SIM_PAYLOAD_MAX - simCount) : 0;
-        memcpy(buffer+bytesRead, segment+read_index.offset+NormDataMsg::GetStreamPayloadHeaderLength(), simCount);
+            UINT16 simCount = read_index.offset + count + NormDataMsg::GetStreamPayloadHeaderLength();
+            simCount = (simCount < SIM_PAYLOAD_MAX) ? (SIM_PAYLOAD_MAX - simCount) : 0;
+            memcpy(buffer+bytesRead, segment+read_index.offset+NormDataMsg::GetStreamPayloadHeaderLength(), simCount);
 #else
-        memcpy(buffer+bytesRead, segment+read_index.offset+NormDataMsg::GetStreamPayloadHeaderLength(), count);
+            memcpy(buffer+bytesRead, segment+read_index.offset+NormDataMsg::GetStreamPayloadHeaderLength(), count);
 #endif // if/else SIMULATE
+        }
         
         read_index.offset += count;
         bytesRead += count;
@@ -3887,6 +4474,13 @@ bool NormStreamObject::ReadPrivate(char* buffer, unsigned int* buflen, bool seek
             if (streamEnded)
             {
                 PLOG(PL_DEBUG, "NormStreamObject::ReadPrivate() stream ended by sender 2\n");
+                if (stage_pumping)
+                {
+                    // Completion is posted after the app reads the staged data
+                    stream_closing = true;
+                    NormAtomicStore(&stage_end, 1);
+                    break;
+                }
                 session.Notify(NormController::RX_OBJECT_COMPLETED, sender, this);
                 stream_closing = true;
                 sender->DeleteObject(this);  
@@ -3935,6 +4529,7 @@ void NormStreamObject::Terminate()
         }
         block->SetId(write_index.block);
         block->ClearPending();
+        session.SenderInvalidateParity(transport_id, write_index.block);  // (stale if cached)
         bool success = stream_buffer.Insert(block);
         ASSERT(success);
     }  // end if (!block)
@@ -4034,138 +4629,168 @@ unsigned int NormStreamObject::GetVacancy(unsigned int wanted)
     return nBytes;
 }  // end NormStreamObject::GetVacancy()
 
-UINT32 NormStreamObject::Write(const char* buffer, UINT32 len, bool eom)
-{               
-    UINT32 nBytes = 0;
-    do
+// Returns the segment (and its "block") at the stream "write_index", allocating
+// them as needed, or NULL if the stream buffer is full
+char* NormStreamObject::GetWriteSegment(NormBlock*& block)
+{
+    // This old code detected buffer "fullness" by offset instead of segment index
+    // but, the problem there was when apps wrote & flushed messages smaller than
+    // the segment_size, the buffer was used up before this detected it.
+    //INT32 deltaOffset = write_offset - tx_offset;  // (TBD) deprecate tx_offset
+    //ASSERT(deltaOffset >= 0);
+    //if (deltaOffset >= (INT32)object_size.LSB())
+    //ASSERT(write_index.block >= tx_index.block);
+    ASSERT(Compare(write_index.block, tx_index.block) >= 0);
+    UINT32 deltaBlock = (UINT32)Difference(write_index.block, tx_index.block);
+    if (deltaBlock > (block_pool.GetTotal() >> 1))  
     {
-        if (stream_closing)
-        {
-            if (0 != len)
-            {
-                PLOG(PL_ERROR, "NormStreamObject::Write() error: stream is closing (len:%lu eom:%d)\n", 
-                                (unsigned long)len, eom);
-                len = 0;
-            }
-            break;
-        }
-        // This old code detected buffer "fullness" by offset instead of segment index
-        // but, the problem there was when apps wrote & flushed messages smaller than
-        // the segment_size, the buffer was used up before this detected it.
-        //INT32 deltaOffset = write_offset - tx_offset;  // (TBD) deprecate tx_offset
-        //ASSERT(deltaOffset >= 0);
-        //if (deltaOffset >= (INT32)object_size.LSB())
-        //ASSERT(write_index.block >= tx_index.block);
-        ASSERT(Compare(write_index.block, tx_index.block) >= 0);
-        UINT32 deltaBlock = (UINT32)Difference(write_index.block, tx_index.block);
-        if (deltaBlock > (block_pool.GetTotal() >> 1))  
-        {
-            write_vacancy = false;
-            PLOG(PL_DEBUG, "NormStreamObject::Write() stream buffer full (1)\n");
-            if (!push_mode) break;  
-        }
-        NormBlock* block = stream_buffer.Find(write_index.block);
+        write_vacancy = false;
+        PLOG(PL_DEBUG, "NormStreamObject::Write() stream buffer full (1)\n");
+        if (!push_mode) return NULL;  
+    }
+    block = stream_buffer.Find(write_index.block);
+    if (NULL == block)
+    {   
+        block = block_pool.Get();
         if (NULL == block)
-        {   
-            block = block_pool.Get();
-            if (NULL == block)
+        {
+            block = stream_buffer.Find(stream_buffer.RangeLo());
+            ASSERT(NULL != block);
+            double delay = session.GetFlowControlDelay() - block->GetNackAge();
+            if (block->IsPending() || (delay >= 1.0e-06))
             {
-                block = stream_buffer.Find(stream_buffer.RangeLo());
-                ASSERT(NULL != block);
-                double delay = session.GetFlowControlDelay() - block->GetNackAge();
-                if (block->IsPending() || (delay >= 1.0e-06))
+                write_vacancy = false;
+                if (push_mode)
                 {
-                    write_vacancy = false;
-                    if (push_mode)
+                    NormBlockId blockId = block->GetId();
+                    pending_mask.Unset(blockId.GetValue());
+                    repair_mask.Unset(blockId.GetValue());
+                    NormBlock* b = FindBlock(blockId);
+                    if (b)
                     {
-                        NormBlockId blockId = block->GetId();
-                        pending_mask.Unset(blockId.GetValue());
-                        repair_mask.Unset(blockId.GetValue());
-                        NormBlock* b = FindBlock(blockId);
-                        if (b)
-                        {
-                            block_buffer.Remove(b);
-                            session.SenderPutFreeBlock(b); 
-                        }   
-                        if (!pending_mask.IsSet()) 
-                        {
-                            pending_mask.Set(write_index.block.GetValue());  
-                            //stream_next_id = write_index.block + 1;
-                            stream_next_id = write_index.block;
-                            Increment(stream_next_id);
-                        }
+                        block_buffer.Remove(b);
+                        session.SenderPutFreeBlock(b); 
+                    }   
+                    if (!pending_mask.IsSet()) 
+                    {
+                        pending_mask.Set(write_index.block.GetValue());  
+                        //stream_next_id = write_index.block + 1;
+                        stream_next_id = write_index.block;
+                        Increment(stream_next_id);
                     }
-                    else
+                }
+                else
+                {
+                    // The timer activated here makes sure a deferred TX_QUEUE_VACANCY is posted
+                    // when flow control has been asserted.
+                    if (!block->IsPending())
                     {
-                        // The timer activated here makes sure a deferred TX_QUEUE_VACANCY is posted
-                        // when flow control has been asserted.
-                        if (!block->IsPending())
-                        {
-                            PLOG(PL_DEBUG, "NormStreamObject::Write() asserting flow control for stream (postedEmpty:%d)\n", 
-                                           session.GetPostedTxQueueEmpty());
-                            if (session.GetPostedTxQueueEmpty())
-                                session.ActivateFlowControl(delay, GetId(), NormController::TX_QUEUE_EMPTY);
-                            else
-                                session.ActivateFlowControl(delay, GetId(), NormController::TX_QUEUE_VACANCY);
-                        }
-                        PLOG(PL_DEBUG, "NormStreamObject::Write() stream buffer full (2) len:%d eom:%d\n", len, eom);
-                        break;
+                        PLOG(PL_DEBUG, "NormStreamObject::Write() asserting flow control for stream (postedEmpty:%d)\n", 
+                                       session.GetPostedTxQueueEmpty());
+                        if (session.GetPostedTxQueueEmpty())
+                            session.ActivateFlowControl(delay, GetId(), NormController::TX_QUEUE_EMPTY);
+                        else
+                            session.ActivateFlowControl(delay, GetId(), NormController::TX_QUEUE_VACANCY);
                     }
-                }                             
-                stream_buffer.Remove(block);
-                block->EmptyToPool(segment_pool);
-            }
-            block->SetId(write_index.block);
-            block->ClearPending();
-            bool success = stream_buffer.Insert(block);
-            ASSERT(success);
-        }  // end if (NULL == block)
-        char* segment = block->GetSegment(write_index.segment);
-        if (NULL == segment)
+                    PLOG(PL_DEBUG, "NormStreamObject::Write() stream buffer full (2)\n");
+                    return NULL;
+                }
+            }                             
+            stream_buffer.Remove(block);
+            block->EmptyToPool(segment_pool);
+        }
+        block->SetId(write_index.block);
+        block->ClearPending();
+        session.SenderInvalidateParity(transport_id, write_index.block);  // (stale if cached)
+        bool success = stream_buffer.Insert(block);
+        ASSERT(success);
+    }  // end if (NULL == block)
+    char* segment = block->GetSegment(write_index.segment);
+    if (NULL == segment)
+    {
+        if (NULL == (segment = segment_pool.Get()))
         {
-            if (NULL == (segment = segment_pool.Get()))
+            NormBlock* b = stream_buffer.Find(stream_buffer.RangeLo());
+            ASSERT(b != block);
+            if (b->IsPending())
             {
-                NormBlock* b = stream_buffer.Find(stream_buffer.RangeLo());
-                ASSERT(b != block);
-                if (b->IsPending())
+                write_vacancy = false;
+                if (push_mode)
                 {
-                    write_vacancy = false;
-                    if (push_mode)
+                    NormBlockId blockId = b->GetId();
+                    pending_mask.Unset(blockId.GetValue());
+                    repair_mask.Unset(blockId.GetValue());
+                    NormBlock* c = FindBlock(blockId);
+                    if (c)
                     {
-                        NormBlockId blockId = b->GetId();
-                        pending_mask.Unset(blockId.GetValue());
-                        repair_mask.Unset(blockId.GetValue());
-                        NormBlock* c = FindBlock(blockId);
-                        if (c)
-                        {
-                            block_buffer.Remove(c);
-                            session.SenderPutFreeBlock(c);
-                        }  
-                        if (!pending_mask.IsSet()) 
-                        {
-                            pending_mask.Set(write_index.block.GetValue());  
-                            //stream_next_id = write_index.block + 1;
-                            stream_next_id = write_index.block;
-                            Increment(stream_next_id);
-                        }  
-                    }
-                    else
+                        block_buffer.Remove(c);
+                        session.SenderPutFreeBlock(c);
+                    }  
+                    if (!pending_mask.IsSet()) 
                     {
-                        PLOG(PL_DEBUG, "NormStreamObject::Write() stream buffer full (3)\n");
-                        break;
-                    }
+                        pending_mask.Set(write_index.block.GetValue());  
+                        //stream_next_id = write_index.block + 1;
+                        stream_next_id = write_index.block;
+                        Increment(stream_next_id);
+                    }  
+                }
+                else
+                {
+                    PLOG(PL_DEBUG, "NormStreamObject::Write() stream buffer full (3)\n");
+                    return NULL;
                 }
-                stream_buffer.Remove(b);
-                b->EmptyToPool(segment_pool);
-                block_pool.Put(b);
-                segment = segment_pool.Get();
-                ASSERT(NULL != segment);
             }
-            NormDataMsg::WriteStreamPayloadMsgStart(segment, 0);
-            NormDataMsg::WriteStreamPayloadLength(segment, 0);
-            NormDataMsg::WriteStreamPayloadOffset(segment, write_offset);
-            block->AttachSegment(write_index.segment, segment);
-        }  // end if (!segment)
+            stream_buffer.Remove(b);
+            b->EmptyToPool(segment_pool);
+            block_pool.Put(b);
+            segment = segment_pool.Get();
+            ASSERT(NULL != segment);
+        }
+        NormDataMsg::WriteStreamPayloadMsgStart(segment, 0);
+        NormDataMsg::WriteStreamPayloadLength(segment, 0);
+        NormDataMsg::WriteStreamPayloadOffset(segment, write_offset);
+        block->AttachSegment(write_index.segment, segment);
+    }  // end if (!segment)
+    return segment;
+}  // end NormStreamObject::GetWriteSegment()
+
+UINT32 NormStreamObject::WriteV(const NormDataFragment* fragList, unsigned int fragCount, bool eom)
+{               
+    if (NULL != write_loan)
+    {
+        // (the loaned segment may only be appended by CommitWrite())
+        PLOG(PL_ERROR, "NormStreamObject::WriteV() error: write buffer is acquired\n");
+        return 0;
+    }
+    UINT32 len = 0;
+    for (unsigned int i = 0; i < fragCount; i++)
+    {
+        if (fragList[i].length > (0xffffffff - len))
+        {
+            len = 0xffffffff;  // (writes stop at the 4 GiB boundary)
+            break;
+        }
+        len += fragList[i].length;
+    }
+    // (fragIndex/fragOffset track the gather position in "fragList")
+    unsigned int fragIndex = 0;
+    UINT32 fragOffset = 0;
+    UINT32 nBytes = 0;
+    do
+    {
+        if (stream_closing)
+        {
+            if (0 != len)
+            {
+                PLOG(PL_ERROR, "NormStreamObject::WriteV() error: stream is closing (len:%lu eom:%d)\n", 
+                                (unsigned long)len, eom);
+                len = 0;
+            }
+            break;
+        }
+        NormBlock* block;
+        char* segment = GetWriteSegment(block);
+        if (NULL == segment) break;
         
         UINT16 index = NormDataMsg::ReadStreamPayloadLength(segment);
         // If it is an application start-of-message, mark the stream header accordingly
@@ -4181,13 +4806,29 @@ UINT32 NormStreamObject::Write(const char* buffer, UINT32 len, bool eom)
         UINT32 space = (UINT32)(segment_size - index);
         count = MIN(count, space);
 #ifdef SIMULATE
-        UINT32 simCount = index + NormDataMsg::GetStreamPayloadHeaderLength();
-        simCount = (simCount < SIM_PAYLOAD_MAX) ? (SIM_PAYLOAD_MAX - simCount) : 0;
-        simCount = MIN(count, simCount);
-        memcpy(segment+index+NormDataMsg::GetStreamPayloadHeaderLength(), buffer+nBytes, simCount);
+        UINT32 copyMax = index + NormDataMsg::GetStreamPayloadHeaderLength();
+        copyMax = (copyMax < SIM_PAYLOAD_MAX) ? (SIM_PAYLOAD_MAX - copyMax) : 0;
 #else
-        memcpy(segment+index+NormDataMsg::GetStreamPayloadHeaderLength(), buffer+nBytes, count);
+        UINT32 copyMax = count;
 #endif // if/else SIMULATE
+        // Gather "count" bytes from the fragment list into the segment
+        char* ptr = segment + index + NormDataMsg::GetStreamPayloadHeaderLength();
+        UINT32 gathered = 0;
+        while (gathered < count)
+        {
+            const NormDataFragment& frag = fragList[fragIndex];
+            UINT32 n = MIN(frag.length - fragOffset, count - gathered);
+            // (a NULL "data" commits data already placed via AcquireWriteBuffer())
+            if ((NULL != frag.data) && (gathered < copyMax))
+                memcpy(ptr + gathered, frag.data + fragOffset, MIN(n, copyMax - gathered));
+            gathered += n;
+            fragOffset += n;
+            if (fragOffset == frag.length)
+            {
+                fragIndex++;
+                fragOffset = 0;
+            }
+        }
         NormDataMsg::WriteStreamPayloadLength(segment, index+count);
         nBytes += count;
         write_offset += count;
@@ -4227,7 +4868,343 @@ UINT32 NormStreamObject::Write(const char* buffer, UINT32 len, bool eom)
         session.TouchSender();  
     }
     return nBytes;
-}  // end NormStreamObject::Write()
+}  // end NormStreamObject::WriteV()
+
+char* NormStreamObject::AcquireWriteBuffer(unsigned int& size)
+{
+    size = 0;
+    if (stream_closing || (NULL != write_loan)) return NULL;
+    if (IsStaged() && !StageDrain()) return NULL;  // (staged data goes first)
+    NormBlock* block;
+    char* segment = GetWriteSegment(block);
+    if (NULL == segment) return NULL;  // (stream buffer full)
+    UINT16 index = NormDataMsg::ReadStreamPayloadLength(segment);
+    size = segment_size - index;
+    write_loan = segment;
+    write_loan_size = size;
+    return (segment + NormDataMsg::GetStreamPayloadHeaderLength() + index);
+}  // end NormStreamObject::AcquireWriteBuffer()
+
+UINT32 NormStreamObject::CommitWrite(UINT32 len)
+{
+    if (NULL == write_loan)
+    {
+        PLOG(PL_ERROR, "NormStreamObject::CommitWrite() error: no write buffer acquired\n");
+        return 0;
+    }
+    if (len > write_loan_size) len = write_loan_size;
+    write_loan = NULL;
+    write_loan_size = 0;
+    // The loaned segment is still the "write_index" segment, so
+    // Write() updates the stream state without copying
+    return Write(NULL, len, false);
+}  // end NormStreamObject::CommitWrite()
+
+bool NormStreamObject::PeekRead(const char*& ptr, unsigned int& len)
+{
+    ptr = NULL;
+    len = 0;
+    if (NULL != read_loan) 
+    {
+        PLOG(PL_ERROR, "NormStreamObject::PeekRead() error: previous data not consumed\n");
+        return true;
+    }
+    if (IsStaged())
+    {
+        // (the NORM thread moves staged stream data into the staging ring)
+        PLOG(PL_ERROR, "NormStreamObject::PeekRead() error: not supported for staged stream\n");
+        return true;
+    }
+    // A zero-length read validates the "read_index" (skipping control
+    // segments, forcing forward, etc) and reports any stream break
+    unsigned int count = 0;
+    if (!Read(NULL, &count)) return false;
+    if (stream_closing) return true;
+    NormBlock* block = stream_buffer.Find(read_index.block);
+    char* segment = (NULL != block) ? block->GetSegment(read_index.segment) : NULL;
+    if (NULL == segment) return true;
+    UINT16 length = NormDataMsg::ReadStreamPayloadLength(segment);
+    if ((length > segment_size) || (read_index.offset >= length)) return true;
+    // The segment is detached from its block while on loan so that it
+    // can't be returned to the segment_pool if the NORM thread needs to
+    // force the "read_index" forward (see WriteSegment())
+    block->DetachSegment(read_index.segment);
+    read_loan = segment;
+    read_loan_index = read_index;
+    ptr = segment + NormDataMsg::GetStreamPayloadHeaderLength() + read_index.offset;
+    len = length - read_index.offset;
+    return true;
+}  // end NormStreamObject::PeekRead()
+
+bool NormStreamObject::Consume(unsigned int len)
+{
+    if (NULL == read_loan)
+    {
+        PLOG(PL_ERROR, "NormStreamObject::Consume() error: no data peeked\n");
+        return false;
+    }
+    char* segment = read_loan;
+    read_loan = NULL;
+    NormBlock* block = stream_buffer.Find(read_loan_index.block);
+    if ((NULL == block) || 
+        (read_loan_index.block != read_index.block) ||
+        (read_loan_index.segment != read_index.segment) ||
+        (read_loan_index.offset != read_index.offset))
+    {
+        // The stream was forced forward while the data was on loan
+        segment_pool.Put(segment);
+        stream_broken = false;
+        return false;
+    }
+    if (NULL == block->GetSegment(read_index.segment))
+        block->AttachSegment(read_index.segment, segment);
+    else
+        segment_pool.Put(segment);  // (a duplicate was received meanwhile)
+    UINT16 length = NormDataMsg::ReadStreamPayloadLength(segment);
+    if (len > (unsigned int)(length - read_index.offset)) 
+        len = length - read_index.offset;
+    return Read(NULL, &len);
+}  // end NormStreamObject::Consume()
+
+bool NormStreamObject::EnableStaging(unsigned int bufferSize)
+{
+    if (IsStaged())
+    {
+        PLOG(PL_ERROR, "NormStreamObject::EnableStaging() error: stream already staged\n");
+        return false;
+    }
+    if (!stage.Init(bufferSize))
+    {
+        PLOG(PL_ERROR, "NormStreamObject::EnableStaging() error: unable to init stage\n");
+        return false;
+    }
+    if ((NULL == sender) && (NULL == (stage_eom_list = new UINT32[STAGE_EOM_MAX])))
+    {
+        PLOG(PL_ERROR, "NormStreamObject::EnableStaging() new stage_eom_list error: %s\n", GetErrorString());
+        stage.Destroy();
+        return false;
+    }
+    stage_event.SetNotifier(session.GetSessionMgr().GetChannelNotifier());
+    stage_event.SetListener(this, &NormStreamObject::OnStageEvent);
+    if (!stage_event.Open() || !stage_event.StartInputNotification())
+    {
+        PLOG(PL_ERROR, "NormStreamObject::EnableStaging() error: unable to open stage_event\n");
+        if (stage_event.IsOpen()) stage_event.Close();
+        if (NULL != stage_eom_list)
+        {
+            delete[] stage_eom_list;
+            stage_eom_list = NULL;
+        }
+        stage.Destroy();
+        return false;
+    }
+    stage_eom_write = stage_eom_read = 0;
+    stage_pending = stage_sync = stage_notify = stage_stalled = stage_break = stage_end = 0;
+    return true;
+}  // end NormStreamObject::EnableStaging()
+
+void NormStreamObject::OnStageEvent(ProtoEvent& /*theEvent*/)
+{
+    stage_event.Reset();
+    NormAtomicExchange(&stage_pending, 0);
+    if (NULL == sender)
+        StageDrain();
+    else if (StageIsSynced())
+        StagePump();
+}  // end NormStreamObject::OnStageEvent()
+
+// The tx staging methods below treat a staged receive stream (whose ring
+// holds rx data) as having nothing staged, i.e. like an unstaged stream
+unsigned int NormStreamObject::StageWrite(const char* buffer, unsigned int len)
+{
+    if (NULL != sender) return 0;  // (receive stream)
+    unsigned int count = stage.Write(buffer, len);
+    if (0 != count) RequestStageService();
+    return count;
+}  // end NormStreamObject::StageWrite()
+
+bool NormStreamObject::StageMarkEom()
+{
+    if (NULL == stage_eom_list) return false;  // (receive stream)
+    UINT32 index = stage_eom_write;
+    if ((index - NormAtomicLoad(&stage_eom_read)) >= STAGE_EOM_MAX) return false;
+    stage_eom_list[index & (STAGE_EOM_MAX - 1)] = stage.GetWriteIndex();
+    NormAtomicStore(&stage_eom_write, index + 1);
+    RequestStageService();
+    return true;
+}  // end NormStreamObject::StageMarkEom()
+
+bool NormStreamObject::StageDrain()
+{
+    if (NULL != sender) return true;  // (receive stream)
+    if (NULL != write_loan) return false;  // (app is writing in place)
+    while (true)
+    {
+        UINT32 readIndex = stage.GetReadIndex();
+        UINT32 eomIndex = stage_eom_read;
+        bool eomPending = (eomIndex != NormAtomicLoad(&stage_eom_write));
+        UINT32 eomOffset = eomPending ? stage_eom_list[eomIndex & (STAGE_EOM_MAX - 1)] : 0;
+        if (eomPending && (eomOffset == readIndex))
+        {
+            // Staged data up to this message end has been written
+            Write(NULL, 0, true);
+            NormAtomicStore(&stage_eom_read, eomIndex + 1);
+            continue;
+        }
+        unsigned int len;
+        const char* data = stage.GetReadData(len);
+        if (NULL == data) 
+        {
+            // (re-check in case of a message end posted after the load above)
+            if (stage_eom_read != NormAtomicLoad(&stage_eom_write)) continue;
+            break;
+        }
+        if (eomPending && ((eomOffset - readIndex) < len)) 
+            len = eomOffset - readIndex;
+        if (stream_closing)
+        {
+            PLOG(PL_ERROR, "NormStreamObject::StageDrain() error: stream is closing (discarding %u bytes)\n", len);
+            stage.CommitRead(len);
+            continue;
+        }
+        UINT32 count = Write(data, len, false);
+        stage.CommitRead(count);
+        if (count < len) return false;  // stream buffer is full
+    }
+    if (stage_close)
+    {
+        stage_close = false;
+        Terminate();
+    }
+    return true;
+}  // end NormStreamObject::StageDrain()
+
+void NormStreamObject::StagePump()
+{
+    bool staged = false;
+    stage_pumping = true;
+    while (true)
+    {
+        unsigned int space;
+        char* ptr = stage.GetWriteSpace(space);
+        if (NULL == ptr)
+        {
+            // Ring is full, app restarts pump (via stage_event) after reading.
+            // The fence orders our "stage_stalled" store with the re-check
+            NormAtomicStore(&stage_stalled, 1);
+            NormAtomicFence();
+            if ((NULL == (ptr = stage.GetWriteSpace(space))) ||
+                (0 == NormAtomicExchange(&stage_stalled, 0)))
+            {
+                break;
+            }
+        }
+        unsigned int count = space;
+        bool result = Read(ptr, &count);
+        if (0 != count)
+        {
+            stage.CommitWrite(count);
+            staged = true;
+        }
+        if (!result)
+        {
+            // Stream break: the app reads the staged data, then
+            // gets the break indication, then must re-sync
+            NormAtomicStore(&stage_sync, 0);
+            NormAtomicStore(&stage_break, 1);
+            staged = true;
+            break;
+        }
+        if ((count < space) || stream_closing) break;
+    }
+    stage_pumping = false;
+    if (0 != NormAtomicLoad(&stage_end)) staged = true;
+    NormAtomicFence();
+    if (staged && (0 != NormAtomicExchange(&stage_notify, 0)))
+        session.Notify(NormController::RX_OBJECT_UPDATED, sender, this);
+}  // end NormStreamObject::StagePump()
+
+bool NormStreamObject::StageRead(char* buffer, unsigned int* buflen, bool& result)
+{
+    while (true)
+    {
+        unsigned int count = stage.Read(buffer, *buflen);
+        if (0 != count)
+        {
+            // Restart a stalled pump now that there is room
+            NormAtomicFence();
+            if (0 != NormAtomicExchange(&stage_stalled, 0))
+                RequestStageService();
+            if (count < *buflen)
+            {
+                // Short read, so (re)arm update notification
+                NormAtomicStore(&stage_notify, 1);
+                *buflen = count;
+            }
+            result = true;
+            return true;
+        }
+        if (0 == *buflen) break;
+        if (0 != NormAtomicLoad(&stage_break))
+        {
+            if (!stage.IsEmpty()) continue;  // (data was staged before break)
+            NormAtomicStore(&stage_break, 0);
+            NormAtomicStore(&stage_notify, 1);
+            result = false;
+            return true;
+        }
+        if ((0 != NormAtomicLoad(&stage_end)) || !StageIsSynced()) 
+            break;  // NORM thread must be suspended
+        // Arm update notification and re-check (see StagePump())
+        NormAtomicStore(&stage_notify, 1);
+        NormAtomicFence();
+        if (!stage.IsEmpty()) continue;
+        result = true;
+        return true;
+    }
+    return false;
+}  // end NormStreamObject::StageRead()
+
+bool NormStreamObject::StageSyncRead(char* buffer, unsigned int* buflen, bool seekMsgStart)
+{
+    if (seekMsgStart)
+    {
+        // Message boundaries aren't kept in the staging ring, so staged data is
+        // discarded and the stream itself is searched for the next message start
+        stage.CommitRead(stage.GetCount());
+        NormAtomicStore(&stage_break, 0);
+        NormAtomicStore(&stage_sync, 0);
+    }
+    else
+    {
+        bool result;
+        if ((NULL != buflen) && StageRead(buffer, buflen, result)) 
+            return result;
+    }
+    if ((0 != NormAtomicLoad(&stage_end)) && stage.IsEmpty())
+    {
+        // All staged data has been read, so now complete the stream
+        NormAtomicStore(&stage_end, 0);
+        NormAtomicStore(&stage_sync, 0);
+        if (NULL != buflen) *buflen = 0;
+        Retain();
+        session.Notify(NormController::RX_OBJECT_COMPLETED, sender, this);
+        sender->DeleteObject(this);
+        Release();
+        return !seekMsgStart;
+    }
+    bool result = Read(buffer, buflen, seekMsgStart);
+    if (result && !read_init && !stream_closing && stage.IsEmpty())
+    {
+        // The app is in sync with the stream, so the NORM thread
+        // fills the staging ring from here on
+        stage_offset = read_offset - stage.GetWriteIndex();
+        NormAtomicStore(&stage_notify, 1);
+        NormAtomicStore(&stage_sync, 1);
+        StagePump();
+    }
+    return result;
+}  // end NormStreamObject::StageSyncRead()
 
 #ifdef SIMULATE
 /////////////////////////////////////////////////////////////////
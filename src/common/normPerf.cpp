@@ -0,0 +1,1276 @@
+// This program measures end-to-end NORM throughput and latency over
+// loopback multicast using the NORM API.  A sender and "recv <n>"
+// receivers run either as sessions of a single NORM instance in this
+// process or, with the "fork" option (UNIX), as separate receiver
+// processes.  Each run sends "count" data or file objects of "size" bytes,
+// or "mcount" stream messages of "msize" bytes, and one CSV line is printed
+// per run.  Comma-separated "txloss" and "rxloss" lists (percent, applied
+// with NormSetTxLoss() and NormSetRxLoss()) produce a loss sweep.
+//
+// Usage: normPerf [type {data|file|stream|all}][recv <count>][fork]
+//                 [addr <addr>][port <port>][interface <name>]
+//                 [size <bytes>][count <n>][msize <bytes>][mcount <n>]
+//                 [segment <bytes>][block <n>][parity <n>][auto <n>]
+//                 [rate <bits/sec>][cc][txloss <pct>[,<pct>...]]
+//                 [rxloss <pct>[,<pct>...]][cache <dir>][timeout <sec>]
+//                 [debug <level>]
+//
+// Notes:
+//   - A run is complete when all receivers have acknowledged the sender's
+//     final watermark (or "timeout" seconds have passed).
+//   - Goodput is that of the slowest receiver, from the sender's first
+//     enqueue to that receiver's final object (or message).
+//   - Stream message latency percentiles are those of the slowest receiver.
+//     (Each message carries its send time.)
+//   - CPU time covers the sender and all receivers and is reported per
+//     GB of source data sent.
+//   - Packet counts are from the system UDP "OutDatagrams" counter (Linux
+//     only), so they include receiver feedback and any other UDP traffic on
+//     the host.  "overhead" is the ratio of those packets to the source
+//     segments sent, less one (i.e., repair and control overhead).
+
+#include "normApi.h"
+#include "protokit.h"  // for ProtoTime, protolib debug, etc
+
+#include <stdio.h>
+#include <stdlib.h>  // for atoi(), qsort(), etc
+#include <string.h>
+
+#ifdef UNIX
+#include <unistd.h>        // for fork(), pipe(), etc
+#include <limits.h>        // for PATH_MAX
+#include <sys/types.h>
+#include <sys/wait.h>      // for waitpid()
+#include <sys/select.h>
+#include <sys/time.h>
+#include <sys/resource.h>  // for getrusage()
+#endif // UNIX
+
+enum {LOSS_MAX = 16};
+
+enum PerfType {PERF_DATA, PERF_FILE, PERF_STREAM, PERF_TYPE_COUNT};
+static const char* const PERF_TYPE_NAME[PERF_TYPE_COUNT] = {"data", "file", "stream"};
+
+// Sender uses node id 1 and receivers use ids 2, 3, ...
+static const NormNodeId PERF_SENDER_ID = 1;
+static const NormNodeId PERF_RECEIVER_ID_BASE = 2;
+
+// Stream messages begin with a 12-byte header: sequence number and
+// send time (seconds, microseconds), each a 32-bit big-endian value
+static const unsigned int PERF_MSG_HEADER_SIZE = 12;
+
+class PerfConfig
+{
+    public:
+        PerfConfig();
+
+        const char*     addr;
+        UINT16          port;
+        const char*     iface;
+        const char*     cache_dir;
+        unsigned int    num_receivers;
+        bool            use_fork;
+        unsigned int    object_size;
+        unsigned int    object_count;
+        unsigned int    msg_size;
+        unsigned int    msg_count;
+        UINT16          segment_size;
+        UINT16          num_data;
+        UINT16          num_parity;
+        UINT16          auto_parity;
+        double          tx_rate;
+        bool            cc_enable;
+        UINT32          tx_buffer_size;
+        UINT32          rx_buffer_size;
+        UINT32          stream_buffer_size;
+        double          timeout;
+};  // end class PerfConfig
+
+PerfConfig::PerfConfig()
+ : addr("224.1.2.3"), port(6003), iface(NULL),
+#ifdef WIN32
+   cache_dir("C:\\Temp\\"),
+#else
+   cache_dir("/tmp/"),
+#endif // if/else WIN32
+   num_receivers(1), use_fork(false),
+   object_size(1024*1024), object_count(50),
+   msg_size(1024), msg_count(20000),
+   segment_size(1400), num_data(64), num_parity(16), auto_parity(0),
+   tx_rate(200.0e+06), cc_enable(false),
+   tx_buffer_size(32*1024*1024), rx_buffer_size(32*1024*1024),
+   stream_buffer_size(4*1024*1024), timeout(60.0)
+{
+}
+
+class PerfRxResult
+{
+    public:
+        void Init()
+        {
+            bytes = 0.0;
+            objects = 0;
+            last_time = 0.0;
+            latency[0] = latency[1] = latency[2] = 0.0;
+            cpu_time = 0.0;
+        }
+
+        double          bytes;
+        unsigned int    objects;     // objects (or stream messages) received
+        double          last_time;   // time of final object/message (sec)
+        double          latency[3];  // p50, p99, p999 stream latency (msec)
+        double          cpu_time;    // receiver process cpu (fork mode only)
+};  // end class PerfRxResult
+
+static void PutUINT32(char* buffer, UINT32 value)
+{
+    buffer[0] = (char)(value >> 24);
+    buffer[1] = (char)(value >> 16);
+    buffer[2] = (char)(value >> 8);
+    buffer[3] = (char)value;
+}  // end PutUINT32()
+
+static UINT32 GetUINT32(const char* buffer)
+{
+    const unsigned char* ptr = (const unsigned char*)buffer;
+    return (((UINT32)ptr[0] << 24) | ((UINT32)ptr[1] << 16) |
+            ((UINT32)ptr[2] << 8) | (UINT32)ptr[3]);
+}  // end GetUINT32()
+
+static int CompareDouble(const void* a, const void* b)
+{
+    double x = *((const double*)a);
+    double y = *((const double*)b);
+    return ((x < y) ? -1 : ((x > y) ? 1 : 0));
+}  // end CompareDouble()
+
+static double GetCpuTime()
+{
+#ifdef UNIX
+    struct rusage usage;
+    if (0 != getrusage(RUSAGE_SELF, &usage)) return 0.0;
+    return ((double)usage.ru_utime.tv_sec + 1.0e-06*(double)usage.ru_utime.tv_usec +
+            (double)usage.ru_stime.tv_sec + 1.0e-06*(double)usage.ru_stime.tv_usec);
+#else
+    return 0.0;  // (TBD - use GetProcessTimes() on WIN32)
+#endif // if/else UNIX
+}  // end GetCpuTime()
+
+// Returns the system UDP datagram transmit count (or -1.0 if unavailable)
+static double GetUdpOutDatagrams()
+{
+#ifdef LINUX
+    FILE* file = fopen("/proc/net/snmp", "r");
+    if (NULL == file) return -1.0;
+    // The "Udp:" header line lists the field names and the next "Udp:"
+    // line has the corresponding values
+    char header[1024], values[1024];
+    bool found = false;
+    while (NULL != fgets(header, 1024, file))
+    {
+        if (0 != strncmp(header, "Udp:", 4)) continue;
+        found = (NULL != fgets(values, 1024, file)) && (0 == strncmp(values, "Udp:", 4));
+        break;
+    }
+    fclose(file);
+    if (!found) return -1.0;
+    char* hptr = header;
+    char* vptr = values;
+    char* hsave;
+    char* vsave;
+    char* name = strtok_r(hptr, " \n", &hsave);
+    char* value = strtok_r(vptr, " \n", &vsave);
+    while ((NULL != name) && (NULL != value))
+    {
+        if (0 == strcmp(name, "OutDatagrams")) return atof(value);
+        name = strtok_r(NULL, " \n", &hsave);
+        value = strtok_r(NULL, " \n", &vsave);
+    }
+    return -1.0;
+#else
+    return -1.0;
+#endif // if/else LINUX
+}  // end GetUdpOutDatagrams()
+
+// Waits up to "timeout" seconds for a NORM event (or "ctrlFd" input on UNIX)
+// and returns "true" if "ctrlFd" is ready for reading
+static bool WaitForEvent(NormInstanceHandle instance, double timeout, int ctrlFd)
+{
+#ifdef UNIX
+    int normFd = NormGetDescriptor(instance);
+    fd_set fdSet;
+    FD_ZERO(&fdSet);
+    FD_SET(normFd, &fdSet);
+    int maxFd = normFd;
+    if (ctrlFd >= 0)
+    {
+        FD_SET(ctrlFd, &fdSet);
+        if (ctrlFd > maxFd) maxFd = ctrlFd;
+    }
+    struct timeval tv;
+    tv.tv_sec = (unsigned long)timeout;
+    tv.tv_usec = (unsigned long)(1.0e+06 * (timeout - (double)tv.tv_sec));
+    if (select(maxFd + 1, &fdSet, NULL, NULL, &tv) <= 0) return false;
+    return ((ctrlFd >= 0) && FD_ISSET(ctrlFd, &fdSet));
+#else
+    WaitForSingleObject(NormGetDescriptor(instance), (DWORD)(1000.0 * timeout));
+    return false;
+#endif // if/else UNIX
+}  // end WaitForEvent()
+
+class PerfReceiver
+{
+    public:
+        PerfReceiver();
+        ~PerfReceiver();
+
+        bool Open(NormInstanceHandle    instance,
+                  const PerfConfig&     config,
+                  PerfType              type,
+                  NormNodeId            nodeId,
+                  double                rxLoss);
+        void Close();
+
+        void HandleEvent(const NormEvent& theEvent);
+        void GetResult(PerfRxResult& result);
+
+    private:
+        void ReadStream();
+
+        NormSessionHandle   session;
+        NormObjectHandle    stream;
+        bool                msg_sync;
+        char*               msg_buffer;
+        unsigned int        msg_size;
+        unsigned int        msg_index;
+        double*             latency_list;
+        unsigned int        latency_max;
+        unsigned int        latency_count;
+        double              bytes;
+        unsigned int        objects;
+        double              last_time;
+};  // end class PerfReceiver
+
+PerfReceiver::PerfReceiver()
+ : session(NORM_SESSION_INVALID), stream(NORM_OBJECT_INVALID), msg_sync(false),
+   msg_buffer(NULL), msg_size(0), msg_index(0),
+   latency_list(NULL), latency_max(0), latency_count(0),
+   bytes(0.0), objects(0), last_time(0.0)
+{
+}
+
+PerfReceiver::~PerfReceiver()
+{
+    Close();
+}
+
+bool PerfReceiver::Open(NormInstanceHandle    instance,
+                        const PerfConfig&     config,
+                        PerfType              type,
+                        NormNodeId            nodeId,
+                        double                rxLoss)
+{
+    if (PERF_STREAM == type)
+    {
+        msg_size = config.msg_size;
+        latency_max = config.msg_count;
+        if (NULL == (msg_buffer = new char[msg_size]))
+        {
+            perror("normPerf: new msg_buffer error");
+            return false;
+        }
+        if (NULL == (latency_list = new double[latency_max]))
+        {
+            perror("normPerf: new latency_list error");
+            Close();
+            return false;
+        }
+    }
+    session = NormCreateSession(instance, config.addr, config.port, nodeId);
+    if (NORM_SESSION_INVALID == session)
+    {
+        fprintf(stderr, "normPerf: receiver NormCreateSession() error\n");
+        Close();
+        return false;
+    }
+    NormSetUserData(session, this);
+    NormSetRxPortReuse(session, true);
+    NormSetMulticastLoopback(session, true);
+    if ((NULL != config.iface) && !NormSetMulticastInterface(session, config.iface))
+        fprintf(stderr, "normPerf: warning: unable to set multicast interface \"%s\"\n", config.iface);
+    NormSetRxLoss(session, rxLoss);
+    if (!NormStartReceiver(session, config.rx_buffer_size))
+    {
+        fprintf(stderr, "normPerf: NormStartReceiver() error\n");
+        Close();
+        return false;
+    }
+    if (!NormSetRxSocketBuffer(session, 4*1024*1024))
+        fprintf(stderr, "normPerf: warning: unable to set rx socket buffer size\n");
+    return true;
+}  // end PerfReceiver::Open()
+
+void PerfReceiver::Close()
+{
+    if (NORM_SESSION_INVALID != session)
+    {
+        NormStopReceiver(session);
+        NormDestroySession(session);
+        session = NORM_SESSION_INVALID;
+    }
+    stream = NORM_OBJECT_INVALID;
+    if (NULL != msg_buffer)
+    {
+        delete[] msg_buffer;
+        msg_buffer = NULL;
+    }
+    if (NULL != latency_list)
+    {
+        delete[] latency_list;
+        latency_list = NULL;
+    }
+}  // end PerfReceiver::Close()
+
+void PerfReceiver::HandleEvent(const NormEvent& theEvent)
+{
+    switch (theEvent.type)
+    {
+        case NORM_RX_OBJECT_NEW:
+            if ((NULL != msg_buffer) && (NORM_OBJECT_STREAM == NormObjectGetType(theEvent.object)))
+            {
+                stream = theEvent.object;
+                msg_sync = false;
+                msg_index = 0;
+            }
+            break;
+
+        case NORM_RX_OBJECT_UPDATED:
+            if ((NORM_OBJECT_INVALID != stream) && (theEvent.object == stream))
+                ReadStream();
+            break;
+
+        case NORM_RX_OBJECT_COMPLETED:
+        case NORM_RX_OBJECT_ABORTED:
+        {
+            NormObjectType objectType = NormObjectGetType(theEvent.object);
+            if (NORM_OBJECT_STREAM == objectType)
+            {
+                if (theEvent.object == stream) stream = NORM_OBJECT_INVALID;
+                break;
+            }
+            if (NORM_RX_OBJECT_COMPLETED == theEvent.type)
+            {
+                bytes += (double)NormObjectGetSize(theEvent.object);
+                objects++;
+                last_time = ProtoTime().GetCurrentTime().GetValue();
+            }
+            if (NORM_OBJECT_FILE == objectType)
+            {
+                // Received files aren't needed, so remove them from the cache
+                char fileName[PATH_MAX + 1];
+                if (NormFileGetName(theEvent.object, fileName, PATH_MAX))
+                {
+                    fileName[PATH_MAX] = '\0';
+                    remove(fileName);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}  // end PerfReceiver::HandleEvent()
+
+void PerfReceiver::ReadStream()
+{
+    while (true)
+    {
+        // If we're not "in sync", seek message start
+        if (!msg_sync)
+        {
+            msg_sync = NormStreamSeekMsgStart(stream);
+            if (!msg_sync) break;  // wait for next NORM_RX_OBJECT_UPDATED to re-sync
+            msg_index = 0;
+        }
+        unsigned int numBytes = msg_size - msg_index;
+        if (!NormStreamRead(stream, msg_buffer + msg_index, &numBytes))
+        {
+            PLOG(PL_WARN, "normPerf: broken stream detected, re-syncing ...\n");
+            msg_sync = false;
+            continue;
+        }
+        msg_index += numBytes;
+        if (msg_index < msg_size) break;  // wait for next NORM_RX_OBJECT_UPDATED
+        // Complete message read
+        double sendTime = (double)GetUINT32(msg_buffer + 4) +
+                          1.0e-06 * (double)GetUINT32(msg_buffer + 8);
+        double currentTime = ProtoTime().GetCurrentTime().GetValue();
+        if (latency_count < latency_max)
+            latency_list[latency_count++] = currentTime - sendTime;
+        bytes += (double)msg_size;
+        objects++;
+        last_time = currentTime;
+        msg_index = 0;
+    }
+}  // end PerfReceiver::ReadStream()
+
+void PerfReceiver::GetResult(PerfRxResult& result)
+{
+    result.Init();
+    result.bytes = bytes;
+    result.objects = objects;
+    result.last_time = last_time;
+    if (latency_count > 0)
+    {
+        static const double PERCENTILE[3] = {0.50, 0.99, 0.999};
+        qsort(latency_list, latency_count, sizeof(double), CompareDouble);
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            unsigned int index = (unsigned int)(PERCENTILE[i] * (double)latency_count);
+            if (index >= latency_count) index = latency_count - 1;
+            result.latency[i] = 1.0e+03 * latency_list[index];
+        }
+    }
+}  // end PerfReceiver::GetResult()
+
+class PerfSender
+{
+    public:
+        PerfSender();
+        ~PerfSender();
+
+        bool Open(NormInstanceHandle    instance,
+                  const PerfConfig&     config,
+                  PerfType              type,
+                  double                txLoss,
+                  const char*           dataBuffer,
+                  const char*           filePath);
+        void Close();
+        bool Start();
+
+        void HandleEvent(const NormEvent& theEvent);
+
+        NormSessionHandle GetSession() const
+            {return session;}
+        bool IsDone() const
+            {return is_done;}
+        double GetStartTime() const
+            {return start_time;}
+        double GetEndTime() const
+            {return end_time;}
+
+    private:
+        void SendMore();
+        bool WriteMessage();
+
+        NormSessionHandle   session;
+        PerfType            type;
+        const char*         data_buffer;
+        unsigned int        data_size;
+        const char*         file_path;
+        NormObjectHandle    stream;
+        UINT32              stream_buffer_size;
+        char*               msg_buffer;
+        unsigned int        msg_size;
+        unsigned int        msg_index;
+        unsigned int        send_count;
+        unsigned int        send_max;
+        NormObjectHandle    last_object;
+        bool                watermark_set;
+        bool                is_done;
+        double              start_time;
+        double              end_time;
+};  // end class PerfSender
+
+PerfSender::PerfSender()
+ : session(NORM_SESSION_INVALID), type(PERF_DATA),
+   data_buffer(NULL), data_size(0), file_path(NULL),
+   stream(NORM_OBJECT_INVALID), stream_buffer_size(0),
+   msg_buffer(NULL), msg_size(0), msg_index(0),
+   send_count(0), send_max(0), last_object(NORM_OBJECT_INVALID),
+   watermark_set(false), is_done(false), start_time(0.0), end_time(0.0)
+{
+}
+
+PerfSender::~PerfSender()
+{
+    Close();
+}
+
+bool PerfSender::Open(NormInstanceHandle    instance,
+                      const PerfConfig&     config,
+                      PerfType              theType,
+                      double                txLoss,
+                      const char*           dataBuffer,
+                      const char*           filePath)
+{
+    type = theType;
+    data_buffer = dataBuffer;
+    data_size = config.object_size;
+    file_path = filePath;
+    stream_buffer_size = config.stream_buffer_size;
+    if (PERF_STREAM == type)
+    {
+        msg_size = config.msg_size;
+        send_max = config.msg_count;
+        if (NULL == (msg_buffer = new char[msg_size]))
+        {
+            perror("normPerf: new msg_buffer error");
+            return false;
+        }
+        memset(msg_buffer, 'a', msg_size);
+    }
+    else
+    {
+        send_max = config.object_count;
+    }
+    session = NormCreateSession(instance, config.addr, config.port, PERF_SENDER_ID);
+    if (NORM_SESSION_INVALID == session)
+    {
+        fprintf(stderr, "normPerf: sender NormCreateSession() error\n");
+        Close();
+        return false;
+    }
+    NormSetRxPortReuse(session, true);
+    NormSetMulticastLoopback(session, true);
+    if ((NULL != config.iface) && !NormSetMulticastInterface(session, config.iface))
+        fprintf(stderr, "normPerf: warning: unable to set multicast interface \"%s\"\n", config.iface);
+    NormSetTxLoss(session, txLoss);
+    NormSetGrttEstimate(session, 0.001);
+    NormSetTxRate(session, config.tx_rate);
+    if (config.cc_enable) NormSetCongestionControl(session, true);
+    if (0 != config.auto_parity) NormSetAutoParity(session, config.auto_parity);
+    // All receivers are acking nodes so the final watermark marks completion
+    for (unsigned int i = 0; i < config.num_receivers; i++)
+    {
+        if (!NormAddAckingNode(session, PERF_RECEIVER_ID_BASE + i))
+        {
+            fprintf(stderr, "normPerf: NormAddAckingNode() error\n");
+            Close();
+            return false;
+        }
+    }
+    if (!NormStartSender(session, NormGetRandomSessionId(), config.tx_buffer_size,
+                         config.segment_size, config.num_data, config.num_parity))
+    {
+        fprintf(stderr, "normPerf: NormStartSender() error\n");
+        Close();
+        return false;
+    }
+    if (!NormSetTxSocketBuffer(session, 4*1024*1024))
+        fprintf(stderr, "normPerf: warning: unable to set tx socket buffer size\n");
+    return true;
+}  // end PerfSender::Open()
+
+void PerfSender::Close()
+{
+    if (NORM_SESSION_INVALID != session)
+    {
+        if (NORM_OBJECT_INVALID != stream)
+        {
+            NormStreamClose(stream);
+            stream = NORM_OBJECT_INVALID;
+        }
+        NormStopSender(session);
+        NormDestroySession(session);
+        session = NORM_SESSION_INVALID;
+    }
+    if (NULL != msg_buffer)
+    {
+        delete[] msg_buffer;
+        msg_buffer = NULL;
+    }
+}  // end PerfSender::Close()
+
+bool PerfSender::Start()
+{
+    start_time = ProtoTime().GetCurrentTime().GetValue();
+    if (PERF_STREAM == type)
+    {
+        stream = NormStreamOpen(session, stream_buffer_size);
+        if (NORM_OBJECT_INVALID == stream)
+        {
+            fprintf(stderr, "normPerf: NormStreamOpen() error\n");
+            return false;
+        }
+    }
+    SendMore();
+    return true;
+}  // end PerfSender::Start()
+
+// Enqueues objects (or writes messages) until the sender is flow
+// controlled (more is sent upon the next NORM_TX_QUEUE_VACANCY)
+void PerfSender::SendMore()
+{
+    while (send_count < send_max)
+    {
+        if (PERF_STREAM == type)
+        {
+            if (!WriteMessage()) break;
+        }
+        else
+        {
+            NormObjectHandle object;
+            if (PERF_FILE == type)
+                object = NormFileEnqueue(session, file_path);
+            else
+                object = NormDataEnqueue(session, data_buffer, data_size);
+            if (NORM_OBJECT_INVALID == object) break;
+            last_object = object;
+            send_count++;
+        }
+    }
+    if ((send_count == send_max) && !watermark_set)
+    {
+        NormObjectHandle object = (PERF_STREAM == type) ? stream : last_object;
+        if (NormSetWatermark(session, object))
+            watermark_set = true;
+        else
+            fprintf(stderr, "normPerf: NormSetWatermark() error\n");
+    }
+}  // end PerfSender::SendMore()
+
+bool PerfSender::WriteMessage()
+{
+    if (0 == msg_index)
+    {
+        ProtoTime currentTime;
+        currentTime.GetCurrentTime();
+        PutUINT32(msg_buffer, send_count);
+        PutUINT32(msg_buffer + 4, (UINT32)currentTime.sec());
+        PutUINT32(msg_buffer + 8, (UINT32)currentTime.usec());
+    }
+    msg_index += NormStreamWrite(stream, msg_buffer + msg_index, msg_size - msg_index);
+    if (msg_index < msg_size) return false;  // stream buffer is full
+    // Flush and mark end-of-message so receivers can sync to message starts
+    NormStreamFlush(stream, true, NORM_FLUSH_PASSIVE);
+    msg_index = 0;
+    send_count++;
+    return true;
+}  // end PerfSender::WriteMessage()
+
+void PerfSender::HandleEvent(const NormEvent& theEvent)
+{
+    switch (theEvent.type)
+    {
+        case NORM_TX_QUEUE_VACANCY:
+        case NORM_TX_QUEUE_EMPTY:
+            SendMore();
+            break;
+
+        case NORM_TX_WATERMARK_COMPLETED:
+            if (NORM_ACK_SUCCESS == NormGetAckingStatus(session))
+            {
+                end_time = ProtoTime().GetCurrentTime().GetValue();
+                is_done = true;
+            }
+            else
+            {
+                // Some receiver(s) didn't acknowledge yet, so try again
+                PLOG(PL_INFO, "normPerf: watermark acknowledgement incomplete, retrying ...\n");
+                NormResetWatermark(session);
+            }
+            break;
+
+        default:
+            break;
+    }
+}  // end PerfSender::HandleEvent()
+
+// Dispatches sender (and in-process receiver) events until the sender is
+// done or the timeout passes, then delivers any events still queued
+static void RunEventLoop(NormInstanceHandle  instance,
+                         PerfSender&         sender,
+                         double              timeout)
+{
+    ProtoTime startTime;
+    startTime.GetCurrentTime();
+    bool draining = false;
+    while (true)
+    {
+        NormEvent theEvent;
+        unsigned int eventCount = 0;
+        while (NormGetNextEvent(instance, &theEvent, false))
+        {
+            eventCount++;
+            if (NORM_SESSION_INVALID == theEvent.session)
+                continue;
+            else if (theEvent.session == sender.GetSession())
+                sender.HandleEvent(theEvent);
+            else if (NULL != NormGetUserData(theEvent.session))
+                ((PerfReceiver*)NormGetUserData(theEvent.session))->HandleEvent(theEvent);
+        }
+        if (draining && (0 == eventCount)) break;
+        if (sender.IsDone())
+        {
+            draining = true;  // one more pass to deliver pending receiver events
+            continue;
+        }
+        if (ProtoTime::Delta(ProtoTime().GetCurrentTime(), startTime) > timeout)
+        {
+            fprintf(stderr, "normPerf: run timed out\n");
+            break;
+        }
+        WaitForEvent(instance, 0.1, -1);
+    }
+}  // end RunEventLoop()
+
+// In-process receivers
+static bool RunLocal(const PerfConfig&  config,
+                     PerfType           type,
+                     double             txLoss,
+                     double             rxLoss,
+                     const char*        dataBuffer,
+                     const char*        filePath,
+                     PerfSender&        sender,
+                     PerfRxResult*      results)
+{
+    NormInstanceHandle instance = NormCreateInstance();
+    if (NORM_INSTANCE_INVALID == instance)
+    {
+        fprintf(stderr, "normPerf: NormCreateInstance() error\n");
+        return false;
+    }
+    NormSetCacheDirectory(instance, config.cache_dir);
+    PerfReceiver* receivers = new PerfReceiver[config.num_receivers];
+    if (NULL == receivers)
+    {
+        perror("normPerf: new receivers error");
+        NormDestroyInstance(instance);
+        return false;
+    }
+    bool result = true;
+    for (unsigned int i = 0; i < config.num_receivers; i++)
+    {
+        if (!receivers[i].Open(instance, config, type, PERF_RECEIVER_ID_BASE + i, rxLoss))
+        {
+            result = false;
+            break;
+        }
+    }
+    if (result && sender.Open(instance, config, type, txLoss, dataBuffer, filePath) && sender.Start())
+    {
+        RunEventLoop(instance, sender, config.timeout);
+        for (unsigned int i = 0; i < config.num_receivers; i++)
+            receivers[i].GetResult(results[i]);
+    }
+    else
+    {
+        result = false;
+    }
+    sender.Close();
+    delete[] receivers;
+    NormDestroyInstance(instance);
+    return result;
+}  // end RunLocal()
+
+#ifdef UNIX
+// Receiver process: signals readiness ('R'), receives until the parent
+// signals the run is done ('D'), then writes its result line and exits
+static int ReceiverProcess(const PerfConfig&    config,
+                           PerfType             type,
+                           NormNodeId           nodeId,
+                           double               rxLoss,
+                           int                  ctrlFd,
+                           int                  resultFd)
+{
+    double cpuStart = GetCpuTime();
+    NormInstanceHandle instance = NormCreateInstance();
+    if (NORM_INSTANCE_INVALID == instance)
+    {
+        fprintf(stderr, "normPerf: NormCreateInstance() error\n");
+        return -1;
+    }
+    NormSetCacheDirectory(instance, config.cache_dir);
+    PerfReceiver receiver;
+    if (!receiver.Open(instance, config, type, nodeId, rxLoss))
+    {
+        NormDestroyInstance(instance);
+        return -1;
+    }
+    if (1 != write(resultFd, "R", 1))
+    {
+        perror("normPerf: receiver write() error");
+        receiver.Close();
+        NormDestroyInstance(instance);
+        return -1;
+    }
+    bool done = false;
+    while (true)
+    {
+        NormEvent theEvent;
+        unsigned int eventCount = 0;
+        while (NormGetNextEvent(instance, &theEvent, false))
+        {
+            eventCount++;
+            receiver.HandleEvent(theEvent);
+        }
+        if (done && (0 == eventCount)) break;
+        if (!done && WaitForEvent(instance, 0.1, ctrlFd))
+            done = true;  // ('D' or parent exit, deliver pending events first)
+    }
+    PerfRxResult result;
+    receiver.GetResult(result);
+    receiver.Close();
+    NormDestroyInstance(instance);
+    result.cpu_time = GetCpuTime() - cpuStart;
+    char text[256];
+    int len = snprintf(text, 256, "%f %u %f %f %f %f %f\n",
+                       result.bytes, result.objects, result.last_time,
+                       result.latency[0], result.latency[1], result.latency[2],
+                       result.cpu_time);
+    if (len != write(resultFd, text, len))
+    {
+        perror("normPerf: receiver result write() error");
+        return -1;
+    }
+    return 0;
+}  // end ReceiverProcess()
+
+// Forked receiver processes
+static bool RunForked(const PerfConfig&  config,
+                      PerfType           type,
+                      double             txLoss,
+                      double             rxLoss,
+                      const char*        dataBuffer,
+                      const char*        filePath,
+                      PerfSender&        sender,
+                      PerfRxResult*      results)
+{
+    unsigned int numReceivers = config.num_receivers;
+    pid_t* pidList = new pid_t[numReceivers];
+    int* ctrlFds = new int[numReceivers];
+    int* resultFds = new int[numReceivers];
+    if ((NULL == pidList) || (NULL == ctrlFds) || (NULL == resultFds))
+    {
+        perror("normPerf: new process list error");
+        if (NULL != pidList) delete[] pidList;
+        if (NULL != ctrlFds) delete[] ctrlFds;
+        if (NULL != resultFds) delete[] resultFds;
+        return false;
+    }
+    fflush(stdout);
+    fflush(stderr);
+    unsigned int forkCount = 0;
+    for (; forkCount < numReceivers; forkCount++)
+    {
+        int ctrlPipe[2], resultPipe[2];
+        if (0 != pipe(ctrlPipe))
+        {
+            perror("normPerf: pipe() error");
+            break;
+        }
+        if (0 != pipe(resultPipe))
+        {
+            perror("normPerf: pipe() error");
+            close(ctrlPipe[0]);
+            close(ctrlPipe[1]);
+            break;
+        }
+        pid_t pid = fork();
+        if (0 == pid)
+        {
+            // Child: close the parent's pipe ends (including earlier children's)
+            for (unsigned int i = 0; i < forkCount; i++)
+            {
+                close(ctrlFds[i]);
+                close(resultFds[i]);
+            }
+            close(ctrlPipe[1]);
+            close(resultPipe[0]);
+            int exitCode = ReceiverProcess(config, type, PERF_RECEIVER_ID_BASE + forkCount,
+                                           rxLoss, ctrlPipe[0], resultPipe[1]);
+            _exit((0 == exitCode) ? 0 : 1);
+        }
+        close(ctrlPipe[0]);
+        close(resultPipe[1]);
+        if (pid < 0)
+        {
+            perror("normPerf: fork() error");
+            close(ctrlPipe[1]);
+            close(resultPipe[0]);
+            break;
+        }
+        pidList[forkCount] = pid;
+        ctrlFds[forkCount] = ctrlPipe[1];
+        resultFds[forkCount] = resultPipe[0];
+    }
+    bool result = (forkCount == numReceivers);
+    // Wait for the receivers to be ready before sending
+    for (unsigned int i = 0; result && (i < forkCount); i++)
+    {
+        char status;
+        if ((1 != read(resultFds[i], &status, 1)) || ('R' != status))
+        {
+            fprintf(stderr, "normPerf: receiver process %u startup error\n", i);
+            result = false;
+        }
+    }
+    NormInstanceHandle instance = NORM_INSTANCE_INVALID;
+    if (result)
+    {
+        instance = NormCreateInstance();
+        if (NORM_INSTANCE_INVALID == instance)
+        {
+            fprintf(stderr, "normPerf: NormCreateInstance() error\n");
+            result = false;
+        }
+    }
+    if (result)
+    {
+        if (sender.Open(instance, config, type, txLoss, dataBuffer, filePath) && sender.Start())
+            RunEventLoop(instance, sender, config.timeout);
+        else
+            result = false;
+    }
+    // Tell the receivers to finish and collect their results
+    for (unsigned int i = 0; i < forkCount; i++)
+    {
+        if (1 != write(ctrlFds[i], "D", 1))
+            perror("normPerf: write() error");
+    }
+    for (unsigned int i = 0; i < forkCount; i++)
+    {
+        char text[256];
+        unsigned int len = 0;
+        int got;
+        while ((len < 255) && ((got = read(resultFds[i], text + len, 255 - len)) > 0))
+            len += got;
+        text[len] = '\0';
+        if (7 != sscanf(text, "%lf %u %lf %lf %lf %lf %lf",
+                        &results[i].bytes, &results[i].objects, &results[i].last_time,
+                        &results[i].latency[0], &results[i].latency[1], &results[i].latency[2],
+                        &results[i].cpu_time))
+        {
+            if (result) fprintf(stderr, "normPerf: receiver process %u result error\n", i);
+            results[i].Init();
+        }
+        close(ctrlFds[i]);
+        close(resultFds[i]);
+        waitpid(pidList[i], NULL, 0);
+    }
+    sender.Close();
+    if (NORM_INSTANCE_INVALID != instance) NormDestroyInstance(instance);
+    delete[] pidList;
+    delete[] ctrlFds;
+    delete[] resultFds;
+    return result;
+}  // end RunForked()
+#endif // UNIX
+
+static bool RunTest(const PerfConfig&   config,
+                    PerfType            type,
+                    double              txLoss,
+                    double              rxLoss,
+                    const char*         dataBuffer,
+                    const char*         filePath)
+{
+    PerfRxResult* results = new PerfRxResult[config.num_receivers];
+    if (NULL == results)
+    {
+        perror("normPerf: new results error");
+        return false;
+    }
+    for (unsigned int i = 0; i < config.num_receivers; i++)
+        results[i].Init();
+    PerfSender sender;
+    double cpuStart = GetCpuTime();
+    double udpStart = GetUdpOutDatagrams();
+    bool result;
+#ifdef UNIX
+    if (config.use_fork)
+        result = RunForked(config, type, txLoss, rxLoss, dataBuffer, filePath, sender, results);
+    else
+#endif // UNIX
+        result = RunLocal(config, type, txLoss, rxLoss, dataBuffer, filePath, sender, results);
+    double udpCount = GetUdpOutDatagrams();
+    if ((udpStart >= 0.0) && (udpCount >= 0.0))
+        udpCount -= udpStart;
+    else
+        udpCount = -1.0;
+    double cpuTime = GetCpuTime() - cpuStart;
+    if (!result)
+    {
+        delete[] results;
+        return false;
+    }
+
+    // Summarize the run (worst receiver for goodput and latency)
+    unsigned int objectSize = (PERF_STREAM == type) ? config.msg_size : config.object_size;
+    unsigned int objectCount = (PERF_STREAM == type) ? config.msg_count : config.object_count;
+    double sourceBytes = (double)objectSize * (double)objectCount;
+    double sourceSegments = (double)objectCount *
+        (double)((objectSize + config.segment_size - 1) / config.segment_size);
+    double startTime = sender.GetStartTime();
+    double goodput = -1.0;
+    double latency[3] = {0.0, 0.0, 0.0};
+    bool complete = sender.IsDone();
+    for (unsigned int i = 0; i < config.num_receivers; i++)
+    {
+        PerfRxResult& rx = results[i];
+        double rate = 0.0;
+        if (rx.last_time > startTime)
+            rate = 8.0e-06 * rx.bytes / (rx.last_time - startTime);
+        if ((goodput < 0.0) || (rate < goodput)) goodput = rate;
+        for (unsigned int j = 0; j < 3; j++)
+        {
+            if (rx.latency[j] > latency[j]) latency[j] = rx.latency[j];
+        }
+        if (rx.objects < objectCount) complete = false;
+        cpuTime += rx.cpu_time;
+    }
+    double elapsed = (sender.GetEndTime() > startTime) ?
+                        (sender.GetEndTime() - startTime) :
+                        (ProtoTime().GetCurrentTime().GetValue() - startTime);
+    double pps = (udpCount >= 0.0) ? (udpCount / elapsed) : -1.0;
+    double overhead = (udpCount >= 0.0) ? ((udpCount / sourceSegments) - 1.0) : -1.0;
+    printf("%s,%u,%.2f,%.2f,%u,%u,%.3f,%.0f,%.3f,%.3f,%.3f,%.3f,%.4f,%s\n",
+           PERF_TYPE_NAME[type], config.num_receivers, txLoss, rxLoss,
+           objectCount, objectSize, goodput, pps, cpuTime / (1.0e-09 * sourceBytes),
+           latency[0], latency[1], latency[2], overhead, complete ? "yes" : "no");
+    fflush(stdout);
+    delete[] results;
+    return complete;
+}  // end RunTest()
+
+// Parses a comma-separated list of non-negative loss percentages
+static unsigned int ParseLossList(const char* text, double* list)
+{
+    unsigned int count = 0;
+    while ((NULL != text) && (count < LOSS_MAX))
+    {
+        char* end;
+        double value = strtod(text, &end);
+        if ((end == text) || (value < 0.0) || (value > 100.0)) return 0;
+        list[count++] = value;
+        text = strchr(text, ',');
+        if (NULL != text) text++;
+    }
+    return count;
+}  // end ParseLossList()
+
+static void Usage()
+{
+    fprintf(stderr, "Usage: normPerf [type {data|file|stream|all}][recv <count>][fork]\n"
+                    "                [addr <addr>][port <port>][interface <name>]\n"
+                    "                [size <bytes>][count <n>][msize <bytes>][mcount <n>]\n"
+                    "                [segment <bytes>][block <n>][parity <n>][auto <n>]\n"
+                    "                [rate <bits/sec>][cc][txloss <pct>[,<pct>...]]\n"
+                    "                [rxloss <pct>[,<pct>...]][cache <dir>][timeout <sec>]\n"
+                    "                [debug <level>]\n");
+}  // end Usage()
+
+int main(int argc, char* argv[])
+{
+    PerfConfig config;
+    bool typeEnable[PERF_TYPE_COUNT] = {true, true, true};
+    double txLossList[LOSS_MAX] = {0.0};
+    unsigned int txLossCount = 1;
+    double rxLossList[LOSS_MAX] = {0.0};
+    unsigned int rxLossCount = 1;
+    int debugLevel = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* cmd = argv[i];
+        if (!strcmp(cmd, "fork"))
+        {
+#ifdef UNIX
+            config.use_fork = true;
+#else
+            fprintf(stderr, "normPerf: \"fork\" option not supported on this system\n");
+            return -1;
+#endif // if/else UNIX
+            continue;
+        }
+        else if (!strcmp(cmd, "cc"))
+        {
+            config.cc_enable = true;
+            continue;
+        }
+        if ((i + 1) >= argc)
+        {
+            fprintf(stderr, "normPerf: missing or invalid \"%s\" argument\n", cmd);
+            Usage();
+            return -1;
+        }
+        const char* val = argv[++i];
+        bool valid = true;
+        if (!strcmp(cmd, "type"))
+        {
+            for (unsigned int t = 0; t < PERF_TYPE_COUNT; t++)
+                typeEnable[t] = !strcmp(val, "all") || !strcmp(val, PERF_TYPE_NAME[t]);
+            valid = typeEnable[PERF_DATA] || typeEnable[PERF_FILE] || typeEnable[PERF_STREAM];
+        }
+        else if (!strcmp(cmd, "recv"))
+        {
+            int value = atoi(val);
+            valid = (value > 0);
+            config.num_receivers = (unsigned int)value;
+        }
+        else if (!strcmp(cmd, "addr"))
+        {
+            config.addr = val;
+        }
+        else if (!strcmp(cmd, "port"))
+        {
+            int value = atoi(val);
+            valid = (value > 0) && (value < 65536);
+            config.port = (UINT16)value;
+        }
+        else if (!strcmp(cmd, "interface"))
+        {
+            config.iface = val;
+        }
+        else if (!strcmp(cmd, "size"))
+        {
+            int value = atoi(val);
+            valid = (value > 0);
+            config.object_size = (unsigned int)value;
+        }
+        else if (!strcmp(cmd, "count"))
+        {
+            int value = atoi(val);
+            valid = (value > 0);
+            config.object_count = (unsigned int)value;
+        }
+        else if (!strcmp(cmd, "msize"))
+        {
+            int value = atoi(val);
+            valid = (value >= (int)PERF_MSG_HEADER_SIZE);
+            config.msg_size = (unsigned int)value;
+        }
+        else if (!strcmp(cmd, "mcount"))
+        {
+            int value = atoi(val);
+            valid = (value > 0);
+            config.msg_count = (unsigned int)value;
+        }
+        else if (!strcmp(cmd, "segment"))
+        {
+            int value = atoi(val);
+            valid = (value > 0) && (value < 65536);
+            config.segment_size = (UINT16)value;
+        }
+        else if (!strcmp(cmd, "block"))
+        {
+            int value = atoi(val);
+            valid = (value > 0) && (value < 65536);
+            config.num_data = (UINT16)value;
+        }
+        else if (!strcmp(cmd, "parity"))
+        {
+            int value = atoi(val);
+            valid = (value >= 0) && (value < 65536);
+            config.num_parity = (UINT16)value;
+        }
+        else if (!strcmp(cmd, "auto"))
+        {
+            int value = atoi(val);
+            valid = (value >= 0) && (value < 65536);
+            config.auto_parity = (UINT16)value;
+        }
+        else if (!strcmp(cmd, "rate"))
+        {
+            config.tx_rate = atof(val);
+            valid = (config.tx_rate > 0.0);
+        }
+        else if (!strcmp(cmd, "txloss"))
+        {
+            txLossCount = ParseLossList(val, txLossList);
+            valid = (0 != txLossCount);
+        }
+        else if (!strcmp(cmd, "rxloss"))
+        {
+            rxLossCount = ParseLossList(val, rxLossList);
+            valid = (0 != rxLossCount);
+        }
+        else if (!strcmp(cmd, "cache"))
+        {
+            config.cache_dir = val;
+        }
+        else if (!strcmp(cmd, "timeout"))
+        {
+            config.timeout = atof(val);
+            valid = (config.timeout > 0.0);
+        }
+        else if (!strcmp(cmd, "debug"))
+        {
+            debugLevel = atoi(val);
+        }
+        else
+        {
+            fprintf(stderr, "normPerf: invalid command \"%s\"\n", cmd);
+            Usage();
+            return -1;
+        }
+        if (!valid)
+        {
+            fprintf(stderr, "normPerf: invalid \"%s\" value \"%s\"\n", cmd, val);
+            Usage();
+            return -1;
+        }
+    }
+    if (config.auto_parity > config.num_parity)
+    {
+        fprintf(stderr, "normPerf: \"auto\" parity exceeds \"parity\" count\n");
+        return -1;
+    }
+    NormSetDebugLevel(debugLevel);
+
+    // Source data for data objects (shared by all enqueued objects)
+    // and a temporary file of the same content for file objects
+    char* dataBuffer = NULL;
+    char filePath[PATH_MAX + 1];
+    filePath[0] = '\0';
+    if (typeEnable[PERF_DATA] || typeEnable[PERF_FILE])
+    {
+        if (NULL == (dataBuffer = new char[config.object_size]))
+        {
+            perror("normPerf: new dataBuffer error");
+            return -1;
+        }
+        for (unsigned int i = 0; i < config.object_size; i++)
+            dataBuffer[i] = (char)i;
+    }
+    if (typeEnable[PERF_FILE])
+    {
+#ifdef WIN32
+        unsigned int processId = (unsigned int)GetCurrentProcessId();
+#else
+        unsigned int processId = (unsigned int)getpid();
+#endif // if/else WIN32/UNIX
+        snprintf(filePath, PATH_MAX, "%snormPerf-%u.dat", config.cache_dir, processId);
+        FILE* file = fopen(filePath, "wb");
+        if ((NULL == file) || (1 != fwrite(dataBuffer, config.object_size, 1, file)))
+        {
+            perror("normPerf: error creating temporary file");
+            if (NULL != file) fclose(file);
+            delete[] dataBuffer;
+            return -1;
+        }
+        fclose(file);
+    }
+
+    printf("type,receivers,txloss,rxloss,objects,bytes,goodputMbps,pps,"
+           "cpuSecPerGB,p50ms,p99ms,p999ms,overhead,complete\n");
+    fflush(stdout);
+    unsigned int failureCount = 0;
+    for (unsigned int t = 0; t < PERF_TYPE_COUNT; t++)
+    {
+        if (!typeEnable[t]) continue;
+        for (unsigned int i = 0; i < txLossCount; i++)
+        {
+            for (unsigned int j = 0; j < rxLossCount; j++)
+            {
+                if (!RunTest(config, (PerfType)t, txLossList[i], rxLossList[j], dataBuffer, filePath))
+                    failureCount++;
+            }
+        }
+    }
+    if ('\0' != filePath[0]) remove(filePath);
+    if (NULL != dataBuffer) delete[] dataBuffer;
+    if (0 != failureCount)
+        fprintf(stderr, "normPerf: %u run(s) incomplete\n", failureCount);
+    return ((0 == failureCount) ? 0 : 1);
+}  // end main()
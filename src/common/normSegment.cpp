@@ -1,8 +1,12 @@
 #include "normSegment.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>  // for _BitScanReverse64()
+#endif // _MSC_VER
+
 NormSegmentPool::NormSegmentPool()
  : seg_size(0), seg_count(0), seg_total(0), seg_list(NULL), seg_pool(NULL),
-   peak_usage(0), overruns(0), overrun_flag(false)
+   overrun_flag(false)
 {
 }
 
@@ -14,8 +18,8 @@ NormSegmentPool::~NormSegmentPool()
 bool NormSegmentPool::Init(unsigned int count, unsigned int size)
 {
     if (seg_pool) Destroy();
-    peak_usage = 0;
-    overruns = 0;        
+    peak_usage.Reset();
+    overruns.Reset();        
 #ifdef SIMULATE
     // In simulations, don't really need big vectors for data
     // since we don't actually read/write real data (for the most part)
@@ -70,14 +74,14 @@ char* NormSegmentPool::Get()
 //#ifdef NORM_DEBUG
         overrun_flag = false;
         unsigned int usage = seg_total - seg_count;
-        if (usage > peak_usage) peak_usage = usage;
+        peak_usage.UpdateMax(usage);
     }
     else
     {
         if (!overrun_flag)
         {
             PLOG(PL_WARN, "NormSegmentPool::Get() warning: operating with constrained buffering resources\n");
-            overruns++; 
+            overruns.Increment(); 
             overrun_flag = true;
         } 
 //#endif // NORM_DEBUG 
@@ -85,6 +89,122 @@ char* NormSegmentPool::Get()
     return ptr;
 }  // end NormSegmentPool::GetSegment()
 
+////////////////////////////////////////////////////////////
+// NormBitmaskRunIterator Implementation
+
+// Note ProtoBitmask stores bit index 0 as the most significant bit
+// of the first mask byte, so the mask is loaded as big-endian words
+// and scanned with "count leading zeros"
+
+static inline UINT32 NormCountLeadingZeros(UINT64 word)
+{
+    ASSERT(0 != word);
+#if defined(__GNUC__) || defined(__clang__)
+    return (UINT32)__builtin_clzll(word);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanReverse64(&index, word);
+    return (UINT32)(63 - index);
+#else
+    UINT32 count = 0;
+    while (0 == (word & ((UINT64)1 << 63)))
+    {
+        word <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}  // end NormCountLeadingZeros()
+
+static inline UINT32 NormPopCount(UINT64 word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (UINT32)__builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (UINT32)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}  // end NormPopCount()
+
+NormBitmaskRunIterator::NormBitmaskRunIterator(const ProtoBitmask& mask,
+                                               UINT32              firstIndex,
+                                               UINT32              endIndex)
+ : mask_ptr(mask.GetMask()), mask_len(mask.GetLength()),
+   next_index(firstIndex), end_index(endIndex)
+{
+    if (end_index > mask.GetSize()) end_index = mask.GetSize();
+}
+
+// Returns the 64-bit word of the mask containing "index", inverted when
+// searching for unset bits, with bits outside [index, end_index) cleared
+UINT64 NormBitmaskRunIterator::GetWord(UINT32 index, bool set, UINT32& wordBase) const
+{
+    UINT32 byteIndex = index >> 3;
+    wordBase = byteIndex << 3;
+    UINT32 byteCount = mask_len - byteIndex;
+    if (byteCount > 8) byteCount = 8;
+    UINT64 word = 0;
+    for (UINT32 i = 0; i < byteCount; i++)
+        word |= ((UINT64)mask_ptr[byteIndex + i]) << (56 - (i << 3));
+    if (!set) word = ~word;
+    word &= ((UINT64)-1) >> (index & 0x07);
+    UINT32 span = end_index - wordBase;
+    if (span < 64) word &= ~(((UINT64)-1) >> span);
+    return word;
+}  // end NormBitmaskRunIterator::GetWord()
+
+UINT32 NormBitmaskRunIterator::FindNext(UINT32 index, bool set) const
+{
+    while (index < end_index)
+    {
+        UINT32 wordBase;
+        UINT64 word = GetWord(index, set, wordBase);
+        if (0 != word) return (wordBase + NormCountLeadingZeros(word));
+        index = wordBase + 64;
+    }
+    return end_index;
+}  // end NormBitmaskRunIterator::FindNext()
+
+bool NormBitmaskRunIterator::GetNextRun(UINT32& runStart, UINT32& runCount)
+{
+    UINT32 start = FindNext(next_index, true);
+    if (start >= end_index)
+    {
+        next_index = end_index;
+        return false;
+    }
+    next_index = FindNext(start + 1, false);
+    runStart = start;
+    runCount = next_index - start;
+    return true;
+}  // end NormBitmaskRunIterator::GetNextRun()
+
+bool NormBitmaskRunIterator::SkipSet(UINT32 count)
+{
+    while (0 != count)
+    {
+        if (next_index >= end_index) return false;
+        UINT32 wordBase;
+        UINT64 word = GetWord(next_index, true, wordBase);
+        UINT32 bits = NormPopCount(word);
+        if (bits < count)
+        {
+            count -= bits;
+            next_index = wordBase + 64;
+        }
+        else
+        {
+            // Clear the leading "count - 1" set bits to find the last one skipped
+            while (--count)
+                word &= ~(((UINT64)1 << 63) >> NormCountLeadingZeros(word));
+            next_index = wordBase + NormCountLeadingZeros(word) + 1;
+        }
+    }
+    return true;
+}  // end NormBitmaskRunIterator::SkipSet()
+
 
 ////////////////////////////////////////////////////////////
 // NormBlock Implementation
@@ -188,17 +308,18 @@ bool NormBlock::IsRepairPending(UINT16 numData, UINT16 numParity)
     {
         if (numParity)
         {
-            UINT16 i = numParity;
-            NormSegmentId nextId = 0;
-            GetFirstPending(nextId);
-            while (i--)
+            // Set bits for the first numParity pending segments (parity can fill these)
+            // (TBD) for more NACK suppression, we could skip ahead
+            // if this bit is already set in repair_mask?
+            UINT32 remaining = numParity;
+            UINT32 runStart, runCount;
+            NormBitmaskRunIterator iterator(pending_mask, 0, size);
+            while ((0 != remaining) && iterator.GetNextRun(runStart, runCount))
             {
-                // (TBD) for more NACK suppression, we could skip ahead
-                // if this bit is already set in repair_mask?
-                repair_mask.Set(nextId);  // set bit a parity can fill
-                nextId++;
-                GetNextPending(nextId);  
-            } 
+                if (runCount > remaining) runCount = remaining;
+                repair_mask.SetBits(runStart, runCount);
+                remaining -= runCount;
+            }
         }
         else if (size > numData)
         {
@@ -348,15 +469,7 @@ bool NormBlock::HandleSegmentRequest(NormSegmentId nextId, NormSegmentId lastId,
     {
         // Explicit data repair request
         parity_count = parity_offset = numParity;
-        while (nextId <= lastId)
-        {
-            if (!repair_mask.Test(nextId))
-            {
-                repair_mask.Set(nextId);
-                increasedRepair = true;
-            }
-            nextId++; 
-        }   
+        increasedRepair = MergeRepairRange(nextId, lastId);
     }
     else
     {
@@ -387,20 +500,27 @@ bool NormBlock::HandleSegmentRequest(NormSegmentId nextId, NormSegmentId lastId,
                 increasedRepair = true;
             }
             // and explicit repair for the rest
-            while (nextId <= lastId)
-            {
-                if (!repair_mask.Test(nextId))
-                {
-                    repair_mask.Set(nextId);
-                    increasedRepair = true;
-                }
-                nextId++; 
-            } 
+            if (MergeRepairRange(nextId, lastId))
+                increasedRepair = true;
         }   
     }
     return increasedRepair;
 }  // end NormBlock::HandleSegmentRequest()
 
+// Sets repair_mask bits [firstId, lastId], returning "true" if any
+// bit in the range was not already set.  (The range comes from a NACK, 
+// so it is clamped to the mask size)
+bool NormBlock::MergeRepairRange(NormSegmentId firstId, NormSegmentId lastId)
+{
+    UINT32 maskSize = repair_mask.GetSize();
+    if ((firstId > lastId) || ((UINT32)firstId >= maskSize)) return false;
+    if ((UINT32)lastId >= maskSize) lastId = (NormSegmentId)(maskSize - 1);
+    NormBitmaskRunIterator iterator(repair_mask, firstId, (UINT32)lastId + 1);
+    if (iterator.FindNextUnset(firstId) > lastId) return false;  // already fully set
+    repair_mask.SetBits(firstId, lastId - firstId + 1);
+    return true;
+}  // end NormBlock::MergeRepairRange()
+
 // (TBD) this should return true if something is appended, false otherwise
 bool NormBlock::AppendRepairAdv(NormCmdRepairAdvMsg& cmd, 
                                 NormObjectId         objectId,
@@ -414,80 +534,50 @@ bool NormBlock::AppendRepairAdv(NormCmdRepairAdvMsg& cmd,
     NormRepairRequest req;
     req.SetFlag(NormRepairRequest::SEGMENT);
     if (repairInfo) req.SetFlag(NormRepairRequest::INFO);
-    NormSymbolId nextId = 0;
-    if (GetFirstRepair(nextId))
-    {
-        UINT16 totalSize = size;
-        NormRepairRequest::Form prevForm = NormRepairRequest::INVALID;
-        UINT16 segmentCount = 0;
-        UINT16 firstId = 0;
-        while (nextId < totalSize)
+    NormRepairRequest::Form prevForm = NormRepairRequest::INVALID;
+    NormBitmaskRunIterator iterator(repair_mask, 0, size);
+    UINT32 runStart, runCount;
+    while (iterator.GetNextRun(runStart, runCount))
+    {
+        // A run of 1 or 2 segments is sent as ITEMS, longer runs as a RANGE
+        NormRepairRequest::Form form = (runCount < 3) ? NormRepairRequest::ITEMS : 
+                                                        NormRepairRequest::RANGES;
+        UINT16 firstId = (UINT16)runStart;
+        UINT16 lastId = (UINT16)(runStart + runCount - 1);
+        if (form != prevForm)
         {
-            UINT16 currentId = nextId;
-            if (!GetNextRepair(++nextId)) nextId = totalSize;
-            if (!segmentCount) firstId = currentId;
-            segmentCount++;
-            // Check for break in consecutive series or end
-            if (((nextId  - currentId) > 1) || (nextId >= totalSize))
+            if (NormRepairRequest::INVALID != prevForm) 
             {
-                NormRepairRequest::Form form;
-                switch (segmentCount)
+                if (0 == cmd.PackRepairRequest(req))
                 {
-                    case 0:
-                        form = NormRepairRequest::INVALID;
-                        break;
-                    case 1:
-                    case 2:
-                        form = NormRepairRequest::ITEMS;
-                        break;
-                    default:
-                        form = NormRepairRequest::RANGES;
-                        break;
+                    prevForm = NormRepairRequest::INVALID;
+                    PLOG(PL_WARN, "NormBlock::AppendRepairAdv() warning: full msg\n");
+                    break;
                 }
-                if (form != prevForm)
-                {
-                    if (NormRepairRequest::INVALID != prevForm) 
-                    {
-                        if (0 == cmd.PackRepairRequest(req))
-                        {
-                            prevForm = NormRepairRequest::INVALID;
-                            PLOG(PL_WARN, "NormBlock::AppendRepairAdv() warning: full msg\n");
-                            break;
-                        }
-                        requestAppended = true;
-                    }
-                    req.SetForm(form);
-                    cmd.AttachRepairRequest(req, payloadMax); // (TBD) error check
-                    prevForm = form;
-                }            
-                switch(form)
-                {
-                    case NormRepairRequest::INVALID:
-                        ASSERT(0);  // can't happen
-                        break;
-                    case NormRepairRequest::ITEMS:
-                        req.AppendRepairItem(fecId, fecM, objectId, blk_id, numData, firstId);
-                        if (2 == segmentCount) 
-                            req.AppendRepairItem(fecId, fecM, objectId, blk_id, numData, currentId);
-                        break;
-                    case NormRepairRequest::RANGES:
-                        req.AppendRepairRange(fecId, fecM, objectId, blk_id, numData, firstId,
-                                              objectId, blk_id, numData, currentId);
-                        break;
-                    case NormRepairRequest::ERASURES:
-                        // erasure counts not used
-                        break;
-                } 
-                segmentCount = 0;  
+                requestAppended = true;
             }
-        }  // end while (nextId < totalSize)
-        if (NormRepairRequest::INVALID != prevForm) 
+            req.SetForm(form);
+            cmd.AttachRepairRequest(req, payloadMax); // (TBD) error check
+            prevForm = form;
+        }            
+        if (NormRepairRequest::ITEMS == form)
         {
-            if (0 == cmd.PackRepairRequest(req))
-                PLOG(PL_WARN, "NormBlock::AppendRepairAdv() warning: full msg\n");
-            else
-                requestAppended = true;
+            req.AppendRepairItem(fecId, fecM, objectId, blk_id, numData, firstId);
+            if (2 == runCount) 
+                req.AppendRepairItem(fecId, fecM, objectId, blk_id, numData, lastId);
         }
+        else
+        {
+            req.AppendRepairRange(fecId, fecM, objectId, blk_id, numData, firstId,
+                                  objectId, blk_id, numData, lastId);
+        }
+    }  // end while (iterator.GetNextRun())
+    if (NormRepairRequest::INVALID != prevForm) 
+    {
+        if (0 == cmd.PackRepairRequest(req))
+            PLOG(PL_WARN, "NormBlock::AppendRepairAdv() warning: full msg\n");
+        else
+            requestAppended = true;
     }
     return requestAppended;
 }  // end NormBlock::AppendRepairAdv()
@@ -531,95 +621,62 @@ bool NormBlock::AppendRepairRequest(NormNackMsg&    nack,
                                     UINT16          payloadMax)
 {
     bool requestAppended = false;
-    NormSegmentId nextId = 0;
-    NormSegmentId endId;
+    UINT32 firstIndex, endIndex;
     if (erasure_count > numParity)
     {
-        // Request explicit repair 
-        GetFirstPending(nextId);
-        UINT16 i = numParity;
-        // Skip numParity missing data segments
-        while (i--)
-        {
-            nextId++;
-            GetNextPending(nextId);
-        }
-        endId = numData + numParity;
+        // Request explicit repair, skipping the first numParity
+        // missing segments (parity will fill those)
+        firstIndex = 0;
+        endIndex = numData + numParity;
     }
     else
     {
-        nextId = numData;
-        GetNextPending(nextId);
-        endId = numData + erasure_count;   
+        firstIndex = numData;
+        endIndex = numData + erasure_count;   
     }
+    NormBitmaskRunIterator iterator(pending_mask, firstIndex, endIndex);
+    if (erasure_count > numParity) iterator.SkipSet(numParity);
     NormRepairRequest req;
     req.SetFlag(NormRepairRequest::SEGMENT);                  
     if (pendingInfo) req.SetFlag(NormRepairRequest::INFO);  
     NormRepairRequest::Form prevForm = NormRepairRequest::INVALID;
-    UINT16 segmentCount = 0;
-    // new code begins here  
-    UINT16 firstId = 0;
-    while (nextId < endId)
-    {
-        UINT16 currentId = nextId;
-        if (!GetNextPending(++nextId)) nextId = endId;
-        if (0 == segmentCount) firstId = currentId;
-        segmentCount++;
-        // Check for break in consecutive series or end
-        if (((nextId  - currentId) > 1) || (nextId >= endId))
+    UINT32 runStart, runCount;
+    while (iterator.GetNextRun(runStart, runCount))
+    {
+        // A run of 1 or 2 segments is requested as ITEMS, longer runs as a RANGE
+        NormRepairRequest::Form form = (runCount < 3) ? NormRepairRequest::ITEMS : 
+                                                        NormRepairRequest::RANGES;
+        UINT16 firstId = (UINT16)runStart;
+        UINT16 lastId = (UINT16)(runStart + runCount - 1);
+        if (form != prevForm)
         {
-            NormRepairRequest::Form form;
-            switch (segmentCount)
-            {
-                case 0:
-                    form = NormRepairRequest::INVALID;
-                    break;
-                case 1:
-                case 2:
-                    form = NormRepairRequest::ITEMS;
-                    break;
-                default:
-                    form = NormRepairRequest::RANGES;
-                    break;
-            }   
-            if (form != prevForm)
+            if (NormRepairRequest::INVALID != prevForm) 
             {
-                if (NormRepairRequest::INVALID != prevForm) 
+                if (0 == nack.PackRepairRequest(req))
                 {
-                    if (0 == nack.PackRepairRequest(req))
-                    {
-                        prevForm = NormRepairRequest::INVALID;  // so we don't re-attempt pack
-                        PLOG(PL_WARN, "NormBlock::AppendRepairRequest() warning: full NACK msg\n");
-                        break;   
-                    }
-                    requestAppended = true;
+                    prevForm = NormRepairRequest::INVALID;  // so we don't re-attempt pack
+                    PLOG(PL_WARN, "NormBlock::AppendRepairRequest() warning: full NACK msg\n");
+                    break;   
                 }
-                nack.AttachRepairRequest(req, payloadMax);  // (TBD) error check
-                req.SetForm(form);
-                prevForm = form;
+                requestAppended = true;
             }
-            switch (form)
-            {
-                case NormRepairRequest::INVALID:
-                    ASSERT(0);
-                    break;
-                case NormRepairRequest::ITEMS:
-                    req.AppendRepairItem(fecId, fecM, objectId, blk_id, numData, firstId);       // (TBD) error check
-                    if (2 == segmentCount)
-                        req.AppendRepairItem(fecId, fecM, objectId, blk_id, numData, currentId); // (TBD) error check
-                    break;
-                case NormRepairRequest::RANGES:
-                    req.AppendRepairRange(fecId, fecM, 
-                                          objectId, blk_id, numData, firstId,       // (TBD) error check
-                                          objectId, blk_id, numData, currentId);    // (TBD) error check
-                    break;
-                case NormRepairRequest::ERASURES:
-                    // erasure counts not used
-                    break;
-            }  // end switch(form)
-            segmentCount = 0;
-        }       
-    }  // end while (nextId < lastId)
+            nack.AttachRepairRequest(req, payloadMax);  // (TBD) error check
+            req.SetForm(form);
+            prevForm = form;
+        }
+        if (NormRepairRequest::ITEMS == form)
+        {
+            req.AppendRepairItem(fecId, fecM, objectId, blk_id, numData, firstId);       // (TBD) error check
+            if (2 == runCount)
+                req.AppendRepairItem(fecId, fecM, objectId, blk_id, numData, lastId);    // (TBD) error check
+        }
+        else
+        {
+            req.AppendRepairRange(fecId, fecM, 
+                                  objectId, blk_id, numData, firstId,       // (TBD) error check
+                                  objectId, blk_id, numData, lastId);       // (TBD) error check
+        }
+    }  // end while (iterator.GetNextRun())
     if (NormRepairRequest::INVALID != prevForm) 
     {
         if (0 == nack.PackRepairRequest(req))
@@ -631,7 +688,7 @@ bool NormBlock::AppendRepairRequest(NormNackMsg&    nack,
 }  // end NormBlock::AppendRepairRequest()
          
 NormBlockPool::NormBlockPool()
- : head((NormBlock*)NULL), blk_total(0), blk_count(0), overruns(0), overrun_flag(false)
+ : head((NormBlock*)NULL), blk_total(0), blk_count(0), overrun_flag(false)
 {
 }
 
@@ -682,9 +739,139 @@ void NormBlockPool::Destroy()
     blk_count = blk_total = 0;
 }  // end NormBlockPool::Destroy()
 
+NormParityCache::NormParityCache()
+ : entry_list(NULL), entry_count(0), parity_buffer(NULL),
+   num_parity(0), payload_max(0)
+{
+}
+
+NormParityCache::~NormParityCache()
+{
+    Destroy();
+}
+
+bool NormParityCache::Init(unsigned int numEntries, UINT16 numParity, UINT16 payloadMax)
+{
+    Destroy();
+    if ((0 == numEntries) || (0 == numParity)) return true;  // (cache disabled)
+    if (NULL == (entry_list = new Entry[numEntries]))
+    {
+        PLOG(PL_FATAL, "NormParityCache::Init() new entry_list error: %s\n", GetErrorString());
+        return false;
+    }
+    unsigned long entrySize = (unsigned long)numParity * payloadMax;
+    if (NULL == (parity_buffer = new char[numEntries * entrySize]))
+    {
+        PLOG(PL_FATAL, "NormParityCache::Init() new parity_buffer error: %s\n", GetErrorString());
+        Destroy();
+        return false;
+    }
+    for (unsigned int i = 0; i < numEntries; i++)
+    {
+        entry_list[i].valid = false;
+        entry_list[i].parity = parity_buffer + i*entrySize;
+    }
+    entry_count = numEntries;
+    num_parity = numParity;
+    payload_max = payloadMax;
+    hit_count.Reset();
+    miss_count.Reset();
+    return true;
+}  // end NormParityCache::Init()
+
+void NormParityCache::Destroy()
+{
+    if (NULL != parity_buffer)
+    {
+        delete[] parity_buffer;
+        parity_buffer = NULL;
+    }
+    if (NULL != entry_list)
+    {
+        delete[] entry_list;
+        entry_list = NULL;
+    }
+    entry_count = 0;
+}  // end NormParityCache::Destroy()
+
+NormParityCache::Entry* NormParityCache::Find(NormObjectId objectId, const NormBlockId& blockId)
+{
+    for (unsigned int i = 0; i < entry_count; i++)
+    {
+        Entry* entry = entry_list + i;
+        if (entry->valid && (entry->object_id == objectId) && (entry->block_id == blockId))
+            return entry;
+    }
+    return NULL;
+}  // end NormParityCache::Find()
+
+void NormParityCache::Save(NormObjectId objectId, NormBlock& block, UINT16 numData)
+{
+    if (NULL == entry_list) return;
+    ASSERT(block.ParityReady(numData));
+    Entry* entry = Find(objectId, block.GetId());
+    if (NULL == entry)
+    {
+        // Use a free entry or else evict the least recently NACKed one
+        entry = entry_list;
+        for (unsigned int i = 0; i < entry_count; i++)
+        {
+            Entry* next = entry_list + i;
+            if (!next->valid)
+            {
+                entry = next;
+                break;
+            }
+            if (ProtoTime::Delta(next->last_nack_time, entry->last_nack_time) < 0.0)
+                entry = next;
+        }
+    }
+    for (UINT16 i = 0; i < num_parity; i++)
+    {
+        const char* segment = block.GetSegment(numData + i);
+        ASSERT(NULL != segment);
+        memcpy(entry->parity + i*payload_max, segment, payload_max);
+    }
+    entry->object_id = objectId;
+    entry->block_id = block.GetId();
+    entry->seg_size_max = block.GetSegSizeMax();
+    entry->last_nack_time = block.GetLastNackTime();
+    entry->valid = true;
+}  // end NormParityCache::Save()
+
+bool NormParityCache::Restore(NormObjectId objectId, NormBlock& block, UINT16 numData)
+{
+    if (NULL == entry_list) return false;
+    Entry* entry = Find(objectId, block.GetId());
+    if (NULL == entry)
+    {
+        miss_count.Increment();
+        return false;
+    }
+    for (UINT16 i = 0; i < num_parity; i++)
+    {
+        char* segment = block.GetSegment(numData + i);
+        ASSERT(NULL != segment);
+        memcpy(segment, entry->parity + i*payload_max, payload_max);
+    }
+    block.UpdateSegSizeMax(entry->seg_size_max);
+    block.SetParityReadiness(numData);
+    hit_count.Increment();
+    return true;
+}  // end NormParityCache::Restore()
+
+void NormParityCache::Invalidate(NormObjectId objectId)
+{
+    for (unsigned int i = 0; i < entry_count; i++)
+    {
+        if (entry_list[i].object_id == objectId)
+            entry_list[i].valid = false;
+    }
+}  // end NormParityCache::Invalidate()
+
 NormBlockBuffer::NormBlockBuffer()
 #ifdef USE_PROTO_TREE
- :
+ : direct_table((NormBlock**)NULL), direct_mask(0), direct_misses(0),
 #else
  : table((NormBlock**)NULL), 
 #endif  // if/else USE_PROTO_TREE
@@ -697,7 +884,8 @@ NormBlockBuffer::~NormBlockBuffer()
     Destroy();
 }
 
-bool NormBlockBuffer::Init(unsigned long rangeMax, unsigned long tableSize, UINT32 fecBlockMask)
+bool NormBlockBuffer::Init(unsigned long rangeMax, unsigned long tableSize, UINT32 fecBlockMask,
+                           bool directIndex)
 {
     Destroy();
     // Make sure tableSize is greater than 0 and 2^n
@@ -717,7 +905,24 @@ bool NormBlockBuffer::Init(unsigned long rangeMax, unsigned long tableSize, UINT
     }
     memset(table, 0, tableSize*sizeof(char*));
     hash_mask = tableSize - 1;
-#endif // !USE_PROTO_TREE
+#else
+    if (directIndex)
+    {
+        // Table size is the power of 2 covering MIN(rangeMax, tableSize), but 
+        // no larger than the block id space so indices stay valid upon wrap
+        unsigned long tableMax = (rangeMax < tableSize) ? rangeMax : tableSize;
+        direct_mask = 0;
+        while ((direct_mask < fecBlockMask) && ((unsigned long)direct_mask + 1) < tableMax)
+            direct_mask = (direct_mask << 1) | 0x01;
+        if (NULL == (direct_table = new NormBlock*[direct_mask + 1]))
+        {
+            PLOG(PL_FATAL, "NormBlockBuffer::Init() direct_table allocation error: %s\n", GetErrorString());
+            return false;
+        }
+        memset(direct_table, 0, (direct_mask + 1)*sizeof(NormBlock*));
+        direct_misses = 0;
+    }
+#endif // if/else USE_PROTO_TREE
     range_max = rangeMax;
     range = 0;
     fec_block_mask = fecBlockMask;
@@ -734,6 +939,13 @@ void NormBlockBuffer::Destroy()
         Remove(block);
         delete block;   
     }
+    if (NULL != direct_table)
+    {
+        delete[] direct_table;
+        direct_table = (NormBlock**)NULL;
+    }
+    direct_mask = 0;
+    direct_misses = 0;
     range_max = range = 0;
 }  // end NormBlockBuffer::Destroy()
 
@@ -741,8 +953,14 @@ NormBlock* NormBlockBuffer::Find(const NormBlockId& blockId) const
 {
     if ((0 == range) || (Compare(blockId, range_lo) < 0) || (Compare(blockId, range_hi) > 0))
         return NULL;
-    else
-        return tree.Find(blockId.GetValuePtr(), 8*sizeof(UINT32));
+    if (NULL != direct_table)
+    {
+        NormBlock* block = direct_table[blockId.GetValue() & direct_mask];
+        if ((NULL != block) && (blockId == block->GetId())) return block;
+        // Only blocks evicted from the table by collisions need the tree
+        if (0 == direct_misses) return NULL;
+    }
+    return tree.Find(blockId.GetValuePtr(), 8*sizeof(UINT32));
 }  // end NormBlockBuffer::Find()
 
 #else
@@ -859,6 +1077,14 @@ bool NormBlockBuffer::Insert(NormBlock* theBlock)
 #ifdef USE_PROTO_TREE
     ASSERT(NULL == Find(theBlock->GetId()));
     tree.Insert(*theBlock);
+    if (NULL != direct_table)
+    {
+        // The newest block wins a table slot collision (which only occurs
+        // when the buffered range is wider than the table)
+        NormBlock*& slot = direct_table[blockId.GetValue() & direct_mask];
+        if (NULL != slot) direct_misses++;
+        slot = theBlock;
+    }
 #else
     UINT32 index = blockId.GetValue() & hash_mask;
     NormBlock* prev = NULL;
@@ -918,6 +1144,14 @@ bool NormBlockBuffer::Remove(NormBlock* theBlock)
     }
     ASSERT(NULL != tree.Find(theBlock->GetId().GetValuePtr(), 8*sizeof(UINT32)));
     tree.Remove(*theBlock);
+    if (NULL != direct_table)
+    {
+        NormBlock*& slot = direct_table[blockId.GetValue() & direct_mask];
+        if (theBlock == slot)
+            slot = (NormBlock*)NULL;
+        else
+            direct_misses--;  // (it had been evicted from the table)
+    }
     return true;
 }  // end NormBlockBuffer::Remove()
 
@@ -10,6 +10,20 @@
 #include "protoPktIP.h"
 #include "protoNet.h"
 
+#if defined(NORM_RECVMMSG) || defined(NORM_SENDMMSG)
+#include <sys/socket.h>  // for recvmmsg(), sendmmsg()
+#include <netinet/in.h>  // for struct in_pktinfo, in6_pktinfo
+#include <errno.h>
+#endif // NORM_RECVMMSG || NORM_SENDMMSG
+#ifdef NORM_SENDMMSG
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif // !SOL_UDP
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103  // (from linux/udp.h, for older headers)
+#endif // !UDP_SEGMENT
+#endif // NORM_SENDMMSG
+
 const UINT8 NormSession::DEFAULT_TTL = 255;
 const double NormSession::DEFAULT_TRANSMIT_RATE = 64000.0;  // bits/sec
 const double NormSession::DEFAULT_GRTT_INTERVAL_MIN = 1.0;  // sec
@@ -24,8 +38,11 @@ const UINT16 NormSession::DEFAULT_NPARITY = 8;
 const UINT16 NormSession::DEFAULT_TX_CACHE_MIN = 8;
 const UINT16 NormSession::DEFAULT_TX_CACHE_MAX = 256;
 const UINT32 NormSession::DEFAULT_TX_CACHE_SIZE = (UINT32)20 * 1024 * 1024;
+const unsigned int NormSession::DEFAULT_TX_PARITY_CACHE = 8;  // blocks
 const double NormSession::DEFAULT_FLOW_CONTROL_FACTOR = 2.0;
 const UINT16 NormSession::DEFAULT_RX_CACHE_MAX = 256;
+const double NormSession::TX_BATCH_INTERVAL = 0.001;        // sec
+const double NormSession::TX_SPIN_MAX = 0.0002;             // sec
 
 const int NormSession::DEFAULT_ROBUST_FACTOR = 20; // default robust factor
 
@@ -49,20 +66,29 @@ NormSession::NormSession(NormSessionMgr &sessionMgr, NormNodeId localNodeId)
 #ifdef ECN_SUPPORT 
       proto_cap(NULL), 
 #endif // ECN_SUPPORT
+      rx_batch_size(0), rx_busy_poll(0),
+#ifdef NORM_RECVMMSG
+      rx_batch_msgs(NULL), rx_batch_hdrs(NULL), rx_batch_iovs(NULL),
+      rx_batch_addrs(NULL), rx_batch_ctrl(NULL),
+#endif // NORM_RECVMMSG
       rx_port_reuse(false), local_node_id(localNodeId),
       ttl(DEFAULT_TTL), tos(0), loopback(false), mcast_loopback(false), fragmentation(false), ecn_enabled(false),
-      tx_rate(DEFAULT_TRANSMIT_RATE / 8.0), tx_rate_min(-1.0), tx_rate_max(-1.0), tx_residual(0),
+      tx_rate(DEFAULT_TRANSMIT_RATE / 8.0), tx_rate_min(-1.0), tx_rate_max(-1.0),
+      tx_batch_size(0), tx_gso(true), tx_pace_mode(TX_PACE_TIMER), tx_bucket_tokens(0.0),
+      tx_residual(0), file_mapping(false), file_read_ahead(DEFAULT_FILE_READ_AHEAD),
       backoff_factor(DEFAULT_BACKOFF_FACTOR), is_sender(false),
       tx_robust_factor(DEFAULT_ROBUST_FACTOR), instance_id(0),
       ndata(DEFAULT_NDATA), nparity(DEFAULT_NPARITY), auto_parity(0), extra_parity(0),
       sndr_emcon(false), tx_only(false), tx_connect(false), fti_mode(FTI_ALWAYS), encoder(NULL),
+      tx_block_encode(false), tx_block_buffer(NULL), tx_block_vectors(NULL), tx_fec_wait(false),
       next_tx_object_id(0),
       tx_cache_count_min(DEFAULT_TX_CACHE_MIN),
       tx_cache_count_max(DEFAULT_TX_CACHE_MAX),
       tx_cache_size_max(DEFAULT_TX_CACHE_SIZE),
       posted_tx_queue_empty(false), posted_tx_rate_changed(false), posted_send_error(false),
       acking_node_count(0), acking_auto_populate(TRACK_NONE), watermark_pending(false), watermark_flushes(false),
-      tx_repair_pending(false), advertise_repairs(false),
+      tx_repair_pending(false),
+      tx_parity_cache_max(DEFAULT_TX_PARITY_CACHE), advertise_repairs(false),
       suppress_nonconfirmed(false), suppress_rate(-1.0), suppress_rtt(-1.0),
       probe_proactive(true), probe_pending(false), probe_reset(true), probe_data_check(false),
       probe_tos(0), grtt_interval(0.5), grtt_interval_min(DEFAULT_GRTT_INTERVAL_MIN),
@@ -118,6 +144,12 @@ NormSession::NormSession(NormSessionMgr &sessionMgr, NormNodeId localNodeId)
 
     grtt_quantized = NormQuantizeRtt(DEFAULT_GRTT_ESTIMATE);
     grtt_measured = grtt_advertised = NormUnquantizeRtt(grtt_quantized);
+    
+    grtt_gauge.SetValue(grtt_advertised);
+    clr_id_stat.SetValue(NORM_NODE_NONE);
+    tx_repair_nack_time.tv_sec = tx_repair_nack_time.tv_usec = 0;
+    tx_repair_timing = tx_repair_sending = false;
+    rx_last_time.tv_sec = rx_last_time.tv_usec = 0;
 
     gsize_measured = DEFAULT_GSIZE_ESTIMATE;
     gsize_quantized = NormQuantizeGroupSize(DEFAULT_GSIZE_ESTIMATE);
@@ -137,6 +169,12 @@ NormSession::NormSession(NormSessionMgr &sessionMgr, NormNodeId localNodeId)
 
 NormSession::~NormSession()
 {
+    fec_pool.Close();
+    file_io_pool.Close();
+    trace_ring.Close();
+#ifdef NORM_RECVMMSG
+    FreeRxBatch();
+#endif // NORM_RECVMMSG
     if (user_timer.IsActive())
         user_timer.Deactivate();
     if (NULL != preset_sender)
@@ -244,6 +282,8 @@ bool NormSession::Open()
                 return false;
             }
         }
+        if ((0 != rx_busy_poll) && !ApplyRxBusyPoll())
+            PLOG(PL_WARN, "NormSession::Open() warning: unable to set rx_socket busy-poll\n");
     }
     if (ecn_enabled)
     {
@@ -323,21 +363,14 @@ bool NormSession::Open()
         }
     }
 #endif // ECN_SUPPORT
-    if (message_pool.IsEmpty())
+    if (!message_pool.IsInitialized())
     {
-        for (unsigned int i = 0; i < DEFAULT_MESSAGE_POOL_DEPTH; i++)
+        // (StartSender() sizes the pool for its "segment_size" when it opens the session)
+        if (!message_pool.Init(DEFAULT_MESSAGE_POOL_DEPTH, DEFAULT_MESSAGE_PAYLOAD_MAX + NormMsg::HEADER_MAX))
         {
-            NormMsg *msg = new NormMsg();
-            if (msg)
-            {
-                message_pool.Append(msg);
-            }
-            else
-            {
-                PLOG(PL_FATAL, "NormSession::Open() new message error: %s\n", GetErrorString());
-                Close();
-                return false;
-            }
+            PLOG(PL_FATAL, "NormSession::Open() message pool init error\n");
+            Close();
+            return false;
         }
     }
     if (!report_timer.IsActive())
@@ -356,7 +389,9 @@ void NormSession::Close()
         StopReceiver();
     if (tx_timer.IsActive())
         tx_timer.Deactivate();
-    message_queue.Destroy();
+    NormMsg* msg;
+    while (NULL != (msg = message_queue.RemoveHead()))
+        message_pool.Put(msg);
     message_pool.Destroy();
     if (tx_socket->IsOpen())
         tx_socket->Close();
@@ -706,8 +741,29 @@ void NormSession::SetTxRateInternal(double txRate)
                 ActivateTimer(probe_timer);
         }
     }
+    UpdateStatsGauges();
 } // end NormSession::SetTxRateInternal()
 
+// Publishes the current rate, GRTT and congestion control state for NormGetSessionStats()
+void NormSession::UpdateStatsGauges()
+{
+    tx_rate_gauge.SetValue(tx_rate);
+    grtt_gauge.SetValue(grtt_advertised);
+    const NormCCNode* clr = (const NormCCNode*)cc_node_list.Head();
+    if (NULL != clr)
+    {
+        clr_id_stat.SetValue(clr->GetId());
+        clr_rate_gauge.SetValue(clr->GetRate());
+        clr_rtt_gauge.SetValue(clr->GetRtt());
+        clr_loss_gauge.SetValue(clr->GetLoss());
+    }
+    else
+    {
+        clr_id_stat.SetValue(NORM_NODE_NONE);
+    }
+    slow_start_stat.SetValue(cc_slow_start ? 1 : 0);
+}  // end NormSession::UpdateStatsGauges()
+
 void NormSession::SetTxRateBounds(double rateMin, double rateMax)
 {
     posted_tx_rate_changed = false;
@@ -777,6 +833,15 @@ bool NormSession::StartSender(UINT16 instanceId,
             return false;
         }
     }
+    // Size pooled messages for our segment size (plus header maximum)
+    if (message_pool.GetMessageSize() < ((unsigned int)segmentSize + NormMsg::HEADER_MAX))
+    {
+        if (!message_pool.Init(DEFAULT_MESSAGE_POOL_DEPTH, segmentSize + NormMsg::HEADER_MAX))
+        {
+            PLOG(PL_FATAL, "NormSession::StartSender() message pool init error\n");
+            return false;
+        }
+    }
     if (!IsOpen())
     {
         if (!Open())
@@ -823,6 +888,16 @@ bool NormSession::StartSender(UINT16 instanceId,
         StopSender();
         return false;
     }
+    
+    // Blocks with repair pending are buffered, so this bounds the number
+    // of distinct blocks NACKed in a repair cycle (within reason)
+    unsigned int nackEntryMax = (numBlocks < 4096) ? (unsigned int)numBlocks : 4096;
+    if (!tx_nack_aggregator.Init(nackEntryMax))
+    {
+        PLOG(PL_FATAL, "NormSession::StartSender() tx_nack_aggregator init error\n");
+        StopSender();
+        return false;
+    }
 
     if (!segment_pool.Init((unsigned int)numSegments, segmentSize + NormDataMsg::GetStreamPayloadHeaderLength()))
     {
@@ -830,7 +905,7 @@ bool NormSession::StartSender(UINT16 instanceId,
         StopSender();
         return false;
     }
-
+    
     if (numParity)
     {
         if (NULL != encoder)
@@ -917,6 +992,21 @@ bool NormSession::StartSender(UINT16 instanceId,
     nparity = numParity;
     is_sender = true;
 
+    if (tx_block_encode && !SenderSetBlockEncode(true))
+    {
+        PLOG(PL_FATAL, "NormSession::StartSender() error: unable to enable block encoding\n");
+        StopSender();
+        return false;
+    }
+
+    // (after "is_sender", "segment_size" and "nparity" are set)
+    if (!SenderSetParityCache(tx_parity_cache_max))
+    {
+        PLOG(PL_FATAL, "NormSession::StartSender() tx_parity_cache init error\n");
+        StopSender();
+        return false;
+    }
+
     flush_count = (GetTxRobustFactor() < 0) ? 0 : (GetTxRobustFactor() + 1);
 
     if (cc_enable && cc_adjust)
@@ -957,6 +1047,128 @@ bool NormSession::StartSender(UINT16 instanceId,
     return true;
 } // end NormSession::StartSender()
 
+bool NormSession::SenderSetBlockEncode(bool state)
+{
+    tx_block_encode = state;
+    // The block vector space is allocated as needed for an active sender
+    if (state && is_sender && (0 != nparity) && (NULL == tx_block_buffer))
+    {
+        UINT16 payloadMax = segment_size + NormDataMsg::GetStreamPayloadHeaderLength();
+        if (NULL == (tx_block_buffer = new char[ndata * payloadMax]))
+        {
+            PLOG(PL_ERROR, "NormSession::SenderSetBlockEncode() new tx_block_buffer error: %s\n", GetErrorString());
+            tx_block_encode = false;
+            return false;
+        }
+        if (NULL == (tx_block_vectors = new char*[ndata]))
+        {
+            PLOG(PL_ERROR, "NormSession::SenderSetBlockEncode() new tx_block_vectors error: %s\n", GetErrorString());
+            delete[] tx_block_buffer;
+            tx_block_buffer = NULL;
+            tx_block_encode = false;
+            return false;
+        }
+        for (UINT16 i = 0; i < ndata; i++)
+            tx_block_vectors[i] = tx_block_buffer + i*payloadMax;
+    }
+    return true;
+}  // end NormSession::SenderSetBlockEncode()
+
+bool NormSession::SenderSetParityCache(unsigned int blockCount)
+{
+    tx_parity_cache_max = blockCount;
+    if (!is_sender) return true;  // cache is allocated by StartSender()
+    UINT16 payloadMax = segment_size + NormDataMsg::GetStreamPayloadHeaderLength();
+#ifdef SIMULATE
+    payloadMax = MIN(payloadMax, SIM_PAYLOAD_MAX);
+#endif // SIMULATE
+    return tx_parity_cache.Init(blockCount, nparity, payloadMax);
+}  // end NormSession::SenderSetParityCache()
+
+bool NormSession::SetFecThreads(unsigned int threadCount)
+{
+    if (threadCount == fec_pool.GetThreadCount()) return true;
+    // Let any in-progress jobs complete and apply their results first
+    fec_pool.Close();
+    HandleFecJobs();
+    if (0 == threadCount) return true;
+    if (!fec_pool.SetListener(this, &NormSession::OnFecEvent) ||
+        !fec_pool.Open(threadCount, session_mgr.GetChannelNotifier()))
+    {
+        PLOG(PL_ERROR, "NormSession::SetFecThreads() error: unable to open FEC worker pool\n");
+        return false;
+    }
+    return true;
+}  // end NormSession::SetFecThreads()
+
+void NormSession::OnFecEvent(ProtoEvent& /*theEvent*/)
+{
+    HandleFecJobs();
+}  // end NormSession::OnFecEvent()
+
+// Applies completed FEC worker results.  The job's object (and sender node) are
+// looked up anew since they may have been deleted while the job was in progress.
+void NormSession::HandleFecJobs()
+{
+    bool parityDone = false;
+    NormFecJob* job;
+    while (NULL != (job = fec_pool.GetCompletedJob()))
+    {
+        if (NormFecJob::ENCODE == job->GetType())
+        {
+            parityDone = true;
+            NormObject* obj = IsSender() ? tx_table.Find(job->GetObjectId()) : NULL;
+            if ((NULL != obj) && ((const void*)obj == job->GetObjectPtr()))
+                obj->SenderHandleParityJob(*job);
+        }
+        else if (IsReceiver())
+        {
+            NormSenderNode* sender = (NormSenderNode*)sender_tree.FindNodeById(job->GetNodeId());
+            if ((NULL != sender) && ((const void*)sender == job->GetNodePtr()))
+                sender->HandleDecodeJob(*job);
+        }
+        fec_pool.PutFreeJob(job);
+    }
+    if (parityDone && tx_fec_wait)
+    {
+        tx_fec_wait = false;
+        TouchSender();
+    }
+}  // end NormSession::HandleFecJobs()
+
+bool NormSession::SetFileIoThreads(unsigned int threadCount, unsigned int readAhead)
+{
+    if (readAhead > NormFileObject::READ_AHEAD_MAX)
+        readAhead = NormFileObject::READ_AHEAD_MAX;
+    file_read_ahead = readAhead;
+    if (threadCount == file_io_pool.GetThreadCount()) return true;
+    // Let any in-progress jobs complete and apply their results first
+    file_io_pool.Close();
+    HandleFileIoJobs();
+    if (0 == threadCount) return true;
+    if (!file_io_pool.SetListener(this, &NormSession::OnFileIoEvent) ||
+        !file_io_pool.Open(threadCount, session_mgr.GetChannelNotifier()))
+    {
+        PLOG(PL_ERROR, "NormSession::SetFileIoThreads() error: unable to open file I/O worker pool\n");
+        return false;
+    }
+    return true;
+}  // end NormSession::SetFileIoThreads()
+
+void NormSession::OnFileIoEvent(ProtoEvent& /*theEvent*/)
+{
+    HandleFileIoJobs();
+}  // end NormSession::OnFileIoEvent()
+
+// Unlike FEC jobs, file I/O jobs are always flushed by their NormFileObject 
+// before it is closed, so the job "owner" is still valid here.
+void NormSession::HandleFileIoJobs()
+{
+    NormFileIoJob* job;
+    while (NULL != (job = file_io_pool.GetCompletedJob()))
+        static_cast<NormFileObject*>(job->GetOwner())->HandleIoJob(job);
+}  // end NormSession::HandleFileIoJobs()
+
 void NormSession::StopSender()
 {
     if (probe_timer.IsActive())
@@ -969,12 +1181,14 @@ void NormSession::StopSender()
         repair_timer.Deactivate();
         tx_repair_pending = false;
     }
+    tx_nack_aggregator.Clear();
     if (flush_timer.IsActive())
         flush_timer.Deactivate();
     if (cmd_timer.IsActive())
         cmd_timer.Deactivate();
     if (flow_control_timer.IsActive())
         flow_control_timer.Deactivate();
+    tx_fec_wait = false;  // (any in-progress parity job results are discarded)
 
     if (NULL != ack_ex_buffer)
     {
@@ -996,6 +1210,13 @@ void NormSession::StopSender()
         delete encoder;
         encoder = NULL;
     }
+    if (NULL != tx_block_buffer)
+    {
+        delete[] tx_block_buffer;
+        tx_block_buffer = NULL;
+        delete[] tx_block_vectors;
+        tx_block_vectors = NULL;
+    }
     acking_node_tree.Destroy();
     cc_node_list.Destroy();
     // Iterate tx_table and release objects
@@ -1011,6 +1232,8 @@ void NormSession::StopSender()
     tx_table.Destroy();
     block_pool.Destroy();
     segment_pool.Destroy();
+    tx_nack_aggregator.Destroy();
+    tx_parity_cache.Destroy();
     tx_repair_mask.Destroy();
     tx_pending_mask.Destroy();
     is_sender = false;
@@ -1353,6 +1576,8 @@ void NormSession::Serve()
             else
             {
                 ReturnMessageToPool(msg);
+                // Transmission resumes when the FEC worker finishes the block parity
+                if (tx_fec_wait) return;
                 if (obj->IsStream())
                 {
                     NormStreamObject *stream = static_cast<NormStreamObject *>(obj);
@@ -1659,7 +1884,8 @@ bool NormSession::SenderQueueWatermarkFlush()
 {
     if (flush_timer.IsActive())
         return false;
-    NormCmdFlushMsg *flush = static_cast<NormCmdFlushMsg *>(GetMessageFromPool());
+    // (the optional app-defined ACK_REQ extension is in addition to the acking node list)
+    NormCmdFlushMsg *flush = static_cast<NormCmdFlushMsg *>(GetMessageFromPool(ack_ex_length + segment_size + NormMsg::HEADER_MAX));
     if (flush)
     {
         flush->Init();
@@ -1952,6 +2178,41 @@ NormDataObject *NormSession::QueueTxData(const char *dataPtr,
     }
 } // end NormSession::QueueTxData()
 
+NormDataObject *NormSession::QueueTxData(const NormDataFragment *fragList,
+                                         unsigned int fragCount,
+                                         const char *infoPtr,
+                                         UINT16 infoLen)
+{
+    if (!IsSender())
+    {
+        PLOG(PL_FATAL, "NormSession::QueueTxData() Error: sender is closed\n");
+        return NULL;
+    }
+    NormDataObject *obj = new NormDataObject(*this, (NormSenderNode *)NULL, next_tx_object_id, session_mgr.GetDataFreeFunction());
+    if (!obj)
+    {
+        PLOG(PL_FATAL, "NormSession::QueueTxData() new data object error: %s\n",
+             GetErrorString());
+        return NULL;
+    }
+    if (!obj->Open(fragList, fragCount, infoPtr, infoLen))
+    {
+        PLOG(PL_FATAL, "NormSession::QueueTxData() fragmented object open error\n");
+        obj->Release();
+        return NULL;
+    }
+    if (QueueTxObject(obj))
+    {
+        return obj;
+    }
+    else
+    {
+        obj->Close();
+        obj->Release();
+        return NULL;
+    }
+} // end NormSession::QueueTxData(fragments)
+
 NormStreamObject *NormSession::QueueTxStream(UINT32 bufferSize,
                                              bool doubleBuffer,
                                              const char *infoPtr,
@@ -2136,6 +2397,7 @@ void NormSession::DeleteTxObject(NormObject *obj, bool notify)
         NormObjectId objectId = obj->GetId();
         tx_pending_mask.Unset(objectId);
         tx_repair_mask.Unset(objectId);
+        tx_parity_cache.Invalidate(objectId);
         obj->Close();
         obj->Release();
     }
@@ -2213,6 +2475,7 @@ NormBlock *NormSession::SenderGetFreeBlock(NormObjectId objectId,
                 b = obj->StealNonPendingBlock(false);
             if (b)
             {
+                SenderSaveParity(*obj, *b);
                 b->EmptyToPool(segment_pool);
                 break;
             }
@@ -2238,6 +2501,7 @@ NormBlock *NormSession::SenderGetFreeBlock(NormObjectId objectId,
                     b = obj->StealNewestBlock(true, blockId);
                 if (b)
                 {
+                    SenderSaveParity(*obj, *b);
                     b->EmptyToPool(segment_pool);
                     break;
                 }
@@ -2247,6 +2511,17 @@ NormBlock *NormSession::SenderGetFreeBlock(NormObjectId objectId,
     return b;
 } // end NormSession::SenderGetFreeBlock()
 
+// Keeps the parity of a repaired block whose buffers are being reclaimed
+void NormSession::SenderSaveParity(NormObject& obj, NormBlock& block)
+{
+    if (tx_parity_cache.IsOpen() && block.InRepair())
+    {
+        UINT16 numData = obj.GetBlockSize(block.GetId());
+        if (block.ParityReady(numData) && !block.FlagIsSet(NormBlock::PARITY_PENDING))
+            tx_parity_cache.Save(obj.GetId(), block, numData);
+    }
+}  // end NormSession::SenderSaveParity()
+
 char *NormSession::SenderGetFreeSegment(NormObjectId objectId,
                                         NormBlockId blockId)
 {
@@ -2266,7 +2541,14 @@ void NormSession::TxSocketRecvHandler(ProtoSocket &theSocket,
 {
     if (ProtoSocket::RECV == theEvent)
     {
-        NormMsg msg;
+#ifdef NORM_RECVMMSG
+        if (rx_batch_size > 1)
+        {
+            RecvBatch(theSocket, true);
+            return;
+        }
+#endif // NORM_RECVMMSG
+        NormLocalMsg<NormMsg> msg;
         unsigned int msgLength = NormMsg::MAX_SIZE;
         while (true)
         {
@@ -2330,9 +2612,18 @@ void NormSession::RxSocketRecvHandler(ProtoSocket &theSocket,
 {
     if (ProtoSocket::RECV == theEvent)
     {
+#if defined(NORM_RECVMMSG) && !defined(RX_MEASURE_ONLY)
+        if (rx_batch_size > 1)
+        {
+            RecvBatch(theSocket, false);
+            return;
+        }
+#endif // NORM_RECVMMSG && !RX_MEASURE_ONLY
         unsigned int recvCount = 0;
-        NormMsg msg;
+        NormLocalMsg<NormMsg> msg;
         unsigned int msgLength = NormMsg::MAX_SIZE;
+        ProtoTime spinEnd;
+        bool spinning = false;
         while (true)
         {
             ProtoAddress destAddr; // we get the pkt destAddr to determine unicast/multicast
@@ -2342,7 +2633,12 @@ void NormSession::RxSocketRecvHandler(ProtoSocket &theSocket,
                                    destAddr))
             {
                 if (0 == msgLength)
-                    break;
+                {
+                    // Socket is drained, but we may "busy-poll" for more
+                    if (!RxBusyPollContinue(spinEnd, spinning)) break;
+                    msgLength = NormMsg::MAX_SIZE;
+                    continue;
+                }
                 if (msg.InitFromBuffer(msgLength))
                 {
 #ifdef RX_MEASURE_ONLY
@@ -2439,6 +2735,192 @@ void NormSession::RxSocketRecvHandler(ProtoSocket &theSocket,
     } // end if/else (theEvent == RECV/SEND)
 } // end NormSession::RxSocketRecvHandler()
 
+bool NormSession::SetRxBatchSize(unsigned int batchSize)
+{
+    if (batchSize > RX_BATCH_MAX) batchSize = RX_BATCH_MAX;
+    if (batchSize < 2) batchSize = 0;  // batching disabled
+    if (batchSize == rx_batch_size) return true;
+#ifdef NORM_RECVMMSG
+    FreeRxBatch();
+    if (0 == batchSize) return true;
+    const unsigned int ctrlSize = CMSG_SPACE(sizeof(struct in6_pktinfo));
+    if ((NULL == (rx_batch_msgs = new NormLocalMsg<NormMsg>[batchSize])) ||
+        (NULL == (rx_batch_hdrs = new struct mmsghdr[batchSize])) ||
+        (NULL == (rx_batch_iovs = new struct iovec[batchSize])) ||
+        (NULL == (rx_batch_addrs = new struct sockaddr_storage[batchSize])) ||
+        (NULL == (rx_batch_ctrl = new char[batchSize * ctrlSize])))
+    {
+        PLOG(PL_FATAL, "NormSession::SetRxBatchSize() new error: %s\n", GetErrorString());
+        FreeRxBatch();
+        return false;
+    }
+    memset(rx_batch_hdrs, 0, batchSize * sizeof(struct mmsghdr));
+    for (unsigned int i = 0; i < batchSize; i++)
+    {
+        rx_batch_iovs[i].iov_base = rx_batch_msgs[i].AccessBuffer();
+        rx_batch_hdrs[i].msg_hdr.msg_iov = rx_batch_iovs + i;
+        rx_batch_hdrs[i].msg_hdr.msg_iovlen = 1;
+        rx_batch_hdrs[i].msg_hdr.msg_name = rx_batch_addrs + i;
+        rx_batch_hdrs[i].msg_hdr.msg_control = rx_batch_ctrl + i*ctrlSize;
+    }
+    rx_batch_size = batchSize;
+    return true;
+#else
+    PLOG(PL_ERROR, "NormSession::SetRxBatchSize() error: batched receive not supported on this platform\n");
+    return false;
+#endif // if/else NORM_RECVMMSG
+}  // end NormSession::SetRxBatchSize()
+
+#ifdef NORM_RECVMMSG
+void NormSession::FreeRxBatch()
+{
+    if (NULL != rx_batch_msgs)
+    {
+        delete[] rx_batch_msgs;
+        rx_batch_msgs = NULL;
+    }
+    if (NULL != rx_batch_hdrs)
+    {
+        delete[] rx_batch_hdrs;
+        rx_batch_hdrs = NULL;
+    }
+    if (NULL != rx_batch_iovs)
+    {
+        delete[] rx_batch_iovs;
+        rx_batch_iovs = NULL;
+    }
+    if (NULL != rx_batch_addrs)
+    {
+        delete[] rx_batch_addrs;
+        rx_batch_addrs = NULL;
+    }
+    if (NULL != rx_batch_ctrl)
+    {
+        delete[] rx_batch_ctrl;
+        rx_batch_ctrl = NULL;
+    }
+    rx_batch_size = 0;
+}  // end NormSession::FreeRxBatch()
+
+// Reads datagrams in batches of up to "rx_batch_size" per recvmmsg() call.  Note
+// the "destAddr" for the rx_socket is recovered from the IP_PKTINFO control message
+// (rx_socket.EnableRecvDstAddr() is set) to determine unicast/multicast reception.
+void NormSession::RecvBatch(ProtoSocket& theSocket, bool isTxSocket)
+{
+    const unsigned int ctrlSize = CMSG_SPACE(sizeof(struct in6_pktinfo));
+    unsigned int recvCount = 0;
+    ProtoTime spinEnd;
+    bool spinning = false;  // (only the rx_socket is "busy-polled")
+    // Same limit as RxSocketRecvHandler() so timeouts get serviced when busy
+    while (recvCount < 100)
+    {
+        for (unsigned int i = 0; i < rx_batch_size; i++)
+        {
+            rx_batch_iovs[i].iov_len = NormMsg::MAX_SIZE;
+            rx_batch_hdrs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+            rx_batch_hdrs[i].msg_hdr.msg_controllen = ctrlSize;
+            rx_batch_hdrs[i].msg_hdr.msg_flags = 0;
+        }
+        int result = recvmmsg(theSocket.GetHandle(), rx_batch_hdrs, rx_batch_size, MSG_DONTWAIT, NULL);
+        if (result <= 0)
+        {
+            if ((result < 0) && (EAGAIN != errno) && (EWOULDBLOCK != errno) && (EINTR != errno))
+            {
+                // Probably an ICMP "port unreachable" error (see RxSocketRecvHandler())
+                PLOG(PL_DEBUG, "NormSession::RecvBatch() recvmmsg() error: %s\n", GetErrorString());
+                if (Address().IsUnicast())
+                    Notify(NormController::SEND_ERROR, NULL, NULL);
+                break;
+            }
+            // Socket is drained, but we may "busy-poll" for more
+            if (isTxSocket || !RxBusyPollContinue(spinEnd, spinning)) break;
+            continue;
+        }
+        unsigned int count = (unsigned int)result;
+        for (unsigned int i = 0; i < count; i++)
+        {
+            struct msghdr& hdr = rx_batch_hdrs[i].msg_hdr;
+            unsigned int msgLength = rx_batch_hdrs[i].msg_len;
+            if (0 != (hdr.msg_flags & MSG_TRUNC))
+            {
+                PLOG(PL_ERROR, "NormSession::RecvBatch() warning: received truncated message\n");
+                continue;
+            }
+            NormMsg& msg = rx_batch_msgs[i];
+            msg.AccessAddress().SetSockAddr(*((struct sockaddr*)(rx_batch_addrs + i)));
+            // Messages arriving on the tx_socket are known to be unicast
+            bool wasUnicast = isTxSocket;
+            if (!isTxSocket)
+            {
+                ProtoAddress destAddr;
+                for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); NULL != cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg))
+                {
+                    if ((IPPROTO_IP == cmsg->cmsg_level) && (IP_PKTINFO == cmsg->cmsg_type))
+                    {
+                        struct in_pktinfo* pktInfo = (struct in_pktinfo*)CMSG_DATA(cmsg);
+                        destAddr.SetRawHostAddress(ProtoAddress::IPv4, (char*)&pktInfo->ipi_addr, 4);
+                        break;
+                    }
+                    else if ((IPPROTO_IPV6 == cmsg->cmsg_level) && (IPV6_PKTINFO == cmsg->cmsg_type))
+                    {
+                        struct in6_pktinfo* pktInfo = (struct in6_pktinfo*)CMSG_DATA(cmsg);
+                        destAddr.SetRawHostAddress(ProtoAddress::IPv6, (char*)&pktInfo->ipi6_addr, 16);
+                        break;
+                    }
+                }
+                wasUnicast = destAddr.IsValid() ? destAddr.IsUnicast() : false;
+            }
+            if (msg.InitFromBuffer(msgLength))
+                HandleReceiveMessage(msg, wasUnicast);
+            else
+                PLOG(PL_ERROR, "NormSession::RecvBatch() warning: received bad message\n");
+        }
+        recvCount += count;
+        // (if the socket has been drained, we may "busy-poll" for more)
+        if ((count < rx_batch_size) && 
+            (isTxSocket || !RxBusyPollContinue(spinEnd, spinning))) break;
+    }
+}  // end NormSession::RecvBatch()
+#endif // NORM_RECVMMSG
+
+bool NormSession::SetRxBusyPoll(unsigned int usec)
+{
+    rx_busy_poll = usec;
+    if (rx_socket.IsOpen()) return ApplyRxBusyPoll();
+    return true;
+}  // end NormSession::SetRxBusyPoll()
+
+// Sets the SO_BUSY_POLL socket option where supported so the kernel polls the
+// device queue for the rx_socket (note increasing this may require privilege)
+bool NormSession::ApplyRxBusyPoll()
+{
+#if defined(SO_BUSY_POLL) && !defined(SIMULATE)
+    int usec = (int)rx_busy_poll;
+    if (0 != setsockopt(rx_socket.GetHandle(), SOL_SOCKET, SO_BUSY_POLL, (char*)&usec, sizeof(usec)))
+    {
+        PLOG(PL_WARN, "NormSession::ApplyRxBusyPoll() setsockopt(SO_BUSY_POLL) error: %s\n", GetErrorString());
+        return false;
+    }
+#endif // SO_BUSY_POLL && !SIMULATE
+    return true;
+}  // end NormSession::ApplyRxBusyPoll()
+
+// Returns true while the receive handler should keep polling a drained rx_socket
+bool NormSession::RxBusyPollContinue(ProtoTime& spinEnd, bool& spinning)
+{
+    if (0 == rx_busy_poll) return false;
+    if (!spinning)
+    {
+        spinEnd.GetCurrentTime();
+        spinEnd += 1.0e-06 * (double)rx_busy_poll;
+        spinning = true;
+        return true;
+    }
+    ProtoTime currentTime;
+    currentTime.GetCurrentTime();
+    return (currentTime < spinEnd);
+}  // end NormSession::RxBusyPollContinue()
+
 #ifdef ECN_SUPPORT
 #ifndef SIMULATE
 void NormSession::OnPktCapture(ProtoChannel &theChannel,
@@ -2557,7 +3039,7 @@ void NormSession::OnPktCapture(ProtoChannel &theChannel,
         }
 
         // TBD - we can avoid this copy
-        NormMsg msg;
+        NormLocalMsg<NormMsg> msg;
         if (msg.CopyFromBuffer((const char *)udpPkt.GetPayload(), udpPkt.GetPayloadLength()))
         {
 
@@ -2792,7 +3274,14 @@ void NormSession::HandleReceiveMessage(NormMsg &msg, bool wasUnicast, bool ecnSt
     struct timeval currentTime;
     ::ProtoSystemTime(currentTime);
 
-    if (trace)
+    // (for NormGetSessionStats())
+    rx_packet_count.Increment();
+    rx_byte_count.Increment(msg.GetLength());
+    if (rx_last_time.tv_sec || rx_last_time.tv_usec)
+        rx_interval_hist.RecordInterval(rx_last_time, currentTime);
+    rx_last_time = currentTime;
+
+    if (trace || trace_ring.IsOpen())
     {
         // Initially assume it's a message we generated (or similarly configured sender)
         UINT8 fecM = fec_m;
@@ -2829,8 +3318,11 @@ void NormSession::HandleReceiveMessage(NormMsg &msg, bool wasUnicast, bool ecnSt
                 instId = 0;
             }
         }
-        NormTrace(currentTime, LocalNodeId(), msg, false, fecM, instId); // TBD don't assume m == 16 (i.e. for fec_id == 2)
-    }                                                                    // end if (trace)
+        if (trace_ring.IsOpen())
+            trace_ring.Record(currentTime, msg, false, fecM, instId);
+        else
+            NormTrace(currentTime, LocalNodeId(), msg, false, fecM, instId); // TBD don't assume m == 16 (i.e. for fec_id == 2)
+    }                                                                        // end if (trace || trace_ring.IsOpen())
 
     NormMsg::Type msgType = msg.GetType();
 
@@ -3148,7 +3640,7 @@ bool NormSession::InsertRemoteSender(NormSenderNode &sender)
     // (supports NormSocket server operations)
     if (!IsReceiver())
         return false;
-    NormCmdCCMsg cmd;
+    NormLocalMsg<NormCmdCCMsg> cmd;
     cmd.Init();
     cmd.SetSequence(sender.GetCurrentSequence());
     cmd.SetSourceId(sender.GetId());
@@ -3237,6 +3729,7 @@ void NormSession::SenderUpdateGrttEstimate(double receiverRtt)
         grtt_current_peak = grtt_measured;
         if (grttQuantizedOld != grtt_quantized)
         {
+            grtt_gauge.SetValue(grtt_advertised);
             if (notify_on_grtt_update)
             {
                 notify_on_grtt_update = false;
@@ -3632,8 +4125,182 @@ void NormSession::SenderHandleAckMessage(const struct timeval &currentTime, cons
     }
 } // end SenderHandleAckMessage()
 
+NormNackAggregator::NormNackAggregator()
+ : entry_table(NULL), entry_used(NULL), table_mask(0),
+   used_list(NULL), used_count(0), used_max(0)
+{
+}
+
+NormNackAggregator::~NormNackAggregator()
+{
+    Destroy();
+}
+
+bool NormNackAggregator::Init(unsigned int entryMax)
+{
+    Destroy();
+    if (0 == entryMax) return false;
+    // Keep the open-addressed table at most half full
+    unsigned int tableSize = 1;
+    while (tableSize < (2 * entryMax)) tableSize <<= 1;
+    if ((NULL == (entry_table = new Entry[tableSize])) ||
+        (NULL == (entry_used = new bool[tableSize])) ||
+        (NULL == (used_list = new unsigned int[entryMax])))
+    {
+        PLOG(PL_FATAL, "NormNackAggregator::Init() new error: %s\n", GetErrorString());
+        Destroy();
+        return false;
+    }
+    memset(entry_used, 0, tableSize * sizeof(bool));
+    table_mask = tableSize - 1;
+    used_count = 0;
+    used_max = entryMax;
+    return true;
+}  // end NormNackAggregator::Init()
+
+void NormNackAggregator::Destroy()
+{
+    if (NULL != used_list)
+    {
+        delete[] used_list;
+        used_list = NULL;
+    }
+    if (NULL != entry_used)
+    {
+        delete[] entry_used;
+        entry_used = NULL;
+    }
+    if (NULL != entry_table)
+    {
+        delete[] entry_table;
+        entry_table = NULL;
+    }
+    table_mask = 0;
+    used_count = used_max = 0;
+}  // end NormNackAggregator::Destroy()
+
+void NormNackAggregator::Clear()
+{
+    for (unsigned int i = 0; i < used_count; i++)
+        entry_used[used_list[i]] = false;
+    used_count = 0;
+}  // end NormNackAggregator::Clear()
+
+NormNackAggregator::Entry* NormNackAggregator::Find(NormObjectId       objectId,
+                                                    const NormBlockId& blockId,
+                                                    unsigned int&      index) const
+{
+    index = table_mask + 1;
+    if (NULL == entry_table) return NULL;
+    UINT32 hash = ((UINT32)((UINT16)objectId) * 0x9e3779b1) ^ (blockId.GetValue() * 0x85ebca6b);
+    hash ^= (hash >> 16);
+    unsigned int i = hash & table_mask;
+    for (unsigned int n = 0; n <= table_mask; n++)
+    {
+        if (!entry_used[i])
+        {
+            index = i;
+            return NULL;
+        }
+        Entry* entry = entry_table + i;
+        if ((entry->block_id == blockId.GetValue()) && (entry->object_id == (UINT16)objectId))
+        {
+            index = i;
+            return entry;
+        }
+        i = (i + 1) & table_mask;
+    }
+    return NULL;
+}  // end NormNackAggregator::Find()
+
+bool NormNackAggregator::IsCovered(NormObjectId         objectId,
+                                   const NormBlockId&   blockId,
+                                   NormSegmentId        firstId,
+                                   NormSegmentId        lastId,
+                                   UINT16               erasureCount) const
+{
+    unsigned int index;
+    const Entry* entry = Find(objectId, blockId, index);
+    if ((NULL == entry) || (erasureCount > entry->erasure_max)) return false;
+    // Recorded intervals are disjoint and non-adjacent, so one must contain the request
+    for (unsigned int i = 0; i < entry->interval_count; i++)
+    {
+        if (firstId < entry->interval_first[i]) break;
+        if (lastId <= entry->interval_last[i]) return true;
+    }
+    return false;
+}  // end NormNackAggregator::IsCovered()
+
+void NormNackAggregator::Insert(NormObjectId        objectId,
+                                const NormBlockId&  blockId,
+                                NormSegmentId       firstId,
+                                NormSegmentId       lastId,
+                                UINT16              erasureCount)
+{
+    unsigned int index;
+    Entry* entry = Find(objectId, blockId, index);
+    if (NULL == entry)
+    {
+        // (if the table is full, later duplicates just won't be coalesced)
+        if ((index > table_mask) || (used_count >= used_max)) return;
+        entry = entry_table + index;
+        entry->block_id = blockId.GetValue();
+        entry->object_id = (UINT16)objectId;
+        entry->erasure_max = 0;
+        entry->interval_count = 0;
+        entry_used[index] = true;
+        used_list[used_count++] = index;
+    }
+    if (erasureCount > entry->erasure_max) entry->erasure_max = erasureCount;
+    // Find intervals [i, j) that overlap or adjoin [firstId, lastId]
+    unsigned int count = entry->interval_count;
+    unsigned int i = 0;
+    while ((i < count) && (((UINT32)entry->interval_last[i] + 1) < firstId)) i++;
+    unsigned int j = i;
+    while ((j < count) && (entry->interval_first[j] <= ((UINT32)lastId + 1))) j++;
+    if (j > i)
+    {
+        // Merge them into a single interval at "i"
+        if (entry->interval_first[i] < firstId) firstId = entry->interval_first[i];
+        if (entry->interval_last[j-1] > lastId) lastId = entry->interval_last[j-1];
+        unsigned int removed = j - i - 1;
+        for (unsigned int k = j; k < count; k++)
+        {
+            entry->interval_first[k - removed] = entry->interval_first[k];
+            entry->interval_last[k - removed] = entry->interval_last[k];
+        }
+        count -= removed;
+    }
+    else
+    {
+        // Insert a new interval at "i" (if there is room; not recording is safe)
+        if (count >= INTERVAL_MAX) return;
+        for (unsigned int k = count; k > i; k--)
+        {
+            entry->interval_first[k] = entry->interval_first[k-1];
+            entry->interval_last[k] = entry->interval_last[k-1];
+        }
+        count++;
+    }
+    entry->interval_first[i] = firstId;
+    entry->interval_last[i] = lastId;
+    entry->interval_count = count;
+}  // end NormNackAggregator::Insert()
+
+void NormNackAggregator::Invalidate(NormObjectId objectId, const NormBlockId& blockId)
+{
+    unsigned int index;
+    Entry* entry = Find(objectId, blockId, index);
+    if (NULL != entry)
+    {
+        entry->erasure_max = 0;
+        entry->interval_count = 0;
+    }
+}  // end NormNackAggregator::Invalidate()
+
 void NormSession::SenderHandleNackMessage(const struct timeval &currentTime, NormNackMsg &nack)
 {
+    tx_nack_count.Increment();
     struct timeval grttResponse;
     nack.GetGrttResponse(grttResponse);
     double receiverRtt = CalculateRtt(currentTime, grttResponse);
@@ -4024,6 +4691,7 @@ void NormSession::SenderHandleNackMessage(const struct timeval &currentTime, Nor
                             else
                             {
                                 // Try to recover block including parity calculation
+                                tx_nack_aggregator.Invalidate(nextObjectId, nextBlockId);
                                 if (NULL == (block = object->SenderRecoverBlock(nextBlockId)))
                                 {
                                     if (NormObject::STREAM == object->GetType())
@@ -4054,6 +4722,23 @@ void NormSession::SenderHandleNackMessage(const struct timeval &currentTime, Nor
                         prevBlockId = nextBlockId;
                     } // end if (freshBlock)
                     ASSERT(NULL != block);
+                    block->SetLastNackTime(ProtoTime(currentTime));  // (for parity cache eviction)
+                    
+                    // Coalesce requests that other NACKs already merged this repair cycle
+                    tx_nack_items.Increment();
+                    if (!holdoff)
+                    {
+                        UINT16 itemErasures = numErasures + (lastSegmentId - nextSegmentId + 1);
+                        if (tx_nack_aggregator.IsCovered(nextObjectId, nextBlockId, nextSegmentId, 
+                                                         lastSegmentId, itemErasures))
+                        {
+                            numErasures = itemErasures;
+                            if (object->IsStream())
+                                static_cast<NormStreamObject *>(object)->SetLastNackTime(nextBlockId, ProtoTime(currentTime));
+                            tx_nack_items_coalesced.Increment();
+                            break;
+                        }
+                    }
 
                     // If stream && explicit data repair, lock the data for retransmission
                     // (TBD) this use of "ndata" needs to be replaced for dynamically shortened blocks
@@ -4204,6 +4889,8 @@ void NormSession::SenderHandleNackMessage(const struct timeval &currentTime, Nor
                         block->HandleSegmentRequest(nextSegmentId, lastSegmentId,
                                                     nextBlockSize, nparity,
                                                     numErasures);
+                        tx_nack_aggregator.Insert(nextObjectId, nextBlockId, nextSegmentId, 
+                                                  lastSegmentId, numErasures);
                         startTimer = true;
                     } // end if/else (holdoff)
                     break;
@@ -4238,6 +4925,13 @@ void NormSession::SenderHandleNackMessage(const struct timeval &currentTime, Nor
                        "NACK aggregation timer (%lf sec)...\n",
              (unsigned long)LocalNodeId(), aggregateInterval);
         ActivateTimer(repair_timer);
+        // Time this repair cycle for NormGetSessionStats() unless an earlier cycle's
+        // repairs are still waiting to be sent
+        if (!tx_repair_sending)
+        {
+            tx_repair_nack_time = currentTime;
+            tx_repair_timing = true;
+        }
     }
 } // end NormSession::SenderHandleNackMessage()
 
@@ -4422,7 +5116,7 @@ void NormSession::SenderCancelCmd()
 bool NormSession::SenderSendAppCmd(const char *buffer, unsigned int length, const ProtoAddress &dst)
 {
     // Build/immediately send a NORM_CMD(APPLICATION) message
-    NormCmdAppMsg appMsg;
+    NormLocalMsg<NormCmdAppMsg> appMsg;
     appMsg.Init();
     appMsg.SetDestination(address);
     appMsg.SetGrtt(grtt_quantized);
@@ -4676,8 +5370,14 @@ bool NormSession::OnRepairTimeout(ProtoTimer & /*theTimer*/)
     if (0 != repair_timer.GetRepeatCount())
     {
         // NACK aggregation period has ended. (incorporate accumulated repair requests)
-        PLOG(PL_DEBUG, "NormSession::OnRepairTimeout() node>%lu sender NACK aggregation time ended.\n",
-             (unsigned long)LocalNodeId());
+        PLOG(PL_DEBUG, "NormSession::OnRepairTimeout() node>%lu sender NACK aggregation time ended (%u blocks NACKed).\n",
+             (unsigned long)LocalNodeId(), tx_nack_aggregator.GetEntryCount());
+        tx_nack_aggregator.Clear();
+        if (tx_repair_timing)
+        {
+            tx_repair_timing = false;
+            tx_repair_sending = true;  // (see CompleteTxMessage())
+        }
         NormObjectTable::Iterator iterator(tx_table);
         NormObject *obj;
         while ((obj = iterator.GetNextObject()))
@@ -4735,11 +5435,43 @@ bool NormSession::OnRepairTimeout(ProtoTimer & /*theTimer*/)
 // (TBD) Should pass current system time to ProtoTimer timeout handlers
 //       for more efficiency ...
 bool NormSession::OnTxTimeout(ProtoTimer & /*theTimer*/)
+{
+    if ((TX_PACE_TIMER == tx_pace_mode) || (tx_rate <= 0.0))
+        return ServiceTxQueue();
+    // Token bucket pacing: messages are sent in small bursts while bucket
+    // tokens are available.  Since the bucket is credited for the actual time
+    // elapsed, timer latency does not reduce the achieved transmit rate.
+    for (unsigned int i = 0; i < TX_BURST_MAX; i++)
+    {
+        if (!ServiceTxQueue())
+            return false;  // tx_timer was deactivated (idle or blocked)
+        double interval = tx_timer.GetInterval();
+        if (interval <= 0.0) continue;  // more tokens available
+        if ((TX_PACE_HYBRID != tx_pace_mode) || (interval > TX_SPIN_MAX))
+            break;
+        // Spin-wait for short intervals that the timer can't deliver precisely
+        struct timeval startTime, currentTime;
+        ProtoSystemTime(startTime);
+        double elapsed;
+        do
+        {
+            ProtoSystemTime(currentTime);
+            elapsed = (double)(currentTime.tv_sec - startTime.tv_sec) +
+                      1.0e-06 * ((double)currentTime.tv_usec - (double)startTime.tv_usec);
+        } while (elapsed < interval);
+        tx_timer.SetInterval(0.0);
+    }
+    return true;
+}  // end NormSession::OnTxTimeout()
+
+// Sends the next queued message (or batch of messages) and sets the
+// tx_timer interval for the next transmission
+bool NormSession::ServiceTxQueue()
 {
     NormMsg *msg;
 
     // Note: sometimes need RepairAdv even when cc_enable is false ...
-    NormCmdRepairAdvMsg adv;
+    NormLocalMsg<NormCmdRepairAdvMsg> adv;
     if (advertise_repairs && (probe_proactive || (repair_timer.IsActive() &&
                                                   repair_timer.GetRepeatCount())))
     {
@@ -4775,6 +5507,14 @@ bool NormSession::OnTxTimeout(ProtoTimer & /*theTimer*/)
     }
     else
     {
+#ifdef NORM_SENDMMSG
+        // (ECN probe_tos raw sends are done one message at a time)
+        if ((tx_batch_size > 1) && (0 == probe_tos))
+        {
+            advertise_repairs = false;
+            return OnTxBatchTimeout();
+        }
+#endif // NORM_SENDMMSG
         msg = message_queue.RemoveHead();
         advertise_repairs = false;
     }
@@ -4802,7 +5542,7 @@ bool NormSession::OnTxTimeout(ProtoTimer & /*theTimer*/)
         {
         case MSG_SEND_OK:
             if (tx_rate > 0.0)
-                tx_timer.SetInterval(GetTxInterval(msgLength, tx_rate));
+                tx_timer.SetInterval(GetTxPaceInterval(msgLength));
             if (advertise_repairs)
             {
                 advertise_repairs = false;
@@ -4860,30 +5600,271 @@ bool NormSession::OnTxTimeout(ProtoTimer & /*theTimer*/)
         else
         {
             // We have a new message as a result of serving, so send it immediately
-            return OnTxTimeout(tx_timer);
+            return ServiceTxQueue();
         }
     }
     return true; // actually will never get here but compiler thinks it's needed
-} // end NormSession::OnTxTimeout()
+} // end NormSession::ServiceTxQueue()
 
-NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
+void NormSession::SetTxPacingMode(TxPacingMode pacingMode)
+{
+    if (pacingMode == tx_pace_mode) return;
+    tx_pace_mode = pacingMode;
+    tx_bucket_tokens = 0.0;
+    ProtoSystemTime(tx_bucket_time);
+}  // end NormSession::SetTxPacingMode()
+
+// Credits the token bucket for the time elapsed since it was last credited
+// (The bucket depth limits bursts to TX_BATCH_INTERVAL worth of data)
+void NormSession::CreditTxBucket()
+{
+    struct timeval currentTime;
+    ProtoSystemTime(currentTime);
+    double elapsed = (double)(currentTime.tv_sec - tx_bucket_time.tv_sec) +
+                     1.0e-06 * ((double)currentTime.tv_usec - (double)tx_bucket_time.tv_usec);
+    tx_bucket_time = currentTime;
+    if (elapsed > 0.0) tx_bucket_tokens += elapsed * tx_rate;
+    double bucketDepth = TX_BATCH_INTERVAL * tx_rate;
+    if (tx_bucket_tokens > bucketDepth) tx_bucket_tokens = bucketDepth;
+}  // end NormSession::CreditTxBucket()
+
+// Returns tx_timer interval until the next transmission after "msgLength" bytes
+// were sent.  In token bucket modes, the bucket is debited and the interval is
+// zero while tokens remain (it may go negative by up to one message)
+double NormSession::GetTxPaceInterval(unsigned int msgLength)
+{
+    if (TX_PACE_TIMER == tx_pace_mode)
+        return GetTxInterval(msgLength, tx_rate);
+    CreditTxBucket();
+    tx_bucket_tokens -= (double)msgLength;
+    return (tx_bucket_tokens >= 0.0) ? 0.0 : (-tx_bucket_tokens / tx_rate);
+}  // end NormSession::GetTxPaceInterval()
+
+// Used for batched transmission to determine if the next message is due
+// in the current pacing interval given "byteCount" bytes already batched
+bool NormSession::TxMessageDue(unsigned int byteCount)
+{
+    if (tx_rate <= 0.0) return true;
+    if (TX_PACE_TIMER == tx_pace_mode)
+        return (GetTxInterval(byteCount, tx_rate) <= TX_BATCH_INTERVAL);
+    CreditTxBucket();
+    return ((double)byteCount < tx_bucket_tokens);
+}  // end NormSession::TxMessageDue()
+
+bool NormSession::SetTxBatchSize(unsigned int batchSize)
+{
+    if (batchSize > TX_BATCH_MAX) batchSize = TX_BATCH_MAX;
+    if (batchSize < 2) batchSize = 0;  // batching disabled
+#ifdef NORM_SENDMMSG
+    tx_batch_size = batchSize;
+    tx_gso = true;  // (re)enable GSO attempts
+    return true;
+#else
+    if (0 == batchSize) return true;
+    PLOG(PL_ERROR, "NormSession::SetTxBatchSize() error: batched transmit not supported on this platform\n");
+    return false;
+#endif // if/else NORM_SENDMMSG
+}  // end NormSession::SetTxBatchSize()
+
+#ifdef NORM_SENDMMSG
+// Sends the queued messages (up to "tx_batch_size") that are due within
+// TX_BATCH_INTERVAL of the current tx_timer timeout using one system call.  The
+// tx_timer interval is then set for the total bytes sent, so the average
+// transmit rate (and "sent_accumulator" accounting) is the same as when
+// messages are sent one per timeout.
+bool NormSession::OnTxBatchTimeout()
 {
-    bool isReceiverMsg = false;
-    bool isProbe = false;
-    bool sendRaw = false;
+    NormMsg* msgList[TX_BATCH_MAX];
+    TxInfo infoList[TX_BATCH_MAX];
+    unsigned int msgCount = 0;
+    unsigned int dequeueCount = 0;
+    unsigned int msgLength = tx_residual;
+    while (dequeueCount < tx_batch_size)
+    {
+        // Is the next message due within this pacing interval?
+        if ((0 != dequeueCount) && !TxMessageDue(msgLength))
+            break;
+        NormMsg* msg = message_queue.RemoveHead();
+        if (NULL == msg)
+        {
+            // Prompt for next sender message
+            if (IsSender()) Serve();
+            if (NULL == (msg = message_queue.RemoveHead())) break;
+        }
+        dequeueCount++;
+        msgLength += msg->GetLength();
+        TxInfo& info = infoList[msgCount];
+        PrepareTxMessage(*msg, info);
+        if (info.is_receiver_msg && receiver_silent)
+        {
+            // don't send receiver messages if "silent receiver" (see SendMessage())
+            ReturnMessageToPool(msg);
+        }
+        else if ((tx_loss_rate > 0.0) && (UniformRand(100.0) < tx_loss_rate))
+        {
+            // "Pretend" like dropped message was sent for trace and timing purposes
+            CompleteTxMessage(*msg, info, false);
+            ReturnMessageToPool(msg);
+        }
+        else
+        {
+            msgList[msgCount++] = msg;
+        }
+    }
+    if (0 == dequeueCount)
+    {
+        // Nothing to send
+        if (tx_timer.IsActive())
+            tx_timer.Deactivate();
+        return false;
+    }
+    unsigned int numSent = 0;
+    MessageStatus status = (0 != msgCount) ? SendMessageBatch(msgList, msgCount, numSent) : MSG_SEND_OK;
+    for (unsigned int i = 0; i < numSent; i++)
+    {
+        CompleteTxMessage(*msgList[i], infoList[i], true);
+        ReturnMessageToPool(msgList[i]);
+    }
+    // Requeue any unsent messages (in order) to try again later
+    for (unsigned int i = msgCount; i > numSent; i--)
+    {
+        NormMsg* msg = msgList[i - 1];
+        if (!infoList[i - 1].is_receiver_msg)
+            tx_sequence--;
+        msgLength -= msg->GetLength();
+        message_queue.Prepend(msg);
+    }
+    if ((0 == numSent) && (MSG_SEND_BLOCKED == status))
+    {
+        // Nothing was sent due to EWOULDBLOCK, so we invoke async i/o output notification
+        if (tx_timer.IsActive())
+            tx_timer.Deactivate();
+        tx_socket->StartOutputNotification();
+        return false; // since timer was deactivated
+    }
+    if (tx_rate > 0.0)
+    {
+        if (msgLength > tx_residual)
+            tx_timer.SetInterval(GetTxPaceInterval(msgLength));
+        else  // nothing sent due to socket error, so just timeout and try again
+            tx_timer.SetInterval(GetTxInterval(tx_residual + msgList[0]->GetLength(), tx_rate));
+    }
+    else if ((MSG_SEND_FAILED == status) && (0 == tx_timer.GetInterval()))
+    {
+        tx_timer.SetInterval(0.001);
+    }
+    return true; // reinstall tx_timer
+}  // end NormSession::OnTxBatchTimeout()
+
+// Sends the list of messages with UDP generic segmentation offload (GSO) when
+// they are equal-sized NORM_DATA messages to the same destination, otherwise
+// (or if GSO fails) with sendmmsg().  The "numSent" messages at the head of the
+// list were sent.
+NormSession::MessageStatus NormSession::SendMessageBatch(NormMsg** msgList, unsigned int msgCount, unsigned int& numSent)
+{
+    struct mmsghdr hdrList[TX_BATCH_MAX];
+    struct iovec iovList[TX_BATCH_MAX];
+    memset(hdrList, 0, msgCount * sizeof(struct mmsghdr));
+    bool isConnected = tx_socket->IsConnected();
+    const ProtoAddress& firstDst = msgList[0]->GetDestination();
+    UINT16 segSize = msgList[0]->GetLength();
+    unsigned int gsoBytes = 0;
+    bool useGso = tx_gso && (msgCount > 1);
+    for (unsigned int i = 0; i < msgCount; i++)
+    {
+        NormMsg& msg = *msgList[i];
+        const ProtoAddress& dst = msg.GetDestination();
+        UINT16 msgSize = msg.GetLength();
+        iovList[i].iov_base = (void*)msg.GetBuffer();
+        iovList[i].iov_len = msgSize;
+        struct msghdr& hdr = hdrList[i].msg_hdr;
+        hdr.msg_iov = iovList + i;
+        hdr.msg_iovlen = 1;
+        if (!isConnected)
+        {
+            hdr.msg_name = (void*)&dst.GetSockAddr();
+            hdr.msg_namelen = (ProtoAddress::IPv6 == dst.GetType()) ?
+                                    sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in);
+        }
+        // Only the last GSO segment may be shorter than the segment size
+        if (useGso && ((NormMsg::DATA != msg.GetType()) || !dst.IsEqual(firstDst) ||
+                       (msgSize > segSize) || ((msgSize < segSize) && (i != (msgCount - 1)))))
+            useGso = false;
+        gsoBytes += msgSize;
+    }
+    int fd = tx_socket->GetHandle();
+    if (useGso && (gsoBytes <= (NormMsg::MAX_SIZE - 48)))  // (less IPv6 + UDP headers)
+    {
+        // The message buffers are gathered into one datagram segmented by the kernel
+        struct msghdr gsoHdr = hdrList[0].msg_hdr;
+        gsoHdr.msg_iov = iovList;
+        gsoHdr.msg_iovlen = msgCount;
+        char ctrlBuffer[CMSG_SPACE(sizeof(UINT16))];
+        memset(ctrlBuffer, 0, sizeof(ctrlBuffer));
+        gsoHdr.msg_control = ctrlBuffer;
+        gsoHdr.msg_controllen = sizeof(ctrlBuffer);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&gsoHdr);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(UINT16));
+        memcpy(CMSG_DATA(cmsg), &segSize, sizeof(UINT16));
+        if (sendmsg(fd, &gsoHdr, 0) >= 0)
+        {
+            numSent = msgCount;
+            return MSG_SEND_OK;
+        }
+        else if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+        {
+            numSent = 0;
+            PLOG(PL_WARN, "NormSession::SendMessageBatch() sendmsg() 'blocked' warning: %s\n", GetErrorString());
+            return MSG_SEND_BLOCKED;
+        }
+        // GSO not supported (by kernel, route or device), so fall back to sendmmsg()
+        PLOG(PL_WARN, "NormSession::SendMessageBatch() UDP GSO error: %s (disabling GSO)\n", GetErrorString());
+        tx_gso = false;
+    }
+    int result = sendmmsg(fd, hdrList, msgCount, 0);
+    if (result > 0)
+    {
+        numSent = (unsigned int)result;
+        return MSG_SEND_OK;
+    }
+    numSent = 0;
+    if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+    {
+        PLOG(PL_WARN, "NormSession::SendMessageBatch() sendmmsg(%s/%hu) 'blocked' warning: %s\n",
+             firstDst.GetHostString(), firstDst.GetPort(), GetErrorString());
+        return MSG_SEND_BLOCKED;
+    }
+    PLOG(PL_WARN, "NormSession::SendMessageBatch() sendmmsg(%s/%hu) 'failed' warning: %s\n",
+         firstDst.GetHostString(), firstDst.GetPort(), GetErrorString());
+    if (!posted_send_error)
+    {
+        posted_send_error = true;
+        Notify(NormController::SEND_ERROR, NULL, NULL);
+    }
+    return MSG_SEND_FAILED;
+}  // end NormSession::SendMessageBatch()
+#endif // NORM_SENDMMSG
+
+void NormSession::PrepareTxMessage(NormMsg& msg, TxInfo& info)
+{
+    info.is_receiver_msg = false;
+    info.is_probe = false;
+    info.send_raw = false;
 
     // Fill in any last minute timestamps
     // (TBD) fill in InstanceId fields on all messages as needed
     // We need "fec_m" for the message for NormTrace() purposes
-    UINT8 fecM = fec_m;          // assume it's a sender message (will be overridden otherwise)
-    UINT16 instId = instance_id; // assume it's a sender message (will be overridden otherwise)
+    info.fec_m = fec_m;          // assume it's a sender message (will be overridden otherwise)
+    info.inst_id = instance_id;  // assume it's a sender message (will be overridden otherwise)
     switch (msg.GetType())
     {
         case NormMsg::INFO:
         case NormMsg::DATA:
         {
             NormObjectMsg &objMsg = static_cast<NormObjectMsg &>(msg);
-            objMsg.SetInstanceId(instId);
+            objMsg.SetInstanceId(info.inst_id);
             msg.SetSequence(tx_sequence++); // (TBD) set for session dst msgs
             if (syn_status)
                 objMsg.SetFlag(NormObjectMsg::FLAG_SYN);
@@ -4892,7 +5873,7 @@ NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
         case NormMsg::CMD:
         {
             NormCmdMsg &cmd = static_cast<NormCmdMsg &>(msg);
-            ((NormCmdMsg &)msg).SetInstanceId(instId);
+            ((NormCmdMsg &)msg).SetInstanceId(info.inst_id);
             switch (cmd.GetFlavor())
             {
                 case NormCmdMsg::CC:
@@ -4901,9 +5882,9 @@ NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
                     struct timeval currentTime;
                     ProtoSystemTime(currentTime);
                     ccMsg.SetSendTime(currentTime);
-                    isProbe = true;
+                    info.is_probe = true;
                     if (0 != probe_tos)
-                        sendRaw = true;  // so probe will be marked accordingly
+                        info.send_raw = true;  // so probe will be marked accordingly
                     if (syn_status)
                         ccMsg.SetSyn();
                     break;
@@ -4919,13 +5900,13 @@ NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
         case NormMsg::NACK:
         {
             msg.SetSequence(0); // TBD - set per destination
-            isReceiverMsg = true;
+            info.is_receiver_msg = true;
             NormNackMsg &nack = (NormNackMsg &)msg;
             NormSenderNode *theSender =
                 (NormSenderNode *)sender_tree.FindNodeById(nack.GetSenderId());
             ASSERT(NULL != theSender);
-            fecM = theSender->GetFecFieldSize();
-            instId = theSender->GetInstanceId();
+            info.fec_m = theSender->GetFecFieldSize();
+            info.inst_id = theSender->GetInstanceId();
             struct timeval grttResponse;
             // When probe_tos is non-zero, GRTT feedback is in ACKs only
             if (0 == probe_tos)
@@ -4944,7 +5925,7 @@ NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
         case NormMsg::ACK:
         {
             msg.SetSequence(0); // TBD - set per destination
-            isReceiverMsg = true;
+            info.is_receiver_msg = true;
             NormAckMsg &ack = (NormAckMsg &)msg;
             NormSenderNode *theSender;
             if (IsServerListener())
@@ -4952,15 +5933,15 @@ NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
             else
                 theSender = (NormSenderNode *)sender_tree.FindNodeById(ack.GetSenderId());
             ASSERT(NULL != theSender);
-            fecM = theSender->GetFecFieldSize();
-            instId = theSender->GetInstanceId();
+            info.fec_m = theSender->GetFecFieldSize();
+            info.inst_id = theSender->GetInstanceId();
             struct timeval grttResponse;
             if ((0 == probe_tos) || (NormAck::CC == ack.GetAckType()))
             {
                 struct timeval currentTime;
                 ProtoSystemTime(currentTime);
                 theSender->CalculateGrttResponse(currentTime, grttResponse);
-                if (0 != probe_tos) sendRaw = true;
+                if (0 != probe_tos) info.send_raw = true;
             }
             else
             {
@@ -4974,12 +5955,87 @@ NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
     }
     // Fill in common message fields
     msg.SetSourceId(local_node_id);
+}  // end NormSession::PrepareTxMessage()
+
+// Updates tracing, sent rate and probing state for a message that was
+// sent (or "dropped" for testing purposes when "wasSent" is false)
+void NormSession::CompleteTxMessage(NormMsg& msg, const TxInfo& info, bool wasSent)
+{
+    UINT16 msgSize = msg.GetLength();
+    if (wasSent && posted_send_error)
+    {
+        // Clear SEND_ERROR indication
+        posted_send_error = false;
+        Notify(NormController::SEND_OK, NULL, NULL);
+    }
+    // Separate send/recv tracing
+    if (trace_ring.IsOpen())
+    {
+        struct timeval currentTime;
+        ProtoSystemTime(currentTime);
+        trace_ring.Record(currentTime, msg, true, info.fec_m, info.inst_id);
+    }
+    else if (trace)
+    {
+        struct timeval currentTime;
+        ProtoSystemTime(currentTime);
+        NormTrace(currentTime, LocalNodeId(), msg, true, info.fec_m, info.inst_id);
+    }
+    // To keep track of _actual_ sent rate (updated even if dropped for testing/debugging)
+    sent_accumulator.Increment(msgSize);
+    if (wasSent)
+    {
+        tx_packet_count.Increment();
+        tx_byte_count.Increment(msgSize);
+    }
+    else
+    {
+        tx_drop_count.Increment();
+    }
+    if (tx_repair_sending && (NormMsg::DATA == msg.GetType()))
+    {
+        // First message sent since the NACK aggregation ended
+        struct timeval currentTime;
+        ProtoSystemTime(currentTime);
+        tx_repair_delay_hist.RecordInterval(tx_repair_nack_time, currentTime);
+        tx_repair_sending = false;
+    }
+    // Update nominal packet size
+    nominal_packet_size += 0.01 * (((double)msgSize) - nominal_packet_size);
+    if (info.is_probe)
+    {
+        probe_pending = false;
+        probe_data_check = true;
+        if (probe_reset)
+        {
+            probe_reset = false;
+            if (!probe_timer.IsActive())
+                ActivateTimer(probe_timer);
+        }
+    }
+    else if (!info.is_receiver_msg && IsSender())
+    {
+        probe_data_check = false;
+        if (!probe_pending && probe_reset)
+        {
+            probe_reset = false;
+            OnProbeTimeout(probe_timer);
+            if (!probe_timer.IsActive())
+                ActivateTimer(probe_timer);
+        }
+    }
+}  // end NormSession::CompleteTxMessage()
+
+NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
+{
+    TxInfo info;
+    PrepareTxMessage(msg, info);
     UINT16 msgSize = msg.GetLength();
     // Possibly drop some tx messages for testing purposes
 
     bool drop = (tx_loss_rate > 0.0) ? (UniformRand(100.0) < tx_loss_rate) : false;
 
-    if (isReceiverMsg && receiver_silent)
+    if (info.is_receiver_msg && receiver_silent)
     {
         // don't send receiver messages if "silent receiver"
         // TBD - perhaps we should make sure silent receivers
@@ -4992,22 +6048,14 @@ NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
     {
         //DMSG(0, "TX MESSAGE DROPPED! (tx_loss_rate:%lf\n", tx_loss_rate);
         // "Pretend" like dropped message was sent for trace and timing purposes
-        if (trace)
-        {
-            struct timeval currentTime;
-            ProtoSystemTime(currentTime);
-            NormTrace(currentTime, LocalNodeId(), msg, true, fecM, instId);
-        }
-        // Update sent rate tracker even if dropped (for testing/debugging)
-        sent_accumulator.Increment(msgSize);
-        nominal_packet_size += 0.01 * (((double)msgSize) - nominal_packet_size);
+        CompleteTxMessage(msg, info, false);
     }
     else
     {
         unsigned int numBytes = msgSize;
         bool result;
 #ifdef ECN_SUPPORT
-        if (sendRaw)
+        if (info.send_raw)
             result = RawSendTo(msg.GetBuffer(), numBytes, msg.GetDestination(), probe_tos);
         else
 #endif // ECN_SUPPORT
@@ -5016,23 +6064,7 @@ NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
         {
             if (numBytes == msgSize)
             {
-                if (posted_send_error)
-                {
-                    // Clear SEND_ERROR indication
-                    posted_send_error = false;
-                    Notify(NormController::SEND_OK, NULL, NULL);
-                }
-                // Separate send/recv tracing
-                if (trace)
-                {
-                    struct timeval currentTime;
-                    ProtoSystemTime(currentTime);
-                    NormTrace(currentTime, LocalNodeId(), msg, true, fecM, instId);
-                }
-                // To keep track of _actual_ sent rate
-                sent_accumulator.Increment(msgSize);
-                // Update nominal packet size
-                nominal_packet_size += 0.01 * (((double)msgSize) - nominal_packet_size);
+                CompleteTxMessage(msg, info, true);
             }
             else
             {
@@ -5059,28 +6091,6 @@ NormSession::MessageStatus NormSession::SendMessage(NormMsg &msg)
             return MSG_SEND_FAILED;
         }
     }
-    if (isProbe)
-    {
-        probe_pending = false;
-        probe_data_check = true;
-        if (probe_reset)
-        {
-            probe_reset = false;
-            if (!probe_timer.IsActive())
-                ActivateTimer(probe_timer);
-        }
-    }
-    else if (!isReceiverMsg && IsSender())
-    {
-        probe_data_check = false;
-        if (!probe_pending && probe_reset)
-        {
-            probe_reset = false;
-            OnProbeTimeout(probe_timer);
-            if (!probe_timer.IsActive())
-                ActivateTimer(probe_timer);
-        }
-    }
     return MSG_SEND_OK;
 } // end NormSession::SendMessage()
 
@@ -5323,6 +6333,7 @@ bool NormSession::OnProbeTimeout(ProtoTimer & /*theTimer*/)
             }
             if (grttQuantizedOld != grtt_quantized)
             {
+                grtt_gauge.SetValue(grtt_advertised);
                 Notify(NormController::GRTT_UPDATED, (NormSenderNode *)NULL, (NormObject *)NULL);
                 PLOG(PL_DEBUG, "NormSession::OnProbeTimeout() node>%lu decreased to new grtt to: %lf sec\n",
                      (unsigned long)LocalNodeId(), grtt_advertised);
@@ -5632,6 +6643,7 @@ void NormSession::AdjustRate(bool onResponse)
             Notify(NormController::TX_RATE_CHANGED, (NormSenderNode *)NULL, (NormObject *)NULL);
         }
     }
+    UpdateStatsGauges();
 
     struct timeval currentTime;
     ::ProtoSystemTime(currentTime);
@@ -5680,6 +6692,23 @@ bool NormSession::OnReportTimeout(ProtoTimer & /*theTimer*/)
         sent_accumulator.Reset();
         PLOG(reportDebugLevel, "   txRate>%9.3lf kbps sentRate>%9.3lf grtt>%lf\n",
              8.0e-03 * tx_rate, sentRate, grtt_advertised);
+        if ((TX_PACE_TIMER != tx_pace_mode) && (tx_rate > 0.0))
+        {
+            PLOG(reportDebugLevel, "   pacing>%s achieved>%5.1lf%% of txRate\n",
+                 (TX_PACE_HYBRID == tx_pace_mode) ? "hybrid" : "bucket",
+                 100.0 * sentRate / (8.0e-03 * tx_rate));
+        }
+        if (tx_parity_cache.IsOpen())
+        {
+            PLOG(reportDebugLevel, "   parityCache hits>%lu misses>%lu\n",
+                 tx_parity_cache.GetHitCount(), tx_parity_cache.GetMissCount());
+        }
+        if (0 != SenderNackItemCount())
+        {
+            PLOG(reportDebugLevel, "   nackItems>%lu coalesced>%lu (%5.1lf%%)\n",
+                 SenderNackItemCount(), SenderNackItemsCoalesced(),
+                 100.0 * (double)SenderNackItemsCoalesced() / (double)SenderNackItemCount());
+        }
         if (cc_enable)
         {
             const NormCCNode *clr = (const NormCCNode *)cc_node_list.Head();
@@ -5715,6 +6744,10 @@ bool NormSession::OnReportTimeout(ProtoTimer & /*theTimer*/)
             PLOG(reportDebugLevel, "   resyncs>%lu nacks>%lu suppressed>%lu\n",
                  next->ResyncCount() ? next->ResyncCount() - 1 : 0, // "ResyncCount()" is really "SyncCount()"
                  next->NackCount(), next->SuppressCount());
+            unsigned long cacheHits, cacheMisses, fastDecodes;
+            if (next->GetDecoderStats(cacheHits, cacheMisses, fastDecodes))
+                PLOG(reportDebugLevel, "   fecDecoder> matrix_cache hits>%lu misses>%lu fast>%lu\n",
+                     cacheHits, cacheMisses, fastDecodes);
             // Some stream status for current receive stream (if applicable)
             NormObject *obj = next->GetNextPendingObject();
             if ((NULL != obj) && obj->IsStream())
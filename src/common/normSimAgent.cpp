@@ -884,7 +884,7 @@ bool NormSimAgent::FlushStream(bool eom)
 void NormSimAgent::Notify(NormController::Event event,
                           class NormSessionMgr* sessionMgr,
                           class NormSession*    session,
-                          class NormSenderNode* sender,
+                          class NormNode*       node,
                           class NormObject*     object)
 {
     switch (event)
@@ -1112,8 +1112,8 @@ void NormSimAgent::Notify(NormController::Event event,
                             if (msg_sync && (0 == mgen_pending_bytes))
                             {
                                 ProtoAddress srcAddr;
-                                srcAddr.ResolveFromString(sender->GetAddress().GetHostString());
-                                srcAddr.SetPort(sender->GetAddress().GetPort());
+                                srcAddr.ResolveFromString(node->GetAddress().GetHostString());
+                                srcAddr.SetPort(node->GetAddress().GetPort());
                                 msg_sink->HandleMessage(mgen_buffer,mgen_bytes,srcAddr);
                                 mgen_bytes = 0;   
                             }
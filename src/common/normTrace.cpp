@@ -0,0 +1,459 @@
+/*********************************************************************
+ *
+ * AUTHORIZATION TO USE AND DISTRIBUTE
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that:
+ *
+ * (1) source code distributions retain this paragraph in its entirety,
+ *
+ * (2) distributions including binary code include this paragraph in
+ *     its entirety in the documentation or other materials provided
+ *     with the distribution, and
+ *
+ * (3) all advertising materials mentioning features or use of this
+ *     software display the following acknowledgment:
+ *
+ *      "This product includes software written and developed
+ *       by Brian Adamson and Joe Macker of the Naval Research
+ *       Laboratory (NRL)."
+ *
+ *  The name of NRL, the name(s) of NRL  employee(s), or any entity
+ *  of the United States Government may not be used to endorse or
+ *  promote  products derived from this software, nor does the
+ *  inclusion of the NRL written and developed software  directly or
+ *  indirectly suggest NRL or United States  Government endorsement
+ *  of this product.
+ *
+ * THIS SOFTWARE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ ********************************************************************/
+
+#include "normTrace.h"
+
+#include <string.h>  // for memset(), memcpy()
+
+// Big-endian field helpers for the trace file format
+static inline void PutUINT16(char* ptr, UINT16 value)
+{
+    ptr[0] = (char)(value >> 8);
+    ptr[1] = (char)value;
+}  // end PutUINT16()
+
+static inline void PutUINT32(char* ptr, UINT32 value)
+{
+    ptr[0] = (char)(value >> 24);
+    ptr[1] = (char)(value >> 16);
+    ptr[2] = (char)(value >> 8);
+    ptr[3] = (char)value;
+}  // end PutUINT32()
+
+static inline UINT16 GetUINT16(const char* ptr)
+{
+    return (UINT16)((((UINT8)ptr[0]) << 8) | ((UINT8)ptr[1]));
+}  // end GetUINT16()
+
+static inline UINT32 GetUINT32(const char* ptr)
+{
+    return ((((UINT32)(UINT8)ptr[0]) << 24) | (((UINT32)(UINT8)ptr[1]) << 16) |
+            (((UINT32)(UINT8)ptr[2]) << 8) | ((UINT32)(UINT8)ptr[3]));
+}  // end GetUINT32()
+
+// This extracts the same message fields NormTrace() prints
+void NormTraceRecord::Init(const struct timeval&   currentTime,
+                           const NormMsg&          msg,
+                           bool                    sent,
+                           UINT8                   fecM,
+                           UINT16                  instId)
+{
+    sec = (UINT32)currentTime.tv_sec;
+    usec = (UINT32)currentTime.tv_usec;
+    flags = sent ? FLAG_SENT : 0;
+    msg_type = (UINT8)msg.GetType();
+    flavor = detail = 0;
+    length = msg.GetLength();
+    seq = msg.GetSequence();
+    inst_id = instId;
+    object_id = 0;
+    block_id = 0;
+    symbol_id = 0;
+    aux = 0;
+    const ProtoAddress& theAddr = sent ? msg.GetDestination() : msg.GetSource();
+    port = theAddr.GetPort();
+    memset(addr, 0, 16);
+    if (ProtoAddress::IPv6 == theAddr.GetType())
+    {
+        flags |= FLAG_IPV6;
+        memcpy(addr, theAddr.GetRawHostAddress(), 16);
+    }
+    else if (theAddr.IsValid())
+    {
+        memcpy(addr, theAddr.GetRawHostAddress(), MIN(theAddr.GetLength(), 4));
+    }
+    switch (msg.GetType())
+    {
+        case NormMsg::INFO:
+        {
+            const NormInfoMsg& info = static_cast<const NormInfoMsg&>(msg);
+            inst_id = info.GetInstanceId();
+            object_id = (UINT16)info.GetObjectId();
+            break;
+        }
+        case NormMsg::DATA:
+        {
+            const NormDataMsg& data = static_cast<const NormDataMsg&>(msg);
+            inst_id = data.GetInstanceId();
+            object_id = (UINT16)data.GetObjectId();
+            block_id = data.GetFecBlockId(fecM).GetValue();
+            symbol_id = data.GetFecSymbolId(fecM);
+            if (data.IsStream())
+            {
+                flags |= FLAG_STREAM;
+                aux = NormDataMsg::ReadStreamPayloadOffset(data.GetPayload());
+            }
+            break;
+        }
+        case NormMsg::CMD:
+        {
+            const NormCmdMsg& cmd = static_cast<const NormCmdMsg&>(msg);
+            inst_id = cmd.GetInstanceId();
+            flavor = (UINT8)cmd.GetFlavor();
+            switch (cmd.GetFlavor())
+            {
+                case NormCmdMsg::ACK_REQ:
+                    detail = (UINT8)static_cast<const NormCmdAckReqMsg&>(msg).GetAckType();
+                    break;
+                case NormCmdMsg::SQUELCH:
+                {
+                    const NormCmdSquelchMsg& squelch = static_cast<const NormCmdSquelchMsg&>(msg);
+                    object_id = (UINT16)squelch.GetObjectId();
+                    block_id = squelch.GetFecBlockId(fecM).GetValue();
+                    symbol_id = squelch.GetFecSymbolId(fecM);
+                    break;
+                }
+                case NormCmdMsg::FLUSH:
+                {
+                    const NormCmdFlushMsg& flush = static_cast<const NormCmdFlushMsg&>(msg);
+                    object_id = (UINT16)flush.GetObjectId();
+                    block_id = flush.GetFecBlockId(fecM).GetValue();
+                    symbol_id = flush.GetFecSymbolId(fecM);
+                    if (0 != flush.GetAckingNodeCount())
+                        flags |= FLAG_WATERMARK;
+                    break;
+                }
+                case NormCmdMsg::CC:
+                {
+                    const NormCmdCCMsg& cc = static_cast<const NormCmdCCMsg&>(msg);
+                    symbol_id = cc.GetCCSequence();
+                    NormHeaderExtension ext;
+                    while (cc.GetNextExtension(ext))
+                    {
+                        if (NormHeaderExtension::CC_RATE == ext.GetType())
+                        {
+                            flags |= FLAG_RATE;
+                            aux = ((NormCCRateExtension&)ext).GetSendRate();
+                            break;
+                        }
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+            break;
+        }
+        case NormMsg::ACK:
+        case NormMsg::NACK:
+        {
+            NormHeaderExtension ext;
+            while (msg.GetNextExtension(ext))
+            {
+                if (NormHeaderExtension::CC_FEEDBACK == ext.GetType())
+                {
+                    if (((NormCCFeedbackExtension&)ext).CCFlagIsSet(NormCC::CLR))
+                        flags |= FLAG_CLR;
+                    break;
+                }
+            }
+            if (NormMsg::ACK == msg.GetType())
+            {
+                const NormAckMsg& ack = static_cast<const NormAckMsg&>(msg);
+                flavor = (UINT8)ack.GetAckType();
+                if (NormAck::FLUSH == ack.GetAckType())
+                {
+                    const NormAckFlushMsg& flushAck = static_cast<const NormAckFlushMsg&>(ack);
+                    object_id = (UINT16)flushAck.GetObjectId();
+                    block_id = flushAck.GetFecBlockId(fecM).GetValue();
+                    symbol_id = flushAck.GetFecSymbolId(fecM);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}  // end NormTraceRecord::Init()
+
+void NormTraceRecord::Pack(char* buffer) const
+{
+    PutUINT32(buffer, sec);
+    PutUINT32(buffer + 4, usec);
+    buffer[8] = (char)flags;
+    buffer[9] = (char)msg_type;
+    buffer[10] = (char)flavor;
+    buffer[11] = (char)detail;
+    PutUINT16(buffer + 12, length);
+    PutUINT16(buffer + 14, seq);
+    PutUINT16(buffer + 16, inst_id);
+    PutUINT16(buffer + 18, object_id);
+    PutUINT32(buffer + 20, block_id);
+    PutUINT16(buffer + 24, symbol_id);
+    PutUINT16(buffer + 26, port);
+    PutUINT32(buffer + 28, aux);
+    memcpy(buffer + 32, addr, 16);
+}  // end NormTraceRecord::Pack()
+
+void NormTraceRecord::Unpack(const char* buffer)
+{
+    sec = GetUINT32(buffer);
+    usec = GetUINT32(buffer + 4);
+    flags = (UINT8)buffer[8];
+    msg_type = (UINT8)buffer[9];
+    flavor = (UINT8)buffer[10];
+    detail = (UINT8)buffer[11];
+    length = GetUINT16(buffer + 12);
+    seq = GetUINT16(buffer + 14);
+    inst_id = GetUINT16(buffer + 16);
+    object_id = GetUINT16(buffer + 18);
+    block_id = GetUINT32(buffer + 20);
+    symbol_id = GetUINT16(buffer + 24);
+    port = GetUINT16(buffer + 26);
+    aux = GetUINT32(buffer + 28);
+    memcpy(addr, buffer + 32, 16);
+}  // end NormTraceRecord::Unpack()
+
+double NormTraceRecord::GetRate() const
+{
+    return NormUnquantizeRate((UINT16)aux);
+}  // end NormTraceRecord::GetRate()
+
+NormTraceRing::NormTraceRing()
+ : trace_file(NULL), ring(NULL), ring_mask(0), ring_write(0), ring_read(0),
+   drop_count(0), write_buffer(NULL), write_error(false), started(false), stopping(false)
+{
+#ifdef WIN32
+    InitializeCriticalSection(&mutex);
+    InitializeConditionVariable(&cond);
+#else
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&cond, NULL);
+#endif // if/else WIN32
+}
+
+NormTraceRing::~NormTraceRing()
+{
+    Close();
+#ifdef WIN32
+    DeleteCriticalSection(&mutex);
+#else
+    pthread_cond_destroy(&cond);
+    pthread_mutex_destroy(&mutex);
+#endif // if/else WIN32
+}
+
+void NormTraceRing::Lock()
+{
+#ifdef WIN32
+    EnterCriticalSection(&mutex);
+#else
+    pthread_mutex_lock(&mutex);
+#endif // if/else WIN32
+}  // end NormTraceRing::Lock()
+
+void NormTraceRing::Unlock()
+{
+#ifdef WIN32
+    LeaveCriticalSection(&mutex);
+#else
+    pthread_mutex_unlock(&mutex);
+#endif // if/else WIN32
+}  // end NormTraceRing::Unlock()
+
+bool NormTraceRing::Open(const char* path, NormNodeId localId, unsigned int ringSize)
+{
+    Close();
+    UINT32 size = 1;
+    while ((size < ringSize) && (size < 0x80000000)) size <<= 1;
+    if (NULL == (ring = new NormTraceRecord[size]))
+    {
+        PLOG(PL_ERROR, "NormTraceRing::Open() new ring error: %s\n", GetErrorString());
+        return false;
+    }
+    // (the writer packs at most half the ring per fwrite())
+    unsigned int bufferSize = ((size > 1) ? (size / 2) : 1) * NormTraceRecord::RECORD_SIZE;
+    if (NULL == (write_buffer = new char[bufferSize]))
+    {
+        PLOG(PL_ERROR, "NormTraceRing::Open() new write_buffer error: %s\n", GetErrorString());
+        delete[] ring;
+        ring = NULL;
+        return false;
+    }
+    if (NULL == (trace_file = fopen(path, "wb")))
+    {
+        PLOG(PL_ERROR, "NormTraceRing::Open() fopen(%s) error: %s\n", path, GetErrorString());
+        Close();
+        return false;
+    }
+    char header[NormTraceRecord::HEADER_SIZE];
+    memcpy(header, "NTRC", 4);
+    PutUINT16(header + 4, NormTraceRecord::VERSION);
+    PutUINT16(header + 6, NormTraceRecord::RECORD_SIZE);
+    PutUINT32(header + 8, localId);
+    PutUINT32(header + 12, 0);  // dropped record count (set by Close())
+    if (1 != fwrite(header, NormTraceRecord::HEADER_SIZE, 1, trace_file))
+    {
+        PLOG(PL_ERROR, "NormTraceRing::Open() fwrite() error: %s\n", GetErrorString());
+        Close();
+        return false;
+    }
+    ring_mask = size - 1;
+    ring_write = ring_read = 0;
+    drop_count = 0;
+    write_error = false;
+    stopping = false;
+#ifdef WIN32
+    thread_handle = CreateThread(NULL, 0, DoWriterThread, this, 0, NULL);
+    started = (NULL != thread_handle);
+#else
+    started = (0 == pthread_create(&thread_id, NULL, DoWriterThread, this));
+#endif // if/else WIN32
+    if (!started)
+    {
+        PLOG(PL_ERROR, "NormTraceRing::Open() error: unable to create writer thread: %s\n", GetErrorString());
+        Close();
+        return false;
+    }
+    return true;
+}  // end NormTraceRing::Open()
+
+void NormTraceRing::Close()
+{
+    if (started)
+    {
+        Lock();
+        stopping = true;
+#ifdef WIN32
+        WakeConditionVariable(&cond);
+#else
+        pthread_cond_signal(&cond);
+#endif // if/else WIN32
+        Unlock();
+#ifdef WIN32
+        WaitForSingleObject(thread_handle, INFINITE);
+        CloseHandle(thread_handle);
+#else
+        pthread_join(thread_id, NULL);
+#endif // if/else WIN32
+        started = false;
+    }
+    if (NULL != trace_file)
+    {
+        Drain();  // (anything recorded since the writer's last pass)
+        if (0 != drop_count)
+        {
+            PLOG(PL_WARN, "NormTraceRing::Close() warning: %lu trace records dropped\n",
+                          (unsigned long)drop_count);
+            char count[4];
+            PutUINT32(count, drop_count);
+            if ((0 != fseek(trace_file, 12, SEEK_SET)) ||
+                (1 != fwrite(count, 4, 1, trace_file)))
+            {
+                PLOG(PL_ERROR, "NormTraceRing::Close() error updating drop count: %s\n", GetErrorString());
+            }
+        }
+        fclose(trace_file);
+        trace_file = NULL;
+    }
+    if (NULL != write_buffer)
+    {
+        delete[] write_buffer;
+        write_buffer = NULL;
+    }
+    if (NULL != ring)
+    {
+        delete[] ring;
+        ring = NULL;
+    }
+    ring_mask = 0;
+}  // end NormTraceRing::Close()
+
+#ifdef WIN32
+DWORD WINAPI NormTraceRing::DoWriterThread(LPVOID param)
+{
+    static_cast<NormTraceRing*>(param)->RunWriter();
+    return 0;
+}  // end NormTraceRing::DoWriterThread()
+#else
+void* NormTraceRing::DoWriterThread(void* param)
+{
+    static_cast<NormTraceRing*>(param)->RunWriter();
+    return NULL;
+}  // end NormTraceRing::DoWriterThread()
+#endif // if/else WIN32
+
+// The writer wakes up periodically rather than being signaled so
+// the protocol thread never needs to take the mutex
+void NormTraceRing::RunWriter()
+{
+    Lock();
+    while (!stopping)
+    {
+        Unlock();
+        Drain();
+        Lock();
+        if (stopping) break;
+#ifdef WIN32
+        SleepConditionVariableCS(&cond, &mutex, WRITE_INTERVAL_MSEC);
+#else
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        struct timespec wakeTime;
+        long nsec = (now.tv_usec * 1000L) + (WRITE_INTERVAL_MSEC * 1000000L);
+        wakeTime.tv_sec = now.tv_sec + (nsec / 1000000000L);
+        wakeTime.tv_nsec = nsec % 1000000000L;
+        pthread_cond_timedwait(&cond, &mutex, &wakeTime);
+#endif // if/else WIN32
+    }
+    Unlock();
+}  // end NormTraceRing::RunWriter()
+
+void NormTraceRing::Drain()
+{
+    UINT32 writeIndex = NormAtomicLoad(&ring_write);
+    UINT32 readIndex = ring_read;
+    UINT32 packMax = (ring_mask + 1) / 2;
+    if (0 == packMax) packMax = 1;
+    if (readIndex == writeIndex) return;
+    while (readIndex != writeIndex)
+    {
+        UINT32 count = writeIndex - readIndex;
+        if (count > packMax) count = packMax;
+        char* ptr = write_buffer;
+        for (UINT32 i = 0; i < count; i++)
+        {
+            ring[(readIndex + i) & ring_mask].Pack(ptr);
+            ptr += NormTraceRecord::RECORD_SIZE;
+        }
+        readIndex += count;
+        // The ring slots are free once packed
+        NormAtomicStore(&ring_read, readIndex);
+        if (!write_error && (count != fwrite(write_buffer, NormTraceRecord::RECORD_SIZE, count, trace_file)))
+        {
+            PLOG(PL_ERROR, "NormTraceRing::Drain() fwrite() error: %s\n", GetErrorString());
+            write_error = true;  // (keep draining so the protocol thread isn't stalled)
+        }
+        writeIndex = NormAtomicLoad(&ring_write);
+    }
+    if (!write_error) fflush(trace_file);
+}  // end NormTraceRing::Drain()
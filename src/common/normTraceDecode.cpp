@@ -0,0 +1,246 @@
+// This program converts a binary NORM message trace file (see
+// NormSetMessageTraceFile() and normTrace.h) to the text "trace" lines
+// that NormTrace() logs, so the existing analysis tools can be used, e.g.:
+//
+//   normTraceDecode input norm.ntr | n2m | trpr ...
+//
+// Usage: normTraceDecode [input <traceFile>][output <textFile>][summary]
+//
+// The "summary" option prints message counts by type (and the number of
+// records the NORM thread dropped, if any) to stderr.
+
+#include "normTrace.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>   // for gmtime()
+
+#ifdef WIN32
+#include <io.h>     // for _setmode()
+#include <fcntl.h>  // for _O_BINARY
+#endif // WIN32
+
+static const char* const MSG_NAME[] =
+{
+    "INVALID",
+    "INFO",
+    "DATA",
+    "CMD",
+    "NACK",
+    "ACK",
+    "REPORT"
+};
+static const char* const CMD_NAME[] =
+{
+    "CMD(INVALID)",
+    "CMD(FLUSH)",
+    "CMD(EOT)",
+    "CMD(SQUELCH)",
+    "CMD(CC)",
+    "CMD(REPAIR_ADV)",
+    "CMD(ACK_REQ)",
+    "CMD(APP)"
+};
+static const char* const REQ_NAME[] =
+{
+    "INVALID",
+    "WATERMARK",
+    "RTT",
+    "APP"
+};
+
+enum {RECORD_SIZE_MAX = 256};
+
+static void Usage()
+{
+    fprintf(stderr, "Usage: normTraceDecode [input <traceFile>][output <textFile>][summary]\n");
+}  // end Usage()
+
+// Prints a record in the same format as NormTrace()
+static void PrintRecord(FILE* outfile, const NormTraceRecord& record, NormNodeId localId)
+{
+    time_t secs = (time_t)record.sec;
+    struct tm* ct = gmtime(&secs);
+    fprintf(outfile, "trace>%02d:%02d:%02d.%06lu ",
+            (int)ct->tm_hour, (int)ct->tm_min, (int)ct->tm_sec, (unsigned long)record.usec);
+    ProtoAddress addr;
+    if (record.FlagIsSet(NormTraceRecord::FLAG_IPV6))
+        addr.SetRawHostAddress(ProtoAddress::IPv6, (const char*)record.addr, 16);
+    else
+        addr.SetRawHostAddress(ProtoAddress::IPv4, (const char*)record.addr, 4);
+    fprintf(outfile, "node>%lu %s>%s/%hu ", (unsigned long)localId,
+            record.FlagIsSet(NormTraceRecord::FLAG_SENT) ? "dst" : "src",
+            addr.GetHostString(), record.port);
+    switch (record.msg_type)
+    {
+        case NormMsg::INFO:
+            fprintf(outfile, "inst>%hu seq>%hu INFO obj>%hu ",
+                    record.inst_id, record.seq, record.object_id);
+            break;
+        case NormMsg::DATA:
+            fprintf(outfile, "inst>%hu seq>%hu DATA obj>%hu blk>%lu seg>%hu ",
+                    record.inst_id, record.seq, record.object_id,
+                    (unsigned long)record.block_id, record.symbol_id);
+            if (record.FlagIsSet(NormTraceRecord::FLAG_STREAM))
+                fprintf(outfile, "offset>%lu ", (unsigned long)record.aux);
+            break;
+        case NormMsg::CMD:
+            fprintf(outfile, "inst>%hu seq>%hu %s ", record.inst_id, record.seq,
+                    (record.flavor <= NormCmdMsg::APPLICATION) ? CMD_NAME[record.flavor] : CMD_NAME[0]);
+            switch (record.flavor)
+            {
+                case NormCmdMsg::ACK_REQ:
+                    fprintf(outfile, "(%s) ", REQ_NAME[MIN(record.detail, 3)]);
+                    break;
+                case NormCmdMsg::SQUELCH:
+                    fprintf(outfile, " obj>%hu blk>%lu seg>%hu ", record.object_id,
+                            (unsigned long)record.block_id, record.symbol_id);
+                    break;
+                case NormCmdMsg::FLUSH:
+                    fprintf(outfile, " obj>%hu blk>%lu seg>%hu ", record.object_id,
+                            (unsigned long)record.block_id, record.symbol_id);
+                    if (record.FlagIsSet(NormTraceRecord::FLAG_WATERMARK))
+                        fprintf(outfile, "(WATERMARK) ");
+                    break;
+                case NormCmdMsg::CC:
+                    fprintf(outfile, " seq>%u ", (unsigned int)record.symbol_id);
+                    if (record.FlagIsSet(NormTraceRecord::FLAG_RATE))
+                        fprintf(outfile, " rate>%f ", 8.0e-03 * record.GetRate());
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case NormMsg::ACK:
+            fprintf(outfile, "inst>%hu ", record.inst_id);
+            if (NormAck::FLUSH == record.flavor)
+                fprintf(outfile, "ACK(FLUSH) obj>%hu blk>%lu seg>%hu ", record.object_id,
+                        (unsigned long)record.block_id, record.symbol_id);
+            else if (NormAck::CC == record.flavor)
+                fprintf(outfile, "ACK(CC) ");
+            else
+                fprintf(outfile, "ACK(ZZZ) ");
+            break;
+        case NormMsg::NACK:
+            fprintf(outfile, "inst>%hu NACK ", record.inst_id);
+            break;
+        default:
+            fprintf(outfile, "%s ", (record.msg_type <= NormMsg::REPORT) ? MSG_NAME[record.msg_type] : MSG_NAME[0]);
+            break;
+    }
+    fprintf(outfile, "len>%hu %s\n", record.length,
+            record.FlagIsSet(NormTraceRecord::FLAG_CLR) ? "(CLR)" : "");
+}  // end PrintRecord()
+
+int main(int argc, char* argv[])
+{
+    const char* inputPath = NULL;
+    const char* outputPath = NULL;
+    bool summary = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp("input", argv[i]) && (++i < argc))
+        {
+            inputPath = argv[i];
+        }
+        else if (!strcmp("output", argv[i]) && (++i < argc))
+        {
+            outputPath = argv[i];
+        }
+        else if (!strcmp("summary", argv[i]))
+        {
+            summary = true;
+        }
+        else
+        {
+            Usage();
+            return -1;
+        }
+    }
+
+    FILE* infile = stdin;
+    if ((NULL != inputPath) && (NULL == (infile = fopen(inputPath, "rb"))))
+    {
+        perror("normTraceDecode: error opening input file");
+        return -1;
+    }
+#ifdef WIN32
+    if (stdin == infile) _setmode(_fileno(stdin), _O_BINARY);
+#endif // WIN32
+    FILE* outfile = stdout;
+    if ((NULL != outputPath) && (NULL == (outfile = fopen(outputPath, "w"))))
+    {
+        perror("normTraceDecode: error opening output file");
+        if (stdin != infile) fclose(infile);
+        return -1;
+    }
+
+    int status = 0;
+    char header[NormTraceRecord::HEADER_SIZE];
+    if ((1 != fread(header, NormTraceRecord::HEADER_SIZE, 1, infile)) ||
+        (0 != memcmp(header, "NTRC", 4)))
+    {
+        fprintf(stderr, "normTraceDecode: input is not a NORM trace file\n");
+        status = -1;
+    }
+    unsigned int version = 0;
+    unsigned int recordSize = 0;
+    if (0 == status)
+    {
+        version = ((UINT8)header[4] << 8) | (UINT8)header[5];
+        recordSize = ((UINT8)header[6] << 8) | (UINT8)header[7];
+        // (newer versions may only append fields to each record)
+        if ((version < NormTraceRecord::VERSION) || (recordSize < NormTraceRecord::RECORD_SIZE) ||
+            (recordSize > RECORD_SIZE_MAX))
+        {
+            fprintf(stderr, "normTraceDecode: unsupported trace file version %u\n", version);
+            status = -1;
+        }
+    }
+    if (0 == status)
+    {
+        NormNodeId localId = ((UINT32)(UINT8)header[8] << 24) | ((UINT32)(UINT8)header[9] << 16) |
+                             ((UINT32)(UINT8)header[10] << 8) | (UINT32)(UINT8)header[11];
+        unsigned long dropCount = ((unsigned long)(UINT8)header[12] << 24) | ((unsigned long)(UINT8)header[13] << 16) |
+                                  ((unsigned long)(UINT8)header[14] << 8) | (unsigned long)(UINT8)header[15];
+        unsigned long sentCount[NormMsg::REPORT + 1];
+        unsigned long recvCount[NormMsg::REPORT + 1];
+        memset(sentCount, 0, sizeof(sentCount));
+        memset(recvCount, 0, sizeof(recvCount));
+        char buffer[RECORD_SIZE_MAX];
+        while (1 == fread(buffer, recordSize, 1, infile))
+        {
+            NormTraceRecord record;
+            record.Unpack(buffer);
+            PrintRecord(outfile, record, localId);
+            unsigned int type = (record.msg_type <= NormMsg::REPORT) ? record.msg_type : 0;
+            if (record.FlagIsSet(NormTraceRecord::FLAG_SENT))
+                sentCount[type]++;
+            else
+                recvCount[type]++;
+        }
+        if (ferror(infile))
+        {
+            perror("normTraceDecode: error reading input file");
+            status = -1;
+        }
+        if (summary)
+        {
+            fprintf(stderr, "normTraceDecode: node>%lu", (unsigned long)localId);
+            if (0 != dropCount)
+                fprintf(stderr, " (%lu records dropped)", dropCount);
+            fprintf(stderr, "\n");
+            for (unsigned int i = NormMsg::INFO; i <= NormMsg::REPORT; i++)
+            {
+                fprintf(stderr, "   %-7s sent>%lu recv>%lu\n", MSG_NAME[i], sentCount[i], recvCount[i]);
+            }
+        }
+        else if (0 != dropCount)
+        {
+            fprintf(stderr, "normTraceDecode: warning: %lu records were dropped by the NORM thread\n", dropCount);
+        }
+    }
+    if (stdin != infile) fclose(infile);
+    if (stdout != outfile) fclose(outfile);
+    return status;
+}  // end main()
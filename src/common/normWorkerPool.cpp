@@ -0,0 +1,297 @@
+/*********************************************************************
+ *
+ * AUTHORIZATION TO USE AND DISTRIBUTE
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that:
+ *
+ * (1) source code distributions retain this paragraph in its entirety,
+ *
+ * (2) distributions including binary code include this paragraph in
+ *     its entirety in the documentation or other materials provided
+ *     with the distribution, and
+ *
+ * (3) all advertising materials mentioning features or use of this
+ *     software display the following acknowledgment:
+ *
+ *      "This product includes software written and developed
+ *       by Brian Adamson and Joe Macker of the Naval Research
+ *       Laboratory (NRL)."
+ *
+ *  The name of NRL, the name(s) of NRL  employee(s), or any entity
+ *  of the United States Government may not be used to endorse or
+ *  promote  products derived from this software, nor does the
+ *  inclusion of the NRL written and developed software  directly or
+ *  indirectly suggest NRL or United States  Government endorsement
+ *  of this product.
+ *
+ * THIS SOFTWARE IS PROVIDED ``AS IS'' AND WITHOUT ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ ********************************************************************/
+
+
+#include "normWorkerPool.h"
+#include "protoDebug.h"  // for PLOG()
+
+NormWorkerPool::Worker::Worker()
+ : pool(NULL), index(0), current(NULL), started(false)
+{
+}
+
+NormWorkerPool::NormWorkerPool(unsigned int jobsPerThread)
+ : jobs_per_thread(jobsPerThread), thread_count(0), worker_list(NULL), 
+   job_max(0), job_count(0), stopping(false), 
+   done_event(false)  // (manual reset, see GetCompletedJob())
+{
+#ifdef WIN32
+    InitializeCriticalSection(&job_mutex);
+    InitializeConditionVariable(&job_cond);
+    InitializeConditionVariable(&done_cond);
+#else
+    pthread_mutex_init(&job_mutex, NULL);
+    pthread_cond_init(&job_cond, NULL);
+    pthread_cond_init(&done_cond, NULL);
+#endif // if/else WIN32
+}
+
+NormWorkerPool::~NormWorkerPool()
+{
+    Close();
+    free_list.Destroy();
+    done_list.Destroy();
+#ifdef WIN32
+    DeleteCriticalSection(&job_mutex);
+#else
+    pthread_cond_destroy(&done_cond);
+    pthread_cond_destroy(&job_cond);
+    pthread_mutex_destroy(&job_mutex);
+#endif // if/else WIN32
+}
+
+void NormWorkerPool::Lock()
+{
+#ifdef WIN32
+    EnterCriticalSection(&job_mutex);
+#else
+    pthread_mutex_lock(&job_mutex);
+#endif // if/else WIN32
+}  // end NormWorkerPool::Lock()
+
+void NormWorkerPool::Unlock()
+{
+#ifdef WIN32
+    LeaveCriticalSection(&job_mutex);
+#else
+    pthread_mutex_unlock(&job_mutex);
+#endif // if/else WIN32
+}  // end NormWorkerPool::Unlock()
+
+bool NormWorkerPool::Open(unsigned int threadCount, ProtoChannel::Notifier* notifier)
+{
+    Close();
+    // Discard any previously completed jobs
+    free_list.Destroy();
+    done_list.Destroy();
+    job_count = 0;
+    if (0 == threadCount) return true;
+    if (NULL == notifier)
+    {
+        PLOG(PL_ERROR, "NormWorkerPool::Open() error: no channel notifier\n");
+        return false;
+    }
+    done_event.SetNotifier(notifier);
+    if (!done_event.Open())
+    {
+        PLOG(PL_ERROR, "NormWorkerPool::Open() error: unable to open done_event\n");
+        return false;
+    }
+    if (!done_event.StartInputNotification())
+    {
+        PLOG(PL_ERROR, "NormWorkerPool::Open() error: unable to start done_event notification\n");
+        done_event.Close();
+        return false;
+    }
+    if (NULL == (worker_list = new Worker[threadCount]))
+    {
+        PLOG(PL_ERROR, "NormWorkerPool::Open() new worker_list error: %s\n", GetErrorString());
+        done_event.Close();
+        return false;
+    }
+    stopping = false;
+    thread_count = threadCount;
+    job_max = jobs_per_thread * threadCount;
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        Worker& worker = worker_list[i];
+        worker.pool = this;
+        worker.index = i;
+#ifdef WIN32
+        worker.thread_handle = CreateThread(NULL, 0, DoWorkerThread, &worker, 0, NULL);
+        worker.started = (NULL != worker.thread_handle);
+#else
+        worker.started = (0 == pthread_create(&worker.thread_id, NULL, DoWorkerThread, &worker));
+#endif // if/else WIN32
+        if (!worker.started)
+        {
+            PLOG(PL_ERROR, "NormWorkerPool::Open() error: unable to create worker thread: %s\n", GetErrorString());
+            Close();
+            return false;
+        }
+    }
+    return true;
+}  // end NormWorkerPool::Open()
+
+void NormWorkerPool::Close()
+{
+    if (NULL != worker_list)
+    {
+        Lock();
+        stopping = true;
+#ifdef WIN32
+        WakeAllConditionVariable(&job_cond);
+#else
+        pthread_cond_broadcast(&job_cond);
+#endif // if/else WIN32
+        Unlock();
+        for (unsigned int i = 0; i < thread_count; i++)
+        {
+            Worker& worker = worker_list[i];
+            if (!worker.started) continue;
+#ifdef WIN32
+            WaitForSingleObject(worker.thread_handle, INFINITE);
+            CloseHandle(worker.thread_handle);
+#else
+            pthread_join(worker.thread_id, NULL);
+#endif // if/else WIN32
+        }
+        delete[] worker_list;
+        worker_list = NULL;
+        done_event.Close();
+    }
+    // (pending_list is empty since workers drain it before exiting)
+    thread_count = 0;
+    stopping = false;
+}  // end NormWorkerPool::Close()
+
+#ifdef WIN32
+DWORD WINAPI NormWorkerPool::DoWorkerThread(LPVOID param)
+{
+    Worker* worker = static_cast<Worker*>(param);
+    worker->pool->RunWorker(*worker);
+    return 0;
+}  // end NormWorkerPool::DoWorkerThread()
+#else
+void* NormWorkerPool::DoWorkerThread(void* param)
+{
+    Worker* worker = static_cast<Worker*>(param);
+    worker->pool->RunWorker(*worker);
+    return NULL;
+}  // end NormWorkerPool::DoWorkerThread()
+#endif // if/else WIN32
+
+void NormWorkerPool::RunWorker(Worker& worker)
+{
+    Lock();
+    while (true)
+    {
+        NormWorkerJob* job = pending_list.RemoveHead();
+        if (NULL == job)
+        {
+            if (stopping) break;
+#ifdef WIN32
+            SleepConditionVariableCS(&job_cond, &job_mutex, INFINITE);
+#else
+            pthread_cond_wait(&job_cond, &job_mutex);
+#endif // if/else WIN32
+            continue;
+        }
+        worker.current = job;
+        Unlock();
+        ProcessJob(worker.index, *job);
+        Lock();
+        worker.current = NULL;
+        done_list.Append(*job);
+        done_event.Set();
+#ifdef WIN32
+        WakeAllConditionVariable(&done_cond);
+#else
+        pthread_cond_broadcast(&done_cond);
+#endif // if/else WIN32
+    }
+    Unlock();
+}  // end NormWorkerPool::RunWorker()
+
+NormWorkerJob* NormWorkerPool::GetFreeJob()
+{
+    if (!IsOpen()) return NULL;
+    NormWorkerJob* job = free_list.RemoveHead();
+    if ((NULL == job) && (job_count < job_max))
+    {
+        if (NULL != (job = CreateJob()))
+            job_count++;
+        else
+            PLOG(PL_ERROR, "NormWorkerPool::GetFreeJob() new job error: %s\n", GetErrorString());
+    }
+    return job;
+}  // end NormWorkerPool::GetFreeJob()
+
+void NormWorkerPool::PutFreeJob(NormWorkerJob* job)
+{
+    free_list.Prepend(*job);
+}  // end NormWorkerPool::PutFreeJob()
+
+void NormWorkerPool::Submit(NormWorkerJob* job)
+{
+    Lock();
+    pending_list.Append(*job);
+#ifdef WIN32
+    WakeConditionVariable(&job_cond);
+#else
+    pthread_cond_signal(&job_cond);
+#endif // if/else WIN32
+    Unlock();
+}  // end NormWorkerPool::Submit()
+
+NormWorkerJob* NormWorkerPool::GetCompletedJob()
+{
+    Lock();
+    NormWorkerJob* job = done_list.RemoveHead();
+    // The done_event is reset while holding the lock once the done_list
+    // is empty, so a worker completion can't be missed
+    if ((NULL == job) && IsOpen())
+        done_event.Reset();
+    Unlock();
+    return job;
+}  // end NormWorkerPool::GetCompletedJob()
+
+bool NormWorkerPool::IsBusy(const void* owner)
+{
+    NormWorkerJob::List::Iterator iterator(pending_list);
+    NormWorkerJob* job;
+    while (NULL != (job = iterator.GetNextItem()))
+    {
+        if (owner == job->GetOwner()) return true;
+    }
+    for (unsigned int i = 0; i < thread_count; i++)
+    {
+        NormWorkerJob* current = worker_list[i].current;
+        if ((NULL != current) && (owner == current->GetOwner())) 
+            return true;
+    }
+    return false;
+}  // end NormWorkerPool::IsBusy()
+
+void NormWorkerPool::Flush(const void* owner)
+{
+    Lock();
+    while (IsBusy(owner)) 
+    {
+#ifdef WIN32
+        SleepConditionVariableCS(&done_cond, &job_mutex, INFINITE);
+#else
+        pthread_cond_wait(&done_cond, &job_mutex);
+#endif // if/else WIN32
+    }
+    Unlock();
+}  // end NormWorkerPool::Flush()
@@ -166,7 +166,7 @@ int main(int argc, char *argv[])
         if (!udpPkt.InitFromPacket(ipPkt))
             continue; // not a UDP packet
 
-        NormMsg msg;
+        NormLocalMsg<NormMsg> msg;
         if (msg.CopyFromBuffer((const char *)udpPkt.GetPayload(), udpPkt.GetPayloadLength()))
         {
             srcAddr.SetPort(udpPkt.GetSrcPort());
@@ -195,6 +195,20 @@ void check_version(JNIEnv *env) {
   env->ReleaseStringUTFChars(versionString, version);
 }
 
+void setHistogramRegion(JNIEnv *env, jlongArray array, int index,
+    const NormHistogram& histogram) {
+  jlong values[3 + NORM_HISTOGRAM_BINS];
+
+  values[0] = (jlong)histogram.count;
+  values[1] = (jlong)histogram.sumUsec;
+  values[2] = (jlong)histogram.maxUsec;
+  for (int i = 0; i < NORM_HISTOGRAM_BINS; i++) {
+    values[3 + i] = (jlong)histogram.bins[i];
+  }
+  env->SetLongArrayRegion(array, index * (3 + NORM_HISTOGRAM_BINS),
+    3 + NORM_HISTOGRAM_BINS, values);
+}
+
 /* Called by the JVM when the library is unloaded */
 JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
   JNIEnv *env;
@@ -11,7 +11,7 @@
  * and C native libraries. Update this string along with it's counterpart in
  * the NormInstance.java file whenever the native API changes.
  */
-#define VERSION "20130415-0927"
+#define VERSION "20261017-1200"
 
 #define PKGNAME(str) Java_mil_navy_nrl_norm_##str
 
@@ -19,6 +19,10 @@
 extern "C" {
 #endif
 
+/* Copies a NormHistogram into the Java array used by NormHistogram.java */
+void setHistogramRegion(JNIEnv *env, jlongArray array, int index,
+  const NormHistogram& histogram);
+
 extern jweak jw_InetAddress;
 extern jmethodID mid_InetAddress_getByAddress;
 
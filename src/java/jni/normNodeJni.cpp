@@ -95,6 +95,31 @@ JNIEXPORT jdouble JNICALL PKGNAME(NormNode_getGrtt)
   return NormNodeGetGrtt(nodeHandle);
 }
 
+JNIEXPORT void JNICALL PKGNAME(NormNode_getStatsNative)
+    (JNIEnv *env, jobject obj, jlongArray counters, jdoubleArray values,
+    jlongArray histograms) {
+  NormNodeHandle nodeHandle;
+  NormNodeStats stats;
+
+  nodeHandle = (NormNodeHandle)env->GetLongField(obj, fid_NormNode_handle);
+
+  if (!NormNodeGetStats(nodeHandle, &stats)) {
+    env->ThrowNew((jclass)env->NewLocalRef(jw_IOException), "Failed to get stats");
+    return;
+  }
+
+  jlong c[] = {(jlong)stats.rxPackets, (jlong)stats.rxBytes,
+    (jlong)stats.rxGoodputBytes, (jlong)stats.nacksSent,
+    (jlong)stats.nacksSuppressed, (jlong)stats.resyncs,
+    (jlong)stats.objectsCompleted, (jlong)stats.objectsFailed,
+    (jlong)stats.bufferPeakSegments, (jlong)stats.bufferOverruns};
+  jdouble v[] = {stats.rxRate, stats.grtt, stats.lossEstimate};
+  env->SetLongArrayRegion(counters, 0, sizeof(c) / sizeof(jlong), c);
+  env->SetDoubleArrayRegion(values, 0, sizeof(v) / sizeof(jdouble), v);
+  setHistogramRegion(env, histograms, 0, stats.rxInterArrival);
+  setHistogramRegion(env, histograms, 1, stats.decodeTime);
+}
+
 JNIEXPORT jint JNICALL PKGNAME(NormNode_getCommand)
     (JNIEnv *env, jobject obj, jbyteArray buffer, jint offset, jint length) {
   NormNodeHandle nodeHandle;
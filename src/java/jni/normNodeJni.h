@@ -65,6 +65,14 @@ JNIEXPORT jobject JNICALL Java_mil_navy_nrl_norm_NormNode_getAddress
 JNIEXPORT jdouble JNICALL Java_mil_navy_nrl_norm_NormNode_getGrtt
   (JNIEnv *, jobject);
 
+/*
+ * Class:     mil_navy_nrl_norm_NormNode
+ * Method:    getStatsNative
+ * Signature: ([J[D[J)V
+ */
+JNIEXPORT void JNICALL Java_mil_navy_nrl_norm_NormNode_getStatsNative
+  (JNIEnv *, jobject, jlongArray, jdoubleArray, jlongArray);
+
 /*
  * Class:     mil_navy_nrl_norm_NormNode
  * Method:    getCommand
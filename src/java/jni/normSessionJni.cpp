@@ -196,6 +196,34 @@ JNIEXPORT jdouble JNICALL PKGNAME(NormSession_getReportInterval)
   return NormGetReportInterval(session);
 }
 
+JNIEXPORT void JNICALL PKGNAME(NormSession_getStatsNative)
+    (JNIEnv *env, jobject obj, jlongArray counters, jdoubleArray values,
+    jlongArray histograms) {
+  NormSessionHandle session;
+  NormSessionStats stats;
+
+  session = (NormSessionHandle)env->GetLongField(obj, fid_NormSession_handle);
+
+  if (!NormGetSessionStats(session, &stats)) {
+    env->ThrowNew((jclass)env->NewLocalRef(jw_IOException), "Failed to get stats");
+    return;
+  }
+
+  jlong c[] = {(jlong)stats.txPackets, (jlong)stats.txBytes,
+    (jlong)stats.txDropped, (jlong)stats.rxPackets, (jlong)stats.rxBytes,
+    (jlong)stats.nacksReceived, (jlong)stats.nackItems,
+    (jlong)stats.nackItemsCoalesced, (jlong)stats.parityCacheHits,
+    (jlong)stats.parityCacheMisses, (jlong)stats.bufferPeakSegments,
+    (jlong)stats.bufferOverruns, (jlong)stats.ccClrId,
+    (jlong)(stats.ccSlowStart ? 1 : 0)};
+  jdouble v[] = {stats.txRate, stats.grtt, stats.ccClrRate, stats.ccClrRtt,
+    stats.ccClrLoss};
+  env->SetLongArrayRegion(counters, 0, sizeof(c) / sizeof(jlong), c);
+  env->SetDoubleArrayRegion(values, 0, sizeof(v) / sizeof(jdouble), v);
+  setHistogramRegion(env, histograms, 0, stats.repairDelay);
+  setHistogramRegion(env, histograms, 1, stats.rxInterArrival);
+}
+
 JNIEXPORT void JNICALL PKGNAME(NormSession_startSender)
     (JNIEnv *env, jobject obj, jint sessionId, jlong bufferSpace,
     jint segmentSize, jshort blockSize, jshort numParity) {
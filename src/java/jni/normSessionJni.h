@@ -127,6 +127,14 @@ JNIEXPORT void JNICALL Java_mil_navy_nrl_norm_NormSession_setReportInterval
 JNIEXPORT jdouble JNICALL Java_mil_navy_nrl_norm_NormSession_getReportInterval
   (JNIEnv *, jobject);
 
+/*
+ * Class:     mil_navy_nrl_norm_NormSession
+ * Method:    getStatsNative
+ * Signature: ([J[D[J)V
+ */
+JNIEXPORT void JNICALL Java_mil_navy_nrl_norm_NormSession_getStatsNative
+  (JNIEnv *, jobject, jlongArray, jdoubleArray, jlongArray);
+
 /*
  * Class:     mil_navy_nrl_norm_NormSession
  * Method:    startSender
@@ -0,0 +1,49 @@
+package mil.navy.nrl.norm;
+
+/**
+ * A histogram of time intervals from NormSessionStats or NormNodeStats.
+ * Bin 0 counts intervals under 1 usec, bin i counts [2^(i-1), 2^i) usec
+ * and the last bin also counts anything longer.
+ */
+public class NormHistogram {
+  public static final int BIN_COUNT = 24;
+
+  /* Number of values held in the native array for each histogram */
+  static final int SIZE = 3 + BIN_COUNT;
+
+  private long count;
+  private long sumUsec;
+  private long maxUsec;
+  private long bins[];
+
+  NormHistogram(long values[], int offset) {
+    count = values[offset];
+    sumUsec = values[offset + 1];
+    maxUsec = values[offset + 2];
+    bins = new long[BIN_COUNT];
+    System.arraycopy(values, offset + 3, bins, 0, BIN_COUNT);
+  }
+
+  public long getCount() {
+    return count;
+  }
+
+  public long getSumUsec() {
+    return sumUsec;
+  }
+
+  public long getMaxUsec() {
+    return maxUsec;
+  }
+
+  /**
+   * @return Returns the mean interval in microseconds.
+   */
+  public double getMeanUsec() {
+    return (count > 0) ? ((double)sumUsec / (double)count) : 0.0;
+  }
+
+  public long getBin(int index) {
+    return bins[index];
+  }
+}
@@ -13,7 +13,7 @@ public class NormInstance {
    * and C native libraries. Update this string along with it's counterpart in
    * the normJni.h file whenever the native API changes.
    */
-  private static final String VERSION = "20130415-0927";
+  private static final String VERSION = "20261017-1200";
 
   static {
     System.loadLibrary("mil_navy_nrl_norm");
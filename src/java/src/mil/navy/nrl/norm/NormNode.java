@@ -35,6 +35,21 @@ public class NormNode {
 
   public native double getGrtt();
 
+  /**
+   * Returns the cumulative statistics kept for this remote sender.
+   */
+  public NormNodeStats getStats() throws IOException {
+    long counters[] = new long[NormNodeStats.COUNTER_COUNT];
+    double values[] = new double[NormNodeStats.VALUE_COUNT];
+    long histograms[] = new long[NormNodeStats.HISTOGRAM_COUNT
+        * NormHistogram.SIZE];
+    getStatsNative(counters, values, histograms);
+    return new NormNodeStats(counters, values, histograms);
+  }
+
+  private native void getStatsNative(long counters[], double values[],
+      long histograms[]) throws IOException;
+
   public native int getCommand(byte buffer[], int offset, int length)
       throws IOException;
 
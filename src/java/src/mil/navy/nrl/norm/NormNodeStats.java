@@ -0,0 +1,94 @@
+package mil.navy.nrl.norm;
+
+/**
+ * Cumulative statistics kept for a remote sender (see NormNode.getStats()).
+ */
+public class NormNodeStats {
+  /* Sizes of the arrays filled in by the native code */
+  static final int COUNTER_COUNT = 10;
+  static final int VALUE_COUNT = 3;
+  static final int HISTOGRAM_COUNT = 2;
+
+  private long counters[];
+  private double values[];
+  private NormHistogram rxInterArrival;
+  private NormHistogram decodeTime;
+
+  NormNodeStats(long counters[], double values[], long histograms[]) {
+    this.counters = counters;
+    this.values = values;
+    rxInterArrival = new NormHistogram(histograms, 0);
+    decodeTime = new NormHistogram(histograms, NormHistogram.SIZE);
+  }
+
+  public long getRxPackets() {
+    return counters[0];
+  }
+
+  public long getRxBytes() {
+    return counters[1];
+  }
+
+  public long getRxGoodputBytes() {
+    return counters[2];
+  }
+
+  public long getNacksSent() {
+    return counters[3];
+  }
+
+  public long getNacksSuppressed() {
+    return counters[4];
+  }
+
+  public long getResyncs() {
+    return counters[5];
+  }
+
+  public long getObjectsCompleted() {
+    return counters[6];
+  }
+
+  public long getObjectsFailed() {
+    return counters[7];
+  }
+
+  public long getBufferPeakSegments() {
+    return counters[8];
+  }
+
+  public long getBufferOverruns() {
+    return counters[9];
+  }
+
+  /**
+   * @return Returns the recent receive rate in bits/sec.
+   */
+  public double getRxRate() {
+    return values[0];
+  }
+
+  public double getGrtt() {
+    return values[1];
+  }
+
+  public double getLossEstimate() {
+    return values[2];
+  }
+
+  public NormHistogram getRxInterArrival() {
+    return rxInterArrival;
+  }
+
+  public NormHistogram getDecodeTime() {
+    return decodeTime;
+  }
+
+  /**
+   * @see java.lang.Object#toString()
+   */
+  public String toString() {
+    return String.format("NormNodeStats [rxPackets=%d nacksSent=%d rxRate=%f]",
+      getRxPackets(), getNacksSent(), getRxRate());
+  }
+}
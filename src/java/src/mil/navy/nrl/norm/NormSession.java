@@ -83,6 +83,22 @@ public class NormSession {
 
   public native double getReportInterval();
 
+  /**
+   * Returns the session's cumulative statistics.  These are read without
+   * suspending the NORM thread.
+   */
+  public NormSessionStats getStats() throws IOException {
+    long counters[] = new long[NormSessionStats.COUNTER_COUNT];
+    double values[] = new double[NormSessionStats.VALUE_COUNT];
+    long histograms[] = new long[NormSessionStats.HISTOGRAM_COUNT
+        * NormHistogram.SIZE];
+    getStatsNative(counters, values, histograms);
+    return new NormSessionStats(counters, values, histograms);
+  }
+
+  private native void getStatsNative(long counters[], double values[],
+      long histograms[]) throws IOException;
+
   /* NORM Sender Functions */
 
   public native void startSender(int sessionId, long bufferSpace,
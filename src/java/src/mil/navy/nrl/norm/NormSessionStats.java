@@ -0,0 +1,125 @@
+package mil.navy.nrl.norm;
+
+/**
+ * Cumulative statistics of a NormSession (see NormSession.getStats()).
+ */
+public class NormSessionStats {
+  /* Sizes of the arrays filled in by the native code */
+  static final int COUNTER_COUNT = 14;
+  static final int VALUE_COUNT = 5;
+  static final int HISTOGRAM_COUNT = 2;
+
+  private long counters[];
+  private double values[];
+  private NormHistogram repairDelay;
+  private NormHistogram rxInterArrival;
+
+  NormSessionStats(long counters[], double values[], long histograms[]) {
+    this.counters = counters;
+    this.values = values;
+    repairDelay = new NormHistogram(histograms, 0);
+    rxInterArrival = new NormHistogram(histograms, NormHistogram.SIZE);
+  }
+
+  public long getTxPackets() {
+    return counters[0];
+  }
+
+  public long getTxBytes() {
+    return counters[1];
+  }
+
+  public long getTxDropped() {
+    return counters[2];
+  }
+
+  public long getRxPackets() {
+    return counters[3];
+  }
+
+  public long getRxBytes() {
+    return counters[4];
+  }
+
+  public long getNacksReceived() {
+    return counters[5];
+  }
+
+  public long getNackItems() {
+    return counters[6];
+  }
+
+  public long getNackItemsCoalesced() {
+    return counters[7];
+  }
+
+  public long getParityCacheHits() {
+    return counters[8];
+  }
+
+  public long getParityCacheMisses() {
+    return counters[9];
+  }
+
+  public long getBufferPeakSegments() {
+    return counters[10];
+  }
+
+  public long getBufferOverruns() {
+    return counters[11];
+  }
+
+  public long getCcClrId() {
+    return counters[12];
+  }
+
+  public boolean isCcSlowStart() {
+    return (counters[13] != 0);
+  }
+
+  /**
+   * @return Returns the transmit rate in bits/sec.
+   */
+  public double getTxRate() {
+    return values[0];
+  }
+
+  public double getGrtt() {
+    return values[1];
+  }
+
+  /**
+   * @return Returns the current limiting receiver's rate in bits/sec.
+   */
+  public double getCcClrRate() {
+    return values[2];
+  }
+
+  public double getCcClrRtt() {
+    return values[3];
+  }
+
+  public double getCcClrLoss() {
+    return values[4];
+  }
+
+  /**
+   * @return Returns the delay from a NACK's arrival to the first repair
+   * transmission for it.
+   */
+  public NormHistogram getRepairDelay() {
+    return repairDelay;
+  }
+
+  public NormHistogram getRxInterArrival() {
+    return rxInterArrival;
+  }
+
+  /**
+   * @see java.lang.Object#toString()
+   */
+  public String toString() {
+    return String.format("NormSessionStats [txPackets=%d rxPackets=%d nacksReceived=%d txRate=%f]",
+      getTxPackets(), getRxPackets(), getNacksReceived(), getTxRate());
+  }
+}
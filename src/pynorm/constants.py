@@ -46,6 +46,11 @@ NORM_SYNC_ALL     = 2
 NORM_BOUNDARY_BLOCK  = 0
 NORM_BOUNDARY_OBJECT = 1
     
+# enum NormTxPacingMode
+NORM_PACING_TIMER  = 0
+NORM_PACING_BUCKET = 1
+NORM_PACING_HYBRID = 2
+    
 # enum NormEventType
 NORM_EVENT_INVALID          = 0
 NORM_TX_QUEUE_VACANCY       = 1
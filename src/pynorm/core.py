@@ -20,6 +20,57 @@ class NormEventStruct(ctypes.Structure):
             ("sender", ctypes.c_void_p),
             ("object", ctypes.c_void_p)]
 
+NORM_HISTOGRAM_BINS = 24
+
+class NormHistogramStruct(ctypes.Structure):
+    _fields_ = [
+            ("count", ctypes.c_ulonglong),
+            ("sumUsec", ctypes.c_ulonglong),
+            ("maxUsec", ctypes.c_ulonglong),
+            ("bins", ctypes.c_ulonglong * NORM_HISTOGRAM_BINS)]
+
+class NormSessionStatsStruct(ctypes.Structure):
+    _fields_ = [
+            ("txPackets", ctypes.c_ulonglong),
+            ("txBytes", ctypes.c_ulonglong),
+            ("txDropped", ctypes.c_ulonglong),
+            ("rxPackets", ctypes.c_ulonglong),
+            ("rxBytes", ctypes.c_ulonglong),
+            ("nacksReceived", ctypes.c_ulonglong),
+            ("nackItems", ctypes.c_ulonglong),
+            ("nackItemsCoalesced", ctypes.c_ulonglong),
+            ("parityCacheHits", ctypes.c_ulonglong),
+            ("parityCacheMisses", ctypes.c_ulonglong),
+            ("bufferPeakSegments", ctypes.c_ulonglong),
+            ("bufferOverruns", ctypes.c_ulonglong),
+            ("txRate", ctypes.c_double),
+            ("grtt", ctypes.c_double),
+            ("ccClrId", ctypes.c_uint32),
+            ("ccClrRate", ctypes.c_double),
+            ("ccClrRtt", ctypes.c_double),
+            ("ccClrLoss", ctypes.c_double),
+            ("ccSlowStart", ctypes.c_bool),
+            ("repairDelay", NormHistogramStruct),
+            ("rxInterArrival", NormHistogramStruct)]
+
+class NormNodeStatsStruct(ctypes.Structure):
+    _fields_ = [
+            ("rxPackets", ctypes.c_ulonglong),
+            ("rxBytes", ctypes.c_ulonglong),
+            ("rxGoodputBytes", ctypes.c_ulonglong),
+            ("nacksSent", ctypes.c_ulonglong),
+            ("nacksSuppressed", ctypes.c_ulonglong),
+            ("resyncs", ctypes.c_ulonglong),
+            ("objectsCompleted", ctypes.c_ulonglong),
+            ("objectsFailed", ctypes.c_ulonglong),
+            ("bufferPeakSegments", ctypes.c_ulonglong),
+            ("bufferOverruns", ctypes.c_ulonglong),
+            ("rxRate", ctypes.c_double),
+            ("grtt", ctypes.c_double),
+            ("lossEstimate", ctypes.c_double),
+            ("rxInterArrival", NormHistogramStruct),
+            ("decodeTime", NormHistogramStruct)]
+
 # ctypes error checkers
 def errcheck_bool(result, func, args):
     """Checks the return value of functions that return bools.  Raises an
@@ -77,6 +128,10 @@ def get_libnorm():
     libnorm.NormCreateInstance.argtypes = [ctypes.c_bool]
     libnorm.NormCreateInstance.errcheck = errcheck_instance
 
+    libnorm.NormCreateShardedInstance.restype = ctypes.c_void_p
+    libnorm.NormCreateShardedInstance.argtypes = [ctypes.c_uint, ctypes.c_bool]
+    libnorm.NormCreateShardedInstance.errcheck = errcheck_instance
+
     libnorm.NormDestroyInstance.restype = None
     libnorm.NormDestroyInstance.argtypes = [ctypes.c_void_p]
 
@@ -98,11 +153,19 @@ def get_libnorm():
     libnorm.NormSetCacheDirectory.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
     libnorm.NormSetCacheDirectory.errcheck = errcheck_bool
 
+    libnorm.NormSetFileIoThreads.restype = ctypes.c_bool
+    libnorm.NormSetFileIoThreads.argtypes = [ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint]
+    libnorm.NormSetFileIoThreads.errcheck = errcheck_bool
+
     libnorm.NormGetNextEvent.restype = ctypes.c_bool
     libnorm.NormGetNextEvent.argtypes = [ctypes.c_void_p,
             ctypes.POINTER(NormEventStruct), ctypes.c_bool]
     libnorm.NormGetNextEvent.errcheck = errcheck_bool
 
+    libnorm.NormGetNextEvents.restype = ctypes.c_uint
+    libnorm.NormGetNextEvents.argtypes = [ctypes.c_void_p,
+            ctypes.POINTER(NormEventStruct), ctypes.c_uint, ctypes.c_bool]
+
     libnorm.NormGetDescriptor.restype = ctypes.c_void_p
     libnorm.NormGetDescriptor.argtypes = [ctypes.c_void_p]
     libnorm.NormGetDescriptor.errcheck = errcheck_descriptor
@@ -180,6 +243,10 @@ def get_libnorm():
     libnorm.NormSetMessageTrace.restype = None
     libnorm.NormSetMessageTrace.argtypes = [ctypes.c_void_p, ctypes.c_bool]
 
+    libnorm.NormSetMessageTraceFile.restype = ctypes.c_bool
+    libnorm.NormSetMessageTraceFile.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+    libnorm.NormSetMessageTraceFile.errcheck = errcheck_bool
+
     libnorm.NormSetTxLoss.restype = None
     libnorm.NormSetTxLoss.argtypes = [ctypes.c_void_p, ctypes.c_double]
 
@@ -212,6 +279,11 @@ def get_libnorm():
     libnorm.NormGetReportInterval.restype = ctypes.c_double
     libnorm.NormGetReportInterval.argtypes = []
 
+    libnorm.NormGetSessionStats.restype = ctypes.c_bool
+    libnorm.NormGetSessionStats.argtypes = [ctypes.c_void_p,
+            ctypes.POINTER(NormSessionStatsStruct)]
+    libnorm.NormGetSessionStats.errcheck = errcheck_bool
+
     # Sender functions
     libnorm.NormStartSender.restype = ctypes.c_bool
     libnorm.NormStartSender.argtypes = [ctypes.c_void_p, ctypes.c_uint16,
@@ -224,6 +296,9 @@ def get_libnorm():
     libnorm.NormSetTxRate.restype = None
     libnorm.NormSetTxRate.argtypes = [ctypes.c_void_p, ctypes.c_double]
 
+    libnorm.NormSetTxPacingMode.restype = None
+    libnorm.NormSetTxPacingMode.argtypes = [ctypes.c_void_p, ctypes.c_int]
+
     libnorm.NormGetTxRate.restype = ctypes.c_double
     libnorm.NormGetTxRate.argtypes = [ctypes.c_void_p]
 
@@ -231,6 +306,10 @@ def get_libnorm():
     libnorm.NormSetTxSocketBuffer.argtypes = [ctypes.c_void_p, ctypes.c_uint]
     libnorm.NormSetTxSocketBuffer.errcheck = errcheck_bool
 
+    libnorm.NormSetTxBatchSize.restype = ctypes.c_bool
+    libnorm.NormSetTxBatchSize.argtypes = [ctypes.c_void_p, ctypes.c_uint]
+    libnorm.NormSetTxBatchSize.errcheck = errcheck_bool
+
     libnorm.NormSetFlowControl.restype = None
     libnorm.NormSetFlowControl.argtypes = [ctypes.c_void_p, ctypes.c_double]
 
@@ -254,6 +333,18 @@ def get_libnorm():
     libnorm.NormSetAutoParity.restype = None
     libnorm.NormSetAutoParity.argtypes = [ctypes.c_void_p, ctypes.c_uint8]
 
+    libnorm.NormSetBlockEncode.restype = ctypes.c_bool
+    libnorm.NormSetBlockEncode.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+    libnorm.NormSetBlockEncode.errcheck = errcheck_bool
+
+    libnorm.NormSetTxParityCache.restype = ctypes.c_bool
+    libnorm.NormSetTxParityCache.argtypes = [ctypes.c_void_p, ctypes.c_uint]
+    libnorm.NormSetTxParityCache.errcheck = errcheck_bool
+
+    libnorm.NormSetFecThreads.restype = ctypes.c_bool
+    libnorm.NormSetFecThreads.argtypes = [ctypes.c_void_p, ctypes.c_uint]
+    libnorm.NormSetFecThreads.errcheck = errcheck_bool
+
     libnorm.NormSetGrttEstimate.restype = None
     libnorm.NormSetGrttEstimate.argtypes = [ctypes.c_void_p, ctypes.c_double]
 
@@ -279,6 +370,9 @@ def get_libnorm():
     libnorm.NormSetTxRobustFactor.restype = None
     libnorm.NormSetTxRobustFactor.argtypes = [ctypes.c_void_p, ctypes.c_int]
 
+    libnorm.NormSetFileMapping.restype = None
+    libnorm.NormSetFileMapping.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+
     libnorm.NormFileEnqueue.restype = ctypes.c_void_p
     libnorm.NormFileEnqueue.argtypes = [ctypes.c_void_p, ctypes.c_char_p,
             ctypes.c_char_p, ctypes.c_uint]
@@ -315,6 +409,10 @@ def get_libnorm():
     libnorm.NormStreamSetPushEnable.restype = None
     libnorm.NormStreamSetPushEnable.argtypes = [ctypes.c_void_p, ctypes.c_bool]
 
+    libnorm.NormStreamEnableStaging.restype = ctypes.c_bool
+    libnorm.NormStreamEnableStaging.argtypes = [ctypes.c_void_p, ctypes.c_uint]
+    libnorm.NormStreamEnableStaging.errcheck = errcheck_bool
+
     libnorm.NormStreamHasVacancy.restype = ctypes.c_bool
     libnorm.NormStreamHasVacancy.argtypes = [ctypes.c_void_p]
 
@@ -366,6 +464,14 @@ def get_libnorm():
     libnorm.NormSetRxSocketBuffer.argtypes = [ctypes.c_void_p, ctypes.c_uint]
     libnorm.NormSetRxSocketBuffer.errcheck = errcheck_bool
 
+    libnorm.NormSetRxBatchSize.restype = ctypes.c_bool
+    libnorm.NormSetRxBatchSize.argtypes = [ctypes.c_void_p, ctypes.c_uint]
+    libnorm.NormSetRxBatchSize.errcheck = errcheck_bool
+
+    libnorm.NormSetRxBusyPoll.restype = ctypes.c_bool
+    libnorm.NormSetRxBusyPoll.argtypes = [ctypes.c_void_p, ctypes.c_uint]
+    libnorm.NormSetRxBusyPoll.errcheck = errcheck_bool
+
     libnorm.NormSetSilentReceiver.restype = None
     libnorm.NormSetSilentReceiver.argtypes = [ctypes.c_void_p, ctypes.c_bool, ctypes.c_int]
             
@@ -472,6 +578,11 @@ def get_libnorm():
     libnorm.NormNodeGetGrtt.restype = ctypes.c_double
     libnorm.NormNodeGetGrtt.argtypes = [ctypes.c_void_p]
 
+    libnorm.NormNodeGetStats.restype = ctypes.c_bool
+    libnorm.NormNodeGetStats.argtypes = [ctypes.c_void_p,
+            ctypes.POINTER(NormNodeStatsStruct)]
+    libnorm.NormNodeGetStats.errcheck = errcheck_bool
+
     libnorm.NormNodeGetCommand.restype = ctypes.c_bool
     libnorm.NormNodeGetCommand.argtypes = [ctypes.c_void_p, ctypes.c_char_p,
             ctypes.POINTER(ctypes.c_uint)]
@@ -24,13 +24,18 @@ from pynorm.object import Object
 class Instance(object):
     """Represents an instance of the NORM protocal engine"""
 
-    def __init__(self, priorityBoost=False):
-        """Creates a new instance of the NORM protocol engine"""
-        self._instance = libnorm.NormCreateInstance(priorityBoost)
+    def __init__(self, priorityBoost=False, threads=1):
+        """Creates a new instance of the NORM protocol engine
+        (with sessions spread across "threads" protocol threads)"""
+        if threads > 1:
+            self._instance = libnorm.NormCreateShardedInstance(threads, priorityBoost)
+        else:
+            self._instance = libnorm.NormCreateInstance(priorityBoost)
         self._sessions = dict()
         self._senders = WeakValueDictionary()
         self._objects = WeakValueDictionary()
         self._estruct = NormEventStruct()
+        self._earray = (NormEventStruct * 0)()
 
         if system() == 'Windows':
             self._select = self._select_windows
@@ -79,15 +84,22 @@ class Instance(object):
         
         if self._estruct.session == c.NORM_SESSION_INVALID:
             raise NormError("No new event")
-        try:
-            sender = self._senders[self._estruct.sender]
-        except KeyError:
-            sender = self._senders[self._estruct.sender] = Node(self._estruct.sender)
-        try:
-            object = self._objects[self._estruct.object]
-        except KeyError:
-            object = self._objects[self._estruct.object] = Object(self._estruct.object)
-        return Event(self._estruct.type, self._sessions[self._estruct.session], sender, object)
+        return self._makeEvent(self._estruct)
+
+    def getNextEvents(self, maxEvents=64, timeout=None):
+        """Returns a list of up to maxEvents pending events (None on timeout)"""
+        if not self._select(timeout):
+            return None
+        if len(self._earray) < maxEvents:
+            self._earray = (NormEventStruct * maxEvents)()
+        count = libnorm.NormGetNextEvents(self, self._earray, maxEvents, True)
+        events = []
+        for estruct in self._earray[:count]:
+            if estruct.type == c.NORM_EVENT_INVALID:
+                events.append(Event(c.NORM_EVENT_INVALID, None, None, None))
+            else:
+                events.append(self._makeEvent(estruct))
+        return events
 
     def getDescriptor(self):
         return libnorm.NormGetDescriptor(self)
@@ -122,6 +134,17 @@ class Instance(object):
     def _select_everythingelse(self, timeout):
         return True if select([self], [], [], timeout)[0] else False
 
+    def _makeEvent(self, estruct):
+        try:
+            sender = self._senders[estruct.sender]
+        except KeyError:
+            sender = self._senders[estruct.sender] = Node(estruct.sender)
+        try:
+            object = self._objects[estruct.object]
+        except KeyError:
+            object = self._objects[estruct.object] = Object(estruct.object)
+        return Event(estruct.type, self._sessions[estruct.session], sender, object)
+
     @property
     def _as_parameter_(self):
         """This is for ctypes, so we can pass this object into C functions"""
@@ -8,7 +8,7 @@ from __future__ import absolute_import
 import ctypes
 
 import pynorm.constants as c
-from pynorm.core import libnorm, NormError
+from pynorm.core import libnorm, NormError, NormNodeStatsStruct
 
 class Node(object):
     """Represents a NORM node instance"""
@@ -46,6 +46,12 @@ class Node(object):
             raise NormError("getGrtt failed")
         return grtt
 
+    def getStats(self):
+        """Returns a NormNodeStatsStruct of cumulative statistics"""
+        stats = NormNodeStatsStruct()
+        libnorm.NormNodeGetStats(self, ctypes.byref(stats))
+        return stats
+
     def setUnicastNack(self, mode):
         libnorm.NormNodeSetUnicastNack(self, mode)
 
@@ -91,6 +91,9 @@ class Object(object):
     def streamPushEnable(self, push):
         libnorm.NormStreamSetPushEnable(self, push)
 
+    def streamEnableStaging(self, bufferSize):
+        libnorm.NormStreamEnableStaging(self, bufferSize)
+
     def streamHasVacancy(self):
         return libnorm.NormStreamHasVacancy(self)
 
@@ -8,7 +8,7 @@ from __future__ import absolute_import
 import ctypes
 
 import pynorm.constants as c
-from pynorm.core import libnorm, NormError
+from pynorm.core import libnorm, NormError, NormSessionStatsStruct
 from pynorm.object import Object
 
 class Session(object):
@@ -68,6 +68,12 @@ class Session(object):
     def setReportInterval(self, interval):
         libnorm.NormSetReportInterval(self, interval)
 
+    def getStats(self):
+        """Returns a NormSessionStatsStruct of cumulative statistics"""
+        stats = NormSessionStatsStruct()
+        libnorm.NormGetSessionStats(self, ctypes.byref(stats))
+        return stats
+
     ## Sender functions
     def startSender(self, sessionId, bufferSpace, segmentSize, blockSize, numParity):
         libnorm.NormStartSender(self, sessionId, bufferSpace, segmentSize,
@@ -79,9 +85,15 @@ class Session(object):
     def setTxRate(self, rate):
         libnorm.NormSetTxRate(self, rate)
 
+    def setTxPacingMode(self, mode):
+        libnorm.NormSetTxPacingMode(self, mode)
+
     def setTxSocketBuffer(self, size):
         libnorm.NormSetTxSocketBuffer(self, size)
 
+    def setTxBatchSize(self, batchSize):
+        libnorm.NormSetTxBatchSize(self, batchSize)
+
     def setCongestionControl(self, ccEnable, adjustRate=True):
         libnorm.NormSetCongestionControl(self, ccEnable, adjustRate)
         
@@ -100,6 +112,15 @@ class Session(object):
     def setAutoParity(self, parity):
         libnorm.NormSetAutoParity(self, parity)
 
+    def setBlockEncode(self, state):
+        libnorm.NormSetBlockEncode(self, state)
+
+    def setTxParityCache(self, blockCount):
+        libnorm.NormSetTxParityCache(self, blockCount)
+
+    def setFecThreads(self, threadCount):
+        libnorm.NormSetFecThreads(self, threadCount)
+
     def getGrttEstimate(self):
         return libnorm.NormGetGrttEstimate(self)
 
@@ -121,6 +142,12 @@ class Session(object):
     def setGroupSize(self, size):
         libnorm.NormSetGroupSize(self, size)
 
+    def setFileIoThreads(self, threadCount, readAhead=4):
+        libnorm.NormSetFileIoThreads(self, threadCount, readAhead)
+
+    def setFileMapping(self, state):
+        libnorm.NormSetFileMapping(self, state)
+
     def fileEnqueue(self, filename, info=""):
         return Object(libnorm.NormFileEnqueue(self, filename, info, len(info)))
 
@@ -171,6 +198,12 @@ class Session(object):
     def setRxSocketBuffer(self, size):
         libnorm.NormSetRxSocketBuffer(self, size)
 
+    def setRxBatchSize(self, batchSize):
+        libnorm.NormSetRxBatchSize(self, batchSize)
+
+    def setRxBusyPoll(self, usec):
+        libnorm.NormSetRxBusyPoll(self, usec)
+
     def setSilentReceiver(self, silent, maxDelay=None):
         if maxDelay == None:
             maxDelay = -1
@@ -191,6 +224,10 @@ class Session(object):
     def setMessageTrace(self, state):
         libnorm.NormSetMessageTrace(self, state)
 
+    def setMessageTraceFile(self, path):
+        """Records a binary message trace to "path" (None closes the file)"""
+        libnorm.NormSetMessageTraceFile(self, path)
+
     ## Properties
     nodeId = property(getNodeId)
     grtt = property(getGrttEstimate, setGrttEstimate)
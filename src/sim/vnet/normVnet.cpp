@@ -0,0 +1,310 @@
+// normVnet.cpp - Runs a NORM sender and many receivers in a single process
+//                over a deterministic VnetNetwork "virtual network"
+//
+// Usage: normVnet [receivers <n>][duration <sec>][seed <value>]
+//                 [link <rate>,<delay>,<loss>][uplink <rate>,<delay>,<loss>]
+//                 [rxlink <first>-<last>,<rate>,<delay>,<loss>][queue <bytes>]
+//                 [sender "<cmds>"][receiver "<cmds>"][profile][debug <level>]
+//
+// Link "rate" is bits/sec (0 for unlimited), "delay" is seconds and "loss"
+// is percent.  The "link" parameters apply to every node's uplink and
+// downlink, "uplink" overrides the sender uplink (e.g., a bottleneck), and
+// "rxlink" overrides the downlinks of a range of receivers (numbered from 1).
+// The "sender" and "receiver" strings are NormSimAgent commands, e.g.:
+//
+//  normVnet receivers 1000 duration 60 link 10000000,0.050,1
+//           sender "address 224.1.2.3/5000 rate 1000000 sendFile 1000000 start sender"
+//           receiver "address 224.1.2.3/5000 start receiver"
+//
+// The sender is NormNodeId 1 and the receivers are NormNodeIds 2, 3, ...
+
+#include "vnetNormAgent.h"
+
+#include <stdio.h>
+#include <stdlib.h>  // for atoi(), atof(), srand()
+#include <string.h>
+#include <sys/time.h>  // for gettimeofday()
+
+// Splits "cmdString" into "argv" (argv[0] is set to "normVnet") and returns
+// argc or -1 if there are too many tokens.  Modifies "cmdString" in place.
+static int TokenizeCommands(char* cmdString, const char** argv, int argMax)
+{
+    int argc = 0;
+    argv[argc++] = "normVnet";
+    char* ptr = strtok(cmdString, " \t\r\n");
+    while (NULL != ptr)
+    {
+        if (argc >= argMax) return -1;
+        argv[argc++] = ptr;
+        ptr = strtok(NULL, " \t\r\n");
+    }
+    return argc;
+}  // end TokenizeCommands()
+
+// Parses "<rate>,<delay>,<loss>"
+static bool ParseLink(const char* text, double& rate, double& delay, double& loss)
+{
+    return (3 == sscanf(text, "%lf,%lf,%lf", &rate, &delay, &loss)) &&
+           (rate >= 0.0) && (delay >= 0.0) && (loss >= 0.0) && (loss <= 100.0);
+}  // end ParseLink()
+
+static double WallClockTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return ((double)tv.tv_sec + 1.0e-06*(double)tv.tv_usec);
+}  // end WallClockTime()
+
+static void Usage()
+{
+    fprintf(stderr, "Usage: normVnet [receivers <n>][duration <sec>][seed <value>]\n"
+                    "                [link <rate>,<delay>,<loss>][uplink <rate>,<delay>,<loss>]\n"
+                    "                [rxlink <first>-<last>,<rate>,<delay>,<loss>][queue <bytes>]\n"
+                    "                [sender \"<cmds>\"][receiver \"<cmds>\"][profile][debug <level>]\n");
+}  // end Usage()
+
+int main(int argc, char* argv[])
+{
+    enum {RXLINK_MAX = 16, ARG_MAX = 64};
+    unsigned int numReceivers = 100;
+    double duration = 60.0;
+    UINT32 seed = 1;
+    double linkRate = 0.0, linkDelay = 0.001, linkLoss = 0.0;
+    bool uplinkSet = false;
+    double uplinkRate = 0.0, uplinkDelay = 0.0, uplinkLoss = 0.0;
+    struct RxLink
+    {
+        unsigned int first, last;
+        double       rate, delay, loss;
+    } rxLinkList[RXLINK_MAX];
+    unsigned int rxLinkCount = 0;
+    unsigned int queueMax = 64000;
+    const char* senderCmds = NULL;
+    const char* receiverCmds = NULL;
+    bool profile = false;
+    
+    for (int i = 1; i < argc; i++)
+    {
+        const char* cmd = argv[i];
+        if (!strcmp(cmd, "profile"))
+        {
+            profile = true;
+            continue;
+        }
+        if ((i + 1) >= argc)
+        {
+            fprintf(stderr, "normVnet: missing or invalid \"%s\" argument\n", cmd);
+            Usage();
+            return -1;
+        }
+        const char* val = argv[++i];
+        bool valid = true;
+        if (!strcmp(cmd, "receivers"))
+        {
+            int value = atoi(val);
+            valid = (value > 0);
+            numReceivers = (unsigned int)value;
+        }
+        else if (!strcmp(cmd, "duration"))
+        {
+            duration = atof(val);
+            valid = (duration > 0.0);
+        }
+        else if (!strcmp(cmd, "seed"))
+        {
+            seed = (UINT32)strtoul(val, NULL, 0);
+        }
+        else if (!strcmp(cmd, "link"))
+        {
+            valid = ParseLink(val, linkRate, linkDelay, linkLoss);
+        }
+        else if (!strcmp(cmd, "uplink"))
+        {
+            valid = ParseLink(val, uplinkRate, uplinkDelay, uplinkLoss);
+            uplinkSet = true;
+        }
+        else if (!strcmp(cmd, "rxlink"))
+        {
+            if (rxLinkCount < RXLINK_MAX)
+            {
+                RxLink& link = rxLinkList[rxLinkCount];
+                valid = (5 == sscanf(val, "%u-%u,%lf,%lf,%lf", &link.first, &link.last,
+                                     &link.rate, &link.delay, &link.loss)) &&
+                        (link.first > 0) && (link.first <= link.last) &&
+                        (link.rate >= 0.0) && (link.delay >= 0.0) &&
+                        (link.loss >= 0.0) && (link.loss <= 100.0);
+                rxLinkCount++;
+            }
+            else
+            {
+                fprintf(stderr, "normVnet: too many \"rxlink\" options (max %d)\n", RXLINK_MAX);
+                valid = false;
+            }
+        }
+        else if (!strcmp(cmd, "queue"))
+        {
+            int value = atoi(val);
+            valid = (value > 0);
+            queueMax = (unsigned int)value;
+        }
+        else if (!strcmp(cmd, "sender"))
+        {
+            senderCmds = val;
+        }
+        else if (!strcmp(cmd, "receiver"))
+        {
+            receiverCmds = val;
+        }
+        else if (!strcmp(cmd, "debug"))
+        {
+            SetDebugLevel(atoi(val));
+        }
+        else
+        {
+            fprintf(stderr, "normVnet: invalid command \"%s\"\n", cmd);
+            Usage();
+            return -1;
+        }
+        if (!valid)
+        {
+            fprintf(stderr, "normVnet: invalid \"%s\" value \"%s\"\n", cmd, val);
+            Usage();
+            return -1;
+        }
+    }
+    if ((NULL == senderCmds) || (NULL == receiverCmds))
+    {
+        fprintf(stderr, "normVnet: \"sender\" and \"receiver\" commands must be given\n");
+        Usage();
+        return -1;
+    }
+    
+    // (NormSimAgent and NORM itself use rand() so seed it too for repeatability)
+    srand(seed);
+    VnetNetwork network;
+    if (!network.Init(numReceivers + 1, seed))
+    {
+        fprintf(stderr, "normVnet: network initialization error\n");
+        return -1;
+    }
+    network.MakeCurrent();
+    network.SetProfiling(profile);
+    
+    // Create the agents (index 0 is the sender)
+    VnetNormAgent** agentList = new VnetNormAgent*[numReceivers + 1];
+    if (NULL == agentList)
+    {
+        perror("normVnet: new agentList error");
+        return -1;
+    }
+    memset(agentList, 0, (numReceivers + 1) * sizeof(VnetNormAgent*));
+    bool success = true;
+    for (unsigned int i = 0; i <= numReceivers; i++)
+    {
+        if (NULL == (agentList[i] = new VnetNormAgent(network)))
+        {
+            perror("normVnet: new VnetNormAgent error");
+            success = false;
+            break;
+        }
+        agentList[i]->AccessUplink().SetParameters(linkRate, linkDelay, linkLoss, queueMax);
+        agentList[i]->AccessDownlink().SetParameters(linkRate, linkDelay, linkLoss, queueMax);
+    }
+    if (success && uplinkSet)
+        agentList[0]->AccessUplink().SetParameters(uplinkRate, uplinkDelay, uplinkLoss, queueMax);
+    for (unsigned int j = 0; success && (j < rxLinkCount); j++)
+    {
+        const RxLink& link = rxLinkList[j];
+        unsigned int last = (link.last < numReceivers) ? link.last : numReceivers;
+        for (unsigned int i = link.first; i <= last; i++)
+            agentList[i]->AccessDownlink().SetParameters(link.rate, link.delay, link.loss, queueMax);
+    }
+    
+    // Start the receivers first so they are listening when the sender begins
+    for (unsigned int i = 1; success && (i <= numReceivers); i++)
+    {
+        char cmdBuffer[1024];
+        strncpy(cmdBuffer, receiverCmds, 1023);
+        cmdBuffer[1023] = '\0';
+        const char* cmdArgv[ARG_MAX];
+        int cmdArgc = TokenizeCommands(cmdBuffer, cmdArgv, ARG_MAX);
+        if ((cmdArgc < 0) || !agentList[i]->ProcessCommands(cmdArgc, cmdArgv))
+        {
+            fprintf(stderr, "normVnet: receiver commands error\n");
+            success = false;
+        }
+    }
+    if (success)
+    {
+        char cmdBuffer[1024];
+        strncpy(cmdBuffer, senderCmds, 1023);
+        cmdBuffer[1023] = '\0';
+        const char* cmdArgv[ARG_MAX];
+        int cmdArgc = TokenizeCommands(cmdBuffer, cmdArgv, ARG_MAX);
+        if ((cmdArgc < 0) || !agentList[0]->ProcessCommands(cmdArgc, cmdArgv))
+        {
+            fprintf(stderr, "normVnet: sender commands error\n");
+            success = false;
+        }
+    }
+    
+    if (success)
+    {
+        double wallStart = WallClockTime();
+        network.Run(duration);
+        double wallTime = WallClockTime() - wallStart;
+        double simTime = network.GetCurrentTime();
+        
+        fprintf(stdout, "normVnet: receivers:%u simulated:%.3lf sec wall:%.3lf sec (speedup %.2lf)\n",
+                numReceivers, simTime, wallTime, (wallTime > 0.0) ? (simTime / wallTime) : 0.0);
+        fprintf(stdout, "normVnet: events:%lu (%.0lf events/sec) packets:%lu\n",
+                network.GetEventCount(), 
+                (wallTime > 0.0) ? ((double)network.GetEventCount() / wallTime) : 0.0,
+                network.GetPacketCount());
+        fprintf(stdout, "normVnet: messages info:%lu data:%lu cmd:%lu nack:%lu ack:%lu report:%lu\n",
+                network.GetTypeCount(NormMsg::INFO), network.GetTypeCount(NormMsg::DATA),
+                network.GetTypeCount(NormMsg::CMD), network.GetTypeCount(NormMsg::NACK),
+                network.GetTypeCount(NormMsg::ACK), network.GetTypeCount(NormMsg::REPORT));
+        unsigned long lossCount = 0;
+        unsigned long dropCount = 0;
+        for (unsigned int i = 0; i <= numReceivers; i++)
+        {
+            lossCount += agentList[i]->AccessUplink().GetLossCount() + 
+                         agentList[i]->AccessDownlink().GetLossCount();
+            dropCount += agentList[i]->AccessUplink().GetQueueDropCount() + 
+                         agentList[i]->AccessDownlink().GetQueueDropCount();
+        }
+        fprintf(stdout, "normVnet: sender uplink packets:%lu losses:%lu drops:%lu (all links losses:%lu drops:%lu)\n",
+                agentList[0]->AccessUplink().GetPacketCount(),
+                agentList[0]->AccessUplink().GetLossCount(),
+                agentList[0]->AccessUplink().GetQueueDropCount(),
+                lossCount, dropCount);
+        if (profile)
+        {
+            double rxCpuTotal = 0.0;
+            double rxCpuMax = 0.0;
+            for (unsigned int i = 1; i <= numReceivers; i++)
+            {
+                double cpuTime = agentList[i]->GetCpuTime();
+                rxCpuTotal += cpuTime;
+                if (cpuTime > rxCpuMax) rxCpuMax = cpuTime;
+            }
+            fprintf(stdout, "normVnet: cpu sender:%.3lf sec (%lu events) receivers total:%.3lf sec "
+                            "mean:%.6lf sec max:%.6lf sec\n",
+                    agentList[0]->GetCpuTime(), agentList[0]->GetEventCount(),
+                    rxCpuTotal, rxCpuTotal / (double)numReceivers, rxCpuMax);
+        }
+    }
+    
+    for (unsigned int i = 0; i <= numReceivers; i++)
+    {
+        if (NULL != agentList[i])
+        {
+            agentList[i]->OnShutdown();
+            delete agentList[i];
+        }
+    }
+    delete[] agentList;
+    network.Destroy();
+    return (success ? 0 : -1);
+}  // end main()
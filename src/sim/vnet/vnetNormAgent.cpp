@@ -0,0 +1,58 @@
+#include "vnetNormAgent.h" 
+
+VnetNormAgent::VnetNormAgent(VnetNetwork& theNetwork)
+  : VnetProtoSimAgent(theNetwork), NormSimAgent(GetTimerMgr(), GetSocketNotifier())
+{
+ 
+}  
+
+VnetNormAgent::~VnetNormAgent()
+{    
+}
+
+void VnetNormAgent::OnShutdown()
+{
+    NormSimAgent::Stop(); 
+}  // end VnetNormAgent::OnShutdown()
+
+bool VnetNormAgent::ProcessCommands(int argc, const char*const* argv) 
+{   
+    int i = 1;
+    while (i < argc)
+    {
+        NormSimAgent::CmdType cmdType = CommandType(argv[i]);
+        switch (cmdType)
+        {
+            case NormSimAgent::CMD_NOARG:
+                if (!ProcessCommand(argv[i], NULL))
+                {
+                    PLOG(PL_FATAL, "VnetNormAgent::ProcessCommands() ProcessCommand(%s) error\n", 
+                            argv[i]);
+                    return false;
+                }
+                i++;
+                break;
+                
+            case NormSimAgent::CMD_ARG:
+                if ((i + 1) >= argc)
+                {
+                    PLOG(PL_FATAL, "VnetNormAgent::ProcessCommands() ProcessCommand(%s) missing argument\n", 
+                            argv[i]);
+                    return false;
+                }
+                if (!ProcessCommand(argv[i], argv[i+1]))
+                {
+                    PLOG(PL_FATAL, "VnetNormAgent::ProcessCommands() ProcessCommand(%s, %s) error\n", 
+                            argv[i], argv[i+1]);
+                    return false;
+                }
+                i += 2;
+                break;
+                
+            case NormSimAgent::CMD_INVALID:
+                PLOG(PL_FATAL, "VnetNormAgent::ProcessCommands() invalid command: %s\n", argv[i]);
+                return false;
+        }
+    }
+    return true; 
+}  // end VnetNormAgent::ProcessCommands()
@@ -0,0 +1,32 @@
+#ifndef _VNET_NORM_AGENT
+#define _VNET_NORM_AGENT
+
+#include "vnetProtoSimAgent.h"
+#include "normSimAgent.h"
+
+// The "VnetNormAgent" is a NormSimAgent attached to a VnetNetwork
+// "virtual network" (a node with one NORM session)
+
+// IMPORTANT NOTE! VnetProtoSimAgent must be listed _first_ here
+// (so it is constructed before the NormSimAgent uses its timer
+//  manager and socket notifier)
+class VnetNormAgent : public VnetProtoSimAgent, public NormSimAgent
+{
+  public:
+    VnetNormAgent(VnetNetwork& theNetwork);
+    ~VnetNormAgent();
+    
+    // Processes NormSimAgent commands (e.g., "address 224.1.2.3/5000 start receiver")
+    bool ProcessCommands(int argc, const char*const* argv);
+    void OnShutdown();
+
+    // NormSimAgent overrides (NormNodeIds are 1, 2, 3, ...)
+    unsigned long GetAgentId() {return (unsigned long)(GetIndex() + 1);} 
+    bool HandleMessage(const char* txBuffer, unsigned int len, const ProtoAddress& srcAddr)
+    {
+        return NormSimAgent::SendMessage(len,txBuffer);
+    }
+
+};  // end class VnetNormAgent
+
+#endif // _VNET_NORM_AGENT
@@ -0,0 +1,631 @@
+#include "vnetProtoSimAgent.h"
+
+#include <string.h>  // for memcpy()
+#include <time.h>    // for clock_gettime()
+
+// The virtual clock starts at this (arbitrary, nonzero) system time
+// so that simulation timestamps are never mistaken for "unset" times
+static const double VNET_EPOCH = 1.0e+06;
+
+// For SIMULATE builds, the current VnetNetwork provides the system time
+void ProtoSystemTime(struct timeval& theTime)
+{
+    VnetNetwork* network = VnetNetwork::GetCurrent();
+    double now = VNET_EPOCH + ((NULL != network) ? network->GetCurrentTime() : 0.0);
+    theTime.tv_sec = (unsigned long)now;
+    theTime.tv_usec = (unsigned long)(1.0e+06 * (now - (double)theTime.tv_sec));
+}  // end ProtoSystemTime()
+
+// Processor (not virtual) time used by this thread, for profiling
+static double VnetThreadCpuTime()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    struct timespec ts;
+    if (0 == clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts))
+        return ((double)ts.tv_sec + 1.0e-09 * (double)ts.tv_nsec);
+#endif // CLOCK_THREAD_CPUTIME_ID
+    return ((double)clock() / (double)CLOCKS_PER_SEC);
+}  // end VnetThreadCpuTime()
+
+VnetPacket::VnetPacket()
+ : ref_count(1), buffer(NULL), length(0)
+{
+}
+
+VnetPacket::~VnetPacket()
+{
+    if (NULL != buffer) delete[] buffer;
+}
+
+VnetPacket* VnetPacket::Create(const char*         buffer,
+                               unsigned int        numBytes,
+                               const ProtoAddress& srcAddr,
+                               const ProtoAddress& dstAddr)
+{
+    VnetPacket* packet = new VnetPacket();
+    if (NULL == packet)
+    {
+        PLOG(PL_ERROR, "VnetPacket::Create() new packet error: %s\n", GetErrorString());
+        return NULL;
+    }
+    if ((0 != numBytes) && (NULL == (packet->buffer = new char[numBytes])))
+    {
+        PLOG(PL_ERROR, "VnetPacket::Create() new buffer error: %s\n", GetErrorString());
+        delete packet;
+        return NULL;
+    }
+    if (0 != numBytes) memcpy(packet->buffer, buffer, numBytes);
+    packet->length = numBytes;
+    packet->src_addr = srcAddr;
+    packet->dst_addr = dstAddr;
+    return packet;
+}  // end VnetPacket::Create()
+
+VnetLink::VnetLink()
+ : tx_rate(0.0), prop_delay(0.0), loss_percent(0.0), queue_max(0),
+   busy_until(0.0), pkt_count(0), loss_count(0), drop_count(0)
+{
+}
+
+bool VnetLink::Transmit(VnetNetwork&  network,
+                        unsigned int  numBytes,
+                        double&       arrivalTime)
+{
+    double currentTime = network.GetCurrentTime();
+    pkt_count++;
+    if (busy_until < currentTime) busy_until = currentTime;
+    if (tx_rate > 0.0)
+    {
+        // Tail drop if the packet doesn't fit in the queue
+        if (0 != queue_max)
+        {
+            double queueBytes = (busy_until - currentTime) * tx_rate / 8.0;
+            if ((queueBytes + (double)numBytes) > (double)queue_max)
+            {
+                drop_count++;
+                return false;
+            }
+        }
+        busy_until += 8.0 * (double)numBytes / tx_rate;
+    }
+    // (lost packets still occupy the link)
+    if ((loss_percent > 0.0) && ((100.0 * network.UniformRand()) < loss_percent))
+    {
+        loss_count++;
+        return false;
+    }
+    arrivalTime = busy_until + prop_delay;
+    return true;
+}  // end VnetLink::Transmit()
+
+VnetProtoSimAgent::VnetProtoSimAgent(VnetNetwork& theNetwork)
+ : network(theNetwork), agent_index(0), timer_seq(0), next_port(32768),
+   proxy_list(NULL), cpu_time(0.0), event_count(0)
+{
+    if (!network.Attach(*this))
+        PLOG(PL_FATAL, "VnetProtoSimAgent::VnetProtoSimAgent() error: network is full\n");
+}
+
+VnetProtoSimAgent::~VnetProtoSimAgent()
+{
+    while (NULL != proxy_list)
+    {
+        VnetSocketProxy* proxy = proxy_list;
+        proxy_list = proxy->next;
+        delete proxy;
+    }
+    network.Detach(*this);
+}
+
+bool VnetProtoSimAgent::GetLocalAddress(ProtoAddress& localAddr)
+{
+    localAddr = agent_addr;
+    return agent_addr.IsValid();
+}  // end VnetProtoSimAgent::GetLocalAddress()
+
+ProtoSimAgent::SocketProxy* VnetProtoSimAgent::OpenSocket(ProtoSocket& theSocket)
+{
+    VnetSocketProxy* proxy = new VnetSocketProxy(*this, theSocket);
+    if (NULL == proxy)
+    {
+        PLOG(PL_ERROR, "VnetProtoSimAgent::OpenSocket() new proxy error: %s\n", GetErrorString());
+        return NULL;
+    }
+    proxy->prev = NULL;
+    proxy->next = proxy_list;
+    if (NULL != proxy_list) proxy_list->prev = proxy;
+    proxy_list = proxy;
+    return proxy;
+}  // end VnetProtoSimAgent::OpenSocket()
+
+void VnetProtoSimAgent::CloseSocket(ProtoSocket& theSocket)
+{
+    VnetSocketProxy* proxy = proxy_list;
+    while (NULL != proxy)
+    {
+        if (&proxy->socket == &theSocket)
+        {
+            if (NULL != proxy->prev)
+                proxy->prev->next = proxy->next;
+            else
+                proxy_list = proxy->next;
+            if (NULL != proxy->next) proxy->next->prev = proxy->prev;
+            delete proxy;
+            return;
+        }
+        proxy = proxy->next;
+    }
+}  // end VnetProtoSimAgent::CloseSocket()
+
+bool VnetProtoSimAgent::UpdateSystemTimer(ProtoTimer::Command command,
+                                          double              delay)
+{
+    // Any previously scheduled timer event becomes stale
+    timer_seq++;
+    if (ProtoTimer::REMOVE == command) return true;
+    if (delay < 0.0) delay = 0.0;
+    return network.ScheduleEvent(network.GetCurrentTime() + delay, VnetNetwork::Event::TIMER,
+                                 this, timer_seq, NULL);
+}  // end VnetProtoSimAgent::UpdateSystemTimer()
+
+void VnetProtoSimAgent::OnTimerEvent(UINT32 timerSeq)
+{
+    if (timerSeq == timer_seq) OnSystemTimeout();
+}  // end VnetProtoSimAgent::OnTimerEvent()
+
+bool VnetProtoSimAgent::IsMember(const ProtoAddress& groupAddr, UINT16 port) const
+{
+    for (VnetSocketProxy* proxy = proxy_list; NULL != proxy; proxy = proxy->next)
+    {
+        if ((port == proxy->port) && proxy->IsMember(groupAddr)) return true;
+    }
+    return false;
+}  // end VnetProtoSimAgent::IsMember()
+
+void VnetProtoSimAgent::Deliver(VnetPacket& packet)
+{
+    const ProtoAddress& dstAddr = packet.GetDstAddr();
+    const ProtoAddress& srcAddr = packet.GetSrcAddr();
+    UINT16 dstPort = dstAddr.GetPort();
+    bool multicast = dstAddr.IsMulticast();
+    // (like sockets with port reuse, all matching sockets get a copy)
+    VnetSocketProxy* proxy = proxy_list;
+    while (NULL != proxy)
+    {
+        VnetSocketProxy* nextProxy = proxy->next;  // (in case socket is closed upon input)
+        if ((dstPort == proxy->port) &&
+            (!multicast || proxy->IsMember(dstAddr)) &&
+            (!proxy->connect_addr.IsValid() ||
+             (proxy->connect_addr.HostIsEqual(srcAddr) &&
+              (proxy->connect_addr.GetPort() == srcAddr.GetPort()))))
+        {
+            proxy->Enqueue(packet);
+        }
+        proxy = nextProxy;
+    }
+}  // end VnetProtoSimAgent::Deliver()
+
+VnetProtoSimAgent::VnetSocketProxy::VnetSocketProxy(VnetProtoSimAgent& theAgent,
+                                                    ProtoSocket&       theSocket)
+ : agent(theAgent), socket(theSocket), port(0), group_count(0), mcast_loopback(false),
+   rx_head(NULL), rx_tail(NULL), rx_queue_count(0), rx_queue_max(1024), rx_drop_count(0),
+   prev(NULL), next(NULL)
+{
+}
+
+VnetProtoSimAgent::VnetSocketProxy::~VnetSocketProxy()
+{
+    while (NULL != rx_head)
+    {
+        RxItem* item = rx_head;
+        rx_head = item->next;
+        item->packet->Release();
+        delete item;
+    }
+}
+
+bool VnetProtoSimAgent::VnetSocketProxy::Bind(UINT16& thePort)
+{
+    if (0 == thePort) thePort = agent.next_port++;
+    port = thePort;
+    return true;
+}  // end VnetProtoSimAgent::VnetSocketProxy::Bind()
+
+bool VnetProtoSimAgent::VnetSocketProxy::Connect(const ProtoAddress& theAddress)
+{
+    connect_addr = theAddress;
+    return true;
+}  // end VnetProtoSimAgent::VnetSocketProxy::Connect()
+
+bool VnetProtoSimAgent::VnetSocketProxy::SendTo(const char*         buffer,
+                                                unsigned int&       numBytes,
+                                                const ProtoAddress& dstAddr)
+{
+    if (0 == port)
+    {
+        UINT16 thePort = 0;
+        Bind(thePort);
+    }
+    ProtoAddress srcAddr = agent.agent_addr;
+    srcAddr.SetPort(port);
+    agent.network.SendPacket(agent, buffer, numBytes, srcAddr, dstAddr, mcast_loopback);
+    return true;
+}  // end VnetProtoSimAgent::VnetSocketProxy::SendTo()
+
+bool VnetProtoSimAgent::VnetSocketProxy::RecvFrom(char*             buffer,
+                                                  unsigned int&     numBytes,
+                                                  ProtoAddress&     srcAddr)
+{
+    ProtoAddress dstAddr;
+    return RecvFrom(buffer, numBytes, srcAddr, dstAddr);
+}  // end VnetProtoSimAgent::VnetSocketProxy::RecvFrom()
+
+bool VnetProtoSimAgent::VnetSocketProxy::RecvFrom(char*             buffer,
+                                                  unsigned int&     numBytes,
+                                                  ProtoAddress&     srcAddr,
+                                                  ProtoAddress&     dstAddr)
+{
+    RxItem* item = rx_head;
+    if (NULL == item)
+    {
+        numBytes = 0;  // nothing to read (as for a non-blocking socket)
+        return true;
+    }
+    if (NULL == (rx_head = item->next)) rx_tail = NULL;
+    rx_queue_count--;
+    VnetPacket* packet = item->packet;
+    delete item;
+    if (packet->GetLength() < numBytes) numBytes = packet->GetLength();
+    memcpy(buffer, packet->GetBuffer(), numBytes);
+    srcAddr = packet->GetSrcAddr();
+    dstAddr = packet->GetDstAddr();
+    packet->Release();
+    return true;
+}  // end VnetProtoSimAgent::VnetSocketProxy::RecvFrom()
+
+bool VnetProtoSimAgent::VnetSocketProxy::JoinGroup(const ProtoAddress& groupAddr)
+{
+    if (IsMember(groupAddr)) return true;
+    if (group_count >= GROUP_MAX)
+    {
+        PLOG(PL_ERROR, "VnetSocketProxy::JoinGroup() error: too many groups\n");
+        return false;
+    }
+    group_list[group_count++] = groupAddr;
+    return true;
+}  // end VnetProtoSimAgent::VnetSocketProxy::JoinGroup()
+
+bool VnetProtoSimAgent::VnetSocketProxy::LeaveGroup(const ProtoAddress& groupAddr)
+{
+    for (unsigned int i = 0; i < group_count; i++)
+    {
+        if (group_list[i].HostIsEqual(groupAddr))
+        {
+            group_list[i] = group_list[--group_count];
+            return true;
+        }
+    }
+    return false;
+}  // end VnetProtoSimAgent::VnetSocketProxy::LeaveGroup()
+
+bool VnetProtoSimAgent::VnetSocketProxy::SetRxBufferSize(unsigned int bufferSize)
+{
+    // (the queue limit is in packets, assuming MTU-sized packets)
+    rx_queue_max = (bufferSize > 1500) ? (bufferSize / 1500) : 1;
+    return true;
+}  // end VnetProtoSimAgent::VnetSocketProxy::SetRxBufferSize()
+
+bool VnetProtoSimAgent::VnetSocketProxy::IsMember(const ProtoAddress& groupAddr) const
+{
+    for (unsigned int i = 0; i < group_count; i++)
+    {
+        if (group_list[i].HostIsEqual(groupAddr)) return true;
+    }
+    return false;
+}  // end VnetProtoSimAgent::VnetSocketProxy::IsMember()
+
+void VnetProtoSimAgent::VnetSocketProxy::Enqueue(VnetPacket& packet)
+{
+    if (rx_queue_count >= rx_queue_max)
+    {
+        rx_drop_count++;  // socket buffer overflow
+        return;
+    }
+    RxItem* item = new RxItem;
+    if (NULL == item)
+    {
+        PLOG(PL_ERROR, "VnetSocketProxy::Enqueue() new item error: %s\n", GetErrorString());
+        rx_drop_count++;
+        return;
+    }
+    packet.Retain();
+    item->packet = &packet;
+    item->next = NULL;
+    if (NULL != rx_tail)
+        rx_tail->next = item;
+    else
+        rx_head = item;
+    rx_tail = item;
+    rx_queue_count++;
+    socket.OnNotify(ProtoSocket::NOTIFY_INPUT);
+}  // end VnetProtoSimAgent::VnetSocketProxy::Enqueue()
+
+VnetNetwork* VnetNetwork::current_network = NULL;
+
+VnetNetwork::VnetNetwork()
+ : current_time(0.0), rand_state(1), profiling(false),
+   agent_list(NULL), agent_count(0), agent_max(0),
+   event_heap(NULL), event_count(0), event_max(0), event_seq(0),
+   event_total(0), packet_total(0)
+{
+    memset(type_count, 0, sizeof(type_count));
+}
+
+VnetNetwork::~VnetNetwork()
+{
+    Destroy();
+}
+
+bool VnetNetwork::Init(unsigned int agentMax, UINT32 randomSeed)
+{
+    Destroy();
+    if (NULL == (agent_list = new VnetProtoSimAgent*[agentMax]))
+    {
+        PLOG(PL_FATAL, "VnetNetwork::Init() new agent_list error: %s\n", GetErrorString());
+        return false;
+    }
+    agent_max = agentMax;
+    agent_count = 0;
+    if (NULL == (event_heap = new Event*[1024]))
+    {
+        PLOG(PL_FATAL, "VnetNetwork::Init() new event_heap error: %s\n", GetErrorString());
+        Destroy();
+        return false;
+    }
+    event_max = 1024;
+    event_count = 0;
+    // (xorshift state must be nonzero)
+    rand_state = (0 != randomSeed) ? (UINT64)randomSeed : (UINT64)1;
+    current_time = 0.0;
+    return true;
+}  // end VnetNetwork::Init()
+
+void VnetNetwork::Destroy()
+{
+    if (NULL != event_heap)
+    {
+        for (unsigned int i = 0; i < event_count; i++)
+        {
+            if (NULL != event_heap[i]->packet) event_heap[i]->packet->Release();
+            delete event_heap[i];
+        }
+        delete[] event_heap;
+        event_heap = NULL;
+    }
+    event_count = event_max = 0;
+    if (NULL != agent_list)
+    {
+        delete[] agent_list;
+        agent_list = NULL;
+    }
+    agent_count = agent_max = 0;
+    if (this == current_network) current_network = NULL;
+}  // end VnetNetwork::Destroy()
+
+double VnetNetwork::UniformRand()
+{
+    // xorshift64* generator
+    rand_state ^= rand_state >> 12;
+    rand_state ^= rand_state << 25;
+    rand_state ^= rand_state >> 27;
+    UINT64 value = rand_state * (UINT64)0x2545F4914F6CDD1DULL;
+    return ((double)(value >> 11) * (1.0 / 9007199254740992.0));
+}  // end VnetNetwork::UniformRand()
+
+bool VnetNetwork::Attach(VnetProtoSimAgent& agent)
+{
+    if (agent_count >= agent_max) return false;
+    agent.agent_index = agent_count;
+    // Agents get addresses 10.0.0.1, 10.0.0.2, etc
+    unsigned int hostId = agent_count + 1;
+    char addr[4];
+    addr[0] = 10;
+    addr[1] = (char)(hostId >> 16);
+    addr[2] = (char)(hostId >> 8);
+    addr[3] = (char)hostId;
+    agent.agent_addr.SetRawHostAddress(ProtoAddress::IPv4, addr, 4);
+    agent_list[agent_count++] = &agent;
+    return true;
+}  // end VnetNetwork::Attach()
+
+void VnetNetwork::Detach(VnetProtoSimAgent& agent)
+{
+    if ((agent.agent_index < agent_count) && (&agent == agent_list[agent.agent_index]))
+        agent_list[agent.agent_index] = NULL;
+    // Pending events for the agent are discarded when dispatched
+    for (unsigned int i = 0; i < event_count; i++)
+    {
+        if (&agent == event_heap[i]->agent) event_heap[i]->agent = NULL;
+    }
+}  // end VnetNetwork::Detach()
+
+VnetProtoSimAgent* VnetNetwork::FindAgent(const ProtoAddress& addr) const
+{
+    if ((ProtoAddress::IPv4 != addr.GetType()) || (10 != (UINT8)addr.GetRawHostAddress()[0]))
+        return NULL;
+    const UINT8* ptr = (const UINT8*)addr.GetRawHostAddress();
+    unsigned int hostId = ((unsigned int)ptr[1] << 16) | ((unsigned int)ptr[2] << 8) | ptr[3];
+    if ((0 == hostId) || (hostId > agent_count)) return NULL;
+    return agent_list[hostId - 1];
+}  // end VnetNetwork::FindAgent()
+
+bool VnetNetwork::ScheduleEvent(double              time,
+                                Event::Type         type,
+                                VnetProtoSimAgent*  agent,
+                                UINT32              timerSeq,
+                                VnetPacket*         packet)
+{
+    if (event_count >= event_max)
+    {
+        unsigned int newMax = 2 * event_max;
+        Event** newHeap = new Event*[newMax];
+        if (NULL == newHeap)
+        {
+            PLOG(PL_ERROR, "VnetNetwork::ScheduleEvent() new event_heap error: %s\n", GetErrorString());
+            return false;
+        }
+        memcpy(newHeap, event_heap, event_count * sizeof(Event*));
+        delete[] event_heap;
+        event_heap = newHeap;
+        event_max = newMax;
+    }
+    Event* theEvent = new Event;
+    if (NULL == theEvent)
+    {
+        PLOG(PL_ERROR, "VnetNetwork::ScheduleEvent() new event error: %s\n", GetErrorString());
+        return false;
+    }
+    theEvent->time = time;
+    theEvent->seq = event_seq++;
+    theEvent->type = type;
+    theEvent->agent = agent;
+    theEvent->timer_seq = timerSeq;
+    theEvent->packet = packet;
+    // Sift up
+    unsigned int index = event_count++;
+    while (index > 0)
+    {
+        unsigned int parent = (index - 1) >> 1;
+        Event* p = event_heap[parent];
+        if ((p->time < time) || ((p->time == time) && (p->seq < theEvent->seq))) break;
+        event_heap[index] = p;
+        index = parent;
+    }
+    event_heap[index] = theEvent;
+    return true;
+}  // end VnetNetwork::ScheduleEvent()
+
+VnetNetwork::Event* VnetNetwork::PopEvent()
+{
+    if (0 == event_count) return NULL;
+    Event* top = event_heap[0];
+    Event* last = event_heap[--event_count];
+    // Sift down
+    unsigned int index = 0;
+    while (true)
+    {
+        unsigned int child = 2*index + 1;
+        if (child >= event_count) break;
+        if ((child + 1) < event_count)
+        {
+            Event* a = event_heap[child];
+            Event* b = event_heap[child + 1];
+            if ((b->time < a->time) || ((b->time == a->time) && (b->seq < a->seq))) child++;
+        }
+        Event* c = event_heap[child];
+        if ((last->time < c->time) || ((last->time == c->time) && (last->seq < c->seq))) break;
+        event_heap[index] = c;
+        index = child;
+    }
+    if (event_count > 0) event_heap[index] = last;
+    return top;
+}  // end VnetNetwork::PopEvent()
+
+void VnetNetwork::SendPacket(VnetProtoSimAgent&      srcAgent,
+                             const char*             buffer,
+                             unsigned int            numBytes,
+                             const ProtoAddress&     srcAddr,
+                             const ProtoAddress&     dstAddr,
+                             bool                    loopback)
+{
+    packet_total++;
+    if (0 != numBytes) type_count[buffer[0] & 0x0f]++;
+    VnetPacket* packet = VnetPacket::Create(buffer, numBytes, srcAddr, dstAddr);
+    if (NULL == packet) return;
+    bool multicast = dstAddr.IsMulticast();
+    if (multicast ? loopback : dstAddr.HostIsEqual(srcAgent.agent_addr))
+    {
+        // Local delivery doesn't use the network links
+        packet->Retain();
+        if (!ScheduleEvent(current_time, Event::DELIVER, &srcAgent, 0, packet))
+            packet->Release();
+    }
+    double arrivalTime;
+    if ((multicast || !dstAddr.HostIsEqual(srcAgent.agent_addr)) &&
+        srcAgent.up_link.Transmit(*this, numBytes, arrivalTime))
+    {
+        packet->Retain();
+        if (!ScheduleEvent(arrivalTime, Event::HUB, &srcAgent, 0, packet))
+            packet->Release();
+    }
+    packet->Release();
+}  // end VnetNetwork::SendPacket()
+
+void VnetNetwork::OnHubEvent(VnetPacket& packet, VnetProtoSimAgent* srcAgent)
+{
+    const ProtoAddress& dstAddr = packet.GetDstAddr();
+    double arrivalTime;
+    if (dstAddr.IsMulticast())
+    {
+        // Replicate to group members (other than the source)
+        UINT16 dstPort = dstAddr.GetPort();
+        for (unsigned int i = 0; i < agent_count; i++)
+        {
+            VnetProtoSimAgent* agent = agent_list[i];
+            if ((NULL == agent) || (agent == srcAgent) || !agent->IsMember(dstAddr, dstPort))
+                continue;
+            if (agent->down_link.Transmit(*this, packet.GetLength(), arrivalTime))
+            {
+                packet.Retain();
+                if (!ScheduleEvent(arrivalTime, Event::DELIVER, agent, 0, &packet))
+                    packet.Release();
+            }
+        }
+    }
+    else
+    {
+        VnetProtoSimAgent* agent = FindAgent(dstAddr);
+        if ((NULL != agent) && agent->down_link.Transmit(*this, packet.GetLength(), arrivalTime))
+        {
+            packet.Retain();
+            if (!ScheduleEvent(arrivalTime, Event::DELIVER, agent, 0, &packet))
+                packet.Release();
+        }
+    }
+}  // end VnetNetwork::OnHubEvent()
+
+void VnetNetwork::Run(double stopTime)
+{
+    MakeCurrent();
+    while ((event_count > 0) && (event_heap[0]->time <= stopTime))
+    {
+        Event* theEvent = PopEvent();
+        if (theEvent->time > current_time) current_time = theEvent->time;
+        event_total++;
+        VnetProtoSimAgent* agent = theEvent->agent;
+        unsigned int agentIndex = (NULL != agent) ? agent->agent_index : 0;
+        double cpuStart = profiling ? VnetThreadCpuTime() : 0.0;
+        switch (theEvent->type)
+        {
+            case Event::TIMER:
+                if (NULL != agent) agent->OnTimerEvent(theEvent->timer_seq);
+                break;
+            case Event::HUB:
+                OnHubEvent(*theEvent->packet, agent);
+                agent = NULL;  // (hub processing isn't charged to an agent)
+                break;
+            case Event::DELIVER:
+                if (NULL != agent) agent->Deliver(*theEvent->packet);
+                break;
+        }
+        // (the agent may have been deleted while handling its event)
+        if ((NULL != agent) && (agent == agent_list[agentIndex]))
+        {
+            agent->event_count++;
+            if (profiling) agent->cpu_time += VnetThreadCpuTime() - cpuStart;
+        }
+        if (NULL != theEvent->packet) theEvent->packet->Release();
+        delete theEvent;
+    }
+    if (current_time < stopTime) current_time = stopTime;
+}  // end VnetNetwork::Run()
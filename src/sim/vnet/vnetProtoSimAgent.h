@@ -0,0 +1,286 @@
+#ifndef _VNET_PROTO_SIM_AGENT
+#define _VNET_PROTO_SIM_AGENT
+
+// vnetProtoSimAgent.h - Deterministic, in-process "virtual network"
+// simulation environment for ProtoSimAgent-based protocol agents.
+//
+// A VnetNetwork is a discrete event scheduler with a virtual clock (which
+// provides ProtoSystemTime() for SIMULATE builds) and a star topology:
+// each attached agent (node) has an uplink to and a downlink from a central
+// hub where multicast packets are replicated to the group members.  Each
+// link has its own rate, delay, random loss and queue limit so thousands of
+// agents (e.g., NORM receivers) can be run in a single process.
+
+#include "protoSimAgent.h"  // from Protolib
+
+class VnetNetwork;
+class VnetProtoSimAgent;
+
+// Reference-counted packet shared by all receivers of a multicast
+class VnetPacket
+{
+    public:
+        static VnetPacket* Create(const char*         buffer,
+                                  unsigned int        numBytes,
+                                  const ProtoAddress& srcAddr,
+                                  const ProtoAddress& dstAddr);
+        void Retain() {ref_count++;}
+        void Release()
+        {
+            if (0 == --ref_count) delete this;
+        }
+
+        const char* GetBuffer() const {return buffer;}
+        unsigned int GetLength() const {return length;}
+        const ProtoAddress& GetSrcAddr() const {return src_addr;}
+        const ProtoAddress& GetDstAddr() const {return dst_addr;}
+
+    private:
+        VnetPacket();
+        ~VnetPacket();
+
+        unsigned int    ref_count;
+        char*           buffer;
+        unsigned int    length;
+        ProtoAddress    src_addr;
+        ProtoAddress    dst_addr;
+};  // end class VnetPacket
+
+// A one-way link: a packet occupies the link for its serialization time
+// at "rate" (bits/sec, 0.0 for unlimited) and then arrives after the
+// propagation "delay" (sec) unless dropped by random "loss" (percent) or
+// because more than "queue_max" bytes are already waiting to be sent.
+class VnetLink
+{
+    public:
+        VnetLink();
+
+        void SetParameters(double rate, double delay, double loss, unsigned int queueMax)
+        {
+            tx_rate = rate;
+            prop_delay = delay;
+            loss_percent = loss;
+            queue_max = queueMax;
+        }
+
+        // Returns "false" if the packet is dropped, else sets "arrivalTime"
+        bool Transmit(VnetNetwork&  network,
+                      unsigned int  numBytes,
+                      double&       arrivalTime);
+
+        unsigned long GetPacketCount() const {return pkt_count;}
+        unsigned long GetLossCount() const {return loss_count;}
+        unsigned long GetQueueDropCount() const {return drop_count;}
+
+    private:
+        double          tx_rate;
+        double          prop_delay;
+        double          loss_percent;
+        unsigned int    queue_max;
+        double          busy_until;    // time when the queued packets will be sent
+        unsigned long   pkt_count;
+        unsigned long   loss_count;
+        unsigned long   drop_count;
+};  // end class VnetLink
+
+class VnetProtoSimAgent : public ProtoSimAgent
+{
+    friend class VnetNetwork;
+    public:
+        virtual ~VnetProtoSimAgent();
+
+        // ProtoSimAgent override
+        bool GetLocalAddress(ProtoAddress& localAddr);
+
+        unsigned int GetIndex() const {return agent_index;}
+        const ProtoAddress& GetAddress() const {return agent_addr;}
+        VnetLink& AccessUplink() {return up_link;}
+        VnetLink& AccessDownlink() {return down_link;}
+
+        // Processor time used handling this agent's events (if profiling)
+        double GetCpuTime() const {return cpu_time;}
+        unsigned long GetEventCount() const {return event_count;}
+
+        class VnetSocketProxy : public ProtoSimAgent::SocketProxy
+        {
+            friend class VnetProtoSimAgent;
+            public:
+                VnetSocketProxy(VnetProtoSimAgent& theAgent, ProtoSocket& theSocket);
+                ~VnetSocketProxy();
+
+                bool Bind(UINT16& thePort);
+                bool Connect(const ProtoAddress& theAddress);
+                bool SendTo(const char*         buffer,
+                            unsigned int&       numBytes,
+                            const ProtoAddress& dstAddr);
+                bool RecvFrom(char*             buffer,
+                              unsigned int&     numBytes,
+                              ProtoAddress&     srcAddr);
+                bool RecvFrom(char*             buffer,
+                              unsigned int&     numBytes,
+                              ProtoAddress&     srcAddr,
+                              ProtoAddress&     dstAddr);
+                bool JoinGroup(const ProtoAddress& groupAddr);
+                bool LeaveGroup(const ProtoAddress& groupAddr);
+                bool SetTTL(unsigned char ttl) {return true;}
+                bool SetLoopback(bool loopback)
+                {
+                    mcast_loopback = loopback;
+                    return true;
+                }
+                bool SetBroadcast(bool broadcast) {return true;}
+                bool SetTOS(UINT8 tos) {return true;}
+                bool SetEcnCapable(bool ecnCapable) {return true;}
+                bool GetEcnStatus() const {return false;}
+                bool SetTxBufferSize(unsigned int bufferSize) {return true;}
+                unsigned int GetTxBufferSize() {return 0;}
+                bool SetRxBufferSize(unsigned int bufferSize);
+                unsigned int GetRxBufferSize() {return (rx_queue_max * 1500);}
+
+                UINT16 GetPort() const {return port;}
+                bool IsMember(const ProtoAddress& groupAddr) const;
+
+            private:
+                // Queues a received packet and notifies the socket
+                void Enqueue(VnetPacket& packet);
+
+                enum {GROUP_MAX = 8};
+                class RxItem
+                {
+                    public:
+                        VnetPacket* packet;
+                        RxItem*     next;
+                };
+
+                VnetProtoSimAgent&  agent;
+                ProtoSocket&        socket;
+                UINT16              port;
+                ProtoAddress        connect_addr;
+                ProtoAddress        group_list[GROUP_MAX];
+                unsigned int        group_count;
+                bool                mcast_loopback;
+                RxItem*             rx_head;
+                RxItem*             rx_tail;
+                unsigned int        rx_queue_count;
+                unsigned int        rx_queue_max;
+                unsigned long       rx_drop_count;
+                VnetSocketProxy*    prev;
+                VnetSocketProxy*    next;
+        };  // end class VnetProtoSimAgent::VnetSocketProxy
+
+    protected:
+        VnetProtoSimAgent(VnetNetwork& theNetwork);
+
+        // ProtoSimAgent overrides
+        ProtoSimAgent::SocketProxy* OpenSocket(ProtoSocket& theSocket);
+        void CloseSocket(ProtoSocket& theSocket);
+
+        // ProtoTimerMgr override
+        bool UpdateSystemTimer(ProtoTimer::Command command,
+                               double              delay);
+
+    private:
+        // These are invoked by the VnetNetwork event scheduler
+        void OnTimerEvent(UINT32 timerSeq);
+        void Deliver(VnetPacket& packet);
+        bool IsMember(const ProtoAddress& groupAddr, UINT16 port) const;
+
+        VnetNetwork&        network;
+        unsigned int        agent_index;
+        ProtoAddress        agent_addr;
+        VnetLink            up_link;
+        VnetLink            down_link;
+        UINT32              timer_seq;     // invalidates stale timer events
+        UINT16              next_port;     // for ephemeral port assignment
+        VnetSocketProxy*    proxy_list;
+        double              cpu_time;
+        unsigned long       event_count;
+};  // end class VnetProtoSimAgent
+
+// The event scheduler, virtual clock, and hub for attached agents
+class VnetNetwork
+{
+    public:
+        VnetNetwork();
+        ~VnetNetwork();
+
+        bool Init(unsigned int agentMax, UINT32 randomSeed);
+        void Destroy();
+
+        // Only one network provides ProtoSystemTime() at a time
+        static VnetNetwork* GetCurrent() {return current_network;}
+        void MakeCurrent() {current_network = this;}
+
+        double GetCurrentTime() const {return current_time;}
+
+        // Runs the simulation until "stopTime" (or no events remain)
+        void Run(double stopTime);
+
+        // Enables per-agent processor time accounting
+        void SetProfiling(bool state) {profiling = state;}
+
+        // Returns a uniform random value in [0.0, 1.0) (deterministic per seed)
+        double UniformRand();
+
+        unsigned int GetAgentCount() const {return agent_count;}
+        VnetProtoSimAgent* GetAgent(unsigned int index) const
+            {return ((index < agent_count) ? agent_list[index] : NULL);}
+
+        unsigned long GetEventCount() const {return event_total;}
+        unsigned long GetPacketCount() const {return packet_total;}
+
+        // Traffic counts by the first byte's low 4 bits (e.g., NORM message type)
+        enum {TYPE_MAX = 16};
+        unsigned long GetTypeCount(unsigned int type) const
+            {return ((type < TYPE_MAX) ? type_count[type] : 0);}
+
+    private:
+        friend class VnetProtoSimAgent;
+
+        class Event
+        {
+            public:
+                enum Type {TIMER, HUB, DELIVER};
+                double              time;
+                unsigned long       seq;     // makes ordering of same-time events deterministic
+                Type                type;
+                VnetProtoSimAgent*  agent;
+                UINT32              timer_seq;
+                VnetPacket*         packet;
+        };
+
+        bool Attach(VnetProtoSimAgent& agent);
+        void Detach(VnetProtoSimAgent& agent);
+        bool ScheduleEvent(double              time,
+                           Event::Type         type,
+                           VnetProtoSimAgent*  agent,
+                           UINT32              timerSeq,
+                           VnetPacket*         packet);
+        Event* PopEvent();
+        void SendPacket(VnetProtoSimAgent&      srcAgent,
+                        const char*             buffer,
+                        unsigned int            numBytes,
+                        const ProtoAddress&     srcAddr,
+                        const ProtoAddress&     dstAddr,
+                        bool                    loopback);
+        void OnHubEvent(VnetPacket& packet, VnetProtoSimAgent* srcAgent);
+        VnetProtoSimAgent* FindAgent(const ProtoAddress& addr) const;
+
+        static VnetNetwork*     current_network;
+
+        double                  current_time;
+        UINT64                  rand_state;
+        bool                    profiling;
+        VnetProtoSimAgent**     agent_list;
+        unsigned int            agent_count;
+        unsigned int            agent_max;
+        Event**                 event_heap;   // binary min-heap by (time, seq)
+        unsigned int            event_count;
+        unsigned int            event_max;
+        unsigned long           event_seq;
+        unsigned long           event_total;
+        unsigned long           packet_total;
+        unsigned long           type_count[TYPE_MAX];
+};  // end class VnetNetwork
+
+#endif // _VNET_PROTO_SIM_AGENT